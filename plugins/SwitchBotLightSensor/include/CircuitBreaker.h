@@ -0,0 +1,69 @@
+#ifndef SWITCHBOT_CIRCUIT_BREAKER_H
+#define SWITCHBOT_CIRCUIT_BREAKER_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+// サーキットブレーカーの状態
+enum class CircuitState {
+    Closed,     // 通常どおりリクエストを送る
+    Open,       // 障害中のためリクエストを送らない
+    HalfOpen    // 復旧確認のため1回だけリクエストを送る
+};
+
+const char* ToString(CircuitState state);
+
+/**
+ * @brief 連続した失敗でAPIへのリクエストを止めるサーキットブレーカー
+ *
+ * 連続した失敗が閾値に達するとOpenになり、待機時間が過ぎるまでリクエストを拒否します。
+ * 待機時間が過ぎるとHalfOpenになって1回だけリクエストを許可し、成功すればClosedへ、
+ * 失敗すれば再びOpenへ戻ります。状態の変化はリスナーへ通知されます。
+ */
+class CircuitBreaker {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimeSource = std::function<Clock::time_point()>;
+    using StateListener = std::function<void(CircuitState from, CircuitState to)>;
+
+    struct Stats {
+        CircuitState state = CircuitState::Closed;
+        int consecutiveFailures = 0;
+        uint64_t trips = 0;         // Openになった回数
+        uint64_t rejected = 0;      // Open中に拒否したリクエスト数
+    };
+
+    CircuitBreaker(int failureThreshold, std::chrono::milliseconds openDuration, TimeSource now = nullptr);
+
+    // リクエストを送ってよいか（HalfOpenでは確認中のリクエストがなければ許可する）
+    bool AllowRequest();
+    void RecordSuccess();
+    void RecordFailure();
+
+    CircuitState GetState() const;
+    Stats GetStats() const;
+
+    // 状態が変化したときに呼ばれる（ロックの外で呼び出す）
+    void SetStateListener(StateListener listener);
+
+private:
+    // 状態を変更する（ロック済みで呼び出し、通知すべき変化を返す）
+    bool Transition(CircuitState to, CircuitState& from);
+    void Notify(CircuitState from, CircuitState to);
+
+    mutable std::mutex m_mutex;
+    TimeSource m_now;
+    int m_failureThreshold;
+    std::chrono::milliseconds m_openDuration;
+    CircuitState m_state = CircuitState::Closed;
+    Clock::time_point m_openedAt;
+    bool m_probeInFlight = false;
+    int m_consecutiveFailures = 0;
+    uint64_t m_trips = 0;
+    uint64_t m_rejected = 0;
+    StateListener m_listener;
+};
+
+#endif // SWITCHBOT_CIRCUIT_BREAKER_H
@@ -0,0 +1,45 @@
+#ifndef SWITCHBOT_CURL_SHARE_H
+#define SWITCHBOT_CURL_SHARE_H
+
+#include <array>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief HTTPクライアント間で共有するcurlの接続キャッシュ
+ *
+ * 接続・DNS・TLSセッションのキャッシュをプロセス内のすべてのHttpClientで
+ * 共有し、センサーごとにTLSハンドシェイクをやり直さないようにします。
+ * curl_global_init/curl_global_cleanupもここで一度だけ行います。
+ */
+class CurlShare {
+public:
+    ~CurlShare();
+
+    CurlShare(const CurlShare&) = delete;
+    CurlShare& operator=(const CurlShare&) = delete;
+
+    /**
+     * @brief 共有インスタンスを取得
+     *
+     * 利用中のHttpClientがなくなると解放され、次回の取得時に作り直されます。
+     * @throws HttpException 初期化に失敗した場合
+     */
+    static std::shared_ptr<CurlShare> Acquire();
+
+    // CURLSH*のハンドル
+    void* GetHandle() const { return m_share; }
+
+    // 共有データの種類（curl_lock_data）に対応するロック（curlのロックコールバック用）
+    std::mutex& GetMutex(int data);
+
+private:
+    CurlShare();
+
+    void* m_share;  // CURLSH*のハンドル
+
+    // 共有するデータの種類ごとのロック
+    std::array<std::mutex, 8> m_mutexes;
+};
+
+#endif // SWITCHBOT_CURL_SHARE_H
@@ -1,22 +1,53 @@
 #ifndef SWITCHBOT_HTTP_CLIENT_H
 #define SWITCHBOT_HTTP_CLIENT_H
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 #include <nlohmann/json.hpp>
 
+class CurlShare;
+
 class HttpClient {
 public:
+    // 接続の再利用状況などの統計
+    struct Stats {
+        uint64_t requests = 0;            // 送信したリクエスト数
+        uint64_t failures = 0;            // 失敗したリクエスト数
+        uint64_t newConnections = 0;      // 新しく確立した接続数
+        uint64_t reusedConnections = 0;   // 既存の接続を再利用したリクエスト数
+
+        // 接続を再利用できたリクエストの割合（0.0-1.0）
+        double ReuseRate() const
+        {
+            uint64_t total = newConnections + reusedConnections;
+            return total == 0 ? 0.0 : static_cast<double>(reusedConnections) / static_cast<double>(total);
+        }
+    };
+
     HttpClient(const std::string& token, const std::string& secret);
     ~HttpClient();
 
+    HttpClient(const HttpClient&) = delete;
+    HttpClient& operator=(const HttpClient&) = delete;
+
     nlohmann::json Get(const std::string& endpoint);
 
+    Stats GetStats() const;
+
 private:
     std::string m_token;
     std::string m_secret;
-    void* m_curl;  // CURL*のハンドル
+    std::shared_ptr<CurlShare> m_share;   // 接続・DNS・TLSセッションのキャッシュ（全クライアントで共有）
+    void* m_curl;           // CURL*のハンドル
+    void* m_baseHeaders;    // curl_slist*（リクエストごとに変わらないヘッダー）
+
+    // easyハンドルは同時に1つのリクエストにしか使えないため、Get()を直列化する
+    mutable std::mutex m_mutex;
+    Stats m_stats;
 
-    void SetupHeaders(void* request, const std::string& timestamp, const std::string& signature, const std::string& nonce);
     std::string GetTimestamp();
     void Initialize();
     void Cleanup();
@@ -0,0 +1,88 @@
+#ifndef SWITCHBOT_LIGHT_LEVEL_CACHE_H
+#define SWITCHBOT_LIGHT_LEVEL_CACHE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+// 照度キャッシュの有効期間
+struct CachePolicy {
+    std::chrono::milliseconds ttl{60000};                    // 新しい値として扱う期間（0でキャッシュしない）
+    std::chrono::milliseconds staleWhileRevalidate{300000};  // TTL経過後も古い値を返しながら再取得する期間
+    std::chrono::milliseconds maxFallbackAge{900000};        // 取得に失敗したときに最後の値を代わりに使える期間（取得時刻から）
+};
+
+/**
+ * @brief 照度の取得結果をキャッシュする
+ *
+ * TTL内の値はそのまま返します。TTLを過ぎた値はstale-while-revalidateの期間内であれば
+ * すぐに返し、裏でワーカースレッドが再取得します。キャッシュがない場合や期間を
+ * 過ぎた場合は呼び出し元で取得します（同時に取得が必要になった呼び出しは1回にまとめます）。
+ * 再取得に失敗した場合は古い値を残し、期間を過ぎるまで次の呼び出しで再取得を試みます。
+ */
+class LightLevelCache {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimeSource = std::function<Clock::time_point()>;
+    using Fetcher = std::function<int()>;
+
+    struct Stats {
+        uint64_t hits = 0;              // TTL内の値を返した回数
+        uint64_t staleHits = 0;         // 古い値を返して再取得を開始した回数
+        uint64_t misses = 0;            // 呼び出し元で取得した回数
+        uint64_t refreshes = 0;         // 裏での再取得に成功した回数
+        uint64_t refreshFailures = 0;   // 裏での再取得に失敗した回数
+
+        // キャッシュから返した割合（0.0-1.0）
+        double HitRate() const
+        {
+            uint64_t total = hits + staleHits + misses;
+            return total == 0 ? 0.0 : static_cast<double>(hits + staleHits) / static_cast<double>(total);
+        }
+    };
+
+    LightLevelCache(Fetcher fetcher, const CachePolicy& policy, TimeSource now = nullptr);
+    ~LightLevelCache();
+
+    LightLevelCache(const LightLevelCache&) = delete;
+    LightLevelCache& operator=(const LightLevelCache&) = delete;
+
+    /**
+     * @brief 照度を取得する
+     * @throws 呼び出し元で取得した場合はFetcherの例外をそのまま送出する
+     */
+    int Get();
+
+    // キャッシュした値を破棄する（次のGet()は呼び出し元で取得する）
+    void Invalidate();
+
+    // 取得に失敗したときの代替値（最後に取得できた値。取得からmaxFallbackAgeを過ぎた値は使わない）
+    std::optional<int> GetFallbackValue() const;
+
+    Stats GetStats() const;
+    const CachePolicy& GetPolicy() const { return m_policy; }
+
+private:
+    void Store(int value, Clock::time_point fetchedAt);
+    void RefreshLoop();
+
+    Fetcher m_fetcher;
+    CachePolicy m_policy;
+    TimeSource m_now;
+
+    mutable std::mutex m_mutex;
+    std::mutex m_fetchMutex;    // 呼び出し元での取得を1回にまとめる
+    std::condition_variable m_refreshRequested;
+    std::optional<int> m_value;
+    Clock::time_point m_fetchedAt;
+    bool m_refreshPending = false;
+    bool m_stopping = false;
+    Stats m_stats;
+    std::thread m_worker;
+};
+
+#endif // SWITCHBOT_LIGHT_LEVEL_CACHE_H
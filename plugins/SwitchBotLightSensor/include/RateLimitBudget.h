@@ -0,0 +1,52 @@
+#ifndef SWITCHBOT_RATE_LIMIT_BUDGET_H
+#define SWITCHBOT_RATE_LIMIT_BUDGET_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+/**
+ * @brief APIの1日あたりの呼び出し回数の予算を管理する
+ *
+ * SwitchBot APIはトークンごとに1日あたりの呼び出し回数が制限されているため、
+ * 呼び出し前に予算を消費し、使い切った場合はリクエストを送らずに失敗させます。
+ * 予算はUTCの日付が変わるとリセットされます。
+ */
+class RateLimitBudget {
+public:
+    using Clock = std::chrono::system_clock;
+    using TimeSource = std::function<Clock::time_point()>;
+
+    struct Stats {
+        int limit = 0;              // 1日あたりの上限
+        int used = 0;               // 今日使った回数
+        uint64_t rejected = 0;      // 予算切れで拒否した回数（累計）
+    };
+
+    // SwitchBot API v1.1の上限
+    static constexpr int kDefaultDailyLimit = 10000;
+
+    explicit RateLimitBudget(int dailyLimit = kDefaultDailyLimit, TimeSource now = nullptr);
+
+    // 予算を消費する（足りない場合は消費せずにfalseを返す）
+    bool TryConsume(int calls = 1);
+
+    int GetRemaining() const;
+    Stats GetStats() const;
+
+    void SetDailyLimit(int dailyLimit);
+
+private:
+    // 日付が変わっていれば使用回数をリセットする（ロック済みで呼び出す）
+    void RollOver() const;
+
+    mutable std::mutex m_mutex;
+    TimeSource m_now;
+    int m_limit;
+    mutable int m_used = 0;
+    mutable int64_t m_day = -1;     // UNIXエポックからの日数（UTC）
+    uint64_t m_rejected = 0;
+};
+
+#endif // SWITCHBOT_RATE_LIMIT_BUDGET_H
@@ -0,0 +1,71 @@
+#ifndef SWITCHBOT_RESILIENT_FETCHER_H
+#define SWITCHBOT_RESILIENT_FETCHER_H
+
+#include "CircuitBreaker.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+
+// 失敗時の再試行とサーキットブレーカーの設定
+struct ResiliencePolicy {
+    int retryCount = 3;                                 // Openにするまでに再試行する回数
+    std::chrono::milliseconds initialBackoff{1000};     // 最初の失敗後の待機時間
+    std::chrono::milliseconds maxBackoff{60000};        // 待機時間の上限
+    double jitter = 0.5;                                // 待機時間をランダムに短くする最大の割合（0.0-1.0）
+    std::chrono::milliseconds openDuration{60000};      // Openにしてから復旧確認までの時間
+};
+
+/**
+ * @brief 指数バックオフとサーキットブレーカーで照度の取得を保護する
+ *
+ * 失敗すると待機時間を指数的に伸ばし（ジッター付き）、待機中の呼び出しはAPIを
+ * 呼ばずにServiceUnavailableExceptionで即座に失敗します。連続した失敗が
+ * retryCount + 1回に達するとサーキットブレーカーがOpenになり、openDurationの間は
+ * 同様に即座に失敗します。待機のためにスレッドを止めることはありません。
+ */
+class ResilientFetcher {
+public:
+    using Clock = CircuitBreaker::Clock;
+    using TimeSource = CircuitBreaker::TimeSource;
+    using Fetcher = std::function<int()>;
+
+    struct Stats {
+        uint64_t attempts = 0;      // APIを呼び出した回数
+        uint64_t failures = 0;      // 呼び出しに失敗した回数
+        uint64_t skipped = 0;       // 待機中またはOpenのため呼び出さなかった回数
+        std::chrono::milliseconds currentBackoff{0};    // 直近の失敗後の待機時間
+        CircuitBreaker::Stats circuit;
+    };
+
+    ResilientFetcher(Fetcher fetcher, const ResiliencePolicy& policy, TimeSource now = nullptr,
+        uint32_t seed = std::random_device{}());
+
+    /**
+     * @brief 照度を取得する
+     * @throws ServiceUnavailableException 待機中またはOpenのため呼び出さなかった場合
+     * @throws 呼び出した場合はFetcherの例外をそのまま送出する
+     */
+    int Fetch();
+
+    Stats GetStats() const;
+    CircuitBreaker& GetCircuitBreaker() { return m_breaker; }
+
+    // n回連続で失敗した後の待機時間（ジッターなし）
+    static std::chrono::milliseconds BackoffFor(const ResiliencePolicy& policy, int failures);
+
+private:
+    Fetcher m_fetcher;
+    ResiliencePolicy m_policy;
+    TimeSource m_now;
+    CircuitBreaker m_breaker;
+
+    mutable std::mutex m_mutex;
+    std::mt19937 m_random;
+    int m_consecutiveFailures = 0;
+    Clock::time_point m_nextAttempt;
+    Stats m_stats;
+};
+
+#endif // SWITCHBOT_RESILIENT_FETCHER_H
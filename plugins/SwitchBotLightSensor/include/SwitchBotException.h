@@ -46,4 +46,23 @@ public:
     }
 };
 
+class RateLimitException : public SwitchBotException
+{
+public:
+    explicit RateLimitException(const std::string& message)
+        : SwitchBotException(message, 429)
+    {
+    }
+};
+
+// サーキットブレーカーがOpenの間や再試行の待機中に、APIを呼び出さずに失敗した場合
+class ServiceUnavailableException : public SwitchBotException
+{
+public:
+    explicit ServiceUnavailableException(const std::string& message)
+        : SwitchBotException(message, 503)
+    {
+    }
+};
+
 #endif // SWITCHBOT_EXCEPTION_H
\ No newline at end of file
@@ -4,38 +4,54 @@
 #include <memory>
 #include <string>
 #include <ILightSensor.h>
+#include "LightLevelCache.h"
+#include "ResilientFetcher.h"
 #include <ConfigManager.h>
 #include <nlohmann/json.hpp>
 
+#ifdef _WIN32
 #ifdef SWITCHBOT_EXPORTS
 #define SWITCHBOT_API __declspec(dllexport)
 #else
 #define SWITCHBOT_API __declspec(dllimport)
 #endif
+#else
+#define SWITCHBOT_API
+#endif
 
-class HttpClient;
+class SwitchBotStatusService;
 class SWITCHBOT_API SwitchBotLightSensor : public ILightSensor {
 private:
     std::string m_token;
     std::string m_deviceId;
-    int m_retryCount;
-    int m_retryInterval;
-    std::unique_ptr<HttpClient> m_httpClient;
+    int m_retryCount;       // サーキットブレーカーをOpenにするまでに再試行する回数
+    int m_retryInterval;    // 最初の再試行までの待機時間（ミリ秒、以降は倍々に伸ばす）
+    std::shared_ptr<SwitchBotStatusService> m_statusService;  // 同じトークンのセンサーで共有
     ConfigManager& m_config;
     CalibrationSettings m_calibration;
+    std::unique_ptr<ResilientFetcher> m_fetcher;    // 再試行とサーキットブレーカー
+    std::unique_ptr<LightLevelCache> m_cache;       // GetLightLevel()の結果のキャッシュ
 
 public:
     SwitchBotLightSensor(
         const std::string& token,
         const std::string& deviceId,
         int retryCount = 3,
-        int retryInterval = 1000
+        int retryInterval = 1000,
+        const CachePolicy& cachePolicy = CachePolicy(),
+        std::chrono::milliseconds circuitOpenDuration = std::chrono::milliseconds(60000)
     );
     virtual ~SwitchBotLightSensor() override;
 
+    // キャッシュ済みの照度を返す（期限切れの場合は裏で再取得し、取得できない場合はmaxFallbackAge以内の最後の値を返す）
     virtual int GetLightLevel() override;
 
+    LightLevelCache::Stats GetCacheStats() const;
+    ResilientFetcher::Stats GetResilienceStats() const;
+
 private:
+    // APIから照度を取得して正規化する
+    int FetchLightLevel();
     nlohmann::json GetDeviceStatus();
     int NormalizeLightLevel(int rawLevel);
     std::string GenerateNonce();
@@ -0,0 +1,100 @@
+#ifndef SWITCHBOT_STATUS_SERVICE_H
+#define SWITCHBOT_STATUS_SERVICE_H
+
+#include "RateLimitBudget.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+class HttpClient;
+
+/**
+ * @brief 同じトークンを使うセンサーのステータス取得をまとめるサービス
+ *
+ * 短い集約時間内に要求されたデバイスのステータスを1回のラウンドで取得し、
+ * 同じデバイスを要求したすべての呼び出し元へ結果を配ります。登録済みの
+ * すべてのデバイスが要求された時点で、集約時間を待たずにラウンドを開始します。
+ * API呼び出しはトークンごとの1日あたりの予算から消費されます。
+ */
+class SwitchBotStatusService {
+public:
+    struct Options {
+        std::string baseUrl = "https://api.switch-bot.com/v1.1/devices/";
+        std::chrono::milliseconds coalesceWindow{200};
+        int dailyLimit = RateLimitBudget::kDefaultDailyLimit;
+        RateLimitBudget::TimeSource now;    // テスト用の時刻取得（nullptrなら現在時刻）
+    };
+
+    struct Stats {
+        uint64_t rounds = 0;              // 実行したラウンド数
+        uint64_t requests = 0;            // FetchStatus()の呼び出し数
+        uint64_t coalescedRequests = 0;   // 同じラウンドの同じデバイスにまとめられた呼び出し数
+        uint64_t apiCalls = 0;            // 実際に送ったAPIリクエスト数
+    };
+
+    SwitchBotStatusService(const std::string& token, const std::string& secret, const Options& options);
+    ~SwitchBotStatusService();
+
+    SwitchBotStatusService(const SwitchBotStatusService&) = delete;
+    SwitchBotStatusService& operator=(const SwitchBotStatusService&) = delete;
+
+    /**
+     * @brief トークンごとの共有インスタンスを取得
+     *
+     * 同じトークンのサービスが既にあればそれを返します（optionsは最初の作成時のものが使われます）。
+     */
+    static std::shared_ptr<SwitchBotStatusService> ForToken(
+        const std::string& token,
+        const std::string& secret,
+        const Options& options);
+
+    // ラウンドの早期開始の判定に使うデバイスの登録
+    void Register(const std::string& deviceId);
+    void Unregister(const std::string& deviceId);
+
+    /**
+     * @brief デバイスのステータスを取得する（次のラウンドの完了まで待機する）
+     * @throws HttpException 通信に失敗した場合
+     * @throws RateLimitException 1日あたりの予算を使い切った場合
+     */
+    nlohmann::json FetchStatus(const std::string& deviceId);
+
+    Stats GetStats() const;
+    RateLimitBudget::Stats GetBudgetStats() const;
+
+private:
+    struct Round {
+        std::set<std::string> devices;
+        std::map<std::string, nlohmann::json> results;
+        std::map<std::string, std::exception_ptr> errors;
+        std::chrono::steady_clock::time_point deadline;
+        bool done = false;
+    };
+
+    void RoundLoop();
+    void RunRound(Round& round);
+    bool AllRegisteredRequested() const;
+
+    Options m_options;
+    std::unique_ptr<HttpClient> m_httpClient;
+    RateLimitBudget m_budget;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_roundRequested;
+    std::condition_variable m_roundCompleted;
+    std::shared_ptr<Round> m_pending;               // 要求を受け付け中のラウンド
+    std::map<std::string, int> m_registered;        // デバイスIDと登録数
+    Stats m_stats;
+    bool m_stopping = false;
+    std::thread m_worker;
+};
+
+#endif // SWITCHBOT_STATUS_SERVICE_H
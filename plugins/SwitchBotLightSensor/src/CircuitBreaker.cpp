@@ -0,0 +1,130 @@
+#include "CircuitBreaker.h"
+#include <stdexcept>
+
+const char* ToString(CircuitState state)
+{
+    switch (state) {
+    case CircuitState::Closed:
+        return "closed";
+    case CircuitState::Open:
+        return "open";
+    case CircuitState::HalfOpen:
+        return "half_open";
+    }
+    return "unknown";
+}
+
+CircuitBreaker::CircuitBreaker(int failureThreshold, std::chrono::milliseconds openDuration, TimeSource now)
+    : m_now(now ? std::move(now) : TimeSource([] { return Clock::now(); }))
+    , m_failureThreshold(failureThreshold)
+    , m_openDuration(openDuration)
+{
+    if (failureThreshold <= 0) {
+        throw std::invalid_argument("失敗回数の閾値は1以上である必要があります");
+    }
+    if (openDuration.count() < 0) {
+        throw std::invalid_argument("待機時間は0以上である必要があります");
+    }
+}
+
+bool CircuitBreaker::AllowRequest()
+{
+    CircuitState from = CircuitState::Closed;
+    bool changed = false;
+    bool allowed = true;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_state == CircuitState::Open && m_now() - m_openedAt >= m_openDuration) {
+            changed = Transition(CircuitState::HalfOpen, from);
+        }
+
+        if (m_state == CircuitState::Open || (m_state == CircuitState::HalfOpen && m_probeInFlight)) {
+            ++m_rejected;
+            allowed = false;
+        }
+        else if (m_state == CircuitState::HalfOpen) {
+            m_probeInFlight = true;
+        }
+    }
+    if (changed) {
+        Notify(from, CircuitState::HalfOpen);
+    }
+    return allowed;
+}
+
+void CircuitBreaker::RecordSuccess()
+{
+    CircuitState from = CircuitState::Closed;
+    bool changed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_consecutiveFailures = 0;
+        m_probeInFlight = false;
+        changed = Transition(CircuitState::Closed, from);
+    }
+    if (changed) {
+        Notify(from, CircuitState::Closed);
+    }
+}
+
+void CircuitBreaker::RecordFailure()
+{
+    CircuitState from = CircuitState::Closed;
+    bool changed = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_consecutiveFailures;
+        // 復旧確認の失敗は閾値に関係なく再びOpenにする
+        if (m_state == CircuitState::HalfOpen || m_consecutiveFailures >= m_failureThreshold) {
+            m_openedAt = m_now();
+            changed = Transition(CircuitState::Open, from);
+            if (changed) {
+                ++m_trips;
+            }
+        }
+        m_probeInFlight = false;
+    }
+    if (changed) {
+        Notify(from, CircuitState::Open);
+    }
+}
+
+CircuitState CircuitBreaker::GetState() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_state;
+}
+
+CircuitBreaker::Stats CircuitBreaker::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return Stats{m_state, m_consecutiveFailures, m_trips, m_rejected};
+}
+
+void CircuitBreaker::SetStateListener(StateListener listener)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_listener = std::move(listener);
+}
+
+bool CircuitBreaker::Transition(CircuitState to, CircuitState& from)
+{
+    if (m_state == to) {
+        return false;
+    }
+    from = m_state;
+    m_state = to;
+    return true;
+}
+
+void CircuitBreaker::Notify(CircuitState from, CircuitState to)
+{
+    StateListener listener;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        listener = m_listener;
+    }
+    if (listener) {
+        listener(from, to);
+    }
+}
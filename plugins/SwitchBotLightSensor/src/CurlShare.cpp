@@ -0,0 +1,69 @@
+#include "CurlShare.h"
+#include "HttpClient.h"
+#include <curl/curl.h>
+
+namespace {
+    std::mutex g_shareMutex;
+    std::weak_ptr<CurlShare> g_share;
+
+    static_assert(CURL_LOCK_DATA_LAST <= 8, "CurlShare::m_mutexes is too small");
+
+    void LockShare(CURL* /*handle*/, curl_lock_data data, curl_lock_access /*access*/, void* userp)
+    {
+        static_cast<CurlShare*>(userp)->GetMutex(data).lock();
+    }
+
+    void UnlockShare(CURL* /*handle*/, curl_lock_data data, void* userp)
+    {
+        static_cast<CurlShare*>(userp)->GetMutex(data).unlock();
+    }
+}
+
+CurlShare::CurlShare()
+    : m_share(nullptr)
+{
+    if (curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+        throw HttpException("Failed to initialize CURL");
+    }
+
+    CURLSH* share = curl_share_init();
+    if (!share) {
+        curl_global_cleanup();
+        throw HttpException("Failed to initialize CURL share");
+    }
+
+    // 複数のスレッドのHttpClientから使われるため、共有データごとにロックする
+    curl_share_setopt(share, CURLSHOPT_LOCKFUNC, LockShare);
+    curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, UnlockShare);
+    curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+    m_share = share;
+}
+
+CurlShare::~CurlShare()
+{
+    if (m_share) {
+        curl_share_cleanup(static_cast<CURLSH*>(m_share));
+        m_share = nullptr;
+    }
+    curl_global_cleanup();
+}
+
+std::shared_ptr<CurlShare> CurlShare::Acquire()
+{
+    std::lock_guard<std::mutex> lock(g_shareMutex);
+    auto share = g_share.lock();
+    if (!share) {
+        share = std::shared_ptr<CurlShare>(new CurlShare());
+        g_share = share;
+    }
+    return share;
+}
+
+std::mutex& CurlShare::GetMutex(int data)
+{
+    size_t index = static_cast<size_t>(data);
+    return m_mutexes[index < m_mutexes.size() ? index : 0];
+}
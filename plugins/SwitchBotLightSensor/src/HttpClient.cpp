@@ -1,6 +1,8 @@
 #include "HttpClient.h"
+#include "CurlShare.h"
 #include <curl/curl.h>
 #include <sstream>
+#include <iomanip>
 #include <chrono>
 #include <random>
 #include <openssl/hmac.h>
@@ -65,6 +67,7 @@ HttpClient::HttpClient(const std::string& token, const std::string& secret)
     : m_token(token)
     , m_secret(secret)
     , m_curl(nullptr)
+    , m_baseHeaders(nullptr)
 {
     Initialize();
 }
@@ -74,11 +77,44 @@ HttpClient::~HttpClient() {
 }
 
 void HttpClient::Initialize() {
-    curl_global_init(CURL_GLOBAL_DEFAULT);
+    // curl_global_initは共有キャッシュの作成時に一度だけ行われる
+    m_share = CurlShare::Acquire();
+
     m_curl = curl_easy_init();
     if (!m_curl) {
+        Cleanup();
         throw HttpException("Failed to initialize CURL");
     }
+
+    // リクエストごとに変わらない設定はここで一度だけ行う
+    curl_easy_setopt(m_curl, CURLOPT_SHARE, m_share->GetHandle());
+    curl_easy_setopt(m_curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(m_curl, CURLOPT_SSL_VERIFYPEER, 1L);
+    curl_easy_setopt(m_curl, CURLOPT_SSL_VERIFYHOST, 2L);
+    curl_easy_setopt(m_curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(m_curl, CURLOPT_CONNECTTIMEOUT_MS, 5000L);
+    curl_easy_setopt(m_curl, CURLOPT_TIMEOUT_MS, 15000L);
+
+    // 接続を使い回すためのTCP設定（アイドル中の切断を検出し、小さなリクエストを遅延させない）
+    curl_easy_setopt(m_curl, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(m_curl, CURLOPT_TCP_KEEPIDLE, 60L);
+    curl_easy_setopt(m_curl, CURLOPT_TCP_KEEPINTVL, 30L);
+    curl_easy_setopt(m_curl, CURLOPT_TCP_NODELAY, 1L);
+
+    struct curl_slist* headers = nullptr;
+    for (const std::string& header : {
+            "Authorization: " + m_token,
+            std::string("Content-Type: application/json"),
+            std::string("charset: utf-8") }) {
+        struct curl_slist* appended = curl_slist_append(headers, header.c_str());
+        if (!appended) {
+            curl_slist_free_all(headers);
+            Cleanup();
+            throw HttpException("Failed to build HTTP headers");
+        }
+        headers = appended;
+    }
+    m_baseHeaders = headers;
 }
 
 void HttpClient::Cleanup() {
@@ -86,32 +122,32 @@ void HttpClient::Cleanup() {
         curl_easy_cleanup(m_curl);
         m_curl = nullptr;
     }
-    curl_global_cleanup();
+    if (m_baseHeaders) {
+        curl_slist_free_all(static_cast<struct curl_slist*>(m_baseHeaders));
+        m_baseHeaders = nullptr;
+    }
+    // 最後のクライアントが破棄されたときに共有キャッシュとcurl_global_cleanupが行われる
+    m_share.reset();
 }
 
-// UUID生成関数
+// UUID（バージョン4）生成関数
 std::string HttpClient::generateUUID() {
-    GUID guid;
-    HRESULT hr = CoCreateGuid(&guid);
-
-    if (SUCCEEDED(hr)) {
-        std::stringstream ss;
-        ss << std::hex << std::setfill('0')
-           << std::setw(8) << guid.Data1 << "-"
-           << std::setw(4) << guid.Data2 << "-"
-           << std::setw(4) << guid.Data3 << "-"
-           << std::setw(2) << static_cast<int>(guid.Data4[0])
-           << std::setw(2) << static_cast<int>(guid.Data4[1]) << "-"
-           << std::setw(2) << static_cast<int>(guid.Data4[2])
-           << std::setw(2) << static_cast<int>(guid.Data4[3])
-           << std::setw(2) << static_cast<int>(guid.Data4[4])
-           << std::setw(2) << static_cast<int>(guid.Data4[5])
-           << std::setw(2) << static_cast<int>(guid.Data4[6])
-           << std::setw(2) << static_cast<int>(guid.Data4[7]);
-        return ss.str();
-    }
-
-    return ""; // エラー時は空文字列を返す
+    thread_local std::mt19937_64 engine{std::random_device{}()};
+    uint64_t high = engine();
+    uint64_t low = engine();
+
+    // バージョン（4）とバリアント（10xx）のビットを設定
+    high = (high & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL;
+    low = (low & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL;
+
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0')
+       << std::setw(8) << (high >> 32) << "-"
+       << std::setw(4) << ((high >> 16) & 0xFFFF) << "-"
+       << std::setw(4) << (high & 0xFFFF) << "-"
+       << std::setw(4) << (low >> 48) << "-"
+       << std::setw(12) << (low & 0xFFFFFFFFFFFFULL);
+    return ss.str();
 }
 
 std::string HttpClient::GetTimestamp() {
@@ -120,19 +156,8 @@ std::string HttpClient::GetTimestamp() {
     return std::to_string(ms.count());
 }
 
-void HttpClient::SetupHeaders(void* request, const std::string& timestamp, const std::string& signature, const std::string& nonce) {
-    struct curl_slist* headers = nullptr;
-    headers = curl_slist_append(headers, ("Authorization: " + m_token).c_str());
-    headers = curl_slist_append(headers, "Content-Type: application/json");
-    headers = curl_slist_append(headers, "charset: utf-8");
-    headers = curl_slist_append(headers, ("t: " + timestamp).c_str());
-    headers = curl_slist_append(headers, ("sign: " + signature).c_str());
-    headers = curl_slist_append(headers, ("nonce: " + nonce).c_str());
-
-    curl_easy_setopt(request, CURLOPT_HTTPHEADER, headers);
-}
-
 nlohmann::json HttpClient::Get(const std::string& endpoint) {
+    std::lock_guard<std::mutex> lock(m_mutex);
     if (!m_curl) {
         std::cerr << "[SwitchBot] Error: CURL not initialized" << std::endl;
         throw HttpException("CURL not initialized");
@@ -157,18 +182,49 @@ nlohmann::json HttpClient::Get(const std::string& endpoint) {
     std::cout << "  - Token: " << m_token.substr(0, 5) << "..." << m_token.substr(m_token.length() - 5) << std::endl;
     std::cout << "  - Sign: " << signature << std::endl;
 
+    // 署名ヘッダーだけをリクエストごとに作成し、共通ヘッダーの前につなげて送る
+    struct curl_slist* signedHeaders = nullptr;
+    for (const std::string& header : { "t: " + timestamp, "sign: " + signature, "nonce: " + nonce }) {
+        struct curl_slist* appended = curl_slist_append(signedHeaders, header.c_str());
+        if (!appended) {
+            curl_slist_free_all(signedHeaders);
+            throw HttpException("Failed to build HTTP headers");
+        }
+        signedHeaders = appended;
+    }
+    struct curl_slist* lastSigned = signedHeaders;
+    while (lastSigned->next) {
+        lastSigned = lastSigned->next;
+    }
+    lastSigned->next = static_cast<struct curl_slist*>(m_baseHeaders);
+
     std::string response_string;
     curl_easy_setopt(m_curl, CURLOPT_URL, endpoint.c_str());
-    curl_easy_setopt(m_curl, CURLOPT_WRITEFUNCTION, WriteCallback);
     curl_easy_setopt(m_curl, CURLOPT_WRITEDATA, &response_string);
-    curl_easy_setopt(m_curl, CURLOPT_SSL_VERIFYPEER, 1L);
-    curl_easy_setopt(m_curl, CURLOPT_SSL_VERIFYHOST, 2L);
-
-    SetupHeaders(m_curl, timestamp, signature, nonce);
+    curl_easy_setopt(m_curl, CURLOPT_HTTPHEADER, signedHeaders);
 
     std::cout << "[SwitchBot] Sending request..." << std::endl;
     CURLcode res = curl_easy_perform(m_curl);
+
+    // 共通ヘッダーを切り離してから、このリクエストの署名ヘッダーだけを解放する
+    curl_easy_setopt(m_curl, CURLOPT_HTTPHEADER, nullptr);
+    curl_easy_setopt(m_curl, CURLOPT_WRITEDATA, nullptr);
+    lastSigned->next = nullptr;
+    curl_slist_free_all(signedHeaders);
+
+    ++m_stats.requests;
+    long connects = 0;
+    if (curl_easy_getinfo(m_curl, CURLINFO_NUM_CONNECTS, &connects) == CURLE_OK && res == CURLE_OK) {
+        if (connects > 0) {
+            m_stats.newConnections += static_cast<uint64_t>(connects);
+        }
+        else {
+            ++m_stats.reusedConnections;
+        }
+    }
+
     if (res != CURLE_OK) {
+        ++m_stats.failures;
         std::string error = curl_easy_strerror(res);
         std::cerr << "[SwitchBot] CURL request failed: " << error << std::endl;
         throw HttpException(std::string("CURL request failed: ") + error);
@@ -179,6 +235,7 @@ nlohmann::json HttpClient::Get(const std::string& endpoint) {
     std::cout << "[SwitchBot] HTTP response code: " << http_code << std::endl;
 
     if (http_code != 200) {
+        ++m_stats.failures;
         std::cerr << "[SwitchBot] HTTP request failed with code: " << http_code << std::endl;
         std::cerr << "[SwitchBot] Response content: " << response_string << std::endl;
 
@@ -194,8 +251,14 @@ nlohmann::json HttpClient::Get(const std::string& endpoint) {
         std::cout << "[SwitchBot] Response parsed successfully" << std::endl;
         return json_response;
     } catch (const nlohmann::json::parse_error& e) {
+        ++m_stats.failures;
         std::cerr << "[SwitchBot] Failed to parse JSON response: " << e.what() << std::endl;
         std::cerr << "[SwitchBot] Raw response: " << response_string << std::endl;
         throw HttpException(std::string("Failed to parse JSON response: ") + e.what());
     }
 }
+
+HttpClient::Stats HttpClient::GetStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
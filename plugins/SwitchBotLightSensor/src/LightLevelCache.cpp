@@ -0,0 +1,138 @@
+#include "LightLevelCache.h"
+#include <stdexcept>
+
+LightLevelCache::LightLevelCache(Fetcher fetcher, const CachePolicy& policy, TimeSource now)
+    : m_fetcher(std::move(fetcher))
+    , m_policy(policy)
+    , m_now(now ? std::move(now) : TimeSource([] { return Clock::now(); }))
+{
+    if (!m_fetcher) {
+        throw std::invalid_argument("照度の取得関数を指定してください");
+    }
+    if (m_policy.ttl.count() < 0 || m_policy.staleWhileRevalidate.count() < 0 || m_policy.maxFallbackAge.count() < 0) {
+        throw std::invalid_argument("キャッシュの有効期間は0以上である必要があります");
+    }
+    m_worker = std::thread(&LightLevelCache::RefreshLoop, this);
+}
+
+LightLevelCache::~LightLevelCache()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_refreshRequested.notify_all();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+int LightLevelCache::Get()
+{
+    // TTLが0の場合はキャッシュせず毎回取得する
+    if (m_policy.ttl.count() == 0) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.misses;
+        }
+        return m_fetcher();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_value) {
+            auto age = m_now() - m_fetchedAt;
+            if (age < m_policy.ttl) {
+                ++m_stats.hits;
+                return *m_value;
+            }
+            if (age < m_policy.ttl + m_policy.staleWhileRevalidate) {
+                ++m_stats.staleHits;
+                if (!m_refreshPending) {
+                    m_refreshPending = true;
+                    m_refreshRequested.notify_one();
+                }
+                return *m_value;
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> fetchLock(m_fetchMutex);
+    {
+        // 待っている間に他の呼び出しが取得していればその値を使う
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_value && m_now() - m_fetchedAt < m_policy.ttl) {
+            ++m_stats.hits;
+            return *m_value;
+        }
+        ++m_stats.misses;
+    }
+
+    int value = m_fetcher();
+    Store(value, m_now());
+    return value;
+}
+
+void LightLevelCache::Invalidate()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_value.reset();
+}
+
+std::optional<int> LightLevelCache::GetFallbackValue() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // センサーが応答しなくなった場合にいつまでも同じ値を使い続けないよう、古すぎる値は代替値にしない
+    if (!m_value || m_now() - m_fetchedAt >= m_policy.maxFallbackAge) {
+        return std::nullopt;
+    }
+    return m_value;
+}
+
+LightLevelCache::Stats LightLevelCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void LightLevelCache::Store(int value, Clock::time_point fetchedAt)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // 裏での再取得と呼び出し元での取得が重なった場合は新しい方を残す
+    if (!m_value || fetchedAt >= m_fetchedAt) {
+        m_value = value;
+        m_fetchedAt = fetchedAt;
+    }
+}
+
+void LightLevelCache::RefreshLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_refreshRequested.wait(lock, [this] { return m_stopping || m_refreshPending; });
+        if (m_stopping) {
+            return;
+        }
+
+        lock.unlock();
+        std::optional<int> value;
+        try {
+            value = m_fetcher();
+        }
+        catch (...) {
+            // 古い値を残し、次のGet()で再取得を試みる
+        }
+        if (value) {
+            Store(*value, m_now());
+        }
+        lock.lock();
+
+        if (value) {
+            ++m_stats.refreshes;
+        }
+        else {
+            ++m_stats.refreshFailures;
+        }
+        m_refreshPending = false;
+    }
+}
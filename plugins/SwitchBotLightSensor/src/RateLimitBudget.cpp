@@ -0,0 +1,55 @@
+#include "RateLimitBudget.h"
+#include <algorithm>
+#include <stdexcept>
+
+RateLimitBudget::RateLimitBudget(int dailyLimit, TimeSource now)
+    : m_now(now ? std::move(now) : TimeSource([] { return Clock::now(); }))
+    , m_limit(0)
+{
+    SetDailyLimit(dailyLimit);
+}
+
+bool RateLimitBudget::TryConsume(int calls)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RollOver();
+    if (calls < 0 || m_used + calls > m_limit) {
+        ++m_rejected;
+        return false;
+    }
+    m_used += calls;
+    return true;
+}
+
+int RateLimitBudget::GetRemaining() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RollOver();
+    return std::max(0, m_limit - m_used);
+}
+
+RateLimitBudget::Stats RateLimitBudget::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    RollOver();
+    return Stats{m_limit, m_used, m_rejected};
+}
+
+void RateLimitBudget::SetDailyLimit(int dailyLimit)
+{
+    if (dailyLimit < 0) {
+        throw std::invalid_argument("1日あたりの上限は0以上である必要があります");
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_limit = dailyLimit;
+}
+
+void RateLimitBudget::RollOver() const
+{
+    auto sinceEpoch = m_now().time_since_epoch();
+    int64_t day = std::chrono::duration_cast<std::chrono::hours>(sinceEpoch).count() / 24;
+    if (day != m_day) {
+        m_day = day;
+        m_used = 0;
+    }
+}
@@ -0,0 +1,97 @@
+#include "ResilientFetcher.h"
+#include "SwitchBotException.h"
+#include <algorithm>
+#include <stdexcept>
+
+ResilientFetcher::ResilientFetcher(Fetcher fetcher, const ResiliencePolicy& policy, TimeSource now, uint32_t seed)
+    : m_fetcher(std::move(fetcher))
+    , m_policy(policy)
+    , m_now(now ? std::move(now) : TimeSource([] { return Clock::now(); }))
+    , m_breaker(std::max(policy.retryCount, 0) + 1, policy.openDuration, m_now)
+    , m_random(seed)
+{
+    if (!m_fetcher) {
+        throw std::invalid_argument("照度の取得関数を指定してください");
+    }
+    if (policy.initialBackoff.count() < 0 || policy.maxBackoff < policy.initialBackoff) {
+        throw std::invalid_argument("再試行の待機時間が不正です");
+    }
+    if (policy.jitter < 0.0 || policy.jitter > 1.0) {
+        throw std::invalid_argument("ジッターは0.0-1.0である必要があります");
+    }
+}
+
+int ResilientFetcher::Fetch()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_now() < m_nextAttempt) {
+            ++m_stats.skipped;
+            throw ServiceUnavailableException("再試行の待機中のためAPIを呼び出しませんでした");
+        }
+    }
+    if (!m_breaker.AllowRequest()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.skipped;
+        throw ServiceUnavailableException("障害中のためAPIの呼び出しを停止しています");
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_stats.attempts;
+    }
+
+    try {
+        int value = m_fetcher();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_consecutiveFailures = 0;
+            m_nextAttempt = Clock::time_point{};
+            m_stats.currentBackoff = std::chrono::milliseconds(0);
+        }
+        m_breaker.RecordSuccess();
+        return value;
+    }
+    catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            ++m_stats.failures;
+            ++m_consecutiveFailures;
+
+            // 待機時間を最大jitterの割合だけランダムに短くし、複数のセンサーの再試行を分散させる
+            auto backoff = BackoffFor(m_policy, m_consecutiveFailures);
+            std::uniform_real_distribution<double> distribution(0.0, m_policy.jitter);
+            backoff = std::chrono::milliseconds(static_cast<long long>(
+                static_cast<double>(backoff.count()) * (1.0 - distribution(m_random))));
+
+            m_nextAttempt = m_now() + backoff;
+            m_stats.currentBackoff = backoff;
+        }
+        m_breaker.RecordFailure();
+        throw;
+    }
+}
+
+ResilientFetcher::Stats ResilientFetcher::GetStats() const
+{
+    Stats stats;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stats = m_stats;
+    }
+    stats.circuit = m_breaker.GetStats();
+    return stats;
+}
+
+std::chrono::milliseconds ResilientFetcher::BackoffFor(const ResiliencePolicy& policy, int failures)
+{
+    if (failures <= 0) {
+        return std::chrono::milliseconds(0);
+    }
+    // 上限に達した後は倍にしない（オーバーフロー防止）
+    auto backoff = policy.initialBackoff;
+    for (int i = 1; i < failures && backoff < policy.maxBackoff; ++i) {
+        backoff *= 2;
+    }
+    return std::min(backoff, policy.maxBackoff);
+}
@@ -1,20 +1,19 @@
 #include "SwitchBotLightSensor.h"
 #include "HttpClient.h"
 #include "SwitchBotException.h"
+#include "SwitchBotStatusService.h"
 #include <common/StringUtils.h>
 #include <sstream>
 #include <algorithm>
-#include <iostream>
-
-namespace {
-    constexpr const char* API_BASE_URL = "https://api.switch-bot.com/v1.1/devices/";
-}
+#include <string>
 
 SwitchBotLightSensor::SwitchBotLightSensor(
     const std::string& token,
     const std::string& deviceId,
     int retryCount,
-    int retryInterval
+    int retryInterval,
+    const CachePolicy& cachePolicy,
+    std::chrono::milliseconds circuitOpenDuration
 )
     : m_token(token)
     , m_deviceId(deviceId)
@@ -33,18 +32,18 @@ SwitchBotLightSensor::SwitchBotLightSensor(
     }
 
     try {
-        std::cout << "[SwitchBot] Initializing device: " << deviceId << std::endl;
+        StringUtils::OutputMessage("[SwitchBot] Initializing device: " + deviceId);
 
-        // 設定を読み込み
-        m_config.Load();
-        std::cout << "[SwitchBot] Configuration loaded successfully" << std::endl;
+        // 設定を読み込み（デーモンが読み込み済みの場合は読み直さない）
+        m_config.EnsureLoaded();
+        StringUtils::OutputMessage("[SwitchBot] Configuration loaded successfully");
 
         // キャリブレーション設定を読み込み
         try {
             m_calibration = m_config.GetDeviceCalibration(deviceId);
-            std::cout << "[SwitchBot] Calibration settings loaded: min="
-                      << m_calibration.minRawValue << ", max="
-                      << m_calibration.maxRawValue << std::endl;
+            StringUtils::OutputMessage("[SwitchBot] Calibration settings loaded: min=" +
+                std::to_string(m_calibration.minRawValue) + ", max=" +
+                std::to_string(m_calibration.maxRawValue));
         }
         catch (const ConfigException& e) {
             StringUtils::OutputMessage(
@@ -55,9 +54,38 @@ SwitchBotLightSensor::SwitchBotLightSensor(
             m_calibration = CalibrationSettings();
         }
 
-        // HTTPクライアントを初期化
-        m_httpClient = std::make_unique<HttpClient>(token, m_config.GetPluginConfig("SwitchBotLightSensor", "secret"));
-        std::cout << "[SwitchBot] HTTP client initialized successfully" << std::endl;
+        // 同じトークンのセンサーとステータス取得を共有する
+        SwitchBotStatusService::Options options;
+        auto settings = m_config.GetPluginGlobalSettings("SwitchBotLightSensor");
+        if (settings.contains("api_base_url") && settings["api_base_url"].is_string()) {
+            options.baseUrl = settings["api_base_url"].get<std::string>();
+        }
+        if (settings.contains("daily_request_limit") && settings["daily_request_limit"].is_number_integer()) {
+            options.dailyLimit = settings["daily_request_limit"].get<int>();
+        }
+        m_statusService = SwitchBotStatusService::ForToken(
+            token, m_config.GetPluginConfig("SwitchBotLightSensor", "secret"), options);
+
+        // 失敗時は待機時間を伸ばしながら再試行し、障害中はAPIの呼び出しを止める
+        ResiliencePolicy resiliencePolicy;
+        resiliencePolicy.retryCount = std::max(m_retryCount, 0);
+        resiliencePolicy.initialBackoff = std::chrono::milliseconds(std::max(m_retryInterval, 0));
+        resiliencePolicy.maxBackoff = std::max(resiliencePolicy.maxBackoff, resiliencePolicy.initialBackoff);
+        resiliencePolicy.openDuration = circuitOpenDuration;
+        m_fetcher = std::make_unique<ResilientFetcher>([this] { return FetchLightLevel(); }, resiliencePolicy);
+        m_fetcher->GetCircuitBreaker().SetStateListener([deviceId](CircuitState from, CircuitState to) {
+            StringUtils::OutputMessage("[SwitchBot] Circuit breaker for " + deviceId + ": " +
+                ToString(from) + " -> " + ToString(to));
+        });
+
+        m_cache = std::make_unique<LightLevelCache>([this] { return m_fetcher->Fetch(); }, cachePolicy);
+        StringUtils::OutputMessage("[SwitchBot] Light level cache: ttl=" + std::to_string(cachePolicy.ttl.count()) +
+            "ms, stale_while_revalidate=" + std::to_string(cachePolicy.staleWhileRevalidate.count()) +
+            "ms, max_fallback_age=" + std::to_string(cachePolicy.maxFallbackAge.count()) + "ms");
+
+        // 登録の解除はデストラクタで行うため、例外を投げうる初期化をすべて終えてから登録する
+        m_statusService->Register(deviceId);
+        StringUtils::OutputMessage("[SwitchBot] Status service initialized successfully");
     }
     catch (const ConfigException& e) {
         StringUtils::OutputExceptionMessage(e);
@@ -65,15 +93,48 @@ SwitchBotLightSensor::SwitchBotLightSensor(
     }
 }
 
-SwitchBotLightSensor::~SwitchBotLightSensor() = default;
+SwitchBotLightSensor::~SwitchBotLightSensor()
+{
+    // 裏での再取得がメンバーを参照しないよう先に停止する
+    m_cache.reset();
+    if (m_statusService) {
+        m_statusService->Unregister(m_deviceId);
+    }
+}
 
 int SwitchBotLightSensor::GetLightLevel()
 {
     try {
-        std::cout << "[SwitchBot] Getting light level for device: " << m_deviceId << std::endl;
+        return m_cache->Get();
+    }
+    catch (const SwitchBotException& e) {
+        // 一度も取得できていない場合や、最後の値が古すぎる場合は呼び出し元へ伝える
+        auto lastValue = m_cache->GetFallbackValue();
+        if (!lastValue) {
+            throw;
+        }
+        StringUtils::OutputMessage("[SwitchBot] Warning: Using last known light level - " + std::string(e.what()));
+        return *lastValue;
+    }
+}
+
+LightLevelCache::Stats SwitchBotLightSensor::GetCacheStats() const
+{
+    return m_cache->GetStats();
+}
+
+ResilientFetcher::Stats SwitchBotLightSensor::GetResilienceStats() const
+{
+    return m_fetcher->GetStats();
+}
+
+int SwitchBotLightSensor::FetchLightLevel()
+{
+    try {
+        StringUtils::OutputMessage("[SwitchBot] Getting light level for device: " + m_deviceId);
 
         auto status = GetDeviceStatus();
-        std::cout << "[SwitchBot] Device status retrieved successfully" << std::endl;
+        StringUtils::OutputMessage("[SwitchBot] Device status retrieved successfully");
 
         // lightLevel フィールドを取得
         if (!status["body"].contains("lightLevel")) {
@@ -82,10 +143,10 @@ int SwitchBotLightSensor::GetLightLevel()
         }
 
         int rawBrightness = status["body"]["lightLevel"].get<int>();
-        std::cout << "[SwitchBot] Raw brightness value: " << rawBrightness << std::endl;
+        StringUtils::OutputMessage("[SwitchBot] Raw brightness value: " + std::to_string(rawBrightness));
 
         int normalizedBrightness = NormalizeLightLevel(rawBrightness);
-        std::cout << "[SwitchBot] Normalized brightness value (0-100): " << normalizedBrightness << std::endl;
+        StringUtils::OutputMessage("[SwitchBot] Normalized brightness value (0-100): " + std::to_string(normalizedBrightness));
 
         return normalizedBrightness;
     }
@@ -102,10 +163,8 @@ int SwitchBotLightSensor::GetLightLevel()
 nlohmann::json SwitchBotLightSensor::GetDeviceStatus()
 {
     try {
-        std::stringstream url;
-        url << API_BASE_URL << m_deviceId << "/status";
-
-        auto response = m_httpClient->Get(url.str());
+        // 同じトークンの他のセンサーの要求とまとめて取得される
+        auto response = m_statusService->FetchStatus(m_deviceId);
 
         // レスポンスのステータスコードを確認
         if (!response.contains("statusCode")) {
@@ -50,12 +50,32 @@ std::unique_ptr<ILightSensor> SwitchBotPlugin::CreateSensor(
             retryInterval = config["retryInterval"].get<int>();
         }
 
+        // 照度キャッシュの有効期間（デバイスごと）
+        CachePolicy cachePolicy;
+        if (config.contains("cache_ttl_ms") && config["cache_ttl_ms"].is_number_integer()) {
+            cachePolicy.ttl = std::chrono::milliseconds(config["cache_ttl_ms"].get<int>());
+        }
+        if (config.contains("stale_while_revalidate_ms") && config["stale_while_revalidate_ms"].is_number_integer()) {
+            cachePolicy.staleWhileRevalidate = std::chrono::milliseconds(config["stale_while_revalidate_ms"].get<int>());
+        }
+        if (config.contains("max_fallback_age_ms") && config["max_fallback_age_ms"].is_number_integer()) {
+            cachePolicy.maxFallbackAge = std::chrono::milliseconds(config["max_fallback_age_ms"].get<int>());
+        }
+
+        // サーキットブレーカーをOpenにしてから復旧を確認するまでの時間
+        std::chrono::milliseconds circuitOpenDuration(60000);
+        if (config.contains("circuit_open_ms") && config["circuit_open_ms"].is_number_integer()) {
+            circuitOpenDuration = std::chrono::milliseconds(config["circuit_open_ms"].get<int>());
+        }
+
         // SwitchBotLightSensorインスタンスの作成
         auto sensor = std::make_unique<SwitchBotLightSensor>(
             token,
             deviceId,
             retryCount,
-            retryInterval
+            retryInterval,
+            cachePolicy,
+            circuitOpenDuration
         );
 
         // 1回目は失敗しやすいのでとりあえず無視
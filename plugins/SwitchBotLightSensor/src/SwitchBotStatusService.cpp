@@ -0,0 +1,175 @@
+#include "SwitchBotStatusService.h"
+#include "HttpClient.h"
+#include "SwitchBotException.h"
+
+namespace {
+    std::mutex g_servicesMutex;
+    std::map<std::string, std::weak_ptr<SwitchBotStatusService>> g_services;
+}
+
+SwitchBotStatusService::SwitchBotStatusService(const std::string& token, const std::string& secret, const Options& options)
+    : m_options(options)
+    , m_httpClient(std::make_unique<HttpClient>(token, secret))
+    , m_budget(options.dailyLimit, options.now)
+{
+    m_worker = std::thread(&SwitchBotStatusService::RoundLoop, this);
+}
+
+SwitchBotStatusService::~SwitchBotStatusService()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_roundRequested.notify_all();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+}
+
+std::shared_ptr<SwitchBotStatusService> SwitchBotStatusService::ForToken(
+    const std::string& token,
+    const std::string& secret,
+    const Options& options)
+{
+    std::lock_guard<std::mutex> lock(g_servicesMutex);
+    auto service = g_services[token].lock();
+    if (!service) {
+        service = std::make_shared<SwitchBotStatusService>(token, secret, options);
+        g_services[token] = service;
+    }
+    return service;
+}
+
+void SwitchBotStatusService::Register(const std::string& deviceId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_registered[deviceId];
+}
+
+void SwitchBotStatusService::Unregister(const std::string& deviceId)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_registered.find(deviceId);
+        if (it != m_registered.end() && --it->second <= 0) {
+            m_registered.erase(it);
+        }
+    }
+    // 残りのデバイスがすべて要求済みになった可能性がある
+    m_roundRequested.notify_all();
+}
+
+nlohmann::json SwitchBotStatusService::FetchStatus(const std::string& deviceId)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_stopping) {
+        throw HttpException("Status service is stopped");
+    }
+
+    ++m_stats.requests;
+    if (!m_pending) {
+        m_pending = std::make_shared<Round>();
+        m_pending->deadline = std::chrono::steady_clock::now() + m_options.coalesceWindow;
+    }
+    if (!m_pending->devices.insert(deviceId).second) {
+        ++m_stats.coalescedRequests;
+    }
+
+    // ラウンドの開始判定はワーカーに任せ、このラウンドの完了を待つ
+    auto round = m_pending;
+    m_roundRequested.notify_all();
+    m_roundCompleted.wait(lock, [&round] { return round->done; });
+
+    auto error = round->errors.find(deviceId);
+    if (error != round->errors.end()) {
+        std::rethrow_exception(error->second);
+    }
+    return round->results.at(deviceId);
+}
+
+SwitchBotStatusService::Stats SwitchBotStatusService::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+RateLimitBudget::Stats SwitchBotStatusService::GetBudgetStats() const
+{
+    return m_budget.GetStats();
+}
+
+bool SwitchBotStatusService::AllRegisteredRequested() const
+{
+    if (!m_pending || m_registered.empty()) {
+        return false;
+    }
+    for (const auto& [deviceId, count] : m_registered) {
+        if (m_pending->devices.count(deviceId) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SwitchBotStatusService::RoundLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_roundRequested.wait(lock, [this] { return m_stopping || m_pending; });
+
+        if (!m_stopping) {
+            // 集約時間が過ぎるか、登録済みのすべてのデバイスが要求されるまで待つ
+            auto deadline = m_pending->deadline;
+            m_roundRequested.wait_until(lock, deadline, [this] {
+                return m_stopping || AllRegisteredRequested();
+            });
+        }
+
+        if (m_stopping) {
+            // 受け付け中のラウンドは実行せずに終了を通知する
+            if (m_pending) {
+                for (const auto& deviceId : m_pending->devices) {
+                    m_pending->errors[deviceId] = std::make_exception_ptr(HttpException("Status service is stopped"));
+                }
+                m_pending->done = true;
+                m_pending.reset();
+                m_roundCompleted.notify_all();
+            }
+            return;
+        }
+
+        // 以降の要求は次のラウンドで受け付ける
+        auto round = std::move(m_pending);
+        ++m_stats.rounds;
+
+        lock.unlock();
+        RunRound(*round);
+        lock.lock();
+
+        round->done = true;
+        m_roundCompleted.notify_all();
+    }
+}
+
+void SwitchBotStatusService::RunRound(Round& round)
+{
+    for (const auto& deviceId : round.devices) {
+        if (!m_budget.TryConsume()) {
+            round.errors[deviceId] = std::make_exception_ptr(
+                RateLimitException("APIの1日あたりの呼び出し上限に達しました"));
+            continue;
+        }
+
+        try {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_stats.apiCalls;
+            }
+            round.results[deviceId] = m_httpClient->Get(m_options.baseUrl + deviceId + "/status");
+        }
+        catch (...) {
+            round.errors[deviceId] = std::current_exception();
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#include "AtomicFile.h"
+#include <algorithm>
+#include <system_error>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    std::filesystem::path TempPathFor(const std::filesystem::path& path)
+    {
+        std::filesystem::path temp = path;
+        temp += ".tmp";
+        return temp;
+    }
+
+#ifdef _WIN32
+    [[noreturn]] void ThrowLastError(const std::string& what)
+    {
+        throw std::system_error(static_cast<int>(GetLastError()), std::system_category(), what);
+    }
+
+    void WriteAndFlush(const std::filesystem::path& temp, std::string_view content)
+    {
+        HANDLE file = CreateFileW(temp.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            ThrowLastError("一時ファイルを作成できませんでした: " + temp.string());
+        }
+
+        size_t written = 0;
+        while (written < content.size()) {
+            DWORD chunk = static_cast<DWORD>(std::min<size_t>(content.size() - written, 1 << 20));
+            DWORD bytes = 0;
+            if (!WriteFile(file, content.data() + written, chunk, &bytes, nullptr)) {
+                DWORD error = GetLastError();
+                CloseHandle(file);
+                throw std::system_error(static_cast<int>(error), std::system_category(), "一時ファイルに書き込めませんでした");
+            }
+            written += bytes;
+        }
+
+        if (!FlushFileBuffers(file)) {
+            DWORD error = GetLastError();
+            CloseHandle(file);
+            throw std::system_error(static_cast<int>(error), std::system_category(), "一時ファイルをディスクに書き出せませんでした");
+        }
+        CloseHandle(file);
+    }
+
+    void Replace(const std::filesystem::path& temp, const std::filesystem::path& path)
+    {
+        if (!MoveFileExW(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+            ThrowLastError("ファイルを置き換えられませんでした: " + path.string());
+        }
+    }
+#else
+    [[noreturn]] void ThrowErrno(const std::string& what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    void WriteAndFlush(const std::filesystem::path& temp, std::string_view content)
+    {
+        int fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            ThrowErrno("一時ファイルを作成できませんでした: " + temp.string());
+        }
+
+        size_t written = 0;
+        while (written < content.size()) {
+            ssize_t bytes = write(fd, content.data() + written, content.size() - written);
+            if (bytes < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                int error = errno;
+                close(fd);
+                throw std::system_error(error, std::generic_category(), "一時ファイルに書き込めませんでした");
+            }
+            written += static_cast<size_t>(bytes);
+        }
+
+        if (fsync(fd) != 0) {
+            int error = errno;
+            close(fd);
+            throw std::system_error(error, std::generic_category(), "一時ファイルをディスクに書き出せませんでした");
+        }
+        if (close(fd) != 0) {
+            ThrowErrno("一時ファイルを閉じられませんでした");
+        }
+    }
+
+    void Replace(const std::filesystem::path& temp, const std::filesystem::path& path)
+    {
+        if (rename(temp.c_str(), path.c_str()) != 0) {
+            ThrowErrno("ファイルを置き換えられませんでした: " + path.string());
+        }
+
+        // 名前の変更自体をディスクに残すため、ディレクトリも書き出す（失敗しても内容は置き換わっている）
+        std::filesystem::path directory = path.parent_path();
+        int dirFd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            close(dirFd);
+        }
+    }
+#endif
+}
+
+void WriteFileAtomically(const std::filesystem::path& path, std::string_view content)
+{
+    std::filesystem::path temp = TempPathFor(path);
+    try {
+        WriteAndFlush(temp, content);
+        Replace(temp, path);
+    }
+    catch (...) {
+        std::error_code ignored;
+        std::filesystem::remove(temp, ignored);
+        throw;
+    }
+}
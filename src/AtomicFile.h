@@ -0,0 +1,20 @@
+#ifndef DISPLAYCONTROLLER_ATOMIC_FILE_H
+#define DISPLAYCONTROLLER_ATOMIC_FILE_H
+
+#include "MonitorBackend.h"
+#include <filesystem>
+#include <string_view>
+
+/**
+ * @brief ファイルの内容を途中の状態を残さずに置き換える
+ *
+ * 同じディレクトリの一時ファイルに書き込んでディスクへ書き出してから（fsync・FlushFileBuffers）、
+ * 対象のファイルへアトミックに名前を変更します。書き込み中にプロセスや OS が停止しても、
+ * 対象のファイルは変更前か変更後のどちらかの内容になります。
+ * 失敗した場合は一時ファイルを削除し、対象のファイルは変更しません。
+ *
+ * @throws std::system_error 書き込みまたは名前の変更に失敗した場合
+ */
+DISPLAYCONTROLLER_API void WriteFileAtomically(const std::filesystem::path& path, std::string_view content);
+
+#endif // DISPLAYCONTROLLER_ATOMIC_FILE_H
@@ -0,0 +1,161 @@
+#include "DisplayBackend.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+
+namespace {
+    // 同じパネルに複数のインターフェースがある場合の優先順位（カーネルのドキュメントの推奨順）
+    int TypePriority(const std::string& type)
+    {
+        if (type == "firmware") {
+            return 0;
+        }
+        if (type == "platform") {
+            return 1;
+        }
+        if (type == "raw") {
+            return 2;
+        }
+        return 3;
+    }
+
+    std::optional<unsigned long> ReadValue(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        unsigned long value = 0;
+        if (!(file >> value)) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+    std::string ReadText(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        std::string text;
+        std::getline(file, text);
+        return text;
+    }
+
+    class BacklightDisplayBackend : public IDisplayBackend {
+    public:
+        explicit BacklightDisplayBackend(std::filesystem::path root)
+            : m_root(std::move(root))
+        {
+        }
+
+        std::vector<DisplayDescriptor> EnumerateDisplays() override
+        {
+            std::optional<std::filesystem::path> selected;
+            int selectedPriority = 0;
+            std::error_code error;
+            std::vector<std::filesystem::path> entries;
+            for (const auto& entry : std::filesystem::directory_iterator(m_root, error)) {
+                entries.push_back(entry.path());
+            }
+            // 同じ優先順位のインターフェースは名前順で選ぶ
+            std::sort(entries.begin(), entries.end());
+            for (const auto& entry : entries) {
+                if (!ReadValue(entry / "max_brightness").value_or(0)) {
+                    continue;
+                }
+                int priority = TypePriority(ReadText(entry / "type"));
+                if (!selected || priority < selectedPriority) {
+                    selected = entry;
+                    selectedPriority = priority;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_device = selected;
+            if (!selected) {
+                return {};
+            }
+
+            DisplayDescriptor display;
+            display.id = kPanelId;
+            std::string name = selected->filename().string();
+            display.deviceName.assign(name.begin(), name.end());
+            // 内蔵パネルはノートPCごとに1台のため、接続先にはDRMのコネクター名（なければインターフェース名）を使う
+            auto device = std::filesystem::read_symlink(*selected / "device", error);
+            display.connector = !error && !device.filename().empty() ? device.filename().string() : name;
+            display.isPrimary = true;
+
+            std::ifstream edid(*selected / "device" / "edid", std::ios::binary);
+            if (edid) {
+                display.edid.assign(std::istreambuf_iterator<char>(edid), std::istreambuf_iterator<char>());
+            }
+            return {display};
+        }
+
+        PhysicalMonitorHandle OpenPhysicalMonitor(MonitorId id) override
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (id != kPanelId || !m_device) {
+                throw DisplayControllerException("列挙されていないモニターです");
+            }
+            return new std::filesystem::path(*m_device);
+        }
+
+        void ClosePhysicalMonitor(PhysicalMonitorHandle handle) override
+        {
+            delete static_cast<std::filesystem::path*>(handle);
+        }
+
+        bool GetBrightness(PhysicalMonitorHandle handle,
+            unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override
+        {
+            const auto& device = *static_cast<std::filesystem::path*>(handle);
+            auto maximum = ReadValue(device / "max_brightness");
+            // actual_brightnessはハードウェアから読んだ値（対応していないドライバーもある）
+            auto current = ReadValue(device / "actual_brightness");
+            if (!current) {
+                current = ReadValue(device / "brightness");
+            }
+            if (!maximum || !current) {
+                return false;
+            }
+            minValue = 0;
+            currentValue = std::min(*current, *maximum);
+            maxValue = *maximum;
+            return true;
+        }
+
+        bool SetBrightness(PhysicalMonitorHandle handle, unsigned long value) override
+        {
+            const auto& device = *static_cast<std::filesystem::path*>(handle);
+            std::ofstream file(device / "brightness");
+            if (!file) {
+                return false;
+            }
+            file << value;
+            file.flush();
+            return static_cast<bool>(file);
+        }
+
+        bool GetContrast(PhysicalMonitorHandle, unsigned long&, unsigned long&, unsigned long&) override
+        {
+            // バックライトはコントラストを持たない
+            return false;
+        }
+
+    private:
+        static inline const MonitorId kPanelId = reinterpret_cast<MonitorId>(1);
+
+        std::filesystem::path m_root;
+        std::mutex m_mutex;
+        std::optional<std::filesystem::path> m_device;
+    };
+}
+
+std::unique_ptr<IDisplayBackend> CreateBacklightDisplayBackend(const std::filesystem::path& root)
+{
+    return std::make_unique<BacklightDisplayBackend>(root);
+}
+
+#endif // __linux__
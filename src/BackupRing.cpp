@@ -0,0 +1,84 @@
+#include "BackupRing.h"
+#include "AtomicFile.h"
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <system_error>
+
+BackupRing::BackupRing(std::filesystem::path target, size_t capacity)
+    : m_target(std::move(target))
+    , m_capacity(capacity)
+{
+    if (m_capacity == 0) {
+        throw std::invalid_argument("バックアップの保持数は1以上である必要があります");
+    }
+}
+
+std::filesystem::path BackupRing::Create(std::string_view content, Clock::time_point now)
+{
+    std::filesystem::path path = MakePath(now);
+    std::filesystem::create_directories(path.parent_path());
+    WriteFileAtomically(path, content);
+    Prune();
+    return path;
+}
+
+std::vector<std::filesystem::path> BackupRing::List() const
+{
+    std::vector<std::filesystem::path> backups;
+    std::filesystem::path directory = m_target.parent_path();
+    std::error_code error;
+    if (!std::filesystem::is_directory(directory, error)) {
+        return backups;
+    }
+
+    std::string prefix = m_target.stem().string() + "_backup_";
+    std::string extension = m_target.extension().string();
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (!entry.is_regular_file(error)) {
+            continue;
+        }
+        // 書き込み途中の一時ファイル（拡張子が異なる）は含めない
+        std::string name = entry.path().filename().string();
+        if (name.rfind(prefix, 0) == 0 && entry.path().extension().string() == extension) {
+            backups.push_back(entry.path());
+        }
+    }
+
+    // 日時は桁数が固定のため、ファイル名の順が作成順になる
+    std::sort(backups.begin(), backups.end(), [](const auto& a, const auto& b) {
+        return a.filename().string() > b.filename().string();
+    });
+    return backups;
+}
+
+std::filesystem::path BackupRing::MakePath(Clock::time_point now) const
+{
+    std::time_t seconds = Clock::to_time_t(now);
+    auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+
+    std::stringstream ss;
+    ss << m_target.stem().string() << "_backup_"
+       << std::put_time(std::localtime(&seconds), "%Y%m%d_%H%M%S")
+       << "_" << std::setw(3) << std::setfill('0') << milliseconds;
+    std::string base = ss.str();
+    std::string extension = m_target.extension().string();
+
+    std::filesystem::path directory = m_target.parent_path();
+    std::filesystem::path path = directory / (base + extension);
+    for (int sequence = 1; std::filesystem::exists(path); ++sequence) {
+        path = directory / (base + "_" + std::to_string(sequence) + extension);
+    }
+    return path;
+}
+
+void BackupRing::Prune() const
+{
+    auto backups = List();
+    for (size_t i = m_capacity; i < backups.size(); ++i) {
+        std::error_code ignored;
+        std::filesystem::remove(backups[i], ignored);
+    }
+}
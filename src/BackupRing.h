@@ -0,0 +1,44 @@
+#ifndef DISPLAYCONTROLLER_BACKUP_RING_H
+#define DISPLAYCONTROLLER_BACKUP_RING_H
+
+#include "MonitorBackend.h"
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief 日時付きのバックアップを最大N個まで保持する
+ *
+ * バックアップは対象ファイルと同じディレクトリに「<名前>_backup_<日時><拡張子>」として
+ * アトミックに書き込み、上限を超えた古いものから削除します。同じ時刻に複数作成した場合も
+ * 上書きしないよう、ファイル名に連番を付けます。
+ */
+class DISPLAYCONTROLLER_API BackupRing {
+public:
+    using Clock = std::chrono::system_clock;
+
+    BackupRing(std::filesystem::path target, size_t capacity);
+
+    /**
+     * @brief バックアップを作成し、上限を超えた古いバックアップを削除する
+     * @return 作成したバックアップのパス
+     * @throws std::system_error 書き込みに失敗した場合
+     */
+    std::filesystem::path Create(std::string_view content, Clock::time_point now = Clock::now());
+
+    // 既存のバックアップ（新しい順）
+    std::vector<std::filesystem::path> List() const;
+
+    size_t GetCapacity() const { return m_capacity; }
+
+private:
+    std::filesystem::path MakePath(Clock::time_point now) const;
+    void Prune() const;
+
+    std::filesystem::path m_target;
+    size_t m_capacity;
+};
+
+#endif // DISPLAYCONTROLLER_BACKUP_RING_H
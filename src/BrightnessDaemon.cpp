@@ -1,12 +1,23 @@
 #include <windows.h>
 #include <shellapi.h>
+#include <dbt.h>
 #include <fstream>
 #include "BrightnessManager.h"
 #include "PluginLoader.h"
 #include "ConfigManager.h"
+#include "ConfigDiff.h"
+#include "DisplayChangeWatcher.h"
+#include "FileWatcher.h"
+#include "SensorFusion.h"
 #include <common/StringUtils.h>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 #include <filesystem>
 #include <nlohmann/json.hpp>
 
@@ -14,6 +25,8 @@ using json = nlohmann::json;
 
 // タスクトレイアイコンの定数
 #define WM_APP_NOTIFY (WM_APP + 1)
+#define WM_APP_CONFIG_CHANGED (WM_APP + 2) // 設定ファイルの変更通知（監視スレッドから送られる）
+#define WM_APP_MONITORS_CONNECTED (WM_APP + 3) // モニターの接続通知（ディスプレイ構成の監視スレッドから送られる）
 #define ID_TRAYICON 1
 #define ID_MENU_EXIT 1001
 #define ID_MENU_TOGGLE 1002
@@ -27,6 +40,14 @@ HWND g_hwnd;
 NOTIFYICONDATAW g_nid;
 std::unique_ptr<BrightnessManager> g_brightnessManager;
 std::unique_ptr<PluginLoader> g_pluginLoader;
+std::unique_ptr<FileWatcher> g_configWatcher;
+std::unique_ptr<DisplayChangeWatcher> g_displayWatcher;
+DisplayChangeSignal *g_displayChangeSignal = nullptr; // g_displayWatcherが所有する
+HDEVNOTIFY g_monitorNotification = nullptr;           // モニターの接続・取り外しの通知の登録
+std::mutex g_connectedMonitorsMutex;
+std::vector<MonitorBrightnessMap::MonitorKeys> g_connectedMonitors; // 設定の追加を待っている、接続されたモニターの識別子と名前
+std::vector<ChangedDevice> g_sensorDevices; // 使用中のセンサーのデバイス（ダミーセンサーの場合は空）
+SensorFusion *g_sensorFusion = nullptr;     // 複数のセンサーをまとめている場合（g_brightnessManagerが所有する）
 bool g_isSyncEnabled = false;
 bool g_isConsoleVisible = false;
 HHOOK g_consoleHook = nullptr;  // コンソールウィンドウのフック
@@ -49,26 +70,31 @@ void ShowContextMenu(HWND hwnd, POINT pt);
 void ToggleSync();
 void ToggleConsoleWindow();
 void Cleanup();
+void LoadPlugins();
 std::unique_ptr<ILightSensor> CreateLightSensor();
-
-// モニター設定の自動追加
-void CheckAndAddMonitorConfigs()
+void ApplyMonitorSettings();
+void StartConfigWatcher();
+void StartDisplayWatcher();
+void ReloadConfig(bool showResult);
+
+// 設定のないモニターの設定を追加する（追加した場合はtrue）
+// 識別子と名前のどちらかで設定があるモニターは追加しない
+bool AddMonitorConfigs(const std::vector<MonitorBrightnessMap::MonitorKeys> &monitors)
 {
     try
     {
         auto &config = ConfigManager::Instance();
-        auto monitors = g_brightnessManager->GetMonitorController().GetMonitors();
 
-        for (const auto &monitor : monitors)
+        // 検出したモニターをまとめて追加し、設定ファイルへの書き込みは1回にする
+        // 途中で例外が発生した場合、確定していない変更は破棄される
+        std::set<std::string> addedNames;
+        auto update = config.BeginUpdate();
+        for (const auto &[identity, name] : monitors)
         {
-            // モニターの詳細情報を取得
-            MonitorController::MonitorInfo info = monitor;
-            g_brightnessManager->GetMonitorController().GetDetailedMonitorInfo(info);
-
-            // 設定が存在しない場合は追加
-            if (!config.HasMonitor(StringUtils::WideToUtf8(info.humanReadableName)))
+            // 設定が存在しない場合は追加（同じ名前のモニターが複数ある場合は1つだけ）
+            if (!update.HasMonitor(identity) && !update.HasMonitor(name) && addedNames.insert(name).second)
             {
-                StringUtils::OutputMessage("新しいモニターを検出: " + StringUtils::WideToUtf8(info.humanReadableName));
+                StringUtils::OutputMessage("新しいモニターを検出: " + name);
 
                 // デフォルトの輝度範囲設定を作成
                 MonitorBrightnessRange range;
@@ -76,19 +102,45 @@ void CheckAndAddMonitorConfigs()
                 range.max = 100;
 
                 // 設定を追加
-                config.AddMonitor(StringUtils::WideToUtf8(info.humanReadableName), range);
-                StringUtils::OutputMessage("モニター設定を追加しました: " + StringUtils::WideToUtf8(info.humanReadableName));
+                update.AddMonitor(name, range);
             }
         }
+        update.Commit();
+
+        for (const auto &name : addedNames)
+        {
+            StringUtils::OutputMessage("モニター設定を追加しました: " + name);
+        }
+        return !addedNames.empty();
     }
     catch (const std::exception &e)
     {
         std::string error = "モニター設定の自動追加に失敗しました: " + std::string(e.what());
         ShowErrorMessage(error, "警告", MB_OK | MB_ICONWARNING);
         StringUtils::OutputMessage(error);
+        return false;
     }
 }
 
+// モニター設定の自動追加（起動時に接続中のすべてのモニターを確認する）
+void CheckAndAddMonitorConfigs()
+{
+    std::vector<MonitorBrightnessMap::MonitorKeys> monitors;
+    try
+    {
+        for (const auto &monitor : g_brightnessManager->GetMonitorController().GetTopology()->GetMonitors())
+        {
+            monitors.push_back({monitor.identity.ToKey(), StringUtils::WideToUtf8(monitor.name)});
+        }
+    }
+    catch (const std::exception &e)
+    {
+        StringUtils::OutputMessage("モニターの列挙に失敗しました: " + std::string(e.what()));
+        return;
+    }
+    AddMonitorConfigs(monitors);
+}
+
 // コンソール管理
 void InitializeConsole()
 {
@@ -131,56 +183,69 @@ void ToggleConsoleWindow()
     }
 }
 
-// センサーの作成
-std::unique_ptr<ILightSensor> CreateLightSensor()
+// プラグインの読み込み
+void LoadPlugins()
 {
+    g_pluginLoader = std::make_unique<PluginLoader>();
     try
     {
-        auto &config = ConfigManager::Instance();
-        config.Load();
-
         std::filesystem::path pluginDir = std::filesystem::current_path() / "plugins";
         if (!std::filesystem::exists(pluginDir))
         {
             std::filesystem::create_directory(pluginDir);
         }
 
-        g_pluginLoader = std::make_unique<PluginLoader>();
         size_t loadedCount = g_pluginLoader->LoadPlugins(pluginDir.string());
         StringUtils::OutputMessage("プラグインを読み込みました: " + std::to_string(loadedCount) + "個");
+    }
+    catch (const std::exception &e)
+    {
+        std::string error = "プラグインの読み込みに失敗しました: " + std::string(e.what());
+        ShowErrorMessage(error, "エラー", MB_OK | MB_ICONWARNING);
+        StringUtils::OutputMessage(error);
+    }
+}
 
-        if (config.HasDeviceType("Light Sensor"))
+// センサーの作成（設定は読み込み済みであること）
+// Light Sensorタイプのデバイスが複数ある場合は、すべてを同時に読み取ってまとめる
+std::unique_ptr<ILightSensor> CreateLightSensor()
+{
+    g_sensorDevices.clear();
+    g_sensorFusion = nullptr;
+    try
+    {
+        auto &config = ConfigManager::Instance();
+        auto snapshot = config.GetSnapshot();
+        const auto &devices = snapshot->GetDevicesByType("Light Sensor");
+        if (!devices.empty())
         {
-            // Light Sensorタイプのデバイスを取得
-            auto devices = config.GetDevicesByType("Light Sensor");
-            if (devices.empty())
-            {
-                throw std::runtime_error("Light Sensorタイプのデバイスが見つかりません");
-            }
-
-            // 最初のデバイスを使用
-            auto device = devices[0];
-            const std::string &deviceName = device["name"].get<std::string>();
-
-            // プラグインを探索
-            for (const auto &plugin : {"SwitchBotLightSensor", "DummyLightSensor"})
+            std::vector<SensorFusion::Source> sources;
+            for (const auto *device : devices)
             {
+                // 作成に失敗したデバイスは除き、残りのセンサーで続ける
+                g_sensorDevices.push_back({device->pluginName, device->name});
                 try
                 {
-                    // デバイス名でプラグインの設定を取得してみる
-                    // 成功すれば、そのプラグインに属しているデバイス
-                    config.GetPluginConfig(plugin, "id", deviceName);
-                    StringUtils::OutputMessage("Light Sensorプラグインを使用: " + std::string(plugin));
-                    return g_pluginLoader->CreateSensor(plugin, device);
+                    StringUtils::OutputMessage("Light Sensorプラグインを使用: " + device->pluginName + " (" + device->name + ")");
+                    sources.push_back({g_pluginLoader->CreateSensor(device->pluginName, device->raw), device->name, device->weight});
                 }
-                catch (const ConfigException &)
+                catch (const std::exception &e)
                 {
-                    // このプラグインには属していない
-                    continue;
+                    StringUtils::OutputMessage("センサーの初期化に失敗しました: " + device->name + ": " + e.what());
                 }
             }
 
-            throw std::runtime_error("デバイス " + deviceName + " に対応するプラグインが見つかりません");
+            if (sources.empty())
+            {
+                throw std::runtime_error("使用できるLight Sensorデバイスがありません");
+            }
+            if (sources.size() == 1)
+            {
+                return std::move(sources.front().sensor);
+            }
+            auto fusion = std::make_unique<SensorFusion>(std::move(sources), config.GetSensorFusionOptions());
+            g_sensorFusion = fusion.get();
+            return fusion;
         }
         else
         {
@@ -198,8 +263,313 @@ std::unique_ptr<ILightSensor> CreateLightSensor()
     }
 }
 
+// モニターごとの輝度範囲・カーブ・割り当てたセンサーを同期ループへ反映する
+// （接続中のモニターへの対応付けはBrightnessManagerが行う）
+void ApplyMonitorSettings()
+{
+    try
+    {
+        auto &config = ConfigManager::Instance();
+        auto snapshot = config.GetSnapshot();
+        // センサーの割り当ては、モニターごとにセンサーを使い分ける設定の場合だけ使う
+        bool useNearest = config.GetSensorFusionOptions().strategy == FusionStrategy::Nearest;
+
+        BrightnessManager::MonitorProfileTable profiles;
+        for (const auto &monitor : snapshot->GetMonitors())
+        {
+            MonitorBrightnessProfile profile;
+            profile.range = monitor.brightnessRange;
+            profile.curve = monitor.brightnessCurve;
+            if (useNearest)
+            {
+                profile.sensor = monitor.sensor;
+            }
+            profiles.emplace(monitor.name, std::move(profile));
+        }
+        g_brightnessManager->SetMonitorProfiles(std::move(profiles));
+    }
+    catch (const std::exception &e)
+    {
+        StringUtils::OutputMessage("モニターごとの設定の適用に失敗しました: " + std::string(e.what()));
+    }
+}
+
+// 使用中のセンサーの構成（デバイスの並び・まとめ方）が変わり、センサーをすべて作り直す必要があるか
+bool IsSensorLayoutChanged(const ConfigDiff &diff, const ConfigSnapshot &snapshot)
+{
+    const auto &devices = snapshot.GetDevicesByType("Light Sensor");
+    if (devices.size() != g_sensorDevices.size())
+    {
+        // ダミーセンサーのままの場合は両方とも空
+        return true;
+    }
+    for (size_t i = 0; i < devices.size(); ++i)
+    {
+        if (devices[i]->pluginName != g_sensorDevices[i].pluginName || devices[i]->name != g_sensorDevices[i].name)
+        {
+            return true;
+        }
+    }
+    // まとめ方の設定は複数のセンサーを使う場合だけ影響する
+    return diff.sensorFusion && g_sensorDevices.size() > 1;
+}
+
+// 設定が変わったデバイスのセンサーだけを作り直す
+// 戻り値: 作り直したセンサーの数（まとめている他のセンサーを残したまま差し替えられない場合はnullopt）
+std::optional<size_t> ReplaceChangedSensors(const ConfigDiff &diff, const ConfigSnapshot &snapshot)
+{
+    size_t replaced = 0;
+    for (const auto *device : snapshot.GetDevicesByType("Light Sensor"))
+    {
+        if (!diff.IsDeviceChanged(device->pluginName, device->name))
+        {
+            continue;
+        }
+        if (!g_sensorFusion)
+        {
+            // センサーが1つだけの場合は、すべて作り直しても変わらない
+            return std::nullopt;
+        }
+        try
+        {
+            StringUtils::OutputMessage("Light Sensorデバイスを再作成: " + device->pluginName + " (" + device->name + ")");
+            auto sensor = g_pluginLoader->CreateSensor(device->pluginName, device->raw);
+            if (!g_sensorFusion->ReplaceSource({std::move(sensor), device->name, device->weight}))
+            {
+                // 前回の作成に失敗して除いたデバイス
+                return std::nullopt;
+            }
+        }
+        catch (const std::exception &e)
+        {
+            StringUtils::OutputMessage("センサーの初期化に失敗しました: " + device->name + ": " + e.what());
+            return std::nullopt;
+        }
+        ++replaced;
+    }
+    return replaced;
+}
+
+// 設定ファイルを読み直し、変更のあった項目だけを同期ループへ反映する
+void ReloadConfig(bool showResult)
+{
+    try
+    {
+        auto &config = ConfigManager::Instance();
+        std::shared_ptr<const ConfigSnapshot> previous;
+        try
+        {
+            previous = config.GetSnapshot();
+        }
+        catch (const ConfigException &)
+        {
+            // 前回の読み込みに失敗している場合はすべての項目を反映する
+        }
+
+        config.Load();
+        auto current = config.GetSnapshot();
+        auto diff = DiffConfigSnapshots(previous.get(), *current);
+
+        if (diff.updateInterval)
+        {
+            g_brightnessManager->SetUpdateInterval(std::chrono::milliseconds(config.GetUpdateInterval()));
+        }
+        if (diff.brightnessRange)
+        {
+            g_brightnessManager->SetBrightnessRange(config.GetMinBrightness(), config.GetMaxBrightness());
+        }
+        if (diff.writeDeadband)
+        {
+            g_brightnessManager->SetWriteDeadband(config.GetWriteDeadband());
+        }
+        if (diff.transition)
+        {
+            g_brightnessManager->SetTransition(std::chrono::milliseconds(config.GetTransitionDuration()), config.GetTransitionCurve());
+        }
+        if (!diff.changedMonitors.empty() || diff.sensorFusion)
+        {
+            ApplyMonitorSettings();
+        }
+        // 構成が変わらなければ、設定が変わったデバイスのセンサーだけを作り直す
+        std::string sensorSummary;
+        std::optional<size_t> replacedSensors;
+        if (!IsSensorLayoutChanged(diff, *current))
+        {
+            replacedSensors = ReplaceChangedSensors(diff, *current);
+        }
+        if (!replacedSensors)
+        {
+            g_brightnessManager->ReplaceSensor(CreateLightSensor());
+            sensorSummary = ", センサーを再作成";
+        }
+        else if (*replacedSensors > 0)
+        {
+            sensorSummary = ", センサーを再作成=" + std::to_string(*replacedSensors);
+        }
+
+        std::string summary = "設定ファイルを再読み込みしました";
+        if (diff.HasChanges())
+        {
+            // 新しい設定を次の更新間隔を待たずに反映する
+            g_brightnessManager->RequestUpdate();
+            summary += " (変更: 同期設定=" + std::string(diff.HasDaemonChanges() ? "あり" : "なし") +
+                       ", モニター=" + std::to_string(diff.changedMonitors.size()) +
+                       ", デバイス=" + std::to_string(diff.changedDevices.size()) +
+                       sensorSummary + ")";
+        }
+        else
+        {
+            summary += " (変更なし)";
+        }
+        StringUtils::OutputMessage(summary);
+        if (showResult)
+        {
+            ShowErrorMessage(summary, "情報", MB_OK | MB_ICONINFORMATION);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        // 読み込みに失敗した場合は、公開中の設定をそのまま使い続ける
+        std::string error = "設定ファイルの再読み込みに失敗しました: " + std::string(e.what());
+        StringUtils::OutputMessage(error);
+        if (showResult)
+        {
+            ShowErrorMessage(error, "警告", MB_OK | MB_ICONWARNING);
+        }
+    }
+}
+
+// 設定ファイルの監視を開始する（変更はウィンドウのメッセージループで反映する）
+void StartConfigWatcher()
+{
+    try
+    {
+        std::filesystem::path configPath = ConfigManager::Instance().GetConfigFilePath();
+        g_configWatcher = std::make_unique<FileWatcher>(
+            CreateFileWatchBackend(configPath),
+            std::chrono::milliseconds(500),
+            []
+            { PostMessageW(g_hwnd, WM_APP_CONFIG_CHANGED, 0, 0); });
+        StringUtils::OutputMessage("設定ファイルの監視を開始しました: " + configPath.string());
+    }
+    catch (const std::exception &e)
+    {
+        StringUtils::OutputMessage("設定ファイルの監視を開始できませんでした。変更はメニューから再読み込みしてください: " + std::string(e.what()));
+    }
+}
+
+// ディスプレイ構成の変更を通知する（ウィンドウのメッセージループから呼ばれる）
+void NotifyDisplayChange()
+{
+    if (g_displayChangeSignal)
+    {
+        // 通知が落ち着いてから監視スレッドでモニターの一覧を作り直す
+        g_displayChangeSignal->Notify();
+    }
+    else if (g_brightnessManager)
+    {
+        g_brightnessManager->OnDisplayChange();
+    }
+}
+
+// ディスプレイ構成の変更の監視を開始する
+// （一覧の作り直しと輝度の状態の引き継ぎは監視スレッドで行い、設定の追加だけをメッセージループで行う）
+void StartDisplayWatcher()
+{
+    try
+    {
+        auto signal = std::make_unique<DisplayChangeSignal>();
+        auto *rawSignal = signal.get();
+        g_displayWatcher = std::make_unique<DisplayChangeWatcher>(
+            std::move(signal),
+            std::chrono::milliseconds(500),
+            []
+            { return g_brightnessManager->OnDisplayChange(); },
+            [](const MonitorTopologyChange &change)
+            {
+                StringUtils::OutputMessage("ディスプレイ構成が変わりました: 接続=" + std::to_string(change.added.size()) +
+                                           ", 取り外し=" + std::to_string(change.removed.size()) +
+                                           ", 接続中=" + std::to_string(change.topology->GetIds().size()));
+                if (change.added.empty())
+                {
+                    return;
+                }
+                {
+                    std::lock_guard<std::mutex> lock(g_connectedMonitorsMutex);
+                    for (const auto &id : change.added)
+                    {
+                        const auto *monitor = change.topology->Find(id);
+                        g_connectedMonitors.push_back({monitor->identity.ToKey(), StringUtils::WideToUtf8(monitor->name)});
+                    }
+                }
+                PostMessageW(g_hwnd, WM_APP_MONITORS_CONNECTED, 0, 0);
+            });
+        g_displayChangeSignal = rawSignal;
+
+        // WM_DISPLAYCHANGEはデスクトップの構成が変わった場合だけ届くため、モニターの接続・取り外しも受け取る
+        // GUID_DEVINTERFACE_MONITOR
+        static const GUID monitorInterface = { 0xe6f07b5f, 0xee97, 0x4a90, { 0xb0, 0x76, 0x33, 0xf5, 0x7b, 0xf4, 0xea, 0xa7 } };
+        DEV_BROADCAST_DEVICEINTERFACE_W filter = {};
+        filter.dbcc_size = sizeof(filter);
+        filter.dbcc_devicetype = DBT_DEVTYP_DEVICEINTERFACE;
+        filter.dbcc_classguid = monitorInterface;
+        g_monitorNotification = RegisterDeviceNotificationW(g_hwnd, &filter, DEVICE_NOTIFY_WINDOW_HANDLE);
+        if (!g_monitorNotification)
+        {
+            StringUtils::OutputMessage("モニターの接続通知を登録できませんでした。ディスプレイ構成の変更通知だけを使用します");
+        }
+    }
+    catch (const std::exception &e)
+    {
+        StringUtils::OutputMessage("ディスプレイ構成の監視を開始できませんでした。変更は通知のたびに反映します: " + std::string(e.what()));
+    }
+}
+
+// 接続されたモニターのうち、設定のないものだけ設定を追加する
+void OnMonitorsConnected()
+{
+    std::vector<MonitorBrightnessMap::MonitorKeys> monitors;
+    {
+        std::lock_guard<std::mutex> lock(g_connectedMonitorsMutex);
+        monitors.swap(g_connectedMonitors);
+    }
+    if (!monitors.empty() && AddMonitorConfigs(monitors))
+    {
+        ApplyMonitorSettings();
+    }
+}
+
+// 起動の各段の所要時間を出力する
+void ReportStartupTime(const std::vector<std::pair<const char *, std::chrono::steady_clock::time_point>> &marks)
+{
+    auto toMilliseconds = [](std::chrono::steady_clock::duration duration) {
+        return std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()) + "ms";
+    };
+
+    std::string message = "起動時間: 合計=" + toMilliseconds(marks.back().second - marks.front().second) + " (";
+    for (size_t i = 1; i < marks.size(); ++i)
+    {
+        message += std::string(i > 1 ? ", " : "") + marks[i].first + "=" + toMilliseconds(marks[i].second - marks[i - 1].second);
+    }
+    StringUtils::OutputMessage(message + ")");
+
+    auto stats = ConfigManager::Instance().GetLastLoadStats();
+    auto toMicroseconds = [](std::chrono::microseconds duration) {
+        return std::to_string(duration.count()) + "us";
+    };
+    StringUtils::OutputMessage(std::string("設定の読み込み: ") + (stats.unchanged ? "変更なし" : "設定ファイルを解析") +
+                               ", 読み込み=" + toMicroseconds(stats.read) +
+                               ", 解析=" + toMicroseconds(stats.parse) +
+                               ", 検証=" + toMicroseconds(stats.validate) +
+                               ", スナップショット=" + toMicroseconds(stats.snapshot) +
+                               ", 合計=" + toMicroseconds(stats.total));
+}
+
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine, int nCmdShow)
 {
+    using StartupClock = std::chrono::steady_clock;
+    std::vector<std::pair<const char *, StartupClock::time_point>> startupMarks{{"開始", StartupClock::now()}};
+
     g_hInstance = hInstance;
 
     WNDCLASSEXW wc = {};
@@ -213,7 +583,22 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
     InitializeTrayIcon();
     InitializeConsole();
 
+    startupMarks.emplace_back("初期化", StartupClock::now());
+
+    LoadPlugins();
+    startupMarks.emplace_back("プラグイン", StartupClock::now());
+    try
+    {
+        ConfigManager::Instance().Load();
+    }
+    catch (const std::exception &e)
+    {
+        // 設定の適用時にバックアップからの復元を試みる
+        StringUtils::OutputMessage("設定の読み込みに失敗しました: " + std::string(e.what()));
+    }
+    startupMarks.emplace_back("設定", StartupClock::now());
     g_brightnessManager = std::make_unique<BrightnessManager>(CreateLightSensor());
+    startupMarks.emplace_back("センサー", StartupClock::now());
 
     try
     {
@@ -229,6 +614,9 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         // 基本設定の適用
         g_brightnessManager->SetUpdateInterval(std::chrono::milliseconds(config.GetUpdateInterval()));
         g_brightnessManager->SetBrightnessRange(config.GetMinBrightness(), config.GetMaxBrightness());
+        g_brightnessManager->SetWriteDeadband(config.GetWriteDeadband());
+        g_brightnessManager->SetTransition(std::chrono::milliseconds(config.GetTransitionDuration()), config.GetTransitionCurve());
+        ApplyMonitorSettings();
         StringUtils::OutputMessage("設定を読み込みました: 更新間隔=" + std::to_string(config.GetUpdateInterval()) + "ms, 輝度範囲=" + std::to_string(config.GetMinBrightness()) + "-" + std::to_string(config.GetMaxBrightness()) + "%");
 
         // 起動時同期設定の適用
@@ -258,6 +646,11 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
         }
     }
 
+    StartConfigWatcher();
+    StartDisplayWatcher();
+    startupMarks.emplace_back("設定の適用", StartupClock::now());
+    ReportStartupTime(startupMarks);
+
     StringUtils::OutputMessage("BrightnessDaemon initialized successfully.");
 
     MSG msg = {};
@@ -307,13 +700,33 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
             return 0;
         }
         case ID_MENU_RELOAD_CONFIG:
-            ConfigManager::Instance().Load();
-            StringUtils::OutputMessage("設定ファイルを再読み込みしました");
-            ShowErrorMessage("設定ファイルを再読み込みしました", "情報", MB_OK | MB_ICONINFORMATION);
+            ReloadConfig(true);
             return 0;
         }
         break;
 
+    case WM_APP_CONFIG_CHANGED:
+        ReloadConfig(false);
+        return 0;
+
+    case WM_APP_MONITORS_CONNECTED:
+        OnMonitorsConnected();
+        return 0;
+
+    case WM_DISPLAYCHANGE:
+        // モニターのIDが変わるため、ハンドルを開き直してモニターごとの設定も対応付け直す
+        // （遷移中の輝度変化は新しいIDへ引き継がれる）
+        NotifyDisplayChange();
+        break;
+
+    case WM_DEVICECHANGE:
+        if ((wParam == DBT_DEVICEARRIVAL || wParam == DBT_DEVICEREMOVECOMPLETE) && lParam &&
+            reinterpret_cast<const DEV_BROADCAST_HDR *>(lParam)->dbch_devicetype == DBT_DEVTYP_DEVICEINTERFACE)
+        {
+            NotifyDisplayChange();
+        }
+        return TRUE;
+
     case WM_DESTROY:
         PostQuitMessage(0);
         return 0;
@@ -400,10 +813,23 @@ void Cleanup()
 {
     Shell_NotifyIconW(NIM_DELETE, &g_nid);
 
+    // 監視スレッドから破棄済みのウィンドウへ通知しないよう、先に停止する
+    g_configWatcher.reset();
+    if (g_monitorNotification)
+    {
+        UnregisterDeviceNotification(g_monitorNotification);
+        g_monitorNotification = nullptr;
+    }
+    g_displayChangeSignal = nullptr;
+    g_displayWatcher.reset();
+
     if (g_brightnessManager)
     {
         g_brightnessManager->StopSync();
     }
+    // センサーとその読み取りスレッドはプラグインのコードなので、プラグインを解放する前に破棄する
+    g_brightnessManager.reset();
+    g_sensorFusion = nullptr;
 
     g_pluginLoader.reset();
 
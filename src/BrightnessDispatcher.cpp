@@ -0,0 +1,127 @@
+#include "BrightnessDispatcher.h"
+#include <algorithm>
+
+bool BrightnessDispatchResult::AllSucceeded() const
+{
+    return std::all_of(entries.begin(), entries.end(),
+        [](const Entry& entry) { return entry.success; });
+}
+
+BrightnessDispatcher::BrightnessDispatcher(size_t workerCount)
+{
+    workerCount = std::max<size_t>(workerCount, 1);
+    m_workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&BrightnessDispatcher::WorkerLoop, this);
+    }
+}
+
+BrightnessDispatcher::~BrightnessDispatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+BrightnessDispatchResult BrightnessDispatcher::Dispatch(std::vector<Job> jobs, std::chrono::milliseconds deadline)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    auto batch = std::make_shared<Batch>();
+    batch->entries.resize(jobs.size());
+    batch->completed.assign(jobs.size(), false);
+    batch->remaining = jobs.size();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            batch->entries[i].id = jobs[i].id;
+            m_queue.push_back(Task{batch, i, jobs[i].busId, std::move(jobs[i].write)});
+        }
+    }
+    m_workAvailable.notify_all();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto allDone = [&batch] { return batch->remaining == 0; };
+    if (deadline.count() > 0) {
+        m_taskCompleted.wait_until(lock, start + deadline, allDone);
+    } else {
+        m_taskCompleted.wait(lock, allDone);
+    }
+
+    if (batch->remaining > 0) {
+        // 期限切れ: 未完了のジョブをタイムアウトとして扱い、未着手のものはキューから外す
+        batch->expired = true;
+        for (size_t i = 0; i < batch->entries.size(); ++i) {
+            if (!batch->completed[i]) {
+                batch->entries[i].timedOut = true;
+            }
+        }
+        m_queue.erase(std::remove_if(m_queue.begin(), m_queue.end(),
+            [&batch](const Task& task) { return task.batch == batch; }), m_queue.end());
+    }
+
+    BrightnessDispatchResult result;
+    result.entries = batch->entries;
+    result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    return result;
+}
+
+std::deque<BrightnessDispatcher::Task>::iterator BrightnessDispatcher::FindRunnableTask()
+{
+    return std::find_if(m_queue.begin(), m_queue.end(),
+        [this](const Task& task) { return m_busyBuses.count(task.busId) == 0; });
+}
+
+void BrightnessDispatcher::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_workAvailable.wait(lock, [this] {
+            return m_stopping || FindRunnableTask() != m_queue.end();
+        });
+        if (m_stopping) {
+            return;
+        }
+
+        auto it = FindRunnableTask();
+        Task task = std::move(*it);
+        m_queue.erase(it);
+        m_busyBuses.insert(task.busId);
+
+        lock.unlock();
+        auto start = std::chrono::steady_clock::now();
+        bool success = false;
+        try {
+            success = task.write && task.write();
+        }
+        catch (...) {
+            // 書き込み処理の例外は失敗として扱う
+            success = false;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        lock.lock();
+
+        m_busyBuses.erase(task.busId);
+        auto& batch = *task.batch;
+        if (!batch.expired) {
+            batch.entries[task.index].success = success;
+            batch.entries[task.index].elapsed = elapsed;
+            batch.completed[task.index] = true;
+            --batch.remaining;
+        }
+
+        // バスが空いたので待機中のワーカーと呼び出し元に通知
+        m_workAvailable.notify_all();
+        m_taskCompleted.notify_all();
+    }
+}
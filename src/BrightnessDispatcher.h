@@ -0,0 +1,90 @@
+#ifndef DISPLAYCONTROLLER_BRIGHTNESS_DISPATCHER_H
+#define DISPLAYCONTROLLER_BRIGHTNESS_DISPATCHER_H
+
+#include "MonitorBackend.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// 複数モニターへの輝度設定の集約結果
+struct DISPLAYCONTROLLER_API BrightnessDispatchResult {
+    struct Entry {
+        MonitorId id{};
+        bool success = false;
+        bool timedOut = false;                    // 期限までに完了しなかった
+        std::chrono::milliseconds elapsed{0};     // DDC/CI通信に要した時間
+    };
+
+    std::vector<Entry> entries;
+    std::chrono::milliseconds elapsed{0};         // 全体の所要時間
+
+    bool AllSucceeded() const;
+};
+
+/**
+ * @brief 輝度設定を複数モニターへ並行して送出するワーカープール
+ *
+ * 同じ物理バス（DDC/CIのI2Cバス）上の通信は同時に1つまでに制限し、
+ * 異なるバスのモニターへは並行して書き込みます。期限を過ぎたジョブは
+ * タイムアウトとして結果に記録され、未着手のものは破棄されます。
+ */
+class DISPLAYCONTROLLER_API BrightnessDispatcher {
+public:
+    struct Job {
+        MonitorId id{};
+        std::uintptr_t busId = 0;           // 同じバスIDのジョブは直列に実行される
+        std::function<bool()> write;        // DDC/CI書き込み処理（成功時true）
+    };
+
+    explicit BrightnessDispatcher(size_t workerCount = 4);
+    ~BrightnessDispatcher();
+
+    // コピー禁止
+    BrightnessDispatcher(const BrightnessDispatcher&) = delete;
+    BrightnessDispatcher& operator=(const BrightnessDispatcher&) = delete;
+
+    /**
+     * @brief ジョブを並行実行し、すべて完了するか期限に達するまで待機する
+     * @param jobs 実行するジョブ
+     * @param deadline 待機の上限（0以下の場合は無制限）
+     * @return ジョブごとの結果（jobsと同じ順序）
+     */
+    BrightnessDispatchResult Dispatch(std::vector<Job> jobs, std::chrono::milliseconds deadline);
+
+    size_t GetWorkerCount() const { return m_workers.size(); }
+
+private:
+    struct Batch {
+        std::vector<BrightnessDispatchResult::Entry> entries;
+        std::vector<bool> completed;
+        size_t remaining = 0;
+        bool expired = false;
+    };
+
+    struct Task {
+        std::shared_ptr<Batch> batch;
+        size_t index = 0;
+        std::uintptr_t busId = 0;
+        std::function<bool()> write;
+    };
+
+    void WorkerLoop();
+    std::deque<Task>::iterator FindRunnableTask();
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_taskCompleted;
+    std::deque<Task> m_queue;
+    std::unordered_set<std::uintptr_t> m_busyBuses;
+    bool m_stopping = false;
+};
+
+#endif // DISPLAYCONTROLLER_BRIGHTNESS_DISPATCHER_H
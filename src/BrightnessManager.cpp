@@ -1,30 +1,63 @@
 #include "BrightnessManager.h"
+#include "SyncLightSensorAdapter.h"
+#include <common/StringUtils.h>
 #include <algorithm>
+#include <optional>
 #include <stdexcept>
 
+namespace {
+    // まとめる前の、指定したセンサーの値（外れ値として除かれた値も含む）
+    std::optional<int> FindSourceLevel(const LightSample& sample, const std::string& name)
+    {
+        for (const auto& source : sample.sources) {
+            if (source.name == name) {
+                return source.level;
+            }
+        }
+        return std::nullopt;
+    }
+}
+
 BrightnessManager::BrightnessManager(std::unique_ptr<ILightSensor> sensor)
-    : m_sensor(std::move(sensor))
-    , m_controller(std::make_unique<MonitorController>())
+    : BrightnessManager(std::move(sensor), std::make_unique<MonitorController>())
+{
+}
+
+BrightnessManager::BrightnessManager(std::unique_ptr<ILightSensor> sensor, std::unique_ptr<MonitorController> controller)
+    : m_sensor(sensor ? MakeAsyncLightSensor(std::move(sensor)) : nullptr)
+    , m_controller(std::move(controller))
     , m_isRunning(false)
-    , m_updateInterval(std::chrono::seconds(5))
-    , m_minBrightness(20)
-    , m_maxBrightness(100)
+    , m_sensorScheduler(std::chrono::seconds(5))
+    , m_applyScheduler(std::chrono::seconds(1))
+    , m_writeSignal(std::chrono::seconds(1))
 {
     if (!m_sensor) {
         throw std::invalid_argument("センサーがnullです");
     }
+    if (!m_controller) {
+        throw std::invalid_argument("モニターコントローラーがnullです");
+    }
+    std::lock_guard<std::mutex> lock(m_profileMutex);
+    RebuildBrightnessMap();
 }
 
 BrightnessManager::~BrightnessManager()
 {
     StopSync();
+    // 読み取り中のコールバックが他のメンバーを参照するため、センサーを先に破棄する
+    m_sensor.reset();
 }
 
 void BrightnessManager::StartSync()
 {
     if (!m_isRunning) {
         m_isRunning = true;
-        m_syncThread = std::thread(&BrightnessManager::SyncLoop, this);
+        m_sensorScheduler.Reset();
+        m_applyScheduler.Reset();
+        m_writeSignal.Reset();
+        m_writeThread = std::thread(&BrightnessManager::WriteLoop, this);
+        m_applyThread = std::thread(&BrightnessManager::ApplyLoop, this);
+        m_sensorThread = std::thread(&BrightnessManager::SensorLoop, this);
     }
 }
 
@@ -32,25 +65,145 @@ void BrightnessManager::StopSync()
 {
     if (m_isRunning) {
         m_isRunning = false;
-        if (m_syncThread.joinable()) {
-            m_syncThread.join();
+        // 待機中のすべてのスレッドをすぐに起床させる
+        m_sensorScheduler.Stop();
+        m_applyScheduler.Stop();
+        m_writeSignal.Stop();
+        if (m_sensorThread.joinable()) {
+            m_sensorThread.join();
+        }
+        if (m_applyThread.joinable()) {
+            m_applyThread.join();
+        }
+        if (m_writeThread.joinable()) {
+            m_writeThread.join();
         }
     }
 }
 
-void BrightnessManager::UpdateBrightness()
+void BrightnessManager::SampleSensor()
 {
+    // 前回の読み取りが終わっていない場合は新しい読み取りを重ねない
+    if (m_readInFlight.exchange(true)) {
+        return;
+    }
+
+    auto requestedAt = Clock::now();
     try {
-        // 照度レベルの取得と輝度値の計算
-        int lightLevel = m_sensor->GetLightLevel();
-        int brightness = CalculateBrightness(lightLevel);
+        m_sensor->StartRead([this, requestedAt](const LightSample& sample) {
+            OnSampleReady(sample, requestedAt);
+        });
+    }
+    catch (const std::exception& e) {
+        StringUtils::OutputExceptionMessage(e);
+        m_sensorMetrics.Record(Clock::now() - requestedAt, false);
+        m_readInFlight = false;
+    }
+}
 
-        // すべてのモニターの輝度を統一的に設定
-        m_controller->SetUnifiedBrightness(brightness);
+void BrightnessManager::OnSampleReady(const LightSample& sample, Clock::time_point requestedAt)
+{
+    // 読み取り中は次の読み取りを開始しないため、メールボックスへの書き込みは常に1スレッドから行われる
+    bool usable = sample.IsUsable();
+    if (usable) {
+        m_samples.Publish(sample);
+    }
+    m_sensorMetrics.Record(Clock::now() - requestedAt, usable);
+    m_readInFlight = false;
+
+    if (usable) {
+        // 適用側の待機を待たずに新しい値を反映させる
+        m_applyScheduler.Notify();
+    }
+}
+
+void BrightnessManager::ApplyLatestSample()
+{
+    auto start = Clock::now();
+    bool success = true;
+    try {
+        auto sample = m_samples.TakeLatest();
+        if (sample) {
+            // すべてのモニターの目標値を更新する（遷移中のモニターは現在値から遷移し直す）
+            // 変換は事前計算した表の参照だけで、モニターが増えても1台あたりの処理は変わらない
+            // モニターの一覧は構成の変更時だけ作り直されるため、ここではOSへ問い合わせない
+            // 輝度を変更できないモニターは一覧を作ったときの判定で除き、書き込みのたびに開き直さない
+            auto map = m_brightnessMap.load();
+            std::lock_guard<std::mutex> lock(m_topologyMutex);
+            for (const auto& monitor : m_controller->GetTopology()->GetMonitors()) {
+                if (!monitor.SupportsBrightness()) {
+                    continue;
+                }
+                MonitorId id = monitor.id;
+                m_writeScheduler.Track(id);
+                const auto& entry = map->Find(id);
+                int level = sample->level;
+                if (!entry.sensor.empty()) {
+                    level = FindSourceLevel(*sample, entry.sensor).value_or(sample->level);
+                }
+                m_transitions.SetTarget(id, MonitorBrightnessMap::Map(entry, level), start);
+            }
+        }
+        AdvanceTransitions();
+
+        if (sample) {
+            m_lastSampleAge = std::chrono::duration_cast<std::chrono::microseconds>(
+                Clock::now() - sample->timestamp);
+        }
     }
     catch (const std::exception& e) {
-        // TODO: エラーログ機能の実装
-        // とりあえず例外は握りつぶす（常駐プログラムは停止させない）
+        StringUtils::OutputExceptionMessage(e);
+        success = false;
+    }
+    m_applyMetrics.Record(Clock::now() - start, success);
+}
+
+void BrightnessManager::RequestUpdate()
+{
+    m_sensorScheduler.Notify();
+}
+
+void BrightnessManager::AdvanceTransitions()
+{
+    // 遷移の途中フレームを書き込み要求に変換し、変化のないモニターへの書き込みは省く
+    // 最後のフレームは不感帯を適用せず、目標値まで確実に書き込む
+    auto frames = m_transitions.AdvanceFrames(BrightnessTransitionEngine::Clock::now());
+    for (const auto& frame : frames) {
+        m_writeScheduler.Submit(frame.id, frame.brightness, frame.final);
+    }
+    // 送出は書き込みスレッドで行う（書き込み中に積まれた要求は最新の値にまとめられる）
+    if (!frames.empty()) {
+        m_writeSignal.Notify();
+    }
+}
+
+void BrightnessManager::ApplyPendingWrites()
+{
+    auto writes = m_writeScheduler.TakePendingWrites();
+    if (writes.empty()) {
+        return;
+    }
+
+    auto start = Clock::now();
+    BrightnessDispatchResult result;
+    try {
+        result = m_controller->DispatchBrightness(writes);
+    }
+    catch (...) {
+        // 送出できなかった書き込みは失敗として扱い、待機時間の後に再送する
+        for (const auto& [id, brightness] : writes) {
+            m_writeScheduler.OnWriteCompleted(id, brightness, false);
+        }
+        throw;
+    }
+    m_writeMetrics.Record(Clock::now() - start, result.AllSucceeded());
+    for (size_t i = 0; i < writes.size() && i < result.entries.size(); ++i) {
+        const auto& entry = result.entries[i];
+        m_writeScheduler.OnWriteCompleted(writes[i].first, writes[i].second, entry.success);
+        if (entry.success) {
+            // 次のフレームの間隔をモニターの書き込み速度に合わせる
+            m_transitions.RecordWriteLatency(entry.id, entry.elapsed);
+        }
     }
 }
 
@@ -59,7 +212,17 @@ void BrightnessManager::SetUpdateInterval(std::chrono::milliseconds interval)
     if (interval.count() < 1000) {
         throw std::invalid_argument("更新間隔は1秒以上である必要があります");
     }
-    m_updateInterval = interval;
+    // 待機中の場合も新しい間隔がすぐに反映される
+    m_sensorScheduler.SetInterval(interval);
+}
+
+void BrightnessManager::SetApplyInterval(std::chrono::milliseconds interval)
+{
+    if (interval.count() < 100) {
+        throw std::invalid_argument("適用間隔は100ミリ秒以上である必要があります");
+    }
+    m_applyScheduler.SetInterval(interval);
+    m_writeSignal.SetInterval(interval);
 }
 
 void BrightnessManager::SetBrightnessRange(int minBrightness, int maxBrightness)
@@ -67,24 +230,156 @@ void BrightnessManager::SetBrightnessRange(int minBrightness, int maxBrightness)
     if (minBrightness < 0 || maxBrightness > 100 || minBrightness >= maxBrightness) {
         throw std::invalid_argument("不正な輝度範囲が指定されました");
     }
+    std::lock_guard<std::mutex> lock(m_profileMutex);
     m_minBrightness = minBrightness;
     m_maxBrightness = maxBrightness;
+    RebuildBrightnessMap();
+}
+
+void BrightnessManager::SetWriteDeadband(int deadband)
+{
+    m_writeScheduler.SetDeadband(deadband);
 }
 
-void BrightnessManager::SyncLoop()
+void BrightnessManager::SetTransition(std::chrono::milliseconds duration, EasingCurve curve)
+{
+    m_transitions.SetDuration(duration);
+    m_transitions.SetEasingCurve(curve);
+}
+
+void BrightnessManager::SetMonitorProfiles(MonitorProfileTable profiles)
+{
+    for (const auto& [name, profile] : profiles) {
+        if (profile.range && !profile.range->IsValid()) {
+            throw std::invalid_argument("不正な輝度範囲が指定されました");
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_profileMutex);
+    m_profiles = std::move(profiles);
+    ResolveMonitorKeys();
+    RebuildBrightnessMap();
+}
+
+void BrightnessManager::ResolveMonitorKeys()
+{
+    m_monitorKeys.clear();
+    if (m_profiles.empty()) {
+        // 対応付ける設定がなければモニターの詳細情報を読み取らない
+        return;
+    }
+    for (const auto& monitor : m_controller->GetTopology()->GetMonitors()) {
+        m_monitorKeys.emplace(monitor.id, MonitorBrightnessMap::MonitorKeys{monitor.identity.ToKey(), StringUtils::WideToUtf8(monitor.name)});
+    }
+}
+
+void BrightnessManager::RebuildBrightnessMap()
+{
+    m_brightnessMap = std::make_shared<const MonitorBrightnessMap>(
+        m_minBrightness, m_maxBrightness, m_profiles, m_monitorKeys);
+}
+
+void BrightnessManager::ReplaceSensor(std::unique_ptr<ILightSensor> sensor)
+{
+    if (!sensor) {
+        throw std::invalid_argument("センサーがnullです");
+    }
+
+    bool wasRunning = m_isRunning;
+    StopSync();
+    // 読み取り中のコールバックが終わるまで古いセンサーの破棄を待つ
+    m_sensor.reset();
+    m_sensor = MakeAsyncLightSensor(std::move(sensor));
+    m_readInFlight = false;
+    if (wasRunning) {
+        StartSync();
+    }
+}
+
+MonitorTopologyChange BrightnessManager::OnDisplayChange()
+{
+    // 適用スレッドが古い一覧のモニターを書き込み対象へ登録し直さないよう、一覧の差し替えから破棄までをまとめて行う
+    std::unique_lock<std::mutex> topologyLock(m_topologyMutex);
+    auto change = m_controller->RefreshTopology();
+
+    // 取り外されたモニターとIDが変わったモニターは、古いIDへの書き込み済みの値と保留中の書き込みを破棄する
+    for (const auto& id : change.removed) {
+        m_writeScheduler.Forget(id);
+    }
+    for (const auto& [before, after] : change.retained) {
+        if (before != after) {
+            m_writeScheduler.Forget(before);
+        }
+    }
+    m_transitions.RemapMonitors(change.retained, BrightnessTransitionEngine::Clock::now());
+    topologyLock.unlock();
+
+    // 新しいMonitorIdにモニター名ごとの変換表を対応付け直す
+    {
+        std::lock_guard<std::mutex> lock(m_profileMutex);
+        ResolveMonitorKeys();
+        RebuildBrightnessMap();
+    }
+    // 接続されたモニターへ次の読み取りを待たずに輝度を設定し、引き継いだ遷移を再開する
+    m_applyScheduler.Notify();
+    if (!change.added.empty()) {
+        RequestUpdate();
+    }
+    return change;
+}
+
+BrightnessWriteScheduler::Stats BrightnessManager::GetWriteStats() const
+{
+    return m_writeScheduler.GetStats();
+}
+
+BrightnessManager::PipelineStats BrightnessManager::GetPipelineStats() const
+{
+    PipelineStats stats;
+    stats.sensor = m_sensorMetrics.GetSnapshot();
+    stats.apply = m_applyMetrics.GetSnapshot();
+    stats.write = m_writeMetrics.GetSnapshot();
+    stats.lastSampleAge = m_lastSampleAge;
+    stats.samplesOverwritten = m_samples.GetOverwrittenCount();
+    return stats;
+}
+
+void BrightnessManager::SensorLoop()
 {
     while (m_isRunning) {
-        UpdateBrightness();
-        std::this_thread::sleep_for(m_updateInterval);
+        SampleSensor();
+        if (m_sensorScheduler.WaitForNextTick() == SyncScheduler::WakeReason::Stopped) {
+            break;
+        }
     }
 }
 
-int BrightnessManager::CalculateBrightness(int lightLevel) const
+void BrightnessManager::ApplyLoop()
 {
-    // 照度レベル（0-100）から輝度（m_minBrightness-m_maxBrightness）への線形変換
-    return static_cast<int>(
-        m_minBrightness +
-        (static_cast<double>(lightLevel) / 100.0) *
-        (m_maxBrightness - m_minBrightness)
-    );
+    while (m_isRunning) {
+        // 新しい読み取り結果の通知・遷移の途中フレーム・適用間隔のいずれかで起床する
+        auto reason = m_applyScheduler.WaitForNextTick(m_transitions.GetNextFrameTime());
+        if (reason == SyncScheduler::WakeReason::Stopped) {
+            break;
+        }
+        ApplyLatestSample();
+    }
+}
+
+void BrightnessManager::WriteLoop()
+{
+    while (m_isRunning) {
+        // 書き込み要求の通知・失敗した書き込みの再送時刻・適用間隔のいずれかで起床する
+        if (m_writeSignal.WaitForNextTick(m_writeScheduler.GetNextRetryTime()) == SyncScheduler::WakeReason::Stopped) {
+            break;
+        }
+        auto start = Clock::now();
+        try {
+            ApplyPendingWrites();
+        }
+        catch (const std::exception& e) {
+            StringUtils::OutputExceptionMessage(e);
+            m_writeMetrics.Record(Clock::now() - start, false);
+        }
+    }
 }
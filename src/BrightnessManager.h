@@ -1,22 +1,63 @@
 #ifndef DISPLAYCONTROLLER_BRIGHTNESSMANAGER_H
 #define DISPLAYCONTROLLER_BRIGHTNESSMANAGER_H
 
-#ifdef DISPLAYCONTROLLERLIB_EXPORTS
-#define DISPLAYCONTROLLERLIB_API __declspec(dllexport)
+#ifdef _WIN32
+    #ifdef DISPLAYCONTROLLERLIB_EXPORTS
+        #define DISPLAYCONTROLLERLIB_API __declspec(dllexport)
+    #else
+        #define DISPLAYCONTROLLERLIB_API __declspec(dllimport)
+    #endif
 #else
-#define DISPLAYCONTROLLERLIB_API __declspec(dllimport)
+    #define DISPLAYCONTROLLERLIB_API
 #endif
 
-#include "ILightSensor.h"
+#include "IAsyncLightSensor.h"
+#include "ConfigTypes.h"
 #include "MonitorController.h"
+#include "BrightnessTransition.h"
+#include "BrightnessWriteScheduler.h"
+#include "LatestValueMailbox.h"
+#include "MonitorBrightnessMap.h"
+#include "StageMetrics.h"
+#include "SyncScheduler.h"
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <mutex>
 
+/**
+ * @brief 照度センサーに合わせてモニターの輝度を同期する
+ *
+ * センサーの読み取り（生産側）と輝度の適用（消費側）は別々のスレッドで動作し、
+ * 最新の読み取り結果だけをロックフリーのメールボックスで受け渡します。
+ * センサーは非同期に読み取るため、どちらのスレッドもセンサーの通信を待ちません。
+ * DDC/CIへの書き込みはさらに別のスレッドで行い、書き込み中に届いた同じモニターへの
+ * 要求は最新の値だけにまとめて次の書き込みで送出します。遅いセンサー通信がモニターの
+ * 更新を遅らせることも、遅いDDC/CI書き込みが次の読み取りや遷移の計算を遅らせることもありません。
+ */
 class DISPLAYCONTROLLERLIB_API BrightnessManager {
 public:
+    using MonitorProfileTable = MonitorBrightnessMap::ProfileTable;
+
+    // センサー読み取りと輝度適用の各段の統計
+    struct PipelineStats {
+        StageMetrics::Snapshot sensor;          // センサー読み取り1回あたり（要求から完了まで）
+        StageMetrics::Snapshot apply;           // 輝度適用1回あたり（目標値と遷移の計算）
+        StageMetrics::Snapshot write;           // DDC/CIへの書き込み1回あたり（全モニター分）
+        std::chrono::microseconds lastSampleAge{0};   // 読み取りから適用完了までの時間
+        uint64_t samplesOverwritten = 0;        // 適用される前に新しい値で上書きされた読み取り数
+    };
+
     explicit BrightnessManager(std::unique_ptr<ILightSensor> sensor);
+
+    /**
+     * @brief モニターコントローラーを指定して作成する
+     *
+     * SimulatedDisplayBackendを使うコントローラーを渡すと、同期処理全体をハードウェアなしで動作させられます。
+     * @throws std::invalid_argument sensorまたはcontrollerがnullの場合
+     */
+    BrightnessManager(std::unique_ptr<ILightSensor> sensor, std::unique_ptr<MonitorController> controller);
     ~BrightnessManager();
 
     // コピー禁止
@@ -26,29 +67,92 @@ public:
     // 同期処理の制御
     void StartSync();
     void StopSync();
-    void UpdateBrightness();
+
+    // 次の更新間隔を待たずにセンサーを読み取る（設定の再読み込み時など）
+    void RequestUpdate();
 
     // 設定
+    // センサーの読み取り間隔
     void SetUpdateInterval(std::chrono::milliseconds interval);
+    // 新しい読み取りがなくても輝度の適用・失敗した書き込みの再送を行う間隔
+    void SetApplyInterval(std::chrono::milliseconds interval);
     void SetBrightnessRange(int minBrightness, int maxBrightness);
+    void SetWriteDeadband(int deadband);
+    void SetTransition(std::chrono::milliseconds duration, EasingCurve curve);
+    // モニター名ごとの輝度範囲・カーブ・割り当てたセンサー（表にないモニターは全体の輝度範囲で線形、出力0-100）
+    // 接続中のモニターへの対応付けは、ディスプレイ構成の変更時にも自動的にやり直す
+    void SetMonitorProfiles(MonitorProfileTable profiles);
+
+    // センサーを差し替える（同期中の場合は一度停止し、新しいセンサーで再開する）
+    void ReplaceSensor(std::unique_ptr<ILightSensor> sensor);
+
+    /**
+     * @brief ディスプレイ構成の変更通知
+     *
+     * モニターの一覧を作り直し、接続し続けているモニターの遷移状態を新しいIDへ引き継ぎます
+     * （遷移中の輝度変化は中断しない）。取り外されたモニターの状態は破棄します。
+     * @return 変更前の一覧との差分
+     */
+    MonitorTopologyChange OnDisplayChange();
+
+    // 書き込みの送出数・省略数などの統計
+    BrightnessWriteScheduler::Stats GetWriteStats() const;
+    PipelineStats GetPipelineStats() const;
 
     // モニターコントローラーへのアクセス
     MonitorController& GetMonitorController() { return *m_controller; }
     const MonitorController& GetMonitorController() const { return *m_controller; }
 
 private:
-    void SyncLoop();
-    int CalculateBrightness(int lightLevel) const;
+    using Clock = std::chrono::steady_clock;
+
+    // メールボックスで受け渡すセンサーの読み取り結果
+    void SensorLoop();
+    void ApplyLoop();
+    void WriteLoop();
+    void SampleSensor();
+    void OnSampleReady(const LightSample& sample, Clock::time_point requestedAt);
+    void ApplyLatestSample();
+    // 以下はm_profileMutexを保持した状態で呼ぶ
+    void ResolveMonitorKeys();
+    void RebuildBrightnessMap();
+    void AdvanceTransitions();
+    void ApplyPendingWrites();
 
-    std::unique_ptr<ILightSensor> m_sensor;
+    std::unique_ptr<IAsyncLightSensor> m_sensor;
     std::unique_ptr<MonitorController> m_controller;
+    BrightnessTransitionEngine m_transitions;
+    BrightnessWriteScheduler m_writeScheduler;
     std::atomic<bool> m_isRunning;
-    std::thread m_syncThread;
-    std::chrono::milliseconds m_updateInterval;
+    // モニターの一覧の差し替えと書き込み対象の登録を排他する
+    std::mutex m_topologyMutex;
+
+    // 生産側: センサーの読み取り
+    std::thread m_sensorThread;
+    SyncScheduler m_sensorScheduler;
+    StageMetrics m_sensorMetrics;
+    std::atomic<bool> m_readInFlight{false};
+
+    // 消費側: 輝度の適用
+    std::thread m_applyThread;
+    SyncScheduler m_applyScheduler;
+    StageMetrics m_applyMetrics;
+    std::atomic<std::chrono::microseconds> m_lastSampleAge{std::chrono::microseconds(0)};
+
+    // 書き込み: 適用側が積んだ書き込み要求をDDC/CIへ送出する
+    std::thread m_writeThread;
+    SyncScheduler m_writeSignal;
+    StageMetrics m_writeMetrics;
+
+    LatestValueMailbox<LightSample> m_samples;
 
-    // 輝度の範囲設定
-    int m_minBrightness;
-    int m_maxBrightness;
+    // 輝度の変換設定（設定の変更時に変換表を作り直し、同期スレッドへまとめて差し替える）
+    std::mutex m_profileMutex;
+    int m_minBrightness = 20;
+    int m_maxBrightness = 100;
+    MonitorProfileTable m_profiles;
+    MonitorBrightnessMap::MonitorKeyTable m_monitorKeys;
+    std::atomic<std::shared_ptr<const MonitorBrightnessMap>> m_brightnessMap;
 };
 
 #endif // DISPLAYCONTROLLER_BRIGHTNESSMANAGER_H
@@ -0,0 +1,46 @@
+#include "BrightnessMapping.h"
+
+int MapBrightnessReference(const MappingConfig& config, int normalizedBrightness)
+{
+    // 範囲チェック
+    normalizedBrightness = std::clamp(normalizedBrightness, 0, 100);
+
+    // マッピングポイントがない場合は線形マッピング
+    if (config.mappingPoints.empty()) {
+        return config.minBrightness +
+            (config.maxBrightness - config.minBrightness) * normalizedBrightness / 100;
+    }
+
+    // カスタムマッピングポイントを使用
+    auto points = config.mappingPoints;
+    std::sort(points.begin(), points.end());
+
+    // 最小値以下または最大値以上の場合
+    if (normalizedBrightness <= points.front().first) {
+        return points.front().second;
+    }
+    if (normalizedBrightness >= points.back().first) {
+        return points.back().second;
+    }
+
+    // 区間を見つけて線形補間
+    for (size_t i = 1; i < points.size(); ++i) {
+        if (normalizedBrightness <= points[i].first) {
+            const auto& p1 = points[i - 1];
+            const auto& p2 = points[i];
+            float t = static_cast<float>(normalizedBrightness - p1.first) /
+                     static_cast<float>(p2.first - p1.first);
+            return p1.second + static_cast<int>(t * (p2.second - p1.second));
+        }
+    }
+
+    return normalizedBrightness; // フォールバック
+}
+
+BrightnessLookupTable::BrightnessLookupTable(const MappingConfig& config)
+    : m_config(config)
+{
+    for (int i = 0; i < kSize; ++i) {
+        m_table[static_cast<size_t>(i)] = MapBrightnessReference(config, i);
+    }
+}
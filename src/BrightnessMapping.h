@@ -0,0 +1,52 @@
+#ifndef DISPLAYCONTROLLER_BRIGHTNESS_MAPPING_H
+#define DISPLAYCONTROLLER_BRIGHTNESS_MAPPING_H
+
+#include "MonitorBackend.h"
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+// 輝度マッピング設定
+struct MappingConfig {
+    int minBrightness;
+    int maxBrightness;
+    std::vector<std::pair<int, int>> mappingPoints;
+
+    MappingConfig() : minBrightness(0), maxBrightness(100) {}
+};
+
+/**
+ * @brief マッピング設定から輝度を計算する（基準実装）
+ *
+ * マッピングポイントを並べ替えて線形補間します。呼び出しのたびに並べ替えるため
+ * 通常はBrightnessLookupTableを使用し、この関数は変換表の生成と検証に使います。
+ */
+DISPLAYCONTROLLER_API int MapBrightnessReference(const MappingConfig& config, int normalizedBrightness);
+
+/**
+ * @brief マッピング設定を事前計算した輝度の変換表
+ *
+ * 入力の0-100の全101値をMapBrightnessReference()で計算しておくため、
+ * 変換結果は基準実装と完全に一致し、変換時にメモリ確保や探索を行いません。
+ */
+class DISPLAYCONTROLLER_API BrightnessLookupTable {
+public:
+    static constexpr int kSize = 101;
+
+    explicit BrightnessLookupTable(const MappingConfig& config);
+
+    // 入力は0-100に丸められる
+    int Map(int normalizedBrightness) const
+    {
+        return m_table[static_cast<size_t>(std::clamp(normalizedBrightness, 0, kSize - 1))];
+    }
+
+    const MappingConfig& GetConfig() const { return m_config; }
+
+private:
+    MappingConfig m_config;
+    std::array<int, kSize> m_table;
+};
+
+#endif // DISPLAYCONTROLLER_BRIGHTNESS_MAPPING_H
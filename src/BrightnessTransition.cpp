@@ -0,0 +1,234 @@
+#include "BrightnessTransition.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+    // 書き込み所要時間の指数移動平均の重み
+    constexpr double kLatencySmoothing = 0.2;
+}
+
+BrightnessTransitionEngine::BrightnessTransitionEngine(std::chrono::milliseconds duration, EasingCurve curve)
+    : m_duration(std::max(duration, std::chrono::milliseconds(0)))
+    , m_curve(curve)
+    , m_minFrameInterval(100)
+{
+}
+
+void BrightnessTransitionEngine::SetDuration(std::chrono::milliseconds duration)
+{
+    if (duration.count() < 0) {
+        throw std::invalid_argument("遷移時間は0以上である必要があります");
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_duration = duration;
+}
+
+void BrightnessTransitionEngine::SetEasingCurve(EasingCurve curve)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_curve = curve;
+}
+
+void BrightnessTransitionEngine::SetMinFrameInterval(std::chrono::milliseconds interval)
+{
+    if (interval.count() <= 0) {
+        throw std::invalid_argument("フレーム間隔は正の値である必要があります");
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_minFrameInterval = interval;
+}
+
+void BrightnessTransitionEngine::SetTarget(MonitorId id, int target, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& state = m_monitors[id];
+
+    if (!state.lastEmitted) {
+        // 現在の輝度が不明なモニターは遷移させずに目標値を直接出力する
+        state.startValue = target;
+        state.targetValue = target;
+        state.startTime = now;
+        state.nextFrame = now;
+        state.active = true;
+        return;
+    }
+
+    if (state.targetValue == target && (state.active || *state.lastEmitted == target)) {
+        return;
+    }
+
+    // 遷移中であってもその時点の値から新しい目標値へ遷移し直す
+    state.startValue = *state.lastEmitted;
+    state.targetValue = target;
+    state.startTime = now;
+    state.nextFrame = now;
+    state.active = true;
+}
+
+std::vector<BrightnessTransitionEngine::Frame> BrightnessTransitionEngine::AdvanceFrames(Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Frame> frames;
+    for (auto& [id, state] : m_monitors) {
+        if (!state.active || state.nextFrame > now) {
+            continue;
+        }
+
+        double t = 1.0;
+        if (m_duration.count() > 0) {
+            double elapsed = std::chrono::duration<double, std::milli>(now - state.startTime).count();
+            t = std::clamp(elapsed / static_cast<double>(m_duration.count()), 0.0, 1.0);
+        }
+
+        int value = state.targetValue;
+        if (t < 1.0) {
+            double eased = ApplyEasing(m_curve, t);
+            value = static_cast<int>(std::lround(
+                state.startValue + (state.targetValue - state.startValue) * eased));
+        }
+        // 緩急カーブは単調なため、丸めた値が目標値に達したら以降のフレームも変わらない
+        bool final = value == state.targetValue;
+        if (final) {
+            state.active = false;
+        }
+
+        // 丸めた値が変化しない途中のフレームは書き込まない
+        if (final || !state.lastEmitted || *state.lastEmitted != value || state.resend) {
+            state.lastEmitted = value;
+            state.resend = false;
+            frames.push_back({id, value, final});
+        }
+
+        if (state.active) {
+            // 遷移の終端を跨ぐ場合は終端に合わせて最終フレームを出す
+            auto end = state.startTime + m_duration;
+            state.nextFrame = std::min<Clock::time_point>(now + GetFrameInterval(state), end);
+        }
+    }
+    return frames;
+}
+
+std::vector<std::pair<MonitorId, int>> BrightnessTransitionEngine::Advance(Clock::time_point now)
+{
+    std::vector<std::pair<MonitorId, int>> values;
+    for (const auto& frame : AdvanceFrames(now)) {
+        values.emplace_back(frame.id, frame.brightness);
+    }
+    return values;
+}
+
+std::optional<BrightnessTransitionEngine::Clock::time_point> BrightnessTransitionEngine::GetNextFrameTime() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::optional<Clock::time_point> next;
+    for (const auto& [id, state] : m_monitors) {
+        if (state.active && (!next || state.nextFrame < *next)) {
+            next = state.nextFrame;
+        }
+    }
+    return next;
+}
+
+void BrightnessTransitionEngine::RecordWriteLatency(MonitorId id, std::chrono::milliseconds latency)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_monitors.find(id);
+    if (it == m_monitors.end()) {
+        return;
+    }
+
+    auto& average = it->second.writeLatencyMs;
+    double sample = static_cast<double>(latency.count());
+    average = average ? *average + (sample - *average) * kLatencySmoothing : sample;
+}
+
+bool BrightnessTransitionEngine::IsActive() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::any_of(m_monitors.begin(), m_monitors.end(),
+        [](const auto& entry) { return entry.second.active; });
+}
+
+std::optional<int> BrightnessTransitionEngine::GetCurrentValue(MonitorId id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_monitors.find(id);
+    if (it == m_monitors.end()) {
+        return std::nullopt;
+    }
+    return it->second.lastEmitted;
+}
+
+void BrightnessTransitionEngine::RemapMonitors(const std::vector<std::pair<MonitorId, MonitorId>>& ids, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::unordered_map<MonitorId, MonitorState> monitors;
+    for (const auto& [before, after] : ids) {
+        auto it = m_monitors.find(before);
+        if (it == m_monitors.end()) {
+            continue;
+        }
+
+        auto state = it->second;
+        if (before != after && state.lastEmitted) {
+            state.resend = true;
+            if (!state.active) {
+                state.startValue = *state.lastEmitted;
+                state.targetValue = *state.lastEmitted;
+                state.startTime = now;
+                state.nextFrame = now;
+                state.active = true;
+            }
+        }
+        monitors.emplace(after, std::move(state));
+    }
+    m_monitors = std::move(monitors);
+}
+
+void BrightnessTransitionEngine::Forget(MonitorId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_monitors.erase(id);
+}
+
+void BrightnessTransitionEngine::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_monitors.clear();
+}
+
+double BrightnessTransitionEngine::ApplyEasing(EasingCurve curve, double t)
+{
+    t = std::clamp(t, 0.0, 1.0);
+    switch (curve) {
+    case EasingCurve::EaseIn:
+        return t * t;
+    case EasingCurve::EaseOut:
+        return t * (2.0 - t);
+    case EasingCurve::EaseInOut:
+        return t < 0.5 ? 2.0 * t * t : 1.0 - 2.0 * (1.0 - t) * (1.0 - t);
+    case EasingCurve::Linear:
+    default:
+        return t;
+    }
+}
+
+EasingCurve BrightnessTransitionEngine::ParseEasingCurve(const std::string& name)
+{
+    if (name == "linear") return EasingCurve::Linear;
+    if (name == "ease_in") return EasingCurve::EaseIn;
+    if (name == "ease_out") return EasingCurve::EaseOut;
+    if (name == "ease_in_out") return EasingCurve::EaseInOut;
+    throw std::invalid_argument("不明な遷移カーブです: " + name);
+}
+
+std::chrono::milliseconds BrightnessTransitionEngine::GetFrameInterval(const MonitorState& state) const
+{
+    // 直前の書き込みが終わる前に次のフレームを出さないよう、計測した所要時間を下限とする
+    if (state.writeLatencyMs) {
+        auto latency = std::chrono::milliseconds(static_cast<long long>(std::ceil(*state.writeLatencyMs)));
+        return std::max(m_minFrameInterval, latency);
+    }
+    return m_minFrameInterval;
+}
@@ -0,0 +1,122 @@
+#ifndef DISPLAYCONTROLLER_BRIGHTNESS_TRANSITION_H
+#define DISPLAYCONTROLLER_BRIGHTNESS_TRANSITION_H
+
+#include "MonitorBackend.h"
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// 輝度変化の緩急
+enum class EasingCurve {
+    Linear,
+    EaseIn,
+    EaseOut,
+    EaseInOut
+};
+
+/**
+ * @brief 輝度を目標値へ滑らかに遷移させるエンジン
+ *
+ * モニターごとに現在値から目標値へ、設定した時間をかけて段階的に輝度を変化させます。
+ * フレーム間隔はモニターごとに計測したDDC/CI書き込みの所要時間を下回らないように
+ * 調整され、丸めた値が変化しない途中のフレームは出力しません。遷移中に新しい目標値が
+ * 設定された場合は、その時点の値から新しい目標値へ遷移し直します。
+ */
+class DISPLAYCONTROLLER_API BrightnessTransitionEngine {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit BrightnessTransitionEngine(
+        std::chrono::milliseconds duration = std::chrono::milliseconds(1000),
+        EasingCurve curve = EasingCurve::EaseInOut);
+
+    // 遷移の設定
+    void SetDuration(std::chrono::milliseconds duration);
+    void SetEasingCurve(EasingCurve curve);
+    void SetMinFrameInterval(std::chrono::milliseconds interval);
+
+    /**
+     * @brief 目標値を設定する
+     *
+     * 初めて目標値を設定したモニターは遷移せずに目標値を出力します。
+     * 遷移中の目標値と同じ値の場合は何もしません。
+     */
+    void SetTarget(MonitorId id, int target, Clock::time_point now);
+
+    // 出力するフレーム
+    struct Frame {
+        MonitorId id;
+        int brightness;
+        bool final;     // 遷移の最後のフレーム（目標値）
+    };
+
+    /**
+     * @brief 指定時刻までに出力すべきフレームを取得する
+     *
+     * 丸めた値が目標値に達した時点で遷移は終わり、最後のフレームは値が変わっていなくても出力します。
+     * 途中のフレームは書き込み側の不感帯で省かれることがあるため、最後のフレームで目標値を確実に書き込ませます。
+     */
+    std::vector<Frame> AdvanceFrames(Clock::time_point now);
+
+    /**
+     * @brief 指定時刻までに出力すべき値を取得する
+     * @return 出力するモニターとその輝度
+     */
+    std::vector<std::pair<MonitorId, int>> Advance(Clock::time_point now);
+
+    // 次にAdvance()を呼ぶべき時刻（遷移中のモニターがなければnullopt）
+    std::optional<Clock::time_point> GetNextFrameTime() const;
+
+    // DDC/CI書き込みの所要時間を記録する（フレーム間隔の調整に使用）
+    void RecordWriteLatency(MonitorId id, std::chrono::milliseconds latency);
+
+    bool IsActive() const;
+    std::optional<int> GetCurrentValue(MonitorId id) const;
+
+    /**
+     * @brief ディスプレイ構成の変更後のIDへ遷移状態を移す
+     * @param ids 接続し続けているモニターの変更前と変更後のIDの組（含まれないモニターの状態は破棄する）
+     *
+     * 遷移中のモニターは遷移を続けます。IDが変わったモニターは新しいIDへまだ書き込んでいないため、
+     * 次のAdvance()で値が変わらなくても出力します。
+     */
+    void RemapMonitors(const std::vector<std::pair<MonitorId, MonitorId>>& ids, Clock::time_point now);
+
+    void Forget(MonitorId id);
+    void Reset();
+
+    // 緩急カーブの適用（t: 0.0-1.0）
+    static double ApplyEasing(EasingCurve curve, double t);
+
+    /**
+     * @brief 設定文字列から緩急カーブへ変換
+     * @throws std::invalid_argument 不明な名前の場合
+     */
+    static EasingCurve ParseEasingCurve(const std::string& name);
+
+private:
+    struct MonitorState {
+        int startValue = 0;
+        int targetValue = 0;
+        std::optional<int> lastEmitted;
+        Clock::time_point startTime;
+        Clock::time_point nextFrame;
+        bool active = false;
+        bool resend = false;                    // 値が変わらなくても次のフレームを出力する
+        std::optional<double> writeLatencyMs;   // 書き込み所要時間の指数移動平均
+    };
+
+    std::chrono::milliseconds GetFrameInterval(const MonitorState& state) const;
+
+    mutable std::mutex m_mutex;
+    std::chrono::milliseconds m_duration;
+    EasingCurve m_curve;
+    std::chrono::milliseconds m_minFrameInterval;
+    std::unordered_map<MonitorId, MonitorState> m_monitors;
+};
+
+#endif // DISPLAYCONTROLLER_BRIGHTNESS_TRANSITION_H
@@ -0,0 +1,168 @@
+#include "BrightnessWriteScheduler.h"
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+
+BrightnessWriteScheduler::BrightnessWriteScheduler(int deadband)
+    : m_deadband(0)
+{
+    SetDeadband(deadband);
+}
+
+void BrightnessWriteScheduler::SetDeadband(int deadband)
+{
+    if (deadband < 0 || deadband > 100) {
+        throw std::invalid_argument("不感帯は0から100の範囲である必要があります");
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_deadband = deadband;
+}
+
+int BrightnessWriteScheduler::GetDeadband() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_deadband;
+}
+
+void BrightnessWriteScheduler::SetRetryPolicy(const RetryPolicy& policy)
+{
+    if (policy.maxRetries < 0 || policy.initialBackoff.count() < 0 || policy.maxBackoff < policy.initialBackoff) {
+        throw std::invalid_argument("不正な再送の設定が指定されました");
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_retryPolicy = policy;
+}
+
+void BrightnessWriteScheduler::Track(MonitorId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_monitors.try_emplace(id);
+}
+
+bool BrightnessWriteScheduler::Submit(MonitorId id, int brightness, bool exact)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_monitors.find(id);
+    if (it == m_monitors.end()) {
+        return false;
+    }
+
+    auto& state = it->second;
+    ++m_stats.requests;
+    if (state.pending) {
+        ++m_stats.requestsCoalesced;
+    }
+    state.pending = brightness;
+    state.pendingExact = exact;
+    // 新しい値は再送の回数を数え直す（待機時間は失敗が続く限り伸ばしたままにする）
+    state.retries = 0;
+    return true;
+}
+
+std::vector<std::pair<MonitorId, int>> BrightnessWriteScheduler::TakePendingWrites(Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<std::pair<MonitorId, int>> writes;
+    for (auto& [id, state] : m_monitors) {
+        if (!state.pending || now < state.retryAt) {
+            continue;
+        }
+
+        int target = *state.pending;
+        int deadband = state.pendingExact ? 0 : m_deadband;
+        state.pending.reset();
+        state.pendingExact = false;
+
+        if (state.lastWritten && std::abs(target - *state.lastWritten) <= deadband) {
+            ++m_stats.writesSuppressed;
+            continue;
+        }
+
+        writes.emplace_back(id, target);
+        ++m_stats.writesIssued;
+    }
+    return writes;
+}
+
+void BrightnessWriteScheduler::OnWriteCompleted(MonitorId id, int brightness, bool success, Clock::time_point now)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!success) {
+        ++m_stats.writesFailed;
+    }
+    // 送出中にForget()されたモニターの状態は作り直さない
+    auto it = m_monitors.find(id);
+    if (it == m_monitors.end()) {
+        return;
+    }
+
+    auto& state = it->second;
+    if (success) {
+        state.lastWritten = brightness;
+        state.failures = 0;
+        state.retries = 0;
+        state.retryAt = {};
+        return;
+    }
+
+    // 失敗（タイムアウトを含む）した場合はモニターの状態が不明なため、最後に書き込んだ値を忘れる
+    state.lastWritten.reset();
+    ++state.failures;
+    auto backoff = m_retryPolicy.initialBackoff;
+    for (int i = 1; i < state.failures && backoff < m_retryPolicy.maxBackoff; ++i) {
+        backoff *= 2;
+    }
+    state.retryAt = now + std::min(backoff, m_retryPolicy.maxBackoff);
+
+    // 新しい要求がなければ待機時間の後に同じ値を再送する（上限に達したら次の要求まで書き込まない）
+    if (state.pending) {
+        return;
+    }
+    if (state.retries >= m_retryPolicy.maxRetries) {
+        ++m_stats.writesAbandoned;
+        state.retries = 0;
+        return;
+    }
+    ++state.retries;
+    state.pending = brightness;
+}
+
+std::optional<BrightnessWriteScheduler::Clock::time_point> BrightnessWriteScheduler::GetNextRetryTime() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::optional<Clock::time_point> next;
+    for (const auto& [id, state] : m_monitors) {
+        if (state.pending && state.failures > 0 && (!next || state.retryAt < *next)) {
+            next = state.retryAt;
+        }
+    }
+    return next;
+}
+
+void BrightnessWriteScheduler::Forget(MonitorId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_monitors.erase(id);
+}
+
+void BrightnessWriteScheduler::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_monitors.clear();
+}
+
+std::optional<int> BrightnessWriteScheduler::GetLastWritten(MonitorId id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_monitors.find(id);
+    if (it == m_monitors.end()) {
+        return std::nullopt;
+    }
+    return it->second.lastWritten;
+}
+
+BrightnessWriteScheduler::Stats BrightnessWriteScheduler::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
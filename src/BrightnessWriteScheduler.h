@@ -0,0 +1,97 @@
+#ifndef DISPLAYCONTROLLER_BRIGHTNESS_WRITE_SCHEDULER_H
+#define DISPLAYCONTROLLER_BRIGHTNESS_WRITE_SCHEDULER_H
+
+#include "MonitorBackend.h"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 冗長なDDC/CI書き込みを省く輝度書き込みスケジューラ
+ *
+ * モニターごとに最後に書き込んだ値を保持し、不感帯（deadband）以内の変化しか
+ * ない要求は破棄します（exact を指定した要求を除く）。次の送出までに同じモニターへ複数の要求があった場合は
+ * 最新の値だけを書き込みます。
+ * 書き込みに失敗したモニターへは待機時間を倍々に伸ばしながら再送し、再送の上限に達した値は破棄します
+ * （応答しないモニターへ書き込みを繰り返さないため）。
+ * 要求を受け付けるのは Track() で登録したモニターだけです。Forget() したモニターへの要求や、
+ * 送出中に Forget() されたモニターの書き込み結果は無視します。
+ */
+class DISPLAYCONTROLLER_API BrightnessWriteScheduler {
+public:
+    struct Stats {
+        uint64_t requests = 0;            // Submit() された要求数
+        uint64_t requestsCoalesced = 0;   // 後続の要求で上書きされた要求数
+        uint64_t writesIssued = 0;        // 実際に送出した書き込み数
+        uint64_t writesSuppressed = 0;    // 不感帯以内のため省いた書き込み数
+        uint64_t writesFailed = 0;        // 失敗した書き込み数
+        uint64_t writesAbandoned = 0;     // 再送の上限に達して破棄した書き込み数
+    };
+
+    using Clock = std::chrono::steady_clock;
+
+    // 書き込みに失敗したときの再送
+    struct RetryPolicy {
+        int maxRetries = 5;                                 // 同じ値を再送する回数の上限
+        std::chrono::milliseconds initialBackoff{1000};     // 最初の再送までの待機時間（失敗が続くたびに倍に伸ばす）
+        std::chrono::milliseconds maxBackoff{60000};        // 待機時間の上限
+    };
+
+    explicit BrightnessWriteScheduler(int deadband = 1);
+
+    // 不感帯の設定（最後に書き込んだ値との差がこの値以下なら書き込まない）
+    void SetDeadband(int deadband);
+    int GetDeadband() const;
+
+    // 再送の設定
+    void SetRetryPolicy(const RetryPolicy& policy);
+
+    // 書き込み対象のモニターを登録する（登録済みの場合は何もしない）
+    void Track(MonitorId id);
+
+    /**
+     * @brief 輝度の書き込みを要求する（送出前の要求は最新の値で上書きされる）
+     * @param exact 不感帯を適用しない（遷移の最後のフレームなど、目標値を確実に書き込む場合）。
+     *              最後に書き込んだ値と同じ場合だけ省く
+     * @return 登録されていないモニターの場合はfalse（要求は破棄する）
+     */
+    bool Submit(MonitorId id, int brightness, bool exact = false);
+
+    // 送出すべき書き込みを取り出す（不感帯以内の要求はここで破棄され、再送の待機中のモニターは次回に回す）
+    std::vector<std::pair<MonitorId, int>> TakePendingWrites(Clock::time_point now = Clock::now());
+
+    // 書き込み結果を反映する（失敗した場合は待機時間の後に再送する）
+    void OnWriteCompleted(MonitorId id, int brightness, bool success, Clock::time_point now = Clock::now());
+
+    // 再送の待機中の書き込みがあれば、最も早い再送の時刻
+    std::optional<Clock::time_point> GetNextRetryTime() const;
+
+    // モニターの登録と最後に書き込んだ値を破棄する（モニター構成の変更時など）
+    void Forget(MonitorId id);
+    void Reset();
+
+    std::optional<int> GetLastWritten(MonitorId id) const;
+    Stats GetStats() const;
+
+private:
+    struct MonitorState {
+        std::optional<int> lastWritten;
+        std::optional<int> pending;
+        bool pendingExact = false;
+        int failures = 0;           // 連続して失敗した回数
+        int retries = 0;            // 保留中の値を再送した回数
+        Clock::time_point retryAt;  // この時刻までは送出しない
+    };
+
+    mutable std::mutex m_mutex;
+    int m_deadband;
+    RetryPolicy m_retryPolicy;
+    std::unordered_map<MonitorId, MonitorState> m_monitors;
+    Stats m_stats;
+};
+
+#endif // DISPLAYCONTROLLER_BRIGHTNESS_WRITE_SCHEDULER_H
@@ -0,0 +1,116 @@
+#include "ConfigDiff.h"
+
+namespace
+{
+    bool SameRange(const std::optional<MonitorBrightnessRange> &a, const std::optional<MonitorBrightnessRange> &b)
+    {
+        if (a.has_value() != b.has_value())
+        {
+            return false;
+        }
+        return !a || (a->min == b->min && a->max == b->max);
+    }
+
+    const nlohmann::json &GlobalSettingsOf(const ConfigSnapshot &snapshot, const std::string &pluginName)
+    {
+        static const nlohmann::json kEmpty = nlohmann::json::object();
+        const auto *plugin = snapshot.FindPlugin(pluginName);
+        return plugin ? plugin->globalSettings : kEmpty;
+    }
+
+    // 同じプラグイン・同じ名前のデバイスが変わっていないか
+    bool SameDevice(const ConfigSnapshot &before, const ConfigSnapshot &after, const DeviceConfig &device)
+    {
+        const auto *previous = before.FindDevice(device.pluginName, device.name);
+        return previous && previous->raw == device.raw &&
+               GlobalSettingsOf(before, device.pluginName) == GlobalSettingsOf(after, device.pluginName);
+    }
+}
+
+bool ConfigDiff::IsDeviceChanged(const std::string &pluginName, const std::string &name) const
+{
+    for (const auto &device : changedDevices)
+    {
+        if (device.pluginName == pluginName && device.name == name)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+ConfigDiff DiffConfigSnapshots(const ConfigSnapshot *before, const ConfigSnapshot &after)
+{
+    ConfigDiff diff;
+    const auto &next = after.GetDaemonSettings();
+
+    if (!before)
+    {
+        diff.updateInterval = true;
+        diff.brightnessRange = true;
+        diff.writeDeadband = true;
+        diff.transition = true;
+        diff.syncOnStartup = true;
+        diff.sensorFusion = true;
+        for (const auto &monitor : after.GetMonitors())
+        {
+            diff.changedMonitors.push_back(monitor.name);
+        }
+        for (const auto &device : after.GetDevices())
+        {
+            diff.changedDevices.push_back({device.pluginName, device.name});
+        }
+        return diff;
+    }
+
+    const auto &previous = before->GetDaemonSettings();
+    diff.updateInterval = previous.updateIntervalMs != next.updateIntervalMs;
+    diff.brightnessRange = previous.minBrightness != next.minBrightness || previous.maxBrightness != next.maxBrightness;
+    diff.writeDeadband = previous.writeDeadband != next.writeDeadband;
+    diff.transition = previous.transitionDurationMs != next.transitionDurationMs || previous.transitionCurve != next.transitionCurve;
+    diff.syncOnStartup = previous.syncOnStartup != next.syncOnStartup;
+    diff.sensorFusion = previous.fusionStrategy != next.fusionStrategy ||
+                        previous.outlierThreshold != next.outlierThreshold ||
+                        previous.maxSampleAgeMs != next.maxSampleAgeMs ||
+                        previous.sensorReadTimeoutMs != next.sensorReadTimeoutMs;
+
+    for (const auto &monitor : after.GetMonitors())
+    {
+        const auto *old = before->FindMonitor(monitor.name);
+        if (!old || !SameRange(old->brightnessRange, monitor.brightnessRange) ||
+            old->brightnessCurve != monitor.brightnessCurve || old->sensor != monitor.sensor)
+        {
+            diff.changedMonitors.push_back(monitor.name);
+        }
+    }
+    for (const auto &monitor : before->GetMonitors())
+    {
+        if (!after.FindMonitor(monitor.name))
+        {
+            diff.changedMonitors.push_back(monitor.name);
+        }
+    }
+
+    for (const auto &device : after.GetDevices())
+    {
+        // 同じ名前のデバイスが複数ある場合、インデックスに載る最初のデバイスだけを比べる
+        if (after.FindDevice(device.pluginName, device.name) != &device)
+        {
+            continue;
+        }
+        if (!SameDevice(*before, after, device))
+        {
+            diff.changedDevices.push_back({device.pluginName, device.name});
+        }
+    }
+    for (const auto &device : before->GetDevices())
+    {
+        if (before->FindDevice(device.pluginName, device.name) == &device &&
+            !after.FindDevice(device.pluginName, device.name))
+        {
+            diff.changedDevices.push_back({device.pluginName, device.name});
+        }
+    }
+
+    return diff;
+}
@@ -0,0 +1,55 @@
+#ifndef DISPLAYCONTROLLER_CONFIG_DIFF_H
+#define DISPLAYCONTROLLER_CONFIG_DIFF_H
+
+#include "ConfigSnapshot.h"
+#include <string>
+#include <vector>
+
+// 変更されたデバイス（追加・削除されたデバイスを含む）
+struct DISPLAYCONTROLLERLIB_API ChangedDevice
+{
+    std::string pluginName;
+    std::string name;
+};
+
+/**
+ * @brief 2つの設定スナップショットの差分
+ *
+ * 再読み込み時に変更のあった項目だけを反映するために使います。
+ * プラグインのglobal_settingsが変わった場合は、そのプラグインのすべてのデバイスを
+ * 変更されたものとして扱います。
+ */
+struct DISPLAYCONTROLLERLIB_API ConfigDiff
+{
+    // brightness_daemonセクション
+    bool updateInterval = false;
+    bool brightnessRange = false;
+    bool writeDeadband = false;
+    bool transition = false;
+    bool syncOnStartup = false;
+    bool sensorFusion = false;
+
+    std::vector<std::string> changedMonitors;   // 輝度範囲・カーブ・割り当てたセンサーの変更、追加・削除があったモニター名
+    std::vector<ChangedDevice> changedDevices;  // 設定ファイル上の順序
+
+    bool HasDaemonChanges() const
+    {
+        return updateInterval || brightnessRange || writeDeadband || transition || syncOnStartup || sensorFusion;
+    }
+
+    bool HasChanges() const
+    {
+        return HasDaemonChanges() || !changedMonitors.empty() || !changedDevices.empty();
+    }
+
+    bool IsDeviceChanged(const std::string &pluginName, const std::string &name) const;
+};
+
+/**
+ * @brief 設定スナップショットの差分を求める
+ * @param before 変更前のスナップショット（nullptrなら、すべての項目を変更ありとする）
+ * @param after 変更後のスナップショット
+ */
+DISPLAYCONTROLLERLIB_API ConfigDiff DiffConfigSnapshots(const ConfigSnapshot *before, const ConfigSnapshot &after);
+
+#endif // DISPLAYCONTROLLER_CONFIG_DIFF_H
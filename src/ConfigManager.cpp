@@ -1,14 +1,29 @@
 #include "ConfigManager.h"
+#include "ConfigValidation.h"
+#include "ConfigSchema.h"
+#include "AtomicFile.h"
+#include "BackupRing.h"
+#include "ConfigSourceKey.h"
 #include <common/StringUtils.h>
+#include <chrono>
 #include <fstream>
 #include <filesystem>
+#include <iterator>
+#include <utility>
+#ifdef _WIN32
 #include <shlobj.h>
 #include <windows.h>
+#else
+#include <cstdlib>
+#endif
+
+using ConfigValidation::ValidateString;
 
 namespace
 {
     std::string GetAppDataPath()
     {
+#ifdef _WIN32
         PWSTR path;
         if (FAILED(SHGetKnownFolderPath(FOLDERID_LocalAppData, 0, nullptr, &path)))
         {
@@ -17,8 +32,109 @@ namespace
         std::wstring widePath(path);
         CoTaskMemFree(path);
         std::filesystem::path basePath = StringUtils::WideToUtf8(widePath);
+#else
+        // Windows以外ではXDG Base Directoryの設定ディレクトリを使う（MonitorControllerと同じ場所）
+        std::filesystem::path basePath;
+        if (const char *configHome = std::getenv("XDG_CONFIG_HOME"); configHome && *configHome)
+        {
+            basePath = configHome;
+        }
+        else if (const char *home = std::getenv("HOME"); home && *home)
+        {
+            basePath = std::filesystem::path(home) / ".config";
+        }
+        else
+        {
+            throw ConfigException(" 設定ディレクトリのパスの取得に失敗しました ");
+        }
+#endif
         return (basePath / "DisplayController" / "Settings").string();
     }
+
+    // 元の設定上の項目とその位置（見つからない設定の詳細なエラーを組み立てるため）
+    struct RawSection
+    {
+        const nlohmann::json *value;
+        std::string path;
+    };
+
+    /**
+     * @brief 元の設定をプラグイン → global_settingsまたはデバイスの順にたどる
+     *
+     * deviceFieldがnullptrならプラグインのglobal_settingsを、そうでなければdevicesのうち
+     * deviceFieldの値がdeviceKeyのデバイスを返します。
+     * @throws ConfigException 途中の項目が見つからない場合
+     */
+    RawSection FindRawSection(const nlohmann::json &raw, const std::string &pluginName,
+                              const char *deviceField, const std::string &deviceKey)
+    {
+        std::string path = "plugins." + pluginName;
+        if (!raw.contains("plugins") || !raw["plugins"].contains(pluginName))
+        {
+            throw ConfigException(ConfigValidationResult{
+                false, path, "object", "undefined", "",
+                "プラグインが見つかりません: " + pluginName});
+        }
+        const auto &pluginConfig = raw["plugins"][pluginName];
+
+        if (!deviceField)
+        {
+            if (!pluginConfig.contains("global_settings"))
+            {
+                throw ConfigException(ConfigValidationResult{
+                    false, path + ".global_settings", "object", "undefined", "",
+                    "global_settingsセクションが見つかりません"});
+            }
+            return {&pluginConfig["global_settings"], path + ".global_settings"};
+        }
+
+        if (!pluginConfig.contains("devices"))
+        {
+            throw ConfigException(ConfigValidationResult{
+                false, path + ".devices", "array", "undefined", "",
+                "devicesセクションが見つかりません"});
+        }
+        const auto &devices = pluginConfig["devices"];
+        for (size_t i = 0; i < devices.size(); ++i)
+        {
+            const auto &device = devices[i];
+            if (device.contains(deviceField) && device[deviceField] == deviceKey)
+            {
+                return {&device, path + ".devices[" + std::to_string(i) + "]"};
+            }
+        }
+        throw ConfigException(ConfigValidationResult{
+            false, path + ".devices", "", "", deviceKey,
+            "デバイスが見つかりません: " + deviceKey});
+    }
+
+    /**
+     * @brief たどった項目から文字列の設定値を取り出す
+     * @throws ConfigException 設定値がない・nullの場合、文字列でないか空の場合
+     */
+    std::string GetRawString(const RawSection &section, const std::string &key, const std::string &missingMessage)
+    {
+        std::string path = section.path + "." + key;
+        if (!section.value->contains(key))
+        {
+            throw ConfigException(ConfigValidationResult{
+                false, path, "string", "undefined", "", missingMessage + key});
+        }
+
+        const auto &value = (*section.value)[key];
+        if (value.is_null())
+        {
+            throw ConfigException(ConfigValidationResult{
+                false, path, "string", "null", "null", "設定値がnullです: " + key});
+        }
+
+        auto result = ValidateString(value, path);
+        if (!result.isValid)
+        {
+            throw ConfigException(result);
+        }
+        return value.get<std::string>();
+    }
 }
 
 ConfigManager &ConfigManager::Instance()
@@ -51,29 +167,14 @@ void ConfigManager::CreateDefaultConfig()
         {"monitors", nlohmann::json::array()},
         {"plugins", {{"DummyLightSensor", {{"devices", nlohmann::json::array({{"id", ""}, {"name", "Dummy Sensor 1"}, {"type", "Light Sensor"}})}}}, {"SwitchBotLightSensor", {{"global_settings", {{"token", ""}, {"secret", ""}}}, {"devices", nlohmann::json::array({{"id", ""}, {"name", "SwitchBot Sensor 1"}, {"type", "Light Sensor"}})}}}}},
         {"brightness_daemon", {{"update_interval_ms", 5000}, {"min_brightness", 0}, {"max_brightness", 100}}}};
-    Save();
+    SaveLocked();
 }
 
 std::vector<std::string> ConfigManager::GetMonitorNames() const
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
+    auto snapshot = AcquireSnapshot();
 
-    std::vector<std::string> names;
-    if (m_config.contains("monitors"))
-    {
-        const auto &monitors = m_config["monitors"];
-        for (const auto &monitor : monitors)
-        {
-            if (monitor.contains("name"))
-            {
-                names.push_back(monitor["name"].get<std::string>());
-            }
-        }
-    }
-    return names;
+    return snapshot->GetMonitorNames();
 }
 
 std::string ConfigManager::GetConfigFilePath() const
@@ -83,38 +184,33 @@ std::string ConfigManager::GetConfigFilePath() const
 
 bool ConfigManager::HasMonitor(const std::string &name) const
 {
-    if (!m_isLoaded)
+    auto snapshot = m_snapshots.Acquire();
+    if (!snapshot)
     {
         return false;
     }
 
-    if (m_config.contains("monitors"))
-    {
-        const auto &monitors = m_config["monitors"];
-        for (const auto &monitor : monitors)
-        {
-            if (monitor.contains("name") && monitor["name"] == name)
-            {
-                return true;
-            }
-        }
-    }
-    return false;
+    return snapshot->FindMonitor(name) != nullptr;
 }
 
 MonitorBrightnessRange ConfigManager::GetMonitorBrightnessRange(const std::string &name) const
 {
-    if (!m_isLoaded)
+    auto snapshot = AcquireSnapshot();
+
+    // 読み込み時に検証済みの値があればそれを返し、なければ元の設定からエラーを組み立てる
+    const auto *config = snapshot->FindMonitor(name);
+    if (config && config->brightnessRange)
     {
-        throw ConfigException("設定が読み込まれていません");
+        return *config->brightnessRange;
     }
 
-    if (!m_config.contains("monitors"))
+    const auto &raw = snapshot->GetRaw();
+    if (!raw.contains("monitors"))
     {
         throw ConfigException("monitorsセクションが見つかりません");
     }
 
-    const auto &monitors = m_config["monitors"];
+    const auto &monitors = raw["monitors"];
     for (const auto &monitor : monitors)
     {
         if (monitor["name"] == name)
@@ -149,12 +245,9 @@ MonitorBrightnessRange ConfigManager::GetMonitorBrightnessRange(const std::strin
     throw ConfigException("モニターが見つかりません: " + name);
 }
 
-void ConfigManager::SetMonitorBrightnessRange(const std::string &name, const MonitorBrightnessRange &range)
+void ConfigManager::Transaction::SetMonitorBrightnessRange(const std::string &name, const MonitorBrightnessRange &range)
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
+    EnsureActive();
 
     if (!range.IsValid())
     {
@@ -175,7 +268,7 @@ void ConfigManager::SetMonitorBrightnessRange(const std::string &name, const Mon
                 {"min", range.min},
                 {"max", range.max}
             };
-            Save();
+            m_dirty = true;
             return;
         }
     }
@@ -183,12 +276,9 @@ void ConfigManager::SetMonitorBrightnessRange(const std::string &name, const Mon
     throw ConfigException("モニターが見つかりません: " + name);
 }
 
-void ConfigManager::AddMonitor(const std::string &name, const MonitorBrightnessRange &range)
+void ConfigManager::Transaction::AddMonitor(const std::string &name, const MonitorBrightnessRange &range)
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
+    EnsureActive();
 
     if (name.empty())
     {
@@ -200,14 +290,18 @@ void ConfigManager::AddMonitor(const std::string &name, const MonitorBrightnessR
         throw ConfigException("不正な輝度範囲です: min=" + std::to_string(range.min) + ", max=" + std::to_string(range.max));
     }
 
-    if (HasMonitor(name))
+    if (!m_config.contains("monitors"))
     {
-        throw ConfigException("同じ名前のモニターが既に存在します: " + name);
+        m_config["monitors"] = nlohmann::json::array();
     }
 
-    if (!m_config.contains("monitors"))
+    // 更新中の未保存の変更も含めて重複を確認する
+    for (const auto &monitor : m_config["monitors"])
     {
-        m_config["monitors"] = nlohmann::json::array();
+        if (monitor.contains("name") && monitor["name"] == name)
+        {
+            throw ConfigException("同じ名前のモニターが既に存在します: " + name);
+        }
     }
 
     nlohmann::json monitor = {
@@ -219,15 +313,12 @@ void ConfigManager::AddMonitor(const std::string &name, const MonitorBrightnessR
     };
 
     m_config["monitors"].push_back(monitor);
-    Save();
+    m_dirty = true;
 }
 
-void ConfigManager::RemoveMonitor(const std::string &name)
+void ConfigManager::Transaction::RemoveMonitor(const std::string &name)
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
+    EnsureActive();
 
     if (!m_config.contains("monitors"))
     {
@@ -240,7 +331,7 @@ void ConfigManager::RemoveMonitor(const std::string &name)
         if ((*it)["name"] == name)
         {
             monitors.erase(it);
-            Save();
+            m_dirty = true;
             return;
         }
     }
@@ -250,129 +341,25 @@ void ConfigManager::RemoveMonitor(const std::string &name)
 
 CalibrationSettings ConfigManager::GetDeviceCalibration(const std::string &deviceId) const
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
-
-    const auto &plugins = m_config["plugins"];
-    if (!plugins.contains("SwitchBotLightSensor"))
-    {
-        throw ConfigException(ConfigValidationResult{
-            false,
-            "plugins.SwitchBotLightSensor",
-            "object",
-            "undefined",
-            "",
-            "SwitchBotLightSensorプラグインが見つかりません"});
-    }
+    auto snapshot = AcquireSnapshot();
 
-    const auto &pluginConfig = plugins["SwitchBotLightSensor"];
-    if (!pluginConfig.contains("devices"))
+    // キャリブレーション設定は読み込み時に検証済み
+    if (const auto *device = snapshot->FindDeviceById("SwitchBotLightSensor", deviceId))
     {
-        throw ConfigException(ConfigValidationResult{
-            false,
-            "plugins.SwitchBotLightSensor.devices",
-            "array",
-            "undefined",
-            "",
-            "devicesセクションが見つかりません"});
-    }
-
-    const auto &devices = pluginConfig["devices"];
-    for (size_t i = 0; i < devices.size(); ++i)
-    {
-        const auto &device = devices[i];
-        if (device["id"] == deviceId)
+        if (device->calibrationError)
         {
-            std::string devicePath = "plugins.SwitchBotLightSensor.devices[" + std::to_string(i) + "]";
-            CalibrationSettings settings;
-
-            if (device.contains("calibration"))
-            {
-                const auto &calibration = device["calibration"];
-                std::string calibrationPath = devicePath + ".calibration";
-
-                try
-                {
-                    if (calibration.contains("min_raw_value"))
-                    {
-                        if (calibration["min_raw_value"].is_null())
-                        {
-                            throw ConfigException(ConfigValidationResult{
-                                false,
-                                calibrationPath + ".min_raw_value",
-                                "number",
-                                "null",
-                                "null",
-                                "min_raw_valueがnullです"});
-                        }
-                        auto result = ValidateNumber(calibration["min_raw_value"], calibrationPath + ".min_raw_value", 0, INT_MAX);
-                        if (!result.isValid)
-                            throw ConfigException(result);
-                        settings.minRawValue = calibration["min_raw_value"].get<int>();
-                    }
-
-                    if (calibration.contains("max_raw_value"))
-                    {
-                        if (calibration["max_raw_value"].is_null())
-                        {
-                            throw ConfigException(ConfigValidationResult{
-                                false,
-                                calibrationPath + ".max_raw_value",
-                                "number",
-                                "null",
-                                "null",
-                                "max_raw_valueがnullです"});
-                        }
-                        auto result = ValidateNumber(calibration["max_raw_value"], calibrationPath + ".max_raw_value", 0, INT_MAX);
-                        if (!result.isValid)
-                            throw ConfigException(result);
-                        settings.maxRawValue = calibration["max_raw_value"].get<int>();
-                    }
-                }
-                catch (const nlohmann::json::type_error &e)
-                {
-                    throw ConfigException(ConfigValidationResult{
-                        false,
-                        calibrationPath,
-                        "number",
-                        "invalid",
-                        "",
-                        "キャリブレーション設定の値が不正です: " + std::string(e.what())});
-                }
-            }
-
-            if (!settings.IsValid())
-            {
-                throw ConfigException(ConfigValidationResult{
-                    false,
-                    devicePath + ".calibration",
-                    "",
-                    "",
-                    "min_raw_value: " + std::to_string(settings.minRawValue) +
-                        ", max_raw_value: " + std::to_string(settings.maxRawValue),
-                    "不正なキャリブレーション設定です: " + deviceId});
-            }
-            return settings;
+            throw ConfigException(*device->calibrationError);
         }
+        return device->calibration;
     }
 
-    throw ConfigException(ConfigValidationResult{
-        false,
-        "plugins.SwitchBotLightSensor.devices",
-        "",
-        "",
-        deviceId,
-        "デバイスが見つかりません: " + deviceId});
+    auto device = FindRawSection(snapshot->GetRaw(), "SwitchBotLightSensor", "id", deviceId);
+    return ConfigValidation::ParseCalibration(*device.value, device.path, deviceId);
 }
 
-void ConfigManager::SetDeviceCalibration(const std::string &deviceName, const CalibrationSettings &settings)
+void ConfigManager::Transaction::SetDeviceCalibration(const std::string &deviceName, const CalibrationSettings &settings)
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
+    EnsureActive();
 
     if (!settings.IsValid())
     {
@@ -400,7 +387,7 @@ void ConfigManager::SetDeviceCalibration(const std::string &deviceName, const Ca
                         auto &calibration = device["calibration"];
                         calibration["min_raw_value"] = settings.minRawValue;
                         calibration["max_raw_value"] = settings.maxRawValue;
-                        Save();
+                        m_dirty = true;
                         return;
                     }
                 }
@@ -410,508 +397,345 @@ void ConfigManager::SetDeviceCalibration(const std::string &deviceName, const Ca
     throw ConfigException("デバイスが見つかりません: " + deviceName);
 }
 
-// バリデーションヘルパーメソッドの実装
-ConfigValidationResult ConfigManager::ValidateValue(const nlohmann::json &value,
-                                                    const std::string &path,
-                                                    const std::string &expectedType) const
+void ConfigManager::ValidateConfig(const nlohmann::json &config)
 {
-    ConfigValidationResult result;
-    result.path = path;
-    result.expectedType = expectedType;
-
-    if (expectedType == "string" && !value.is_string())
+    auto errors = ConfigSchema::Default().Validate(config);
+    if (!errors.empty())
     {
-        result.isValid = false;
-        result.actualType = value.type_name();
-        result.value = value.dump();
-        result.message = "文字列である必要があります";
+        throw ConfigException(errors);
     }
-    else if (expectedType == "number" && !value.is_number())
-    {
-        result.isValid = false;
-        result.actualType = value.type_name();
-        result.value = value.dump();
-        result.message = "数値である必要があります";
-    }
-    else if (expectedType == "object" && !value.is_object())
-    {
-        result.isValid = false;
-        result.actualType = value.type_name();
-        result.value = value.dump();
-        result.message = "オブジェクトである必要があります";
-    }
-    else if (expectedType == "array" && !value.is_array())
-    {
-        result.isValid = false;
-        result.actualType = value.type_name();
-        result.value = value.dump();
-        result.message = "配列である必要があります";
-    }
-
-    return result;
 }
 
-ConfigValidationResult ConfigManager::ValidateNumber(const nlohmann::json &value,
-                                                     const std::string &path,
-                                                     int min,
-                                                     int max) const
+void ConfigManager::Load()
 {
-    auto result = ValidateValue(value, path, "number");
-    if (!result.isValid)
-        return result;
+    using Clock = std::chrono::steady_clock;
+    auto elapsedSince = [](Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+    };
 
-    int numValue = value.get<int>();
-    if (numValue < min || numValue > max)
+    try
     {
-        result.isValid = false;
-        result.value = std::to_string(numValue);
-        result.message = std::to_string(min) + "から" + std::to_string(max) + "の範囲である必要があります";
-    }
+        auto loadStart = Clock::now();
+        LoadStats stats;
 
-    return result;
-}
+        std::string configPath = GetConfigPath();
+        if (!std::filesystem::exists(configPath))
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+            EnsureConfigDirectoryExists();
+            CreateDefaultConfig();
+            stats.total = elapsedSince(loadStart);
+            m_lastLoadStats = stats;
+            return;
+        }
 
-ConfigValidationResult ConfigManager::ValidateString(const nlohmann::json &value,
-                                                     const std::string &path,
-                                                     bool allowEmpty) const
-{
-    auto result = ValidateValue(value, path, "string");
-    if (!result.isValid)
-        return result;
+        // 更新日時は内容より先に取得する（読み込み中に更新されても、キーのハッシュは読み込んだ内容と一致する）
+        auto stageStart = Clock::now();
+        auto modifiedTime = std::filesystem::last_write_time(configPath);
+        std::ifstream file(configPath, std::ios::binary);
+        if (!file.is_open())
+        {
+            throw ConfigException("設定ファイルを開けませんでした");
+        }
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        auto sourceKey = ConfigSourceKey::Compute(content, modifiedTime);
+        stats.read = elapsedSince(stageStart);
+
+        // 公開中の設定と同じ内容（自身の保存による変更通知や、変更のない再読み込み）なら解析と検証を省略する
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+            if (m_isLoaded && m_loadedSource && *m_loadedSource == sourceKey)
+            {
+                stats.unchanged = true;
+                stats.total = elapsedSince(loadStart);
+                m_lastLoadStats = stats;
+                return;
+            }
+        }
 
-    std::string strValue = value.get<std::string>();
-    if (!allowEmpty && strValue.empty())
+        stageStart = Clock::now();
+        nlohmann::json loadedConfig = nlohmann::json::parse(content);
+
+        // 後方互換性のための移行ロジック
+        if (loadedConfig.contains("switchbot") && !loadedConfig.contains("plugins"))
+        {
+            // switchbot セクションを plugins セクションに移行
+            nlohmann::json plugins = nlohmann::json::object();
+            plugins["SwitchBotLightSensor"] = {
+                {"global_settings", {{"token", loadedConfig["switchbot"]["token"]}, {"secret", loadedConfig["switchbot"]["secret"]}}},
+                {"devices", loadedConfig["switchbot"]["devices"]}};
+            loadedConfig["plugins"] = plugins;
+            loadedConfig.erase("switchbot");
+        }
+        stats.parse = elapsedSince(stageStart);
+
+        // 検証とスナップショットの構築は公開中の設定に触れずに行い、失敗した場合は現在の設定を残す
+        stageStart = Clock::now();
+        ValidateConfig(loadedConfig);
+        stats.validate = elapsedSince(stageStart);
+
+        stageStart = Clock::now();
+        auto snapshot = std::make_shared<const ConfigSnapshot>(loadedConfig);
+        stats.snapshot = elapsedSince(stageStart);
+
+        std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+        m_config = std::move(loadedConfig);
+        m_isLoaded = true;
+        m_loadedSource = sourceKey;
+        ++m_revision;
+        m_snapshots.Publish(std::move(snapshot));
+        stats.total = elapsedSince(loadStart);
+        m_lastLoadStats = stats;
+    }
+    catch (const nlohmann::json::exception &e)
+    {
+        throw ConfigException("設定ファイルの解析に失敗しました : " + std::string(e.what()));
+    }
+    catch (const std::filesystem::filesystem_error &e)
     {
-        result.isValid = false;
-        result.value = strValue;
-        result.message = "空の文字列は許可されていません";
+        throw ConfigException("設定ファイルを読み込めませんでした : " + std::string(e.what()));
     }
+}
 
-    return result;
+void ConfigManager::EnsureLoaded()
+{
+    if (m_snapshots.Acquire())
+    {
+        return;
+    }
+    Load();
 }
 
-ConfigValidationResult ConfigManager::ValidateObject(const nlohmann::json &value,
-                                                     const std::string &path) const
+ConfigManager::LoadStats ConfigManager::GetLastLoadStats() const
 {
-    return ValidateValue(value, path, "object");
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    return m_lastLoadStats;
 }
 
-ConfigValidationResult ConfigManager::ValidateArray(const nlohmann::json &value,
-                                                    const std::string &path) const
+void ConfigManager::Save()
 {
-    return ValidateValue(value, path, "array");
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    SaveLocked();
 }
 
-void ConfigManager::ValidateConfig() const
+void ConfigManager::SaveLocked()
 {
-    // monitorsセクションの検証（オプショナル）
-    if (m_config.contains("monitors"))
+    try
     {
-        auto result = ValidateArray(m_config["monitors"], "monitors");
-        if (!result.isValid)
-            throw ConfigException(result);
-
-        const auto &monitors = m_config["monitors"];
-        for (size_t i = 0; i < monitors.size(); ++i)
-        {
-            const auto &monitor = monitors[i];
-            std::string monitorPath = "monitors[" + std::to_string(i) + "]";
-
-            // nameフィールドの検証
-            if (!monitor.contains("name"))
-            {
-                throw ConfigException(ConfigValidationResult{
-                    false, monitorPath + ".name", "string", "undefined", "",
-                    "モニター名が指定されていません"});
-            }
-            auto nameResult = ValidateString(monitor["name"], monitorPath + ".name");
-            if (!nameResult.isValid)
-                throw ConfigException(nameResult);
-
-            // brightness_rangeの検証
-            if (!monitor.contains("brightness_range"))
-            {
-                throw ConfigException(ConfigValidationResult{
-                    false, monitorPath + ".brightness_range", "object", "undefined", "",
-                    "brightness_rangeが指定されていません"});
-            }
-            auto rangeResult = ValidateObject(monitor["brightness_range"], monitorPath + ".brightness_range");
-            if (!rangeResult.isValid)
-                throw ConfigException(rangeResult);
-
-            const auto &range = monitor["brightness_range"];
-            std::string rangePath = monitorPath + ".brightness_range";
-
-            // minの検証
-            if (!range.contains("min"))
-            {
-                throw ConfigException(ConfigValidationResult{
-                    false, rangePath + ".min", "number", "undefined", "",
-                    "最小輝度が指定されていません"});
-            }
-            auto minResult = ValidateNumber(range["min"], rangePath + ".min", 0, 100);
-            if (!minResult.isValid)
-                throw ConfigException(minResult);
+        EnsureConfigDirectoryExists();
+        // 書き込み中に停止しても設定ファイルが壊れないよう、一時ファイルから置き換える
+        std::string content = m_config.dump(2);
+        WriteFileAtomically(GetConfigPath(), content);
+        m_isLoaded = true;
 
-            // maxの検証
-            if (!range.contains("max"))
-            {
-                throw ConfigException(ConfigValidationResult{
-                    false, rangePath + ".max", "number", "undefined", "",
-                    "最大輝度が指定されていません"});
-            }
-            auto maxResult = ValidateNumber(range["max"], rangePath + ".max", 0, 100);
-            if (!maxResult.isValid)
-                throw ConfigException(maxResult);
-
-            // min <= maxの検証
-            int minBrightness = range["min"].get<int>();
-            int maxBrightness = range["max"].get<int>();
-            if (minBrightness > maxBrightness)
-            {
-                throw ConfigException(ConfigValidationResult{
-                    false, rangePath, "", "",
-                    "min: " + std::to_string(minBrightness) + ", max: " + std::to_string(maxBrightness),
-                    "最小輝度は最大輝度以下である必要があります"});
-            }
-        }
+        // 保存した内容を記録し、この保存による変更通知での再読み込みを省略する
+        std::error_code error;
+        auto modifiedTime = std::filesystem::last_write_time(GetConfigPath(), error);
+        m_loadedSource = error ? std::nullopt : std::optional(ConfigSourceKey::Compute(content, modifiedTime));
+        ++m_revision;
+        m_snapshots.Publish(std::make_shared<const ConfigSnapshot>(m_config));
     }
-
-    // プラグインセクションの検証
-    if (!m_config.contains("plugins"))
+    catch (const nlohmann::json::exception &e)
     {
-        throw ConfigException(ConfigValidationResult{
-            false, "plugins", "object", "undefined", "",
-            "設定ファイルにpluginsセクションがありません"});
+        throw ConfigException("設定ファイルの書き込みに失敗しました : " + std::string(e.what()));
     }
-
-    const auto &plugins = m_config["plugins"];
-    for (auto &[pluginName, pluginConfig] : plugins.items())
+    catch (const std::system_error &e)
     {
-        std::string pluginPath = "plugins." + pluginName;
-
-        // プラグイン設定の基本構造を検証
-        if (!pluginConfig.contains("devices") && !pluginConfig.contains("global_settings"))
-        {
-            throw ConfigException(ConfigValidationResult{
-                false, pluginPath, "", "", "",
-                "devices または global_settings セクションがありません"});
-        }
-
-        // global_settingsの検証
-        if (pluginConfig.contains("global_settings"))
-        {
-            auto result = ValidateObject(pluginConfig["global_settings"], pluginPath + ".global_settings");
-            if (!result.isValid)
-                throw ConfigException(result);
-        }
-
-        // devicesの検証
-        if (pluginConfig.contains("devices"))
-        {
-            auto result = ValidateArray(pluginConfig["devices"], pluginPath + ".devices");
-            if (!result.isValid)
-                throw ConfigException(result);
-
-            const auto &devices = pluginConfig["devices"];
-            for (size_t i = 0; i < devices.size(); ++i)
-            {
-                const auto &device = devices[i];
-                std::string devicePath = pluginPath + ".devices[" + std::to_string(i) + "]";
-
-                // 必須フィールドの存在チェック
-                for (const auto &field : {"id", "name", "type"})
-                {
-                    if (!device.contains(field))
-                    {
-                        throw ConfigException(ConfigValidationResult{
-                            false, devicePath + "." + field, "string", "undefined", "",
-                            std::string(field) + "が指定されていません"});
-                    }
-                }
-
-                // 各フィールドの型と値の検証
-                auto idResult = ValidateString(device["id"], devicePath + ".id");
-                if (!idResult.isValid)
-                    throw ConfigException(idResult);
-
-                auto nameResult = ValidateString(device["name"], devicePath + ".name");
-                if (!nameResult.isValid)
-                    throw ConfigException(nameResult);
-
-                auto typeResult = ValidateString(device["type"], devicePath + ".type");
-                if (!typeResult.isValid)
-                    throw ConfigException(typeResult);
-
-                if (device.contains("description"))
-                {
-                    auto descResult = ValidateString(device["description"], devicePath + ".description", true);
-                    if (!descResult.isValid)
-                        throw ConfigException(descResult);
-                }
-            }
-        }
+        throw ConfigException("設定ファイルの書き込みに失敗しました : " + std::string(e.what()));
     }
+}
 
-    // brightness_daemonセクションの検証
-    if (!m_config.contains("brightness_daemon"))
+ConfigManager::Transaction ConfigManager::BeginUpdate()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    if (!m_isLoaded)
     {
-        throw ConfigException(ConfigValidationResult{
-            false, "brightness_daemon", "object", "undefined", "",
-            "設定ファイルにbrightness_daemonセクションがありません"});
+        throw ConfigException("設定が読み込まれていません");
     }
+    return Transaction(*this, m_config, m_revision);
+}
 
-    const auto &brightness = m_config["brightness_daemon"];
-    std::string brightnessPath = "brightness_daemon";
-
-    // update_interval_msの検証
-    if (!brightness.contains("update_interval_ms"))
+void ConfigManager::CommitUpdate(nlohmann::json config, uint64_t baseRevision)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    if (m_revision != baseRevision)
     {
-        throw ConfigException(ConfigValidationResult{
-            false, brightnessPath + ".update_interval_ms", "number", "undefined", "",
-            "update_interval_msが設定されていません"});
+        throw ConfigException("更新の開始後に設定が変更されたため、変更を保存できません");
     }
-    auto intervalResult = ValidateNumber(brightness["update_interval_ms"], brightnessPath + ".update_interval_ms", 1000, INT_MAX);
-    if (!intervalResult.isValid)
-        throw ConfigException(intervalResult);
 
-    // min_brightnessの検証
-    if (!brightness.contains("min_brightness"))
+    // 保存できなかった場合は作業コピーを元に戻し、設定ファイルと公開中の設定を変更前のまま残す
+    auto previous = std::move(m_config);
+    m_config = std::move(config);
+    try
     {
-        throw ConfigException(ConfigValidationResult{
-            false, brightnessPath + ".min_brightness", "number", "undefined", "",
-            "min_brightnessが設定されていません"});
+        SaveLocked();
     }
-    auto minResult = ValidateNumber(brightness["min_brightness"], brightnessPath + ".min_brightness", 0, 100);
-    if (!minResult.isValid)
-        throw ConfigException(minResult);
-
-    // max_brightnessの検証
-    if (!brightness.contains("max_brightness"))
+    catch (...)
     {
-        throw ConfigException(ConfigValidationResult{
-            false, brightnessPath + ".max_brightness", "number", "undefined", "",
-            "max_brightnessが設定されていません"});
+        m_config = std::move(previous);
+        throw;
     }
-    auto maxResult = ValidateNumber(brightness["max_brightness"], brightnessPath + ".max_brightness", 0, 100);
-    if (!maxResult.isValid)
-        throw ConfigException(maxResult);
+}
 
-    // min_brightness <= max_brightnessの検証
-    int minBrightness = brightness["min_brightness"].get<int>();
-    int maxBrightness = brightness["max_brightness"].get<int>();
-    if (minBrightness > maxBrightness)
-    {
-        throw ConfigException(ConfigValidationResult{
-            false, brightnessPath, "", "",
-            "min_brightness: " + std::to_string(minBrightness) + ", max_brightness: " + std::to_string(maxBrightness),
-            "min_brightnessはmax_brightness以下である必要があります"});
-    }
+// 単独の変更も更新として行う（ロックを保持したまま開始と確定を行うため、他の変更とは競合しない）
+void ConfigManager::SetUpdateInterval(int interval_ms)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    auto update = BeginUpdate();
+    update.SetUpdateInterval(interval_ms);
+    update.Commit();
 }
 
-void ConfigManager::Load()
+void ConfigManager::SetMinBrightness(int value)
 {
-    try
-    {
-        std::string configPath = GetConfigPath();
-        if (!std::filesystem::exists(configPath))
-        {
-            EnsureConfigDirectoryExists();
-            CreateDefaultConfig();
-            return;
-        }
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    auto update = BeginUpdate();
+    update.SetMinBrightness(value);
+    update.Commit();
+}
 
-        std::ifstream file(configPath);
-        if (!file.is_open())
-        {
-            throw ConfigException("設定ファイルを開けませんでした");
-        }
+void ConfigManager::SetMaxBrightness(int value)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    auto update = BeginUpdate();
+    update.SetMaxBrightness(value);
+    update.Commit();
+}
 
-        nlohmann::json loadedConfig;
-        file >> loadedConfig;
+void ConfigManager::SetDeviceCalibration(const std::string &deviceName, const CalibrationSettings &settings)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    auto update = BeginUpdate();
+    update.SetDeviceCalibration(deviceName, settings);
+    update.Commit();
+}
 
-        // 後方互換性のための移行ロジック
-        if (loadedConfig.contains("switchbot") && !loadedConfig.contains("plugins"))
-        {
-            // switchbot セクションを plugins セクションに移行
-            nlohmann::json plugins = nlohmann::json::object();
-            plugins["SwitchBotLightSensor"] = {
-                {"global_settings", {{"token", loadedConfig["switchbot"]["token"]}, {"secret", loadedConfig["switchbot"]["secret"]}}},
-                {"devices", loadedConfig["switchbot"]["devices"]}};
-            loadedConfig["plugins"] = plugins;
-            loadedConfig.erase("switchbot");
-        }
+void ConfigManager::SetMonitorBrightnessRange(const std::string &name, const MonitorBrightnessRange &range)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    auto update = BeginUpdate();
+    update.SetMonitorBrightnessRange(name, range);
+    update.Commit();
+}
 
-        m_config = loadedConfig;
-        ValidateConfig();
-        m_isLoaded = true;
-    }
-    catch (const nlohmann::json::exception &e)
+void ConfigManager::AddMonitor(const std::string &name, const MonitorBrightnessRange &range)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    auto update = BeginUpdate();
+    update.AddMonitor(name, range);
+    update.Commit();
+}
+
+void ConfigManager::RemoveMonitor(const std::string &name)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    auto update = BeginUpdate();
+    update.RemoveMonitor(name);
+    update.Commit();
+}
+
+void ConfigManager::AddDevice(const std::string &pluginName, const std::string &id, const std::string &name, const std::string &type, const std::string &description)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+    auto update = BeginUpdate();
+    update.AddDevice(pluginName, id, name, type, description);
+    update.Commit();
+}
+
+ConfigManager::Transaction::Transaction(ConfigManager &manager, nlohmann::json config, uint64_t baseRevision)
+    : m_manager(&manager), m_config(std::move(config)), m_baseRevision(baseRevision)
+{
+}
+
+ConfigManager::Transaction::Transaction(Transaction &&other) noexcept
+    : m_manager(std::exchange(other.m_manager, nullptr)),
+      m_config(std::move(other.m_config)),
+      m_baseRevision(other.m_baseRevision),
+      m_dirty(other.m_dirty)
+{
+}
+
+void ConfigManager::Transaction::EnsureActive() const
+{
+    if (!m_manager)
     {
-        throw ConfigException("設定ファイルの解析に失敗しました : " + std::string(e.what()));
+        throw ConfigException("設定の更新は既に終了しています");
     }
 }
 
-void ConfigManager::Save()
+bool ConfigManager::Transaction::HasMonitor(const std::string &name) const
 {
-    try
+    EnsureActive();
+    if (!m_config.contains("monitors"))
     {
-        EnsureConfigDirectoryExists();
-        std::ofstream file(GetConfigPath());
-        if (!file.is_open())
+        return false;
+    }
+    for (const auto &monitor : m_config["monitors"])
+    {
+        if (monitor.contains("name") && monitor["name"] == name)
         {
-            throw ConfigException("設定ファイルを書き込み用に開けませんでした");
+            return true;
         }
-
-        file << m_config.dump(2);
-        m_isLoaded = true;
     }
-    catch (const nlohmann::json::exception &e)
+    return false;
+}
+
+void ConfigManager::Transaction::Commit()
+{
+    EnsureActive();
+    // 保存の成否にかかわらず更新は終了する
+    auto *manager = std::exchange(m_manager, nullptr);
+    if (m_dirty)
     {
-        throw ConfigException("設定ファイルの書き込みに失敗しました : " + std::string(e.what()));
+        manager->CommitUpdate(std::move(m_config), m_baseRevision);
     }
 }
 
-std::string ConfigManager::GetPluginConfig(const std::string &pluginName, const std::string &key, const std::string &deviceName) const
+void ConfigManager::Transaction::Rollback()
 {
-    if (!m_isLoaded)
+    EnsureActive();
+    m_manager = nullptr;
+    m_config = nlohmann::json();
+}
+
+std::shared_ptr<const ConfigSnapshot> ConfigManager::AcquireSnapshot() const
+{
+    auto snapshot = m_snapshots.Acquire();
+    if (!snapshot)
     {
         throw ConfigException("設定が読み込まれていません");
     }
+    return snapshot;
+}
 
-    const auto &plugins = m_config["plugins"];
-    if (!plugins.contains(pluginName))
+std::shared_ptr<const ConfigSnapshot> ConfigManager::GetSnapshot() const
+{
+    return AcquireSnapshot();
+}
+
+std::string ConfigManager::GetPluginConfig(const std::string &pluginName, const std::string &key, const std::string &deviceName) const
+{
+    auto snapshot = AcquireSnapshot();
+
+    if (const auto *value = snapshot->FindPluginSetting(pluginName, key, deviceName))
     {
-        throw ConfigException(ConfigValidationResult{
-            false,
-            "plugins." + pluginName,
-            "object",
-            "undefined",
-            "",
-            "プラグインが見つかりません: " + pluginName});
+        return *value;
     }
 
-    const auto &pluginConfig = plugins[pluginName];
-    std::string basePath = "plugins." + pluginName;
-
+    // 見つからない場合は元の設定をたどって詳細なエラーを組み立てる
     try
     {
         if (deviceName.empty())
         {
-            // グローバル設定の取得
-            if (!pluginConfig.contains("global_settings"))
-            {
-                throw ConfigException(ConfigValidationResult{
-                    false,
-                    basePath + ".global_settings",
-                    "object",
-                    "undefined",
-                    "",
-                    "global_settingsセクションが見つかりません"});
-            }
-
-            const auto &globalSettings = pluginConfig["global_settings"];
-            if (!globalSettings.contains(key))
-            {
-                throw ConfigException(ConfigValidationResult{
-                    false,
-                    basePath + ".global_settings." + key,
-                    "string",
-                    "undefined",
-                    "",
-                    "グローバル設定が見つかりません: " + key});
-            }
-
-            const auto &value = globalSettings[key];
-            if (value.is_null())
-            {
-                throw ConfigException(ConfigValidationResult{
-                    false,
-                    basePath + ".global_settings." + key,
-                    "string",
-                    "null",
-                    "null",
-                    "設定値がnullです: " + key});
-            }
-
-            auto result = ValidateString(value, basePath + ".global_settings." + key);
-            if (!result.isValid)
-            {
-                throw ConfigException(result);
-            }
-
-            return value.get<std::string>();
-        }
-        else
-        {
-            // デバイス設定の取得
-            if (!pluginConfig.contains("devices"))
-            {
-                throw ConfigException(ConfigValidationResult{
-                    false,
-                    basePath + ".devices",
-                    "array",
-                    "undefined",
-                    "",
-                    "devicesセクションが見つかりません"});
-            }
-
-            const auto &devices = pluginConfig["devices"];
-            for (size_t i = 0; i < devices.size(); ++i)
-            {
-                const auto &device = devices[i];
-                if (device["name"] == deviceName)
-                {
-                    std::string devicePath = basePath + ".devices[" + std::to_string(i) + "]";
-
-                    if (!device.contains(key))
-                    {
-                        throw ConfigException(ConfigValidationResult{
-                            false,
-                            devicePath + "." + key,
-                            "string",
-                            "undefined",
-                            "",
-                            "デバイス設定が見つかりません: " + key});
-                    }
-
-                    const auto &value = device[key];
-                    if (value.is_null())
-                    {
-                        throw ConfigException(ConfigValidationResult{
-                            false,
-                            devicePath + "." + key,
-                            "string",
-                            "null",
-                            "null",
-                            "設定値がnullです: " + key});
-                    }
-
-                    auto result = ValidateString(value, devicePath + "." + key);
-                    if (!result.isValid)
-                    {
-                        throw ConfigException(result);
-                    }
-
-                    return value.get<std::string>();
-                }
-            }
-
-            throw ConfigException(ConfigValidationResult{
-                false,
-                basePath + ".devices",
-                "",
-                "",
-                deviceName,
-                "デバイスが見つかりません: " + deviceName});
+            auto section = FindRawSection(snapshot->GetRaw(), pluginName, nullptr, {});
+            return GetRawString(section, key, "グローバル設定が見つかりません: ");
         }
+        auto section = FindRawSection(snapshot->GetRaw(), pluginName, "name", deviceName);
+        return GetRawString(section, key, "デバイス設定が見つかりません: ");
     }
     catch (const nlohmann::json::type_error &e)
     {
-        std::string path = deviceName.empty()
-                               ? basePath + ".global_settings." + key
-                               : basePath + ".devices[?]." + key;
-
+        std::string path = "plugins." + pluginName + (deviceName.empty() ? ".global_settings." : ".devices[?].") + key;
         throw ConfigException(ConfigValidationResult{
             false,
             path,
@@ -922,8 +746,9 @@ std::string ConfigManager::GetPluginConfig(const std::string &pluginName, const
     }
 }
 
-void ConfigManager::AddDevice(const std::string &pluginName, const std::string &id, const std::string &name, const std::string &type, const std::string &description)
+void ConfigManager::Transaction::AddDevice(const std::string &pluginName, const std::string &id, const std::string &name, const std::string &type, const std::string &description)
 {
+    EnsureActive();
     if (pluginName.empty())
     {
         throw ConfigException("プラグイン名を指定してください");
@@ -977,124 +802,86 @@ void ConfigManager::AddDevice(const std::string &pluginName, const std::string &
     }
 
     devices.push_back(device);
-    Save();
+    m_dirty = true;
 }
 
-std::vector<nlohmann::json> ConfigManager::GetDevicesByType(const std::string &type) const
+nlohmann::json ConfigManager::GetPluginGlobalSettings(const std::string &pluginName) const
 {
-    if (!m_isLoaded)
+    auto snapshot = AcquireSnapshot();
+
+    const auto *plugin = snapshot->FindPlugin(pluginName);
+    if (!plugin)
     {
-        throw ConfigException("設定が読み込まれていません");
+        throw ConfigException("プラグインが見つかりません: " + pluginName);
     }
+    return plugin->globalSettings;
+}
 
+std::vector<nlohmann::json> ConfigManager::GetDevicesByType(const std::string &type) const
+{
+    auto snapshot = AcquireSnapshot();
+
+    const auto &devices = snapshot->GetDevicesByType(type);
     std::vector<nlohmann::json> result;
-    const auto &plugins = m_config["plugins"];
-    for (const auto &[pluginName, pluginConfig] : plugins.items())
+    result.reserve(devices.size());
+    for (const auto *device : devices)
     {
-        if (pluginConfig.contains("devices"))
-        {
-            const auto &devices = pluginConfig["devices"];
-            for (const auto &device : devices)
-            {
-                if (device["type"] == type)
-                {
-                    result.push_back(device);
-                }
-            }
-        }
+        result.push_back(device->raw);
     }
     return result;
 }
 
 nlohmann::json ConfigManager::GetFirstDeviceByType(const std::string &type) const
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
+    auto snapshot = AcquireSnapshot();
 
-    const auto &plugins = m_config["plugins"];
-    for (const auto &[pluginName, pluginConfig] : plugins.items())
+    const auto &devices = snapshot->GetDevicesByType(type);
+    if (devices.empty())
     {
-        if (pluginConfig.contains("devices"))
-        {
-            const auto &devices = pluginConfig["devices"];
-            for (const auto &device : devices)
-            {
-                if (device["type"] == type)
-                {
-                    return device;
-                }
-            }
-        }
+        throw ConfigException("指定されたタイプのデバイスが見つかりません : " + type);
     }
-    throw ConfigException("指定されたタイプのデバイスが見つかりません : " + type);
+    return devices.front()->raw;
 }
 
 bool ConfigManager::HasDevice(const std::string &name) const
 {
-    if (!m_isLoaded)
+    auto snapshot = m_snapshots.Acquire();
+    if (!snapshot)
     {
         return false;
     }
 
-    const auto &plugins = m_config["plugins"];
-    for (const auto &[pluginName, pluginConfig] : plugins.items())
-    {
-        if (pluginConfig.contains("devices"))
-        {
-            const auto &devices = pluginConfig["devices"];
-            for (const auto &device : devices)
-            {
-                if (device["name"] == name)
-                {
-                    return true;
-                }
-            }
-        }
-    }
-    return false;
+    return snapshot->FindDeviceByName(name) != nullptr;
 }
 
 bool ConfigManager::HasDeviceType(const std::string &type) const
 {
-    if (!m_isLoaded)
+    auto snapshot = m_snapshots.Acquire();
+    if (!snapshot)
     {
         return false;
     }
 
-    const auto &plugins = m_config["plugins"];
-    for (const auto &[pluginName, pluginConfig] : plugins.items())
-    {
-        if (pluginConfig.contains("devices"))
-        {
-            const auto &devices = pluginConfig["devices"];
-            for (const auto &device : devices)
-            {
-                if (device["type"] == type)
-                {
-                    return true;
-                }
-            }
-        }
-    }
-    return false;
+    return !snapshot->GetDevicesByType(type).empty();
 }
 
 // 同期設定
 bool ConfigManager::GetSyncOnStartup() const
 {
- if (!m_isLoaded)
+ auto snapshot = AcquireSnapshot();
+
+ if (auto value = snapshot->GetDaemonSettings().syncOnStartup)
  {
-  throw ConfigException("設定が読み込まれていません");
+  return *value;
  }
 
- if (!m_config.contains("brightness_daemon"))
+ const auto &raw = snapshot->GetRaw();
+ if (!raw.contains("brightness_daemon"))
  {
   throw ConfigException("brightness_daemonセクションが見つかりません");
  }
 
- const auto &brightness = m_config["brightness_daemon"];
+ const auto &brightness = raw["brightness_daemon"];
  if (!brightness.contains("sync_on_startup"))
  {
   return false; // デフォルト値はfalse
@@ -1111,21 +898,143 @@ bool ConfigManager::GetSyncOnStartup() const
  }
 }
 
+int ConfigManager::GetWriteDeadband() const
+{
+    auto snapshot = AcquireSnapshot();
+
+    if (auto value = snapshot->GetDaemonSettings().writeDeadband)
+    {
+        return *value;
+    }
+
+    const auto &raw = snapshot->GetRaw();
+    if (!raw.contains("brightness_daemon"))
+    {
+        throw ConfigException("brightness_daemonセクションが見つかりません");
+    }
+
+    const auto &brightness = raw["brightness_daemon"];
+    if (!brightness.contains("write_deadband"))
+    {
+        return 1; // デフォルト値
+    }
+
+    try
+    {
+        return brightness["write_deadband"].get<int>();
+    }
+    catch (const nlohmann::json::exception &e)
+    {
+        throw ConfigException("write_deadbandの値が不正です: " + std::string(e.what()));
+    }
+}
+
+int ConfigManager::GetTransitionDuration() const
+{
+    auto snapshot = AcquireSnapshot();
+
+    if (auto value = snapshot->GetDaemonSettings().transitionDurationMs)
+    {
+        return *value;
+    }
+
+    const auto &raw = snapshot->GetRaw();
+    if (!raw.contains("brightness_daemon"))
+    {
+        throw ConfigException("brightness_daemonセクションが見つかりません");
+    }
+
+    const auto &brightness = raw["brightness_daemon"];
+    if (!brightness.contains("transition_duration_ms"))
+    {
+        return 1000; // デフォルト値
+    }
+
+    try
+    {
+        return brightness["transition_duration_ms"].get<int>();
+    }
+    catch (const nlohmann::json::exception &e)
+    {
+        throw ConfigException("transition_duration_msの値が不正です: " + std::string(e.what()));
+    }
+}
+
+EasingCurve ConfigManager::GetTransitionCurve() const
+{
+    auto snapshot = AcquireSnapshot();
+
+    if (auto value = snapshot->GetDaemonSettings().transitionCurve)
+    {
+        return *value;
+    }
+
+    const auto &raw = snapshot->GetRaw();
+    if (!raw.contains("brightness_daemon"))
+    {
+        throw ConfigException("brightness_daemonセクションが見つかりません");
+    }
+
+    const auto &brightness = raw["brightness_daemon"];
+    if (!brightness.contains("transition_curve"))
+    {
+        return EasingCurve::EaseInOut; // デフォルト値
+    }
+
+    try
+    {
+        return BrightnessTransitionEngine::ParseEasingCurve(brightness["transition_curve"].get<std::string>());
+    }
+    catch (const std::exception &e)
+    {
+        throw ConfigException("transition_curveの値が不正です: " + std::string(e.what()));
+    }
+}
+
+SensorFusion::Options ConfigManager::GetSensorFusionOptions() const
+{
+    auto snapshot = AcquireSnapshot();
+    const auto &daemon = snapshot->GetDaemonSettings();
+
+    // 値の範囲は読み込み時にスキーマで検証済み
+    SensorFusion::Options options;
+    if (daemon.fusionStrategy)
+    {
+        options.strategy = *daemon.fusionStrategy;
+    }
+    if (daemon.outlierThreshold)
+    {
+        options.outlierThreshold = *daemon.outlierThreshold;
+    }
+    if (daemon.maxSampleAgeMs)
+    {
+        options.maxSampleAge = std::chrono::milliseconds(*daemon.maxSampleAgeMs);
+    }
+    if (daemon.sensorReadTimeoutMs)
+    {
+        options.readTimeout = std::chrono::milliseconds(*daemon.sensorReadTimeoutMs);
+    }
+    return options;
+}
+
 // ここから不足していた実装を追加
 
 int ConfigManager::GetUpdateInterval() const
 {
-    if (!m_isLoaded)
+    auto snapshot = AcquireSnapshot();
+
+    if (auto value = snapshot->GetDaemonSettings().updateIntervalMs)
     {
-        throw ConfigException("設定が読み込まれていません");
+        return *value;
     }
 
-    if (!m_config.contains("brightness_daemon"))
+    const auto &raw = snapshot->GetRaw();
+    if (!raw.contains("brightness_daemon"))
     {
         throw ConfigException("brightness_daemonセクションが見つかりません");
     }
 
-    const auto &brightness = m_config["brightness_daemon"];
+    const auto &brightness = raw["brightness_daemon"];
     if (!brightness.contains("update_interval_ms"))
     {
         throw ConfigException("update_interval_msが設定されていません");
@@ -1141,12 +1050,9 @@ int ConfigManager::GetUpdateInterval() const
     }
 }
 
-void ConfigManager::SetUpdateInterval(int interval_ms)
+void ConfigManager::Transaction::SetUpdateInterval(int interval_ms)
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
+    EnsureActive();
 
     if (interval_ms < 1000)
     {
@@ -1154,22 +1060,26 @@ void ConfigManager::SetUpdateInterval(int interval_ms)
     }
 
     m_config["brightness_daemon"]["update_interval_ms"] = interval_ms;
-    Save();
+    m_dirty = true;
 }
 
 int ConfigManager::GetMinBrightness() const
 {
-    if (!m_isLoaded)
+    auto snapshot = AcquireSnapshot();
+
+    auto value = snapshot->GetDaemonSettings().minBrightness;
+    if (value && *value >= 0 && *value <= 100)
     {
-        throw ConfigException("設定が読み込まれていません");
+        return *value;
     }
 
-    if (!m_config.contains("brightness_daemon"))
+    const auto &raw = snapshot->GetRaw();
+    if (!raw.contains("brightness_daemon"))
     {
         throw ConfigException("brightness_daemonセクションが見つかりません");
     }
 
-    const auto &brightness = m_config["brightness_daemon"];
+    const auto &brightness = raw["brightness_daemon"];
     if (!brightness.contains("min_brightness"))
     {
         throw ConfigException("min_brightnessが設定されていません");
@@ -1190,12 +1100,9 @@ int ConfigManager::GetMinBrightness() const
     }
 }
 
-void ConfigManager::SetMinBrightness(int value)
+void ConfigManager::Transaction::SetMinBrightness(int value)
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
+    EnsureActive();
 
     if (value < 0 || value > 100)
     {
@@ -1208,22 +1115,26 @@ void ConfigManager::SetMinBrightness(int value)
     }
 
     m_config["brightness_daemon"]["min_brightness"] = value;
-    Save();
+    m_dirty = true;
 }
 
 int ConfigManager::GetMaxBrightness() const
 {
-    if (!m_isLoaded)
+    auto snapshot = AcquireSnapshot();
+
+    auto value = snapshot->GetDaemonSettings().maxBrightness;
+    if (value && *value >= 0 && *value <= 100)
     {
-        throw ConfigException("設定が読み込まれていません");
+        return *value;
     }
 
-    if (!m_config.contains("brightness_daemon"))
+    const auto &raw = snapshot->GetRaw();
+    if (!raw.contains("brightness_daemon"))
     {
         throw ConfigException("brightness_daemonセクションが見つかりません");
     }
 
-    const auto &brightness = m_config["brightness_daemon"];
+    const auto &brightness = raw["brightness_daemon"];
     if (!brightness.contains("max_brightness"))
     {
         throw ConfigException("max_brightnessが設定されていません");
@@ -1244,12 +1155,9 @@ int ConfigManager::GetMaxBrightness() const
     }
 }
 
-void ConfigManager::SetMaxBrightness(int value)
+void ConfigManager::Transaction::SetMaxBrightness(int value)
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
+    EnsureActive();
 
     if (value < 0 || value > 100)
     {
@@ -1262,7 +1170,7 @@ void ConfigManager::SetMaxBrightness(int value)
     }
 
     m_config["brightness_daemon"]["max_brightness"] = value;
-    Save();
+    m_dirty = true;
 }
 
 nlohmann::json ConfigManager::CreateDefaultMonitorConfig(const std::string& name) const
@@ -1278,24 +1186,12 @@ nlohmann::json ConfigManager::CreateDefaultMonitorConfig(const std::string& name
 
 void ConfigManager::CreateBackup() const
 {
-    if (!m_isLoaded)
-    {
-        throw ConfigException("設定が読み込まれていません");
-    }
+    auto snapshot = AcquireSnapshot();
 
     try
     {
-        std::filesystem::path backupPath = GetBackupPath();
-        std::filesystem::create_directories(backupPath.parent_path());
-
-        std::ofstream backupFile(backupPath);
-        if (!backupFile.is_open())
-        {
-            throw ConfigException("バックアップファイルを作成できませんでした: " + backupPath.string());
-        }
-
-        backupFile << m_config.dump(2);
-        backupFile.close();
+        BackupRing backups(GetConfigPath(), MAX_BACKUPS);
+        backups.Create(snapshot->GetRaw().dump(2));
     }
     catch (const std::exception& e)
     {
@@ -1303,59 +1199,56 @@ void ConfigManager::CreateBackup() const
     }
 }
 
-std::string ConfigManager::GetBackupPath() const
-{
-    std::filesystem::path configPath = GetConfigPath();
-    std::time_t now = std::time(nullptr);
-    std::stringstream ss;
-    ss << configPath.stem().string() << "_backup_"
-       << std::put_time(std::localtime(&now), "%Y%m%d_%H%M%S")
-       << configPath.extension().string();
-    return (configPath.parent_path() / ss.str()).string();
-}
-
 void ConfigManager::RestoreFromBackup()
 {
-    std::filesystem::path configDir = std::filesystem::path(GetConfigPath()).parent_path();
-    std::vector<std::filesystem::path> backupFiles;
-
-    // バックアップファイルを検索
-    for (const auto& entry : std::filesystem::directory_iterator(configDir))
-    {
-        if (entry.path().filename().string().find("_backup_") != std::string::npos)
-        {
-            backupFiles.push_back(entry.path());
-        }
-    }
-
+    BackupRing backups(GetConfigPath(), MAX_BACKUPS);
+    auto backupFiles = backups.List();
     if (backupFiles.empty())
     {
         throw ConfigException("利用可能なバックアップファイルが見つかりません");
     }
 
-    // 最新のバックアップファイルを使用
-    std::sort(backupFiles.begin(), backupFiles.end(), std::greater<>());
-    std::filesystem::path latestBackup = backupFiles[0];
-
-    try
+    // 新しいバックアップから順に、読み込めて検証を通るものを使用する
+    std::string lastError;
+    for (const auto &backupPath : backupFiles)
     {
-        std::ifstream backupFile(latestBackup);
-        if (!backupFile.is_open())
+        nlohmann::json backupConfig;
+        try
+        {
+            std::ifstream backupFile(backupPath);
+            if (!backupFile.is_open())
+            {
+                throw ConfigException("バックアップファイルを開けませんでした: " + backupPath.string());
+            }
+
+            backupConfig = nlohmann::json::parse(backupFile);
+            ValidateConfig(backupConfig);
+        }
+        catch (const nlohmann::json::exception &e)
+        {
+            lastError = "バックアップファイルの解析に失敗しました: " + backupPath.string() + ": " + std::string(e.what());
+            StringUtils::OutputMessage(lastError);
+            continue;
+        }
+        catch (const ConfigException &e)
         {
-            throw ConfigException("バックアップファイルを開けませんでした: " + latestBackup.string());
+            lastError = e.what();
+            StringUtils::OutputMessage("バックアップを使用できません: " + backupPath.string() + ": " + lastError);
+            continue;
         }
 
-        nlohmann::json backupConfig = nlohmann::json::parse(backupFile);
-        m_config = backupConfig;
-        ValidateConfig();
-        Save();
-    }
-    catch (const nlohmann::json::exception& e)
-    {
-        throw ConfigException("バックアップファイルの解析に失敗しました: " + std::string(e.what()));
-    }
-    catch (const std::exception& e)
-    {
-        throw ConfigException("バックアップからの復元に失敗しました: " + std::string(e.what()));
+        try
+        {
+            std::lock_guard<std::recursive_mutex> lock(m_writeMutex);
+            m_config = std::move(backupConfig);
+            SaveLocked();
+            return;
+        }
+        catch (const std::exception &e)
+        {
+            throw ConfigException("バックアップからの復元に失敗しました: " + std::string(e.what()));
+        }
     }
+
+    throw ConfigException("バックアップからの復元に失敗しました: " + lastError);
 }
@@ -1,88 +1,107 @@
 #ifndef DISPLAYCONTROLLER_CONFIG_MANAGER_H
 #define DISPLAYCONTROLLER_CONFIG_MANAGER_H
 
-#ifdef DISPLAYCONTROLLERLIB_EXPORTS
-#define DISPLAYCONTROLLERLIB_API __declspec(dllexport)
-#else
-#define DISPLAYCONTROLLERLIB_API __declspec(dllimport)
-#endif
-
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 #include <sstream>
 #include <iomanip>
 #include <ctime>
 #include <nlohmann/json.hpp>
 #include <common/StringUtils.h>
-
-// 設定のバリデーション結果を格納する構造体
-struct DISPLAYCONTROLLERLIB_API ConfigValidationResult
-{
-    bool isValid = true;
-    std::string path;
-    std::string expectedType;
-    std::string actualType;
-    std::string value;
-    std::string message;
-
-    // エラーメッセージを生成
-    std::string FormatMessage() const {
-        if (isValid) return "";
-
-        std::string detail = "設定エラー: " + message + "\n";
-        detail += "場所: " + path + "\n";
-
-        if (!expectedType.empty() && !actualType.empty()) {
-            detail += "期待される型: " + expectedType + "\n";
-            detail += "実際の型: " + actualType + "\n";
-        }
-
-        if (!value.empty()) {
-            detail += "値: " + value;
-        }
-
-        return detail;
-    }
-};
-
-// モニターの輝度範囲設定を管理する構造体
-struct DISPLAYCONTROLLERLIB_API MonitorBrightnessRange
-{
-    int min = 0;    // デフォルト値
-    int max = 100;  // デフォルト値
-
-    bool IsValid() const
-    {
-        return min >= 0 && max > min && max <= 100;
-    }
-};
-
-// キャリブレーション設定を管理する構造体
-struct DISPLAYCONTROLLERLIB_API CalibrationSettings
-{
-    int minRawValue = 0;    // デフォルト値
-    int maxRawValue = 1000; // デフォルト値
-
-    bool IsValid() const
-    {
-        return minRawValue >= 0 && maxRawValue > minRawValue;
-    }
-};
+#include "BrightnessTransition.h"
+#include "ConfigTypes.h"
+#include "ConfigSnapshot.h"
+#include "ConfigSnapshotStore.h"
+#include "ConfigSourceKey.h"
+#include "SensorFusion.h"
 
 class DISPLAYCONTROLLERLIB_API ConfigManager
 {
 public:
     static ConfigManager &Instance();
 
-    // 設定の読み込み
+    // 設定の読み込みにかかった時間
+    struct LoadStats
+    {
+        bool unchanged = false;                 // 公開中の設定と同じ内容のため、解析と検証を省略した
+        std::chrono::microseconds read{0};      // ファイルの読み込みとハッシュの計算
+        std::chrono::microseconds parse{0};
+        std::chrono::microseconds validate{0};
+        std::chrono::microseconds snapshot{0};
+        std::chrono::microseconds total{0};
+    };
+
+    // 設定の読み込み（ファイルの内容が前回の読み込みや保存から変わっていなければ何もしない）
     void Load();
+    // まだ読み込んでいない場合だけ読み込む
+    void EnsureLoaded();
+    // 直近のLoad()の所要時間
+    LoadStats GetLastLoadStats() const;
 
     // 設定の保存
     void Save();
 
+    /**
+     * @brief 複数の変更をまとめて1回で保存する更新
+     *
+     * 開始時の設定の作業コピーに変更を加え、Commit()で1回だけ保存して公開します。
+     * Commit()までの変更はファイルにも公開中のスナップショットにも反映しません。
+     * Commit()せずに破棄した場合は変更を破棄します。更新中もロックは保持しないため、
+     * 他のスレッドの読み書きを待たせません（その場合、Commit()は変更を保存せずに例外を投げる）。
+     */
+    class DISPLAYCONTROLLERLIB_API Transaction
+    {
+    public:
+        Transaction(Transaction &&other) noexcept;
+        Transaction &operator=(Transaction &&) = delete;
+        Transaction(const Transaction &) = delete;
+        Transaction &operator=(const Transaction &) = delete;
+        ~Transaction() = default;
+
+        // 作業コピーの変更（内容はConfigManagerの同名の関数と同じ）
+        bool HasMonitor(const std::string &name) const;
+        void AddMonitor(const std::string &name, const MonitorBrightnessRange &range);
+        void SetMonitorBrightnessRange(const std::string &name, const MonitorBrightnessRange &range);
+        void RemoveMonitor(const std::string &name);
+        void AddDevice(const std::string &pluginName, const std::string &id, const std::string &name, const std::string &type, const std::string &description = "");
+        void SetDeviceCalibration(const std::string &deviceName, const CalibrationSettings &settings);
+        void SetUpdateInterval(int interval_ms);
+        void SetMinBrightness(int value);
+        void SetMaxBrightness(int value);
+
+        /**
+         * @brief 変更を1回で保存して公開する（変更がなければ何もしない）
+         * @throws ConfigException 保存に失敗した場合、または更新の開始後に他の変更が保存されていた場合
+         *         （どちらも設定ファイルと公開中の設定は変更前のまま）
+         */
+        void Commit();
+        // 変更を破棄する
+        void Rollback();
+
+    private:
+        friend class ConfigManager;
+        Transaction(ConfigManager &manager, nlohmann::json config, uint64_t baseRevision);
+        // 終了した更新への操作は例外
+        void EnsureActive() const;
+
+        ConfigManager *m_manager;       // 終了した更新ではnullptr
+        nlohmann::json m_config;        // 作業コピー
+        uint64_t m_baseRevision;        // 作業コピーの元になった設定の版
+        bool m_dirty = false;
+    };
+
+    // 更新を開始する（読み込み前は例外）
+    Transaction BeginUpdate();
+
     // プラグイン設定の取得
     std::string GetPluginConfig(const std::string &pluginName, const std::string &key, const std::string &deviceName = "") const;
+    // 文字列以外の値も含むプラグインのグローバル設定（global_settingsがなければ空のオブジェクト）
+    nlohmann::json GetPluginGlobalSettings(const std::string &pluginName) const;
 
     // デバイス管理
     std::vector<nlohmann::json> GetDevicesByType(const std::string &type) const;
@@ -104,6 +123,16 @@ public:
   // 同期設定の取得
   bool GetSyncOnStartup() const;
 
+    // 輝度書き込みの不感帯（変化がこの値以下なら書き込まない）
+    int GetWriteDeadband() const;
+
+    // 輝度遷移の時間（ミリ秒、0なら遷移しない）と緩急カーブ
+    int GetTransitionDuration() const;
+    EasingCurve GetTransitionCurve() const;
+
+    // 複数の照度センサーをまとめる設定（sensor_fusionセクション、未設定の項目は既定値）
+    SensorFusion::Options GetSensorFusionOptions() const;
+
     // キャリブレーション設定の取得と設定
     CalibrationSettings GetDeviceCalibration(const std::string &deviceId) const;
     void SetDeviceCalibration(const std::string &deviceName, const CalibrationSettings &settings);
@@ -123,6 +152,15 @@ public:
     // 設定ファイルのパスを取得
     std::string GetConfigFilePath() const;
 
+    /**
+     * @brief 読み込んだ設定のスナップショットを取得
+     *
+     * 読み込みと保存のたびに新しいスナップショットが作られ、アトミックに差し替えられます。
+     * 取得したスナップショットは再読み込み後も変わらないため、複数の設定値を
+     * 一貫した状態で読み取る場合は、個別のゲッターの代わりにこちらを使います。
+     */
+    std::shared_ptr<const ConfigSnapshot> GetSnapshot() const;
+
 private:
     ConfigManager() = default;
     ~ConfigManager() = default;
@@ -130,52 +168,31 @@ private:
     ConfigManager &operator=(const ConfigManager &) = delete;
 
     std::string GetConfigPath() const;
-    void ValidateConfig() const;
+    static void ValidateConfig(const nlohmann::json &config);
     void CreateDefaultConfig();
     void EnsureConfigDirectoryExists() const;
-    std::string GetBackupPath() const;
 
     // モニター設定関連
     nlohmann::json CreateDefaultMonitorConfig(const std::string& name) const;
 
-    // 設定値のバリデーションヘルパー
-    ConfigValidationResult ValidateValue(const nlohmann::json& value,
-                                       const std::string& path,
-                                       const std::string& expectedType) const;
-    ConfigValidationResult ValidateNumber(const nlohmann::json& value,
-                                        const std::string& path,
-                                        int min,
-                                        int max) const;
-    ConfigValidationResult ValidateString(const nlohmann::json& value,
-                                        const std::string& path,
-                                        bool allowEmpty = false) const;
-    ConfigValidationResult ValidateObject(const nlohmann::json& value,
-                                        const std::string& path) const;
-    ConfigValidationResult ValidateArray(const nlohmann::json& value,
-                                       const std::string& path) const;
-
+    // m_writeMutexを保持した状態で保存し、新しいスナップショットを公開する
+    void SaveLocked();
+    // 更新の作業コピーを保存する（開始後に他の変更が保存されていた場合と保存に失敗した場合は例外）
+    void CommitUpdate(nlohmann::json config, uint64_t baseRevision);
+    // 公開中のスナップショット（読み込み前は例外）
+    std::shared_ptr<const ConfigSnapshot> AcquireSnapshot() const;
+
+    // 読み取りは公開中のスナップショットだけを参照し、ロックを取らない。
+    // m_configとm_isLoadedは変更・保存・再読み込み用の作業コピーで、m_writeMutexで保護する
+    ConfigSnapshotStore m_snapshots;
+    mutable std::recursive_mutex m_writeMutex;
     nlohmann::json m_config;
     bool m_isLoaded = false;
+    uint64_t m_revision = 0;    // 読み込みと保存のたびに増える設定の版
+    std::optional<ConfigSourceKey> m_loadedSource;  // m_configの元になった設定ファイルの内容
+    LoadStats m_lastLoadStats;
+    static constexpr size_t MAX_BACKUPS = 10;
     static constexpr const char *CONFIG_FILENAME = "config.json";
 };
 
-class ConfigException : public std::runtime_error
-{
-public:
-    explicit ConfigException(const std::string &message)
-        : std::runtime_error(message), m_validationResult()
-    {
-    }
-
-    explicit ConfigException(const ConfigValidationResult& result)
-        : std::runtime_error(result.FormatMessage()), m_validationResult(result)
-    {
-    }
-
-    const ConfigValidationResult& GetValidationResult() const { return m_validationResult; }
-
-private:
-    ConfigValidationResult m_validationResult;
-};
-
 #endif // DISPLAYCONTROLLER_CONFIG_MANAGER_H
@@ -0,0 +1,395 @@
+#include "ConfigSchema.h"
+#include "BrightnessTransition.h"
+#include "SensorFusion.h"
+#include <climits>
+#include <stdexcept>
+
+namespace
+{
+    // 検証中の位置（オブジェクトのキーまたは配列の添字）
+    struct PathSegment
+    {
+        const std::string *key;
+        size_t index;
+    };
+
+    std::string FormatBound(double value)
+    {
+        return std::to_string(static_cast<long long>(value));
+    }
+
+    ConfigSchema BuildDefaultSchema()
+    {
+        using json = nlohmann::json;
+
+        ConfigSchema schema;
+        ConfigSchema::NodeId percent = schema.Number(0, 100);
+        ConfigSchema::NodeId name = schema.String();
+
+        // monitors
+        ConfigSchema::NodeId brightnessRange = schema.Object(
+            {{"min", percent, "最小輝度が指定されていません"},
+             {"max", percent, "最大輝度が指定されていません"}},
+            {{[](const json &range) { return range["min"].get<double>() <= range["max"].get<double>(); },
+              "最小輝度は最大輝度以下である必要があります",
+              [](const json &range) { return "min: " + range["min"].dump() + ", max: " + range["max"].dump(); }}});
+        ConfigSchema::NodeId curvePoint = schema.Object(
+            {{"light", percent, "lightが指定されていません"},
+             {"brightness", percent, "brightnessが指定されていません"}});
+        ConfigSchema::NodeId monitor = schema.Object(
+            {{"name", name, "モニター名が指定されていません"},
+             {"brightness_range", brightnessRange, "brightness_rangeが指定されていません"},
+             {"brightness_curve", schema.Array(curvePoint)},
+             {"sensor", name}});
+
+        // plugins
+        ConfigSchema::NodeId device = schema.Object(
+            {{"id", name, "idが指定されていません"},
+             {"name", name, "nameが指定されていません"},
+             {"type", name, "typeが指定されていません"},
+             {"description", schema.String(true)},
+             {"weight", schema.Number(0, 1000)},
+             // SwitchBotLightSensorの照度キャッシュ（デバイスごと）
+             {"cache_ttl_ms", schema.Number(0, INT_MAX)},
+             {"stale_while_revalidate_ms", schema.Number(0, INT_MAX)},
+             {"max_fallback_age_ms", schema.Number(0, INT_MAX)}});
+        ConfigSchema::NodeId plugin = schema.Object(
+            {{"global_settings", schema.Object({})},
+             {"devices", schema.Array(device)}},
+            {{[](const json &config) { return config.contains("devices") || config.contains("global_settings"); },
+              "devices または global_settings セクションがありません",
+              nullptr}});
+
+        // brightness_daemon
+        ConfigSchema::NodeId transitionCurve = schema.String(ConfigSchema::StringCheck{
+            [](const std::string &curve) {
+                try
+                {
+                    BrightnessTransitionEngine::ParseEasingCurve(curve);
+                    return true;
+                }
+                catch (const std::invalid_argument &)
+                {
+                    return false;
+                }
+            },
+            "linear|ease_in|ease_out|ease_in_out",
+            "transition_curveの値が不正です"});
+        ConfigSchema::NodeId fusionStrategy = schema.String(ConfigSchema::StringCheck{
+            [](const std::string &strategy) {
+                try
+                {
+                    SensorFusion::ParseStrategy(strategy);
+                    return true;
+                }
+                catch (const std::invalid_argument &)
+                {
+                    return false;
+                }
+            },
+            "median|weighted_mean|max|nearest",
+            "strategyの値が不正です"});
+        ConfigSchema::NodeId sensorFusion = schema.Object(
+            {{"strategy", fusionStrategy},
+             {"outlier_threshold", percent},
+             {"max_sample_age_ms", schema.Number(1000, INT_MAX)},
+             {"read_timeout_ms", schema.Number(100, 600000)}});
+        ConfigSchema::NodeId daemon = schema.Object(
+            {{"update_interval_ms", schema.Number(1000, INT_MAX), "update_interval_msが設定されていません"},
+             {"min_brightness", percent, "min_brightnessが設定されていません"},
+             {"max_brightness", percent, "max_brightnessが設定されていません"},
+             {"write_deadband", percent},
+             {"transition_duration_ms", schema.Number(0, 60000)},
+             {"transition_curve", transitionCurve},
+             {"sensor_fusion", sensorFusion}},
+            {{[](const json &config) {
+                  return config["min_brightness"].get<double>() <= config["max_brightness"].get<double>();
+              },
+              "min_brightnessはmax_brightness以下である必要があります",
+              [](const json &config) {
+                  return "min_brightness: " + config["min_brightness"].dump() +
+                         ", max_brightness: " + config["max_brightness"].dump();
+              }}});
+
+        schema.SetRoot(schema.Object(
+            {{"monitors", schema.Array(monitor)},
+             {"plugins", schema.Map(plugin), "設定ファイルにpluginsセクションがありません"},
+             {"brightness_daemon", daemon, "設定ファイルにbrightness_daemonセクションがありません"}}));
+        return schema;
+    }
+}
+
+// 1回の検証の状態（現在の位置と見つかったエラー）
+class ConfigSchema::Walker
+{
+public:
+    explicit Walker(const ConfigSchema &schema) : m_schema(schema) {}
+
+    void Visit(NodeId id, const nlohmann::json &value)
+    {
+        const Node &node = m_schema.m_nodes[id];
+        switch (node.kind)
+        {
+        case Kind::String:
+            VisitString(node, value);
+            break;
+        case Kind::Number:
+            VisitNumber(node, value);
+            break;
+        case Kind::Object:
+            VisitObject(node, value);
+            break;
+        case Kind::Map:
+            if (!value.is_object())
+            {
+                AddTypeError(node, value);
+                break;
+            }
+            for (auto it = value.begin(); it != value.end(); ++it)
+            {
+                m_path.push_back({&it.key(), 0});
+                Visit(node.child, it.value());
+                m_path.pop_back();
+            }
+            break;
+        case Kind::Array:
+            if (!value.is_array())
+            {
+                AddTypeError(node, value);
+                break;
+            }
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                m_path.push_back({nullptr, i});
+                Visit(node.child, value[i]);
+                m_path.pop_back();
+            }
+            break;
+        }
+    }
+
+    std::vector<ConfigValidationResult> TakeErrors() { return std::move(m_errors); }
+
+private:
+    void VisitString(const Node &node, const nlohmann::json &value)
+    {
+        if (!value.is_string())
+        {
+            AddTypeError(node, value);
+            return;
+        }
+
+        const auto &text = value.get_ref<const std::string &>();
+        if (!node.allowEmpty && text.empty())
+        {
+            AddError("string", "", text, "空の文字列は許可されていません");
+        }
+        else if (node.check.accepts && !node.check.accepts(text))
+        {
+            AddError(node.check.expected, "string", text, node.check.message);
+        }
+    }
+
+    void VisitNumber(const Node &node, const nlohmann::json &value)
+    {
+        if (!value.is_number())
+        {
+            AddTypeError(node, value);
+            return;
+        }
+
+        double number = value.get<double>();
+        if (number < node.min || number > node.max)
+        {
+            AddError("number", "", value.dump(),
+                     FormatBound(node.min) + "から" + FormatBound(node.max) + "の範囲である必要があります");
+        }
+    }
+
+    void VisitObject(const Node &node, const nlohmann::json &value)
+    {
+        if (!value.is_object())
+        {
+            AddTypeError(node, value);
+            return;
+        }
+
+        size_t errorCount = m_errors.size();
+        for (const auto &field : node.fields)
+        {
+            auto it = value.find(field.key);
+            m_path.push_back({&field.key, 0});
+            if (it != value.end())
+            {
+                Visit(field.node, *it);
+            }
+            else if (field.missingMessage)
+            {
+                AddError(TypeName(m_schema.m_nodes[field.node].kind), "undefined", "", field.missingMessage);
+            }
+            m_path.pop_back();
+        }
+
+        // 項目の値が不正な場合、項目間の制約は確認できない
+        if (m_errors.size() != errorCount)
+        {
+            return;
+        }
+        for (const auto &constraint : node.constraints)
+        {
+            if (!constraint.holds(value))
+            {
+                AddError("", "", constraint.describe ? constraint.describe(value) : "", constraint.message);
+            }
+        }
+    }
+
+    void AddTypeError(const Node &node, const nlohmann::json &value)
+    {
+        const char *message = "";
+        switch (node.kind)
+        {
+        case Kind::String:
+            message = "文字列である必要があります";
+            break;
+        case Kind::Number:
+            message = "数値である必要があります";
+            break;
+        case Kind::Object:
+        case Kind::Map:
+            message = "オブジェクトである必要があります";
+            break;
+        case Kind::Array:
+            message = "配列である必要があります";
+            break;
+        }
+        AddError(TypeName(node.kind), value.type_name(), value.dump(), message);
+    }
+
+    void AddError(std::string expectedType, std::string actualType, std::string value, std::string message)
+    {
+        m_errors.push_back(ConfigValidationResult{
+            false, FormatPath(), std::move(expectedType), std::move(actualType), std::move(value), std::move(message)});
+    }
+
+    std::string FormatPath() const
+    {
+        std::string path;
+        for (const auto &segment : m_path)
+        {
+            if (segment.key)
+            {
+                if (!path.empty())
+                {
+                    path += '.';
+                }
+                path += *segment.key;
+            }
+            else
+            {
+                path += "[" + std::to_string(segment.index) + "]";
+            }
+        }
+        return path;
+    }
+
+    const ConfigSchema &m_schema;
+    std::vector<PathSegment> m_path;
+    std::vector<ConfigValidationResult> m_errors;
+};
+
+ConfigSchema::NodeId ConfigSchema::String(bool allowEmpty)
+{
+    Node node;
+    node.kind = Kind::String;
+    node.allowEmpty = allowEmpty;
+    return Add(std::move(node));
+}
+
+ConfigSchema::NodeId ConfigSchema::String(StringCheck check)
+{
+    Node node;
+    node.kind = Kind::String;
+    node.check = std::move(check);
+    return Add(std::move(node));
+}
+
+ConfigSchema::NodeId ConfigSchema::Number(double min, double max)
+{
+    Node node;
+    node.kind = Kind::Number;
+    node.min = min;
+    node.max = max;
+    return Add(std::move(node));
+}
+
+ConfigSchema::NodeId ConfigSchema::Object(std::initializer_list<Field> fields, std::initializer_list<Constraint> constraints)
+{
+    Node node;
+    node.kind = Kind::Object;
+    node.fields = fields;
+    node.constraints = constraints;
+    return Add(std::move(node));
+}
+
+ConfigSchema::NodeId ConfigSchema::Map(NodeId value)
+{
+    Node node;
+    node.kind = Kind::Map;
+    node.child = value;
+    return Add(std::move(node));
+}
+
+ConfigSchema::NodeId ConfigSchema::Array(NodeId element)
+{
+    Node node;
+    node.kind = Kind::Array;
+    node.child = element;
+    return Add(std::move(node));
+}
+
+void ConfigSchema::SetRoot(NodeId root)
+{
+    m_root = root;
+}
+
+std::vector<ConfigValidationResult> ConfigSchema::Validate(const nlohmann::json &config) const
+{
+    if (m_nodes.empty())
+    {
+        throw std::logic_error("スキーマが空です");
+    }
+
+    Walker walker(*this);
+    walker.Visit(m_root, config);
+    return walker.TakeErrors();
+}
+
+const ConfigSchema &ConfigSchema::Default()
+{
+    static const ConfigSchema schema = BuildDefaultSchema();
+    return schema;
+}
+
+ConfigSchema::NodeId ConfigSchema::Add(Node node)
+{
+    m_nodes.push_back(std::move(node));
+    return m_nodes.size() - 1;
+}
+
+const char *ConfigSchema::TypeName(Kind kind)
+{
+    switch (kind)
+    {
+    case Kind::String:
+        return "string";
+    case Kind::Number:
+        return "number";
+    case Kind::Object:
+    case Kind::Map:
+        return "object";
+    case Kind::Array:
+        return "array";
+    }
+    return "";
+}
@@ -0,0 +1,98 @@
+#ifndef DISPLAYCONTROLLER_CONFIG_SCHEMA_H
+#define DISPLAYCONTROLLER_CONFIG_SCHEMA_H
+
+#include "ConfigTypes.h"
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+/**
+ * @brief 設定ファイルの構造を宣言的に表したスキーマ
+ *
+ * 型・範囲・必須項目・項目間の制約をノードとして一度だけ組み立て、設定全体を1回の走査で検証します。
+ * 最初のエラーで止めずにすべてのエラーを返します。エラーのパスやメッセージの文字列は
+ * 検証に失敗した項目についてだけ作るため、正しい設定の検証では文字列を確保しません。
+ */
+class DISPLAYCONTROLLERLIB_API ConfigSchema
+{
+public:
+    using NodeId = size_t;
+
+    // オブジェクトの項目（missingMessageがnullptrなら省略可能）
+    struct Field
+    {
+        std::string key;
+        NodeId node;
+        const char *missingMessage = nullptr;
+    };
+
+    // オブジェクト全体に対する制約（項目がすべて正しい場合だけ確認する）
+    struct Constraint
+    {
+        std::function<bool(const nlohmann::json &)> holds;
+        const char *message;
+        // エラーに表示する値（省略可能）
+        std::function<std::string(const nlohmann::json &)> describe;
+    };
+
+    // 文字列の値の検査（expectedは期待される値の説明）
+    struct StringCheck
+    {
+        std::function<bool(const std::string &)> accepts;
+        const char *expected = nullptr;
+        const char *message = nullptr;
+    };
+
+    NodeId String(bool allowEmpty = false);
+    NodeId String(StringCheck check);
+    NodeId Number(double min, double max);
+    NodeId Object(std::initializer_list<Field> fields, std::initializer_list<Constraint> constraints = {});
+    // 任意の名前のメンバーをすべて同じノードで検証するオブジェクト
+    NodeId Map(NodeId value);
+    NodeId Array(NodeId element);
+    void SetRoot(NodeId root);
+
+    /**
+     * @brief 設定を検証する
+     * @return 見つかったすべてのエラー（正しい場合は空）
+     */
+    std::vector<ConfigValidationResult> Validate(const nlohmann::json &config) const;
+
+    // config.jsonのスキーマ（最初の呼び出しで一度だけ組み立てる）
+    static const ConfigSchema &Default();
+
+private:
+    enum class Kind
+    {
+        String,
+        Number,
+        Object,
+        Map,
+        Array
+    };
+
+    struct Node
+    {
+        Kind kind = Kind::String;
+        bool allowEmpty = false;
+        double min = 0;
+        double max = 0;
+        NodeId child = 0;
+        std::vector<Field> fields;
+        std::vector<Constraint> constraints;
+        StringCheck check;
+    };
+
+    class Walker;
+
+    NodeId Add(Node node);
+    static const char *TypeName(Kind kind);
+
+    std::vector<Node> m_nodes;
+    NodeId m_root = 0;
+};
+
+#endif // DISPLAYCONTROLLER_CONFIG_SCHEMA_H
@@ -0,0 +1,327 @@
+#include "ConfigSnapshot.h"
+#include "ConfigValidation.h"
+
+namespace
+{
+    // 空でない文字列の設定値を集める（空文字列はGetPluginConfig()でエラーになるため含めない）
+    ConfigIndex<std::string> CollectStrings(const nlohmann::json &object)
+    {
+        ConfigIndex<std::string> strings;
+        if (!object.is_object())
+        {
+            return strings;
+        }
+        for (const auto &[key, value] : object.items())
+        {
+            if (value.is_string() && !value.get_ref<const std::string &>().empty())
+            {
+                strings.emplace(key, value.get<std::string>());
+            }
+        }
+        return strings;
+    }
+
+    std::string GetStringOrEmpty(const nlohmann::json &object, const char *key)
+    {
+        auto it = object.find(key);
+        if (it == object.end() || !it->is_string())
+        {
+            return {};
+        }
+        return it->get<std::string>();
+    }
+
+    std::optional<int> GetInt(const nlohmann::json &object, const char *key)
+    {
+        auto it = object.find(key);
+        if (it == object.end() || !it->is_number())
+        {
+            return std::nullopt;
+        }
+        return it->get<int>();
+    }
+
+    const std::vector<const DeviceConfig *> kNoDevices;
+}
+
+ConfigSnapshot::ConfigSnapshot(nlohmann::json config)
+    : m_raw(std::move(config))
+{
+    if (!m_raw.is_object())
+    {
+        return;
+    }
+    BuildPlugins();
+    BuildMonitors();
+    BuildDaemonSettings();
+}
+
+const PluginConfig *ConfigSnapshot::FindPlugin(std::string_view pluginName) const
+{
+    auto it = m_plugins.find(pluginName);
+    return it != m_plugins.end() ? &it->second : nullptr;
+}
+
+const DeviceConfig *ConfigSnapshot::FindDeviceByName(std::string_view name) const
+{
+    auto it = m_devicesByName.find(name);
+    return it != m_devicesByName.end() ? it->second : nullptr;
+}
+
+const DeviceConfig *ConfigSnapshot::FindDevice(std::string_view pluginName, std::string_view deviceName) const
+{
+    const auto *plugin = FindPlugin(pluginName);
+    if (!plugin)
+    {
+        return nullptr;
+    }
+    auto it = plugin->devicesByName.find(deviceName);
+    return it != plugin->devicesByName.end() ? it->second : nullptr;
+}
+
+const DeviceConfig *ConfigSnapshot::FindDeviceById(std::string_view pluginName, std::string_view id) const
+{
+    const auto *plugin = FindPlugin(pluginName);
+    if (!plugin)
+    {
+        return nullptr;
+    }
+    auto it = plugin->devicesById.find(id);
+    return it != plugin->devicesById.end() ? it->second : nullptr;
+}
+
+const MonitorConfig *ConfigSnapshot::FindMonitor(std::string_view name) const
+{
+    auto it = m_monitorsByName.find(name);
+    return it != m_monitorsByName.end() ? it->second : nullptr;
+}
+
+const std::string *ConfigSnapshot::FindPluginSetting(std::string_view pluginName, std::string_view key, std::string_view deviceName) const
+{
+    const ConfigIndex<std::string> *strings = nullptr;
+    if (deviceName.empty())
+    {
+        const auto *plugin = FindPlugin(pluginName);
+        strings = plugin ? &plugin->strings : nullptr;
+    }
+    else
+    {
+        const auto *device = FindDevice(pluginName, deviceName);
+        strings = device ? &device->strings : nullptr;
+    }
+    if (!strings)
+    {
+        return nullptr;
+    }
+
+    auto it = strings->find(key);
+    return it != strings->end() ? &it->second : nullptr;
+}
+
+const std::vector<const DeviceConfig *> &ConfigSnapshot::GetDevicesByType(std::string_view type) const
+{
+    auto it = m_devicesByType.find(type);
+    return it != m_devicesByType.end() ? it->second : kNoDevices;
+}
+
+void ConfigSnapshot::BuildPlugins()
+{
+    auto pluginsIt = m_raw.find("plugins");
+    if (pluginsIt == m_raw.end() || !pluginsIt->is_object())
+    {
+        return;
+    }
+
+    // インデックスが要素のアドレスを保持するため、先にすべてのデバイスを格納する
+    for (const auto &[pluginName, pluginConfig] : pluginsIt->items())
+    {
+        auto devicesIt = pluginConfig.find("devices");
+        if (!pluginConfig.is_object() || devicesIt == pluginConfig.end() || !devicesIt->is_array())
+        {
+            continue;
+        }
+
+        const auto &devices = *devicesIt;
+        for (size_t i = 0; i < devices.size(); ++i)
+        {
+            const auto &device = devices[i];
+            if (!device.is_object())
+            {
+                continue;
+            }
+
+            DeviceConfig config;
+            config.pluginName = pluginName;
+            config.id = GetStringOrEmpty(device, "id");
+            config.name = GetStringOrEmpty(device, "name");
+            config.type = GetStringOrEmpty(device, "type");
+            config.description = GetStringOrEmpty(device, "description");
+            config.index = i;
+            config.raw = device;
+            auto weightIt = device.find("weight");
+            if (weightIt != device.end() && weightIt->is_number() && weightIt->get<double>() >= 0)
+            {
+                config.weight = weightIt->get<double>();
+            }
+            config.strings = CollectStrings(device);
+
+            try
+            {
+                std::string devicePath = "plugins." + pluginName + ".devices[" + std::to_string(i) + "]";
+                config.calibration = ConfigValidation::ParseCalibration(device, devicePath, config.id);
+            }
+            catch (const ConfigException &e)
+            {
+                config.calibrationError = e.GetValidationResult();
+            }
+
+            m_devices.push_back(std::move(config));
+        }
+    }
+
+    for (const auto &[pluginName, pluginConfig] : pluginsIt->items())
+    {
+        PluginConfig plugin;
+        plugin.name = pluginName;
+        if (pluginConfig.is_object() && pluginConfig.contains("global_settings") && pluginConfig["global_settings"].is_object())
+        {
+            plugin.globalSettings = pluginConfig["global_settings"];
+            plugin.strings = CollectStrings(plugin.globalSettings);
+        }
+        m_plugins.emplace(pluginName, std::move(plugin));
+    }
+
+    // 同じ名前やIDが複数ある場合は、線形探索と同じく最初のデバイスを使う
+    for (const auto &device : m_devices)
+    {
+        auto &plugin = m_plugins.find(device.pluginName)->second;
+        plugin.devicesByName.emplace(device.name, &device);
+        plugin.devicesById.emplace(device.id, &device);
+        m_devicesByName.emplace(device.name, &device);
+        m_devicesByType[device.type].push_back(&device);
+    }
+}
+
+void ConfigSnapshot::BuildMonitors()
+{
+    auto monitorsIt = m_raw.find("monitors");
+    if (monitorsIt == m_raw.end() || !monitorsIt->is_array())
+    {
+        return;
+    }
+
+    for (const auto &monitor : *monitorsIt)
+    {
+        if (!monitor.is_object() || !monitor.contains("name") || !monitor["name"].is_string())
+        {
+            continue;
+        }
+
+        MonitorConfig config;
+        config.name = monitor["name"].get<std::string>();
+        config.sensor = GetStringOrEmpty(monitor, "sensor");
+
+        auto rangeIt = monitor.find("brightness_range");
+        if (rangeIt != monitor.end() && rangeIt->is_object())
+        {
+            auto min = GetInt(*rangeIt, "min");
+            auto max = GetInt(*rangeIt, "max");
+            if (min && max)
+            {
+                MonitorBrightnessRange range;
+                range.min = *min;
+                range.max = *max;
+                if (range.IsValid())
+                {
+                    config.brightnessRange = range;
+                }
+            }
+        }
+
+        auto curveIt = monitor.find("brightness_curve");
+        if (curveIt != monitor.end() && curveIt->is_array())
+        {
+            for (const auto &point : *curveIt)
+            {
+                if (!point.is_object())
+                {
+                    continue;
+                }
+                auto light = GetInt(point, "light");
+                auto brightness = GetInt(point, "brightness");
+                if (light && brightness)
+                {
+                    config.brightnessCurve.emplace_back(*light, *brightness);
+                }
+            }
+        }
+
+        m_monitorNames.push_back(config.name);
+        m_monitors.push_back(std::move(config));
+    }
+
+    for (const auto &monitor : m_monitors)
+    {
+        m_monitorsByName.emplace(monitor.name, &monitor);
+    }
+}
+
+void ConfigSnapshot::BuildDaemonSettings()
+{
+    auto daemonIt = m_raw.find("brightness_daemon");
+    if (daemonIt == m_raw.end() || !daemonIt->is_object())
+    {
+        return;
+    }
+
+    const auto &daemon = *daemonIt;
+    m_daemon.updateIntervalMs = GetInt(daemon, "update_interval_ms");
+    m_daemon.minBrightness = GetInt(daemon, "min_brightness");
+    m_daemon.maxBrightness = GetInt(daemon, "max_brightness");
+    m_daemon.writeDeadband = GetInt(daemon, "write_deadband");
+    m_daemon.transitionDurationMs = GetInt(daemon, "transition_duration_ms");
+
+    auto syncIt = daemon.find("sync_on_startup");
+    if (syncIt != daemon.end() && syncIt->is_boolean())
+    {
+        m_daemon.syncOnStartup = syncIt->get<bool>();
+    }
+
+    auto curveIt = daemon.find("transition_curve");
+    if (curveIt != daemon.end() && curveIt->is_string())
+    {
+        try
+        {
+            m_daemon.transitionCurve = BrightnessTransitionEngine::ParseEasingCurve(curveIt->get<std::string>());
+        }
+        catch (const std::invalid_argument &)
+        {
+            // 不正な値はnulloptのままにする
+        }
+    }
+
+    auto fusionIt = daemon.find("sensor_fusion");
+    if (fusionIt != daemon.end() && fusionIt->is_object())
+    {
+        const auto &fusion = *fusionIt;
+        auto strategyIt = fusion.find("strategy");
+        if (strategyIt != fusion.end() && strategyIt->is_string())
+        {
+            try
+            {
+                m_daemon.fusionStrategy = SensorFusion::ParseStrategy(strategyIt->get<std::string>());
+            }
+            catch (const std::invalid_argument &)
+            {
+                // 不正な値はnulloptのままにする
+            }
+        }
+        auto thresholdIt = fusion.find("outlier_threshold");
+        if (thresholdIt != fusion.end() && thresholdIt->is_number())
+        {
+            m_daemon.outlierThreshold = thresholdIt->get<double>();
+        }
+        m_daemon.maxSampleAgeMs = GetInt(fusion, "max_sample_age_ms");
+        m_daemon.sensorReadTimeoutMs = GetInt(fusion, "read_timeout_ms");
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef DISPLAYCONTROLLER_CONFIG_SNAPSHOT_H
+#define DISPLAYCONTROLLER_CONFIG_SNAPSHOT_H
+
+#include "ConfigTypes.h"
+#include "BrightnessTransition.h"
+#include "SensorFusion.h"
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// string_viewのまま検索できる（一時的なstd::stringを作らない）文字列ハッシュ
+struct ConfigKeyHash
+{
+    using is_transparent = void;
+
+    size_t operator()(std::string_view key) const noexcept
+    {
+        return std::hash<std::string_view>{}(key);
+    }
+};
+
+template <typename T>
+using ConfigIndex = std::unordered_map<std::string, T, ConfigKeyHash, std::equal_to<>>;
+
+// デバイス設定
+struct DISPLAYCONTROLLERLIB_API DeviceConfig
+{
+    std::string pluginName;
+    std::string id;
+    std::string name;
+    std::string type;
+    std::string description;
+    size_t index = 0;                   // プラグインのdevices配列内の位置
+    nlohmann::json raw;                 // 設定ファイル上のデバイスオブジェクト
+    double weight = 1.0;                // 複数のセンサーを重み付き平均でまとめる場合の重み
+    ConfigIndex<std::string> strings;   // 文字列の設定値
+
+    // 読み込み時に検証したキャリブレーション設定（不正な場合はcalibrationErrorに理由を持つ）
+    CalibrationSettings calibration;
+    std::optional<ConfigValidationResult> calibrationError;
+};
+
+// プラグイン設定
+struct DISPLAYCONTROLLERLIB_API PluginConfig
+{
+    std::string name;
+    nlohmann::json globalSettings = nlohmann::json::object();
+    ConfigIndex<std::string> strings;           // global_settingsの文字列の設定値
+    ConfigIndex<const DeviceConfig*> devicesByName;
+    ConfigIndex<const DeviceConfig*> devicesById;
+};
+
+// モニター設定
+struct DISPLAYCONTROLLERLIB_API MonitorConfig
+{
+    std::string name;
+    std::optional<MonitorBrightnessRange> brightnessRange;  // 未設定または不正な場合はnullopt
+    std::vector<std::pair<int, int>> brightnessCurve;      // 照度と輝度の対応点（未設定なら空）
+    std::string sensor;                                     // 割り当てたセンサーのデバイス名（未設定なら空）
+};
+
+// brightness_daemonセクション（未設定または型が不正な項目はnullopt）
+struct DISPLAYCONTROLLERLIB_API DaemonSettings
+{
+    std::optional<int> updateIntervalMs;
+    std::optional<int> minBrightness;
+    std::optional<int> maxBrightness;
+    std::optional<bool> syncOnStartup;
+    std::optional<int> writeDeadband;
+    std::optional<int> transitionDurationMs;
+    std::optional<EasingCurve> transitionCurve;
+
+    // sensor_fusionセクション
+    std::optional<FusionStrategy> fusionStrategy;
+    std::optional<double> outlierThreshold;
+    std::optional<int> maxSampleAgeMs;
+    std::optional<int> sensorReadTimeoutMs;
+};
+
+/**
+ * @brief 読み込んだ設定の不変なスナップショット
+ *
+ * 設定を読み込んだ時点で型付きの構造へ変換し、デバイス名・デバイスID・デバイスタイプ・
+ * モニター名のハッシュインデックスを作成します。検索はO(1)で、メモリ確保を行いません。
+ * 構築後は変更されないため、複数のスレッドから同時に参照できます。
+ *
+ * 構築時に値を検証しますが、不正な値があっても例外は送出しません。該当する項目を
+ * インデックスに含めないため、呼び出し元は見つからない場合に元の設定から詳細な
+ * エラーを組み立てられます。
+ */
+class DISPLAYCONTROLLERLIB_API ConfigSnapshot
+{
+public:
+    explicit ConfigSnapshot(nlohmann::json config);
+
+    ConfigSnapshot(const ConfigSnapshot &) = delete;
+    ConfigSnapshot &operator=(const ConfigSnapshot &) = delete;
+
+    const nlohmann::json &GetRaw() const { return m_raw; }
+    const DaemonSettings &GetDaemonSettings() const { return m_daemon; }
+
+    // 見つからない場合はnullptr
+    const PluginConfig *FindPlugin(std::string_view pluginName) const;
+    const DeviceConfig *FindDeviceByName(std::string_view name) const;
+    const DeviceConfig *FindDevice(std::string_view pluginName, std::string_view deviceName) const;
+    const DeviceConfig *FindDeviceById(std::string_view pluginName, std::string_view id) const;
+    const MonitorConfig *FindMonitor(std::string_view name) const;
+
+    // プラグインの文字列設定（deviceNameが空ならglobal_settings）
+    const std::string *FindPluginSetting(std::string_view pluginName, std::string_view key, std::string_view deviceName = {}) const;
+
+    // 設定ファイル上の順序を保ったデバイス一覧（該当がなければ空）
+    const std::vector<const DeviceConfig *> &GetDevicesByType(std::string_view type) const;
+    const std::vector<DeviceConfig> &GetDevices() const { return m_devices; }
+
+    const std::vector<MonitorConfig> &GetMonitors() const { return m_monitors; }
+    const std::vector<std::string> &GetMonitorNames() const { return m_monitorNames; }
+
+private:
+    void BuildPlugins();
+    void BuildMonitors();
+    void BuildDaemonSettings();
+
+    nlohmann::json m_raw;
+    DaemonSettings m_daemon;
+
+    // インデックスが要素を指すため、構築後は要素を追加しない
+    std::vector<DeviceConfig> m_devices;
+    std::vector<MonitorConfig> m_monitors;
+    std::vector<std::string> m_monitorNames;
+
+    ConfigIndex<PluginConfig> m_plugins;
+    ConfigIndex<const DeviceConfig *> m_devicesByName;
+    ConfigIndex<std::vector<const DeviceConfig *>> m_devicesByType;
+    ConfigIndex<const MonitorConfig *> m_monitorsByName;
+};
+
+#endif // DISPLAYCONTROLLER_CONFIG_SNAPSHOT_H
@@ -0,0 +1,49 @@
+#ifndef DISPLAYCONTROLLER_CONFIG_SNAPSHOT_STORE_H
+#define DISPLAYCONTROLLER_CONFIG_SNAPSHOT_STORE_H
+
+#include "ConfigSnapshot.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @brief 現在の設定スナップショットを保持し、アトミックに差し替える
+ *
+ * 再読み込みでは新しいスナップショットを別に組み立ててから一度に公開します。
+ * 読み取り側は参照カウント付きのポインタを取得するだけで、差し替えや
+ * ファイルの読み込みを待ちません。取得したスナップショットは差し替え後も
+ * 最後の参照が外れるまで有効なため、1回の処理の中では常に同じ設定を参照できます。
+ */
+class ConfigSnapshotStore {
+public:
+    ConfigSnapshotStore() = default;
+
+    ConfigSnapshotStore(const ConfigSnapshotStore&) = delete;
+    ConfigSnapshotStore& operator=(const ConfigSnapshotStore&) = delete;
+
+    // 現在のスナップショット（未公開ならnullptr）
+    std::shared_ptr<const ConfigSnapshot> Acquire() const
+    {
+        return m_current.load(std::memory_order_acquire);
+    }
+
+    // 新しいスナップショットを公開し、それまでのスナップショットを返す
+    std::shared_ptr<const ConfigSnapshot> Publish(std::shared_ptr<const ConfigSnapshot> snapshot)
+    {
+        auto previous = m_current.exchange(std::move(snapshot), std::memory_order_acq_rel);
+        m_generation.fetch_add(1, std::memory_order_release);
+        return previous;
+    }
+
+    // これまでに公開した回数（変更の検出に使う）
+    uint64_t GetGeneration() const
+    {
+        return m_generation.load(std::memory_order_acquire);
+    }
+
+private:
+    std::atomic<std::shared_ptr<const ConfigSnapshot>> m_current;
+    std::atomic<uint64_t> m_generation{0};
+};
+
+#endif // DISPLAYCONTROLLER_CONFIG_SNAPSHOT_STORE_H
@@ -0,0 +1,33 @@
+#ifndef DISPLAYCONTROLLER_CONFIG_SOURCE_KEY_H
+#define DISPLAYCONTROLLER_CONFIG_SOURCE_KEY_H
+
+#include "Fnv1a.h"
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+/**
+ * @brief 設定ファイルの内容を識別するキー
+ *
+ * 内容のハッシュ（FNV-1a）・サイズ・更新日時の組で、前回読み込んだ内容から変わったかを判定します。
+ * 更新日時の精度が粗いファイルシステムでも、内容が変われば必ずハッシュで区別できます。
+ */
+struct ConfigSourceKey
+{
+    uint64_t hash = 0;
+    uint64_t size = 0;
+    int64_t modifiedTime = 0;
+
+    bool operator==(const ConfigSourceKey &other) const = default;
+
+    static ConfigSourceKey Compute(std::string_view content, std::filesystem::file_time_type modifiedTime)
+    {
+        ConfigSourceKey key;
+        key.hash = Fnv1a64(content);
+        key.size = content.size();
+        key.modifiedTime = static_cast<int64_t>(modifiedTime.time_since_epoch().count());
+        return key;
+    }
+};
+
+#endif // DISPLAYCONTROLLER_CONFIG_SOURCE_KEY_H
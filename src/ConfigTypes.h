@@ -0,0 +1,114 @@
+#ifndef DISPLAYCONTROLLER_CONFIG_TYPES_H
+#define DISPLAYCONTROLLER_CONFIG_TYPES_H
+
+#ifdef _WIN32
+    #ifdef DISPLAYCONTROLLERLIB_EXPORTS
+        #define DISPLAYCONTROLLERLIB_API __declspec(dllexport)
+    #else
+        #define DISPLAYCONTROLLERLIB_API __declspec(dllimport)
+    #endif
+#else
+    #define DISPLAYCONTROLLERLIB_API
+#endif
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 設定のバリデーション結果を格納する構造体
+struct DISPLAYCONTROLLERLIB_API ConfigValidationResult
+{
+    bool isValid = true;
+    std::string path;
+    std::string expectedType;
+    std::string actualType;
+    std::string value;
+    std::string message;
+
+    // エラーメッセージを生成
+    std::string FormatMessage() const {
+        if (isValid) return "";
+
+        std::string detail = "設定エラー: " + message + "\n";
+        detail += "場所: " + path + "\n";
+
+        if (!expectedType.empty() && !actualType.empty()) {
+            detail += "期待される型: " + expectedType + "\n";
+            detail += "実際の型: " + actualType + "\n";
+        }
+
+        if (!value.empty()) {
+            detail += "値: " + value;
+        }
+
+        return detail;
+    }
+};
+
+// モニターの輝度範囲設定を管理する構造体
+struct DISPLAYCONTROLLERLIB_API MonitorBrightnessRange
+{
+    int min = 0;    // デフォルト値
+    int max = 100;  // デフォルト値
+
+    bool IsValid() const
+    {
+        return min >= 0 && max > min && max <= 100;
+    }
+};
+
+// キャリブレーション設定を管理する構造体
+struct DISPLAYCONTROLLERLIB_API CalibrationSettings
+{
+    int minRawValue = 0;    // デフォルト値
+    int maxRawValue = 1000; // デフォルト値
+
+    bool IsValid() const
+    {
+        return minRawValue >= 0 && maxRawValue > minRawValue;
+    }
+};
+
+class ConfigException : public std::runtime_error
+{
+public:
+    explicit ConfigException(const std::string &message)
+        : std::runtime_error(message), m_validationResult()
+    {
+    }
+
+    explicit ConfigException(const ConfigValidationResult& result)
+        : std::runtime_error(result.FormatMessage()), m_validationResult(result), m_validationResults{result}
+    {
+    }
+
+    // 検証で見つかったすべてのエラーをまとめて報告する
+    explicit ConfigException(const std::vector<ConfigValidationResult>& results)
+        : std::runtime_error(FormatMessages(results)),
+          m_validationResult(results.empty() ? ConfigValidationResult{} : results.front()),
+          m_validationResults(results)
+    {
+    }
+
+    // 最初のエラー
+    const ConfigValidationResult& GetValidationResult() const { return m_validationResult; }
+    const std::vector<ConfigValidationResult>& GetValidationResults() const { return m_validationResults; }
+
+private:
+    static std::string FormatMessages(const std::vector<ConfigValidationResult>& results) {
+        std::string message;
+        if (results.size() > 1) {
+            message = std::to_string(results.size()) + "件の設定エラーがあります\n\n";
+        }
+        for (size_t i = 0; i < results.size(); ++i) {
+            if (i > 0) message += "\n\n";
+            message += results[i].FormatMessage();
+        }
+        return message;
+    }
+
+    ConfigValidationResult m_validationResult;
+    std::vector<ConfigValidationResult> m_validationResults;
+};
+
+#endif // DISPLAYCONTROLLER_CONFIG_TYPES_H
@@ -0,0 +1,161 @@
+#include "ConfigValidation.h"
+#include <climits>
+
+namespace ConfigValidation
+{
+
+ConfigValidationResult ValidateValue(const nlohmann::json &value,
+                                     const std::string &path,
+                                     const std::string &expectedType)
+{
+    ConfigValidationResult result;
+    result.path = path;
+    result.expectedType = expectedType;
+
+    if (expectedType == "string" && !value.is_string())
+    {
+        result.isValid = false;
+        result.actualType = value.type_name();
+        result.value = value.dump();
+        result.message = "文字列である必要があります";
+    }
+    else if (expectedType == "number" && !value.is_number())
+    {
+        result.isValid = false;
+        result.actualType = value.type_name();
+        result.value = value.dump();
+        result.message = "数値である必要があります";
+    }
+    else if (expectedType == "object" && !value.is_object())
+    {
+        result.isValid = false;
+        result.actualType = value.type_name();
+        result.value = value.dump();
+        result.message = "オブジェクトである必要があります";
+    }
+    else if (expectedType == "array" && !value.is_array())
+    {
+        result.isValid = false;
+        result.actualType = value.type_name();
+        result.value = value.dump();
+        result.message = "配列である必要があります";
+    }
+
+    return result;
+}
+
+ConfigValidationResult ValidateNumber(const nlohmann::json &value,
+                                      const std::string &path,
+                                      int min,
+                                      int max)
+{
+    auto result = ValidateValue(value, path, "number");
+    if (!result.isValid)
+        return result;
+
+    int numValue = value.get<int>();
+    if (numValue < min || numValue > max)
+    {
+        result.isValid = false;
+        result.value = std::to_string(numValue);
+        result.message = std::to_string(min) + "から" + std::to_string(max) + "の範囲である必要があります";
+    }
+
+    return result;
+}
+
+ConfigValidationResult ValidateString(const nlohmann::json &value,
+                                      const std::string &path,
+                                      bool allowEmpty)
+{
+    auto result = ValidateValue(value, path, "string");
+    if (!result.isValid)
+        return result;
+
+    std::string strValue = value.get<std::string>();
+    if (!allowEmpty && strValue.empty())
+    {
+        result.isValid = false;
+        result.value = strValue;
+        result.message = "空の文字列は許可されていません";
+    }
+
+    return result;
+}
+
+CalibrationSettings ParseCalibration(const nlohmann::json &device,
+                                     const std::string &devicePath,
+                                     const std::string &deviceId)
+{
+    CalibrationSettings settings;
+
+    if (device.contains("calibration"))
+    {
+        const auto &calibration = device["calibration"];
+        std::string calibrationPath = devicePath + ".calibration";
+
+        try
+        {
+            if (calibration.contains("min_raw_value"))
+            {
+                if (calibration["min_raw_value"].is_null())
+                {
+                    throw ConfigException(ConfigValidationResult{
+                        false,
+                        calibrationPath + ".min_raw_value",
+                        "number",
+                        "null",
+                        "null",
+                        "min_raw_valueがnullです"});
+                }
+                auto result = ValidateNumber(calibration["min_raw_value"], calibrationPath + ".min_raw_value", 0, INT_MAX);
+                if (!result.isValid)
+                    throw ConfigException(result);
+                settings.minRawValue = calibration["min_raw_value"].get<int>();
+            }
+
+            if (calibration.contains("max_raw_value"))
+            {
+                if (calibration["max_raw_value"].is_null())
+                {
+                    throw ConfigException(ConfigValidationResult{
+                        false,
+                        calibrationPath + ".max_raw_value",
+                        "number",
+                        "null",
+                        "null",
+                        "max_raw_valueがnullです"});
+                }
+                auto result = ValidateNumber(calibration["max_raw_value"], calibrationPath + ".max_raw_value", 0, INT_MAX);
+                if (!result.isValid)
+                    throw ConfigException(result);
+                settings.maxRawValue = calibration["max_raw_value"].get<int>();
+            }
+        }
+        catch (const nlohmann::json::type_error &e)
+        {
+            throw ConfigException(ConfigValidationResult{
+                false,
+                calibrationPath,
+                "number",
+                "invalid",
+                "",
+                "キャリブレーション設定の値が不正です: " + std::string(e.what())});
+        }
+    }
+
+    if (!settings.IsValid())
+    {
+        throw ConfigException(ConfigValidationResult{
+            false,
+            devicePath + ".calibration",
+            "",
+            "",
+            "min_raw_value: " + std::to_string(settings.minRawValue) +
+                ", max_raw_value: " + std::to_string(settings.maxRawValue),
+            "不正なキャリブレーション設定です: " + deviceId});
+    }
+    return settings;
+}
+
+} // namespace ConfigValidation
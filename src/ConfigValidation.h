@@ -0,0 +1,31 @@
+#ifndef DISPLAYCONTROLLER_CONFIG_VALIDATION_H
+#define DISPLAYCONTROLLER_CONFIG_VALIDATION_H
+
+#include "ConfigTypes.h"
+#include <string>
+#include <nlohmann/json.hpp>
+
+// 設定値のバリデーションヘルパー（ConfigManagerとConfigSnapshotで共有する）
+namespace ConfigValidation
+{
+    ConfigValidationResult ValidateValue(const nlohmann::json &value,
+                                         const std::string &path,
+                                         const std::string &expectedType);
+    ConfigValidationResult ValidateNumber(const nlohmann::json &value,
+                                          const std::string &path,
+                                          int min,
+                                          int max);
+    ConfigValidationResult ValidateString(const nlohmann::json &value,
+                                          const std::string &path,
+                                          bool allowEmpty = false);
+
+    /**
+     * @brief デバイス設定のcalibrationを読み取る
+     * @throws ConfigException 値が不正な場合
+     */
+    CalibrationSettings ParseCalibration(const nlohmann::json &device,
+                                         const std::string &devicePath,
+                                         const std::string &deviceId);
+}
+
+#endif // DISPLAYCONTROLLER_CONFIG_VALIDATION_H
@@ -0,0 +1,256 @@
+#include "DisplayBackend.h"
+
+#ifdef __linux__
+
+#include "DdcCiProtocol.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <linux/i2c-dev.h>
+#include <map>
+#include <mutex>
+#include <sys/ioctl.h>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+    // 処理中の応答（nullメッセージ）や通信エラーの場合に送り直す回数
+    constexpr int kMaxAttempts = 3;
+
+    std::optional<std::string> ReadTextFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path);
+        if (!file) {
+            return std::nullopt;
+        }
+        std::string text;
+        std::getline(file, text);
+        return text;
+    }
+
+    std::vector<uint8_t> ReadBinaryFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return {};
+        }
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // コネクターのDDCに使うI2Cバスの名前（例: i2c-5）。見つからない場合は空
+    std::string FindDdcBus(const std::filesystem::path& connector)
+    {
+        std::error_code error;
+        auto ddc = std::filesystem::read_symlink(connector / "ddc", error);
+        if (!error) {
+            return ddc.filename().string();
+        }
+        // DisplayPortではAUXチャネルのI2Cアダプターがコネクターの下にある
+        for (const auto& entry : std::filesystem::directory_iterator(connector, error)) {
+            std::string name = entry.path().filename().string();
+            if (name.rfind("i2c-", 0) == 0) {
+                return name;
+            }
+        }
+        return {};
+    }
+
+    class DdcCiDisplayBackend : public IDisplayBackend {
+    public:
+        DdcCiDisplayBackend(std::filesystem::path drmRoot, std::filesystem::path devRoot)
+            : m_drmRoot(std::move(drmRoot))
+            , m_devRoot(std::move(devRoot))
+        {
+        }
+
+        std::vector<DisplayDescriptor> EnumerateDisplays() override
+        {
+            std::vector<DisplayDescriptor> displays;
+            std::error_code error;
+            std::vector<std::filesystem::path> connectors;
+            for (const auto& entry : std::filesystem::directory_iterator(m_drmRoot, error)) {
+                // card0-DP-1 のようなコネクターだけを対象とする（card0 自体は除く）
+                std::string name = entry.path().filename().string();
+                if (name.rfind("card", 0) == 0 && name.find('-') != std::string::npos) {
+                    connectors.push_back(entry.path());
+                }
+            }
+            // 列挙順を安定させる
+            std::sort(connectors.begin(), connectors.end());
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (const auto& connector : connectors) {
+                std::string name = connector.filename().string();
+                // 内蔵パネルはDDC/CIに対応していないため、バックライトのバックエンドで扱う
+                if (name.find("-eDP-") != std::string::npos || name.find("-LVDS-") != std::string::npos) {
+                    continue;
+                }
+                if (ReadTextFile(connector / "status").value_or("") != "connected") {
+                    continue;
+                }
+                std::string bus = FindDdcBus(connector);
+                if (bus.empty()) {
+                    continue;
+                }
+
+                DisplayDescriptor display;
+                display.id = AllocateId(name);
+                display.deviceName.assign(name.begin(), name.end());
+                display.connector = name;
+                display.edid = ReadBinaryFile(connector / "edid");
+                m_devices.insert_or_assign(display.id, Device{m_devRoot / bus, std::stoi(bus.substr(4))});
+                displays.push_back(std::move(display));
+            }
+            return displays;
+        }
+
+        std::uintptr_t GetBusId(MonitorId id) override
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_devices.find(id);
+            return it != m_devices.end() ? static_cast<std::uintptr_t>(it->second.busNumber) : reinterpret_cast<std::uintptr_t>(id);
+        }
+
+        PhysicalMonitorHandle OpenPhysicalMonitor(MonitorId id) override
+        {
+            std::filesystem::path path;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_devices.find(id);
+                if (it == m_devices.end()) {
+                    throw DisplayControllerException("列挙されていないモニターです");
+                }
+                path = it->second.path;
+            }
+
+            int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+            if (fd < 0) {
+                throw DisplayControllerException("I2Cデバイスを開けません: " + path.string() + ": " + std::strerror(errno));
+            }
+            if (::ioctl(fd, I2C_SLAVE, kDdcCiAddress) < 0) {
+                std::string reason = std::strerror(errno);
+                ::close(fd);
+                throw DisplayControllerException("DDC/CIのアドレスを設定できません: " + path.string() + ": " + reason);
+            }
+
+            auto connection = std::make_unique<Connection>();
+            connection->fd = fd;
+            return connection.release();
+        }
+
+        void ClosePhysicalMonitor(PhysicalMonitorHandle handle) override
+        {
+            std::unique_ptr<Connection> connection(static_cast<Connection*>(handle));
+            if (connection) {
+                ::close(connection->fd);
+            }
+        }
+
+        bool GetBrightness(PhysicalMonitorHandle handle,
+            unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override
+        {
+            return GetVcp(handle, kVcpBrightness, minValue, currentValue, maxValue);
+        }
+
+        bool SetBrightness(PhysicalMonitorHandle handle, unsigned long value) override
+        {
+            auto& connection = *static_cast<Connection*>(handle);
+            std::lock_guard<std::mutex> lock(connection.mutex);
+            auto request = EncodeDdcSetVcpRequest(kVcpBrightness, static_cast<uint16_t>(std::min(value, 0xFFFFul)));
+            for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+                WaitForBus(connection);
+                bool written = Write(connection, request);
+                connection.nextCommand = std::chrono::steady_clock::now() + kDdcSetVcpDelay;
+                if (written) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool GetContrast(PhysicalMonitorHandle handle,
+            unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override
+        {
+            return GetVcp(handle, kVcpContrast, minValue, currentValue, maxValue);
+        }
+
+    private:
+        struct Device {
+            std::filesystem::path path;
+            int busNumber = 0;
+        };
+
+        // 開いたI2Cデバイス（同じモニターへの要求は規格の間隔を空けて1つずつ送る）
+        struct Connection {
+            int fd = -1;
+            std::mutex mutex;
+            std::chrono::steady_clock::time_point nextCommand{};
+        };
+
+        // コネクター名ごとにプロセス内で変わらないIDを割り当てる（m_mutexを保持した状態で呼ぶ）
+        MonitorId AllocateId(const std::string& connector)
+        {
+            auto [it, inserted] = m_ids.try_emplace(connector, nullptr);
+            if (inserted) {
+                it->second = reinterpret_cast<MonitorId>(m_ids.size());
+            }
+            return it->second;
+        }
+
+        static void WaitForBus(const Connection& connection)
+        {
+            std::this_thread::sleep_until(connection.nextCommand);
+        }
+
+        static bool Write(Connection& connection, const std::vector<uint8_t>& data)
+        {
+            return ::write(connection.fd, data.data(), data.size()) == static_cast<ssize_t>(data.size());
+        }
+
+        bool GetVcp(PhysicalMonitorHandle handle, uint8_t code,
+            unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue)
+        {
+            auto& connection = *static_cast<Connection*>(handle);
+            std::lock_guard<std::mutex> lock(connection.mutex);
+            auto request = EncodeDdcGetVcpRequest(code);
+            for (int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+                WaitForBus(connection);
+                if (!Write(connection, request)) {
+                    connection.nextCommand = std::chrono::steady_clock::now() + kDdcSetVcpDelay;
+                    continue;
+                }
+                std::this_thread::sleep_for(kDdcGetVcpReplyDelay);
+
+                std::vector<uint8_t> reply(kDdcGetVcpReplySize);
+                ssize_t size = ::read(connection.fd, reply.data(), reply.size());
+                connection.nextCommand = std::chrono::steady_clock::now() + kDdcSetVcpDelay;
+                if (size != static_cast<ssize_t>(reply.size())) {
+                    continue;
+                }
+                if (auto value = DecodeDdcGetVcpReply(reply, code)) {
+                    minValue = 0;
+                    currentValue = value->current;
+                    maxValue = value->maximum;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        std::filesystem::path m_drmRoot;
+        std::filesystem::path m_devRoot;
+        std::mutex m_mutex;
+        std::map<std::string, MonitorId> m_ids;
+        std::map<MonitorId, Device> m_devices;
+    };
+}
+
+std::unique_ptr<IDisplayBackend> CreateDdcCiDisplayBackend(const std::filesystem::path& drmRoot, const std::filesystem::path& devRoot)
+{
+    return std::make_unique<DdcCiDisplayBackend>(drmRoot, devRoot);
+}
+
+#endif // __linux__
@@ -0,0 +1,69 @@
+#include "DdcCiProtocol.h"
+
+namespace {
+    // ホストのアドレス（要求の送信元）と、応答のチェックサムに使う仮想的なホストのアドレス
+    constexpr uint8_t kHostAddress = 0x51;
+    constexpr uint8_t kReplyChecksumSeed = 0x50;
+    // モニターの書き込みアドレス（要求のチェックサムに含める）
+    constexpr uint8_t kDisplayWriteAddress = kDdcCiAddress << 1;
+
+    constexpr uint8_t kGetVcpOpcode = 0x01;
+    constexpr uint8_t kGetVcpReplyOpcode = 0x02;
+    constexpr uint8_t kSetVcpOpcode = 0x03;
+    constexpr uint8_t kLengthFlag = 0x80;
+
+    std::vector<uint8_t> EncodeRequest(const std::vector<uint8_t>& payload)
+    {
+        std::vector<uint8_t> packet;
+        packet.reserve(payload.size() + 3);
+        packet.push_back(kHostAddress);
+        packet.push_back(static_cast<uint8_t>(kLengthFlag | payload.size()));
+        packet.insert(packet.end(), payload.begin(), payload.end());
+
+        uint8_t checksum = kDisplayWriteAddress;
+        for (uint8_t byte : packet) {
+            checksum ^= byte;
+        }
+        packet.push_back(checksum);
+        return packet;
+    }
+}
+
+std::vector<uint8_t> EncodeDdcGetVcpRequest(uint8_t code)
+{
+    return EncodeRequest({kGetVcpOpcode, code});
+}
+
+std::vector<uint8_t> EncodeDdcSetVcpRequest(uint8_t code, uint16_t value)
+{
+    return EncodeRequest({kSetVcpOpcode, code, static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value & 0xFF)});
+}
+
+std::optional<DdcVcpValue> DecodeDdcGetVcpReply(const std::vector<uint8_t>& reply, uint8_t code)
+{
+    if (reply.size() < kDdcGetVcpReplySize) {
+        return std::nullopt;
+    }
+    // 送信元（モニター）・長さ（本体8バイト）
+    if (reply[0] != kDisplayWriteAddress || reply[1] != (kLengthFlag | 8)) {
+        return std::nullopt;
+    }
+
+    uint8_t checksum = kReplyChecksumSeed;
+    for (size_t i = 0; i < kDdcGetVcpReplySize - 1; ++i) {
+        checksum ^= reply[i];
+    }
+    if (checksum != reply[kDdcGetVcpReplySize - 1]) {
+        return std::nullopt;
+    }
+
+    // 本体: オペコード・結果（0: 成功、1: 対応していないVCPコード）・VCPコード・種類・最大値・現在値
+    if (reply[2] != kGetVcpReplyOpcode || reply[3] != 0x00 || reply[4] != code) {
+        return std::nullopt;
+    }
+
+    DdcVcpValue value;
+    value.maximum = static_cast<uint16_t>((reply[6] << 8) | reply[7]);
+    value.current = static_cast<uint16_t>((reply[8] << 8) | reply[9]);
+    return value;
+}
@@ -0,0 +1,44 @@
+#ifndef DISPLAYCONTROLLER_DDC_CI_PROTOCOL_H
+#define DISPLAYCONTROLLER_DDC_CI_PROTOCOL_H
+
+#include "MonitorBackend.h"
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// DDC/CI（VESA DDC/CI 1.1）のVCPコード
+constexpr uint8_t kVcpBrightness = 0x10;
+constexpr uint8_t kVcpContrast = 0x12;
+
+// モニターのI2Cアドレス（7ビット）
+constexpr uint8_t kDdcCiAddress = 0x37;
+
+// VCP値の取得要求の応答の長さ（送信元・長さ・8バイトの本体・チェックサム）
+constexpr size_t kDdcGetVcpReplySize = 11;
+
+// 要求の後、応答を読むまで・次の要求を送るまでに待つ時間（規格の最小値）
+constexpr std::chrono::milliseconds kDdcGetVcpReplyDelay{40};
+constexpr std::chrono::milliseconds kDdcSetVcpDelay{50};
+
+struct DdcVcpValue {
+    uint16_t current = 0;
+    uint16_t maximum = 0;
+};
+
+/**
+ * @brief VCP値の取得要求（I2Cで送るバイト列。宛先アドレスはI2Cの層で付加される）
+ */
+DISPLAYCONTROLLER_API std::vector<uint8_t> EncodeDdcGetVcpRequest(uint8_t code);
+
+// VCP値の設定要求
+DISPLAYCONTROLLER_API std::vector<uint8_t> EncodeDdcSetVcpRequest(uint8_t code, uint16_t value);
+
+/**
+ * @brief VCP値の取得要求への応答を解析する
+ * @return チェックサム・長さ・VCPコードが正しく、モニターが対応している場合だけ値を返す
+ *         （処理中を表すnullメッセージや、対応していないVCPコードの場合はnullopt）
+ */
+DISPLAYCONTROLLER_API std::optional<DdcVcpValue> DecodeDdcGetVcpReply(const std::vector<uint8_t>& reply, uint8_t code);
+
+#endif // DISPLAYCONTROLLER_DDC_CI_PROTOCOL_H
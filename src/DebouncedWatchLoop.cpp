@@ -0,0 +1,62 @@
+#include "DebouncedWatchLoop.h"
+
+namespace {
+    // 通知を待つ間隔（停止はCancelで起床するため、長くてよい）
+    constexpr std::chrono::milliseconds kIdleWait = std::chrono::hours(1);
+}
+
+DebouncedWatchLoop::~DebouncedWatchLoop()
+{
+    Stop();
+}
+
+void DebouncedWatchLoop::Start(std::chrono::milliseconds debounce, WaitForChange waitForChange, Cancel cancel, OnSettled onSettled)
+{
+    m_debounce = debounce;
+    m_waitForChange = std::move(waitForChange);
+    m_cancel = std::move(cancel);
+    m_onSettled = std::move(onSettled);
+    m_stopping = false;
+    m_thread = std::thread(&DebouncedWatchLoop::Run, this);
+}
+
+void DebouncedWatchLoop::Stop()
+{
+    m_stopping = true;
+    if (m_cancel) {
+        m_cancel();
+    }
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+uint64_t DebouncedWatchLoop::GetEventCount() const
+{
+    return m_events.load();
+}
+
+void DebouncedWatchLoop::Run()
+{
+    while (!m_stopping) {
+        if (!m_waitForChange(kIdleWait)) {
+            continue;
+        }
+        ++m_events;
+
+        // 変更が終わるまでに届く後続の通知をまとめる
+        while (!m_stopping && m_waitForChange(m_debounce)) {
+            ++m_events;
+        }
+        if (m_stopping) {
+            break;
+        }
+
+        try {
+            m_onSettled();
+        }
+        catch (...) {
+            // 監視は続ける（エラーの通知は呼び出し側で行う）
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef DISPLAYCONTROLLER_DEBOUNCED_WATCH_LOOP_H
+#define DISPLAYCONTROLLER_DEBOUNCED_WATCH_LOOP_H
+
+#include "MonitorBackend.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+/**
+ * @brief 変更通知を待ち、通知が落ち着いてから処理を呼び出す監視スレッド
+ *
+ * 短い間に続けて届く通知をまとめるため、最後の通知から debounce の間
+ * 新しい通知がなくなるまで待ってから onSettled を1回呼び出します。
+ * ファイルの監視（FileWatcher）とディスプレイ構成の監視（DisplayChangeWatcher）で共通の処理です。
+ */
+class DISPLAYCONTROLLER_API DebouncedWatchLoop {
+public:
+    // 変更を待つ（変更があればtrue、タイムアウトまたはキャンセルで戻った場合はfalse）
+    using WaitForChange = std::function<bool(std::chrono::milliseconds)>;
+    // 待機中の WaitForChange をすぐに戻す
+    using Cancel = std::function<void()>;
+    using OnSettled = std::function<void()>;
+
+    DebouncedWatchLoop() = default;
+    ~DebouncedWatchLoop();
+
+    DebouncedWatchLoop(const DebouncedWatchLoop&) = delete;
+    DebouncedWatchLoop& operator=(const DebouncedWatchLoop&) = delete;
+
+    /**
+     * @brief 監視スレッドを開始する
+     *
+     * onSettled は監視スレッドから呼ばれます。onSettled が投げた例外は無視して監視を続けます
+     * （エラーの通知は呼び出し側で行う）。
+     */
+    void Start(std::chrono::milliseconds debounce, WaitForChange waitForChange, Cancel cancel, OnSettled onSettled);
+
+    // 監視スレッドを停止して終了を待つ（何度呼んでもよい）
+    void Stop();
+
+    // 受け取った変更通知の数
+    uint64_t GetEventCount() const;
+
+private:
+    void Run();
+
+    std::chrono::milliseconds m_debounce{0};
+    WaitForChange m_waitForChange;
+    Cancel m_cancel;
+    OnSettled m_onSettled;
+    std::atomic<bool> m_stopping{false};
+    std::atomic<uint64_t> m_events{0};
+    std::thread m_thread;
+};
+
+#endif // DISPLAYCONTROLLER_DEBOUNCED_WATCH_LOOP_H
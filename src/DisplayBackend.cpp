@@ -0,0 +1,153 @@
+#include "DisplayBackend.h"
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+    class EmptyDisplayBackend : public IDisplayBackend {
+    public:
+        std::vector<DisplayDescriptor> EnumerateDisplays() override { return {}; }
+
+        PhysicalMonitorHandle OpenPhysicalMonitor(MonitorId) override
+        {
+            throw DisplayControllerException("この環境ではモニターを操作できません");
+        }
+
+        void ClosePhysicalMonitor(PhysicalMonitorHandle) override {}
+
+        bool GetBrightness(PhysicalMonitorHandle, unsigned long&, unsigned long&, unsigned long&) override { return false; }
+        bool SetBrightness(PhysicalMonitorHandle, unsigned long) override { return false; }
+        bool GetContrast(PhysicalMonitorHandle, unsigned long&, unsigned long&, unsigned long&) override { return false; }
+    };
+
+    class CompositeDisplayBackend : public IDisplayBackend {
+    public:
+        explicit CompositeDisplayBackend(std::vector<std::unique_ptr<IDisplayBackend>> backends)
+            : m_backends(std::move(backends))
+        {
+            for (const auto& backend : m_backends) {
+                if (!backend) {
+                    throw std::invalid_argument("バックエンドがnullです");
+                }
+            }
+        }
+
+        std::vector<DisplayDescriptor> EnumerateDisplays() override
+        {
+            std::vector<DisplayDescriptor> displays;
+            for (size_t i = 0; i < m_backends.size(); ++i) {
+                for (auto& display : m_backends[i]->EnumerateDisplays()) {
+                    display.id = MapId(i, display.id);
+                    displays.push_back(std::move(display));
+                }
+            }
+            return displays;
+        }
+
+        std::uintptr_t GetBusId(MonitorId id) override
+        {
+            std::pair<size_t, MonitorId> route;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_routes.find(id);
+                if (it == m_routes.end()) {
+                    return reinterpret_cast<std::uintptr_t>(id);
+                }
+                route = it->second;
+            }
+            // 異なるバックエンドのモニターは別の経路として扱う（重なっても並行度が下がるだけ）
+            return (m_backends[route.first]->GetBusId(route.second) << 4) ^ route.first;
+        }
+
+        PhysicalMonitorHandle OpenPhysicalMonitor(MonitorId id) override
+        {
+            auto [index, childId] = Resolve(id);
+            auto entry = std::make_unique<HandleEntry>();
+            entry->backend = m_backends[index].get();
+            entry->handle = entry->backend->OpenPhysicalMonitor(childId);
+            return entry.release();
+        }
+
+        void ClosePhysicalMonitor(PhysicalMonitorHandle handle) override
+        {
+            std::unique_ptr<HandleEntry> entry(static_cast<HandleEntry*>(handle));
+            if (entry) {
+                entry->backend->ClosePhysicalMonitor(entry->handle);
+            }
+        }
+
+        bool GetBrightness(PhysicalMonitorHandle handle,
+            unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override
+        {
+            auto* entry = static_cast<HandleEntry*>(handle);
+            return entry->backend->GetBrightness(entry->handle, minValue, currentValue, maxValue);
+        }
+
+        bool SetBrightness(PhysicalMonitorHandle handle, unsigned long value) override
+        {
+            auto* entry = static_cast<HandleEntry*>(handle);
+            return entry->backend->SetBrightness(entry->handle, value);
+        }
+
+        bool GetContrast(PhysicalMonitorHandle handle,
+            unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override
+        {
+            auto* entry = static_cast<HandleEntry*>(handle);
+            return entry->backend->GetContrast(entry->handle, minValue, currentValue, maxValue);
+        }
+
+    private:
+        struct HandleEntry {
+            IDisplayBackend* backend = nullptr;
+            PhysicalMonitorHandle handle = nullptr;
+        };
+
+        // 子のバックエンドのIDに、プロセス内で変わらないIDを割り当てる
+        MonitorId MapId(size_t index, MonitorId childId)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto [it, inserted] = m_ids.try_emplace({index, childId}, nullptr);
+            if (inserted) {
+                it->second = reinterpret_cast<MonitorId>(m_routes.size() + 1);
+                m_routes.emplace(it->second, std::make_pair(index, childId));
+            }
+            return it->second;
+        }
+
+        std::pair<size_t, MonitorId> Resolve(MonitorId id)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_routes.find(id);
+            if (it == m_routes.end()) {
+                throw DisplayControllerException("列挙されていないモニターです");
+            }
+            return it->second;
+        }
+
+        std::vector<std::unique_ptr<IDisplayBackend>> m_backends;
+        std::mutex m_mutex;
+        std::map<std::pair<size_t, MonitorId>, MonitorId> m_ids;
+        std::unordered_map<MonitorId, std::pair<size_t, MonitorId>> m_routes;
+    };
+}
+
+std::unique_ptr<IDisplayBackend> CreateCompositeDisplayBackend(std::vector<std::unique_ptr<IDisplayBackend>> backends)
+{
+    return std::make_unique<CompositeDisplayBackend>(std::move(backends));
+}
+
+std::unique_ptr<IDisplayBackend> CreateDisplayBackend()
+{
+#if defined(_WIN32)
+    return CreateWin32DisplayBackend();
+#elif defined(__linux__)
+    std::vector<std::unique_ptr<IDisplayBackend>> backends;
+    backends.push_back(CreateBacklightDisplayBackend());
+    backends.push_back(CreateDdcCiDisplayBackend());
+    return CreateCompositeDisplayBackend(std::move(backends));
+#else
+    return std::make_unique<EmptyDisplayBackend>();
+#endif
+}
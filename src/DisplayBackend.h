@@ -0,0 +1,96 @@
+#ifndef DISPLAYCONTROLLER_DISPLAY_BACKEND_H
+#define DISPLAYCONTROLLER_DISPLAY_BACKEND_H
+
+#include "MonitorBackend.h"
+#include "MonitorTopology.h"
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief バックエンドが列挙したディスプレイ
+ *
+ * バックエンドが読み取れた項目だけを設定します（読み取れない項目は既定値のまま）。
+ */
+struct DisplayDescriptor {
+    MonitorId id = nullptr;
+    std::wstring deviceName;            // OSのデバイス名（例: \\.\DISPLAY1、card0-DP-1、intel_backlight）
+    std::string connector;              // 接続先の識別子（シリアル番号のないモニターの識別に使う）
+    bool isPrimary = false;
+    MonitorTopology::Bounds bounds;
+
+    // OSから取得した物理サイズ（mm、0は不明）。EDIDに物理サイズがある場合はそちらを優先する
+    int widthMm = 0;
+    int heightMm = 0;
+
+    std::vector<uint8_t> edid;          // 読み取れない場合は空
+};
+
+/**
+ * @brief ディスプレイの列挙と物理モニター操作をまとめたプラットフォームごとのバックエンド
+ *
+ * MonitorControllerはこのインターフェースだけを通してOSへアクセスするため、
+ * 輝度の変換・遷移・送出などの処理はどのプラットフォームでも同じように動作します。
+ *
+ * 実装:
+ * - Windows: EnumDisplayMonitors・SetupAPI（EDID）・Dxva2（DDC/CI）
+ * - Linux: i2c-devによるDDC/CI（外部モニター）と /sys/class/backlight（ノートPCの内蔵パネル）
+ * - SimulatedDisplayBackend: メモリ上のモニター（テストやベンチマーク用）
+ */
+DISPLAYCONTROLLER_INTERFACE IDisplayBackend : public IMonitorBackend {
+public:
+    /**
+     * @brief 接続中のディスプレイを列挙する（モニターの一覧の作成ごとに1回だけ呼ばれる）
+     * @throws DisplayControllerException 列挙できなかった場合
+     */
+    virtual std::vector<DisplayDescriptor> EnumerateDisplays() = 0;
+
+    /**
+     * @brief 物理モニターへの通信経路の識別子
+     *
+     * 同じ値のモニターへの書き込みは順番に、異なる値のモニターへの書き込みは並行して送出します。
+     */
+    virtual std::uintptr_t GetBusId(MonitorId id) { return reinterpret_cast<std::uintptr_t>(id); }
+};
+
+// 実行環境に合ったバックエンド（Windows: Win32、Linux: バックライトとDDC/CIをまとめたもの、その他: モニターなし）
+DISPLAYCONTROLLER_API std::unique_ptr<IDisplayBackend> CreateDisplayBackend();
+
+/**
+ * @brief 複数のバックエンドのディスプレイをまとめて1つのバックエンドとして扱う
+ *
+ * 子のバックエンドのIDが重ならないよう、まとめたバックエンド側でIDを割り当て直します。
+ * @throws std::invalid_argument nullのバックエンドが含まれる場合
+ */
+DISPLAYCONTROLLER_API std::unique_ptr<IDisplayBackend> CreateCompositeDisplayBackend(
+    std::vector<std::unique_ptr<IDisplayBackend>> backends);
+
+#ifdef _WIN32
+DISPLAYCONTROLLER_API std::unique_ptr<IDisplayBackend> CreateWin32DisplayBackend();
+#endif
+
+#ifdef __linux__
+/**
+ * @brief i2c-devを通してDDC/CIで外部モニターを操作するバックエンド
+ *
+ * drmRootのコネクター（card0-DP-1など）からEDIDとDDCのI2Cバスを調べ、devRootの
+ * i2c-Nデバイスで通信します。内蔵パネル（eDP・LVDS）はバックライトのバックエンドで扱うため含めません。
+ * i2c-devモジュールの読み込みと、/dev/i2c-* への読み書きの権限が必要です。
+ */
+DISPLAYCONTROLLER_API std::unique_ptr<IDisplayBackend> CreateDdcCiDisplayBackend(
+    const std::filesystem::path& drmRoot = "/sys/class/drm", const std::filesystem::path& devRoot = "/dev");
+
+/**
+ * @brief /sys/class/backlight でノートPCの内蔵パネルの輝度を操作するバックエンド
+ *
+ * 同じパネルを操作するインターフェースが複数ある場合は、カーネルの推奨に従って
+ * firmware・platform・rawの順に1つだけを使います。書き込みにはbrightnessファイルへの
+ * 書き込み権限（udevルールなど）が必要です。
+ */
+DISPLAYCONTROLLER_API std::unique_ptr<IDisplayBackend> CreateBacklightDisplayBackend(
+    const std::filesystem::path& root = "/sys/class/backlight");
+#endif
+
+#endif // DISPLAYCONTROLLER_DISPLAY_BACKEND_H
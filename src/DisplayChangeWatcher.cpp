@@ -0,0 +1,74 @@
+#include "DisplayChangeWatcher.h"
+#include <stdexcept>
+
+void DisplayChangeSignal::Notify()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_pending;
+    }
+    m_changed.notify_all();
+}
+
+bool DisplayChangeSignal::WaitForChange(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_changed.wait_for(lock, timeout, [this] { return m_cancelled || m_pending > 0; });
+    if (m_cancelled || m_pending == 0) {
+        return false;
+    }
+    --m_pending;
+    return true;
+}
+
+void DisplayChangeSignal::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cancelled = true;
+    }
+    m_changed.notify_all();
+}
+
+DisplayChangeWatcher::DisplayChangeWatcher(std::unique_ptr<IDisplayChangeBackend> backend, std::chrono::milliseconds debounce,
+                                           Refresh refresh, Callback onChanged)
+    : m_backend(std::move(backend))
+    , m_refresh(std::move(refresh))
+    , m_onChanged(std::move(onChanged))
+{
+    if (!m_backend) {
+        throw std::invalid_argument("ディスプレイ構成の監視のバックエンドがnullです");
+    }
+    if (!m_refresh || !m_onChanged) {
+        throw std::invalid_argument("一覧の作り直しと変更時のコールバックを指定してください");
+    }
+    if (debounce.count() < 0) {
+        throw std::invalid_argument("変更をまとめる時間は0以上である必要があります");
+    }
+    // 作り直しに失敗しても監視は続ける（次の通知で作り直す）
+    m_loop.Start(debounce,
+        [this](std::chrono::milliseconds timeout) { return m_backend->WaitForChange(timeout); },
+        [this] { m_backend->Cancel(); },
+        [this] {
+            auto change = m_refresh();
+            ++m_refreshes;
+            m_added += change.added.size();
+            m_removed += change.removed.size();
+            m_onChanged(change);
+        });
+}
+
+DisplayChangeWatcher::~DisplayChangeWatcher()
+{
+    m_loop.Stop();
+}
+
+DisplayChangeWatcher::Stats DisplayChangeWatcher::GetStats() const
+{
+    Stats stats;
+    stats.events = m_loop.GetEventCount();
+    stats.refreshes = m_refreshes.load();
+    stats.added = m_added.load();
+    stats.removed = m_removed.load();
+    return stats;
+}
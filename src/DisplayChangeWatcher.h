@@ -0,0 +1,91 @@
+#ifndef DISPLAYCONTROLLER_DISPLAY_CHANGE_WATCHER_H
+#define DISPLAYCONTROLLER_DISPLAY_CHANGE_WATCHER_H
+
+#include "DebouncedWatchLoop.h"
+#include "MonitorBackend.h"
+#include "MonitorTopology.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief ディスプレイ構成の変更通知を受け取るバックエンド
+ */
+DISPLAYCONTROLLER_INTERFACE IDisplayChangeBackend {
+public:
+    virtual ~IDisplayChangeBackend() = default;
+
+    /**
+     * @brief 構成の変更を待つ
+     * @return 変更があればtrue、タイムアウトまたはCancel()で戻った場合はfalse
+     */
+    virtual bool WaitForChange(std::chrono::milliseconds timeout) = 0;
+
+    // 待機中のWaitForChange()をすぐに戻す（以降の呼び出しも待たずに戻る）
+    virtual void Cancel() = 0;
+};
+
+/**
+ * @brief Notify() で変更を知らせるバックエンド
+ *
+ * Windowsではウィンドウメッセージ（WM_DISPLAYCHANGE・WM_DEVICECHANGE）の処理から、
+ * テストではシミュレーターから呼び出します。どのスレッドから呼び出してもかまいません。
+ */
+class DISPLAYCONTROLLER_API DisplayChangeSignal : public IDisplayChangeBackend {
+public:
+    void Notify();
+
+    bool WaitForChange(std::chrono::milliseconds timeout) override;
+    void Cancel() override;
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_changed;
+    uint64_t m_pending = 0;
+    bool m_cancelled = false;
+};
+
+/**
+ * @brief ディスプレイ構成の変更を監視し、変更が落ち着いてからモニターの一覧を作り直す
+ *
+ * モニターの接続や解像度の変更では短い間に複数の通知が届くため、最後の通知から
+ * debounce の間新しい通知がなくなるまで待ち、refresh で一覧を1回だけ作り直します。
+ * 作り直した結果（接続・取り外し・接続し続けているモニター）をコールバックへ渡します。
+ * refresh とコールバックは監視スレッドから呼ばれます。
+ */
+class DISPLAYCONTROLLER_API DisplayChangeWatcher {
+public:
+    using Refresh = std::function<MonitorTopologyChange()>;
+    using Callback = std::function<void(const MonitorTopologyChange&)>;
+
+    struct Stats {
+        uint64_t events = 0;      // バックエンドから受け取った変更通知の数
+        uint64_t refreshes = 0;   // 一覧を作り直した回数
+        uint64_t added = 0;       // 接続されたモニターの延べ数
+        uint64_t removed = 0;     // 取り外されたモニターの延べ数
+    };
+
+    DisplayChangeWatcher(std::unique_ptr<IDisplayChangeBackend> backend, std::chrono::milliseconds debounce,
+                         Refresh refresh, Callback onChanged);
+    ~DisplayChangeWatcher();
+
+    DisplayChangeWatcher(const DisplayChangeWatcher&) = delete;
+    DisplayChangeWatcher& operator=(const DisplayChangeWatcher&) = delete;
+
+    Stats GetStats() const;
+
+private:
+    std::unique_ptr<IDisplayChangeBackend> m_backend;
+    Refresh m_refresh;
+    Callback m_onChanged;
+    std::atomic<uint64_t> m_refreshes{0};
+    std::atomic<uint64_t> m_added{0};
+    std::atomic<uint64_t> m_removed{0};
+    DebouncedWatchLoop m_loop;  // 最後に宣言し最初に破棄する（監視スレッドが参照する他のメンバーより先に停止させる）
+};
+
+#endif // DISPLAYCONTROLLER_DISPLAY_CHANGE_WATCHER_H
@@ -0,0 +1,67 @@
+#include "Dxva2MonitorBackend.h"
+
+#ifdef _WIN32
+
+#include <windows.h>
+#include <vector>
+#include <physicalmonitorenumerationapi.h>
+#include <highlevelmonitorconfigurationapi.h>
+#pragma comment(lib, "Dxva2.lib")
+
+// Windows API関数の宣言
+extern "C" {
+    BOOL WINAPI SetMonitorBrightness(HANDLE hMonitor, DWORD dwNewBrightness);
+    BOOL WINAPI DestroyPhysicalMonitor(HANDLE hMonitor);
+}
+
+PhysicalMonitorHandle Dxva2MonitorBackend::OpenPhysicalMonitor(MonitorId id)
+{
+    DWORD numberOfPhysicalMonitors = 0;
+    if (!::GetNumberOfPhysicalMonitorsFromHMONITOR(id, &numberOfPhysicalMonitors)) {
+        throw WindowsApiException("Failed to get number of physical monitors: " + std::to_string(::GetLastError()));
+    }
+
+    if (numberOfPhysicalMonitors == 0) {
+        throw WindowsApiException("No physical monitors found");
+    }
+
+    std::vector<PHYSICAL_MONITOR> physicalMonitors(numberOfPhysicalMonitors);
+    if (!::GetPhysicalMonitorsFromHMONITOR(id, numberOfPhysicalMonitors, physicalMonitors.data())) {
+        throw WindowsApiException("Failed to get physical monitors: " + std::to_string(::GetLastError()));
+    }
+
+    HANDLE handle = physicalMonitors[0].hPhysicalMonitor;
+
+    // Clean up the remaining handles if any
+    for (DWORD i = 1; i < numberOfPhysicalMonitors; ++i) {
+        DestroyPhysicalMonitor(physicalMonitors[i].hPhysicalMonitor);
+    }
+
+    return handle;
+}
+
+void Dxva2MonitorBackend::ClosePhysicalMonitor(PhysicalMonitorHandle handle)
+{
+    if (handle) {
+        DestroyPhysicalMonitor(handle);
+    }
+}
+
+bool Dxva2MonitorBackend::GetBrightness(PhysicalMonitorHandle handle,
+    unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue)
+{
+    return ::GetMonitorBrightness(handle, &minValue, &currentValue, &maxValue) != FALSE;
+}
+
+bool Dxva2MonitorBackend::SetBrightness(PhysicalMonitorHandle handle, unsigned long value)
+{
+    return SetMonitorBrightness(handle, value) != FALSE;
+}
+
+bool Dxva2MonitorBackend::GetContrast(PhysicalMonitorHandle handle,
+    unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue)
+{
+    return ::GetMonitorContrast(handle, &minValue, &currentValue, &maxValue) != FALSE;
+}
+
+#endif // _WIN32
@@ -0,0 +1,24 @@
+#ifndef DISPLAYCONTROLLER_DXVA2_MONITOR_BACKEND_H
+#define DISPLAYCONTROLLER_DXVA2_MONITOR_BACKEND_H
+
+#include "MonitorBackend.h"
+
+#ifdef _WIN32
+
+/**
+ * @brief Dxva2 API（High-Level Monitor Configuration API）を使用するバックエンド
+ */
+class DISPLAYCONTROLLER_API Dxva2MonitorBackend : public IMonitorBackend {
+public:
+    PhysicalMonitorHandle OpenPhysicalMonitor(MonitorId id) override;
+    void ClosePhysicalMonitor(PhysicalMonitorHandle handle) override;
+    bool GetBrightness(PhysicalMonitorHandle handle,
+        unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override;
+    bool SetBrightness(PhysicalMonitorHandle handle, unsigned long value) override;
+    bool GetContrast(PhysicalMonitorHandle handle,
+        unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override;
+};
+
+#endif // _WIN32
+
+#endif // DISPLAYCONTROLLER_DXVA2_MONITOR_BACKEND_H
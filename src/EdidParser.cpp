@@ -0,0 +1,284 @@
+#include "EdidParser.h"
+#include "Fnv1a.h"
+
+namespace {
+    constexpr size_t EDID_BLOCK_SIZE = 128;
+    constexpr size_t DESCRIPTOR_OFFSET = 54;
+    constexpr size_t DESCRIPTOR_SIZE = 18;
+    constexpr size_t DESCRIPTOR_COUNT = 4;
+    constexpr size_t EXTENSION_COUNT_OFFSET = 126;
+
+    constexpr uint8_t SERIAL_DESCRIPTOR_TAG = 0xFF;
+    constexpr uint8_t TEXT_DESCRIPTOR_TAG = 0xFE;
+    constexpr uint8_t NAME_DESCRIPTOR_TAG = 0xFC;
+
+    constexpr uint8_t DISPLAYID_EXTENSION_TAG = 0x70;
+    // DisplayID 1.x と 2.x でデータブロックのタグが異なる
+    constexpr uint8_t DISPLAYID_PRODUCT_ID_V1 = 0x00;
+    constexpr uint8_t DISPLAYID_DISPLAY_PARAMS_V1 = 0x01;
+    constexpr uint8_t DISPLAYID_PRODUCT_ID_V2 = 0x20;
+    constexpr uint8_t DISPLAYID_DISPLAY_PARAMS_V2 = 0x21;
+
+    uint16_t ReadLe16(const uint8_t* p)
+    {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+
+    uint32_t ReadLe32(const uint8_t* p)
+    {
+        return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+               (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+    }
+
+    bool IsBlockChecksumValid(const uint8_t* block)
+    {
+        uint8_t sum = 0;
+        for (size_t i = 0; i < EDID_BLOCK_SIZE; ++i) {
+            sum = static_cast<uint8_t>(sum + block[i]);
+        }
+        return sum == 0;
+    }
+
+    // 記述子などの文字列（改行で終わり、残りは空白で埋められる）。表示できない文字は除く
+    std::string ReadText(const uint8_t* p, size_t length)
+    {
+        std::string text;
+        for (size_t i = 0; i < length; ++i) {
+            char c = static_cast<char>(p[i]);
+            if (c == '\n' || c == '\0') {
+                break;
+            }
+            if (c >= 0x20 && c <= 0x7E) {
+                text += c;
+            }
+        }
+        while (!text.empty() && text.back() == ' ') {
+            text.pop_back();
+        }
+        return text;
+    }
+
+    EdidDetailedTiming ReadDetailedTiming(const uint8_t* d)
+    {
+        EdidDetailedTiming timing;
+        timing.pixelClockKHz = static_cast<uint32_t>(ReadLe16(d)) * 10;
+        timing.horizontalActive = d[2] | ((d[4] & 0xF0) << 4);
+        timing.verticalActive = d[5] | ((d[7] & 0xF0) << 4);
+        timing.widthMm = d[12] | ((d[14] & 0xF0) << 4);
+        timing.heightMm = d[13] | ((d[14] & 0x0F) << 8);
+        return timing;
+    }
+
+    void ParseBaseBlock(const uint8_t* b, EdidInfo& info)
+    {
+        // 製造元ID（5ビットずつの3文字、ビッグエンディアン）
+        uint16_t id = static_cast<uint16_t>((b[8] << 8) | b[9]);
+        for (int shift : {10, 5, 0}) {
+            info.manufacturer += static_cast<char>(((id >> shift) & 0x1F) + 'A' - 1);
+        }
+
+        info.productCode = ReadLe16(b + 10);
+        info.serialNumber = ReadLe32(b + 12);
+
+        // 週が0xFFの場合は製造年ではなくモデル年
+        uint8_t week = b[16];
+        info.isModelYear = week == 0xFF;
+        info.manufactureWeek = (week >= 1 && week <= 54) ? week : 0;
+        info.manufactureYear = b[17] + 1990;
+
+        info.version = b[18];
+        info.revision = b[19];
+        info.isDigital = (b[20] & 0x80) != 0;
+
+        // 片方が0の場合は縦横比を表すため、サイズとしては使わない
+        if (b[21] != 0 && b[22] != 0) {
+            info.widthMm = b[21] * 10;
+            info.heightMm = b[22] * 10;
+        }
+
+        for (size_t i = 0; i < DESCRIPTOR_COUNT; ++i) {
+            const uint8_t* d = b + DESCRIPTOR_OFFSET + i * DESCRIPTOR_SIZE;
+            if (d[0] != 0 || d[1] != 0) {
+                // 詳細タイミング記述子。先頭のものが推奨タイミング
+                if (i == 0) {
+                    info.preferredTiming = ReadDetailedTiming(d);
+                }
+                continue;
+            }
+
+            std::string text = ReadText(d + 5, DESCRIPTOR_SIZE - 5);
+            switch (d[3]) {
+            case SERIAL_DESCRIPTOR_TAG:
+                info.serial = text;
+                break;
+            case NAME_DESCRIPTOR_TAG:
+                info.name = text;
+                break;
+            case TEXT_DESCRIPTOR_TAG:
+                info.text = text;
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (info.preferredTiming && info.preferredTiming->widthMm > 0 && info.preferredTiming->heightMm > 0) {
+            info.widthMm = info.preferredTiming->widthMm;
+            info.heightMm = info.preferredTiming->heightMm;
+        }
+    }
+
+    void ParseDisplayIdProduct(const uint8_t* payload, size_t length, EdidInfo& info)
+    {
+        // OUI/PNP ID(3) 製品コード(2) シリアル番号(4) 週(1) 年(1) 名前の長さ(1) 名前
+        if (length < 12) {
+            return;
+        }
+        if (info.serialNumber == 0) {
+            info.serialNumber = ReadLe32(payload + 5);
+        }
+        if (info.name.empty()) {
+            size_t nameLength = payload[11];
+            if (nameLength > length - 12) {
+                nameLength = length - 12;
+            }
+            info.name = ReadText(payload + 12, nameLength);
+        }
+    }
+
+    void ParseDisplayIdParameters(const uint8_t* payload, size_t length, int unitTenthsMm, EdidInfo& info)
+    {
+        // 横幅(2) 高さ(2) の順で、単位はunitTenthsMm * 0.1mm
+        if (length < 4) {
+            return;
+        }
+        int width = ReadLe16(payload) * unitTenthsMm / 10;
+        int height = ReadLe16(payload + 2) * unitTenthsMm / 10;
+        if (width > 0 && height > 0) {
+            info.widthMm = width;
+            info.heightMm = height;
+        }
+    }
+
+    void ParseDisplayIdBlock(const uint8_t* block, EdidInfo& info)
+    {
+        // 1: バージョン、2: データブロックの長さ、3: 製品の種類、4: 拡張の数、5以降: データブロック
+        // データブロックの後ろに区間のチェックサムがあり、最後の1バイトはEDIDブロックのチェックサム
+        size_t end = 5 + static_cast<size_t>(block[2]);
+        if (end > EDID_BLOCK_SIZE - 2) {
+            end = EDID_BLOCK_SIZE - 2;
+        }
+        info.hasDisplayId = true;
+
+        size_t pos = 5;
+        while (pos + 3 <= end) {
+            uint8_t tag = block[pos];
+            uint8_t revision = block[pos + 1];
+            size_t length = block[pos + 2];
+            if (tag == 0 && revision == 0 && length == 0) {
+                break; // 残りは埋め草
+            }
+            if (pos + 3 + length > end) {
+                break;
+            }
+
+            const uint8_t* payload = block + pos + 3;
+            switch (tag) {
+            case DISPLAYID_PRODUCT_ID_V1:
+            case DISPLAYID_PRODUCT_ID_V2:
+                ParseDisplayIdProduct(payload, length, info);
+                break;
+            case DISPLAYID_DISPLAY_PARAMS_V1:
+                ParseDisplayIdParameters(payload, length, 1, info);
+                break;
+            case DISPLAYID_DISPLAY_PARAMS_V2:
+                // リビジョンの最上位ビットが1の場合は1mm単位
+                ParseDisplayIdParameters(payload, length, (revision & 0x80) ? 10 : 1, info);
+                break;
+            default:
+                break;
+            }
+            pos += 3 + length;
+        }
+    }
+}
+
+bool IsValidEdidBaseBlock(const std::vector<uint8_t>& edid)
+{
+    static const uint8_t header[8] = {0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00};
+    if (edid.size() < EDID_BLOCK_SIZE) {
+        return false;
+    }
+    for (size_t i = 0; i < sizeof(header); ++i) {
+        if (edid[i] != header[i]) {
+            return false;
+        }
+    }
+    return IsBlockChecksumValid(edid.data());
+}
+
+std::optional<EdidInfo> ParseEdid(const std::vector<uint8_t>& edid)
+{
+    if (!IsValidEdidBaseBlock(edid)) {
+        return std::nullopt;
+    }
+
+    EdidInfo info;
+    ParseBaseBlock(edid.data(), info);
+
+    // 宣言された拡張の数と実際に読み取れたブロック数の少ない方だけ読む
+    size_t count = edid[EXTENSION_COUNT_OFFSET];
+    size_t available = edid.size() / EDID_BLOCK_SIZE - 1;
+    if (count > available) {
+        count = available;
+    }
+    for (size_t i = 1; i <= count; ++i) {
+        const uint8_t* block = edid.data() + i * EDID_BLOCK_SIZE;
+        EdidExtension extension;
+        extension.tag = block[0];
+        extension.checksumValid = IsBlockChecksumValid(block);
+        info.extensions.push_back(extension);
+
+        if (extension.checksumValid && extension.tag == DISPLAYID_EXTENSION_TAG) {
+            ParseDisplayIdBlock(block, info);
+        }
+    }
+    return info;
+}
+
+uint64_t HashEdid(const std::vector<uint8_t>& edid)
+{
+    return Fnv1a64(edid);
+}
+
+std::shared_ptr<const EdidInfo> EdidCache::Parse(const std::vector<uint8_t>& edid)
+{
+    uint64_t hash = HashEdid(edid);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto& bucket = m_entries[hash];
+    for (const auto& entry : bucket) {
+        if (entry.bytes == edid) {
+            return entry.info;
+        }
+    }
+
+    std::shared_ptr<const EdidInfo> info;
+    if (auto parsed = ParseEdid(edid)) {
+        info = std::make_shared<const EdidInfo>(std::move(*parsed));
+    }
+    ++m_parseCount;
+    bucket.push_back({edid, info});
+    return info;
+}
+
+size_t EdidCache::GetParseCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_parseCount;
+}
+
+void EdidCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
@@ -0,0 +1,99 @@
+#ifndef DISPLAYCONTROLLER_EDID_PARSER_H
+#define DISPLAYCONTROLLER_EDID_PARSER_H
+
+#include "MonitorBackend.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 詳細タイミング記述子（最初の記述子が推奨タイミング）
+struct EdidDetailedTiming {
+    uint32_t pixelClockKHz = 0;
+    int horizontalActive = 0;
+    int verticalActive = 0;
+    int widthMm = 0;        // 映像の表示サイズ（0は不明）
+    int heightMm = 0;
+};
+
+// 拡張ブロック
+struct EdidExtension {
+    uint8_t tag = 0;        // 0x02: CTA-861、0x70: DisplayID など
+    bool checksumValid = false;
+};
+
+/**
+ * @brief EDIDを解析した結果
+ *
+ * 基本ブロック（EDID 1.3/1.4）と拡張ブロックを解析します。DisplayID拡張ブロックに
+ * 製品識別情報やディスプレイパラメーターがある場合は、基本ブロックにない項目を補います。
+ */
+struct DISPLAYCONTROLLER_API EdidInfo {
+    int version = 0;
+    int revision = 0;
+
+    std::string manufacturer;       // PNP ID（例: DEL）
+    uint16_t productCode = 0;
+    uint32_t serialNumber = 0;      // 0は未設定
+    int manufactureWeek = 0;        // 0は未設定
+    int manufactureYear = 0;
+    bool isModelYear = false;       // manufactureYearがモデル年を表す
+    bool isDigital = false;
+
+    std::string name;               // モニター名の記述子（0xFC）
+    std::string serial;             // シリアル番号の記述子（0xFF）
+    std::string text;               // 文字列の記述子（0xFE）
+
+    // 物理サイズ（mm、0は不明）。DisplayID・詳細タイミング・基本ブロック（cm単位）の順に精度の高い値を使う
+    int widthMm = 0;
+    int heightMm = 0;
+
+    std::optional<EdidDetailedTiming> preferredTiming;
+    std::vector<EdidExtension> extensions;
+    bool hasDisplayId = false;
+};
+
+// EDIDの基本ブロック（128バイト）のヘッダーとチェックサムが正しいか
+DISPLAYCONTROLLER_API bool IsValidEdidBaseBlock(const std::vector<uint8_t>& edid);
+
+/**
+ * @brief EDIDを解析する
+ *
+ * 基本ブロックが不正な場合はnulloptを返します。チェックサムが合わない拡張ブロックや、
+ * 長さが範囲外のDisplayIDデータブロックは読み飛ばします。任意のバイト列を渡しても
+ * 範囲外を読むことはありません。
+ */
+DISPLAYCONTROLLER_API std::optional<EdidInfo> ParseEdid(const std::vector<uint8_t>& edid);
+
+// EDIDのハッシュ値（FNV-1a 64bit）
+DISPLAYCONTROLLER_API uint64_t HashEdid(const std::vector<uint8_t>& edid);
+
+/**
+ * @brief 解析済みのEDIDをハッシュ値ごとに保持する
+ *
+ * 同じEDIDは1回だけ解析します。ハッシュ値が衝突した場合もバイト列を比べて区別します。
+ * 複数のスレッドから同時に呼び出せます。
+ */
+class DISPLAYCONTROLLER_API EdidCache {
+public:
+    // 不正なEDIDの場合はnullptr
+    std::shared_ptr<const EdidInfo> Parse(const std::vector<uint8_t>& edid);
+
+    size_t GetParseCount() const;
+    void Clear();
+
+private:
+    struct Entry {
+        std::vector<uint8_t> bytes;
+        std::shared_ptr<const EdidInfo> info;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<uint64_t, std::vector<Entry>> m_entries;
+    size_t m_parseCount = 0;
+};
+
+#endif // DISPLAYCONTROLLER_EDID_PARSER_H
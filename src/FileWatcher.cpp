@@ -0,0 +1,132 @@
+#include "FileWatcher.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+    class PollingFileWatchBackend : public IFileWatchBackend {
+    public:
+        PollingFileWatchBackend(const std::filesystem::path& file, std::chrono::milliseconds interval)
+            : m_file(file)
+            , m_interval(interval)
+            , m_last(Inspect())
+        {
+            if (interval.count() <= 0) {
+                throw std::invalid_argument("ポーリング間隔は0より大きい必要があります");
+            }
+        }
+
+        bool WaitForChange(std::chrono::milliseconds timeout) override
+        {
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (!m_cancelled) {
+                auto current = Inspect();
+                if (current != m_last) {
+                    m_last = current;
+                    return true;
+                }
+
+                auto now = std::chrono::steady_clock::now();
+                if (now >= deadline) {
+                    return false;
+                }
+                auto wait = std::min<std::chrono::steady_clock::duration>(m_interval, deadline - now);
+                m_cancelRequested.wait_for(lock, wait, [this] { return m_cancelled; });
+            }
+            return false;
+        }
+
+        void Cancel() override
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_cancelled = true;
+            }
+            m_cancelRequested.notify_all();
+        }
+
+    private:
+        struct FileState {
+            bool exists = false;
+            std::filesystem::file_time_type lastWrite{};
+            std::uintmax_t size = 0;
+
+            bool operator==(const FileState&) const = default;
+        };
+
+        FileState Inspect() const
+        {
+            std::error_code error;
+            FileState state;
+            state.lastWrite = std::filesystem::last_write_time(m_file, error);
+            if (error) {
+                return state;
+            }
+            state.size = std::filesystem::file_size(m_file, error);
+            state.exists = !error;
+            return state;
+        }
+
+        std::filesystem::path m_file;
+        std::chrono::milliseconds m_interval;
+        FileState m_last;
+        std::mutex m_mutex;
+        std::condition_variable m_cancelRequested;
+        bool m_cancelled = false;
+    };
+}
+
+std::unique_ptr<IFileWatchBackend> CreatePollingFileWatchBackend(
+    const std::filesystem::path& file, std::chrono::milliseconds interval)
+{
+    return std::make_unique<PollingFileWatchBackend>(file, interval);
+}
+
+std::unique_ptr<IFileWatchBackend> CreateFileWatchBackend(const std::filesystem::path& file)
+{
+#if defined(_WIN32)
+    return CreateWin32FileWatchBackend(file);
+#elif defined(__linux__)
+    return CreateInotifyFileWatchBackend(file);
+#else
+    return CreatePollingFileWatchBackend(file, std::chrono::seconds(1));
+#endif
+}
+
+FileWatcher::FileWatcher(std::unique_ptr<IFileWatchBackend> backend, std::chrono::milliseconds debounce, Callback onChanged)
+    : m_backend(std::move(backend))
+    , m_onChanged(std::move(onChanged))
+{
+    if (!m_backend) {
+        throw std::invalid_argument("ファイル監視のバックエンドがnullです");
+    }
+    if (!m_onChanged) {
+        throw std::invalid_argument("変更時のコールバックを指定してください");
+    }
+    if (debounce.count() < 0) {
+        throw std::invalid_argument("変更をまとめる時間は0以上である必要があります");
+    }
+    m_loop.Start(debounce,
+        [this](std::chrono::milliseconds timeout) { return m_backend->WaitForChange(timeout); },
+        [this] { m_backend->Cancel(); },
+        [this] {
+            ++m_notifications;
+            m_onChanged();
+        });
+}
+
+FileWatcher::~FileWatcher()
+{
+    m_loop.Stop();
+}
+
+FileWatcher::Stats FileWatcher::GetStats() const
+{
+    Stats stats;
+    stats.events = m_loop.GetEventCount();
+    stats.notifications = m_notifications.load();
+    return stats;
+}
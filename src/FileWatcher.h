@@ -0,0 +1,79 @@
+#ifndef DISPLAYCONTROLLER_FILE_WATCHER_H
+#define DISPLAYCONTROLLER_FILE_WATCHER_H
+
+#include "DebouncedWatchLoop.h"
+#include "MonitorBackend.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+/**
+ * @brief ファイルの変更通知を受け取るバックエンド
+ *
+ * エディターの保存方法（上書き・一時ファイルからの置き換え）によらず変更を検出できるよう、
+ * 実装は対象ファイルのあるディレクトリを監視し、対象ファイル名の通知だけを返します。
+ */
+DISPLAYCONTROLLER_INTERFACE IFileWatchBackend {
+public:
+    virtual ~IFileWatchBackend() = default;
+
+    /**
+     * @brief 対象ファイルの変更を待つ
+     * @return 変更があればtrue、タイムアウトまたはCancel()で戻った場合はfalse
+     */
+    virtual bool WaitForChange(std::chrono::milliseconds timeout) = 0;
+
+    // 待機中のWaitForChange()をすぐに戻す（以降の呼び出しも待たずに戻る）
+    virtual void Cancel() = 0;
+};
+
+// 実行環境に合ったバックエンド（Windows: ReadDirectoryChangesW、Linux: inotify、その他: ポーリング）
+DISPLAYCONTROLLER_API std::unique_ptr<IFileWatchBackend> CreateFileWatchBackend(const std::filesystem::path& file);
+
+// 更新日時とサイズを一定間隔で比べるバックエンド（変更通知のAPIがない環境用）
+DISPLAYCONTROLLER_API std::unique_ptr<IFileWatchBackend> CreatePollingFileWatchBackend(
+    const std::filesystem::path& file, std::chrono::milliseconds interval);
+
+#ifdef __linux__
+DISPLAYCONTROLLER_API std::unique_ptr<IFileWatchBackend> CreateInotifyFileWatchBackend(const std::filesystem::path& file);
+#endif
+
+#ifdef _WIN32
+DISPLAYCONTROLLER_API std::unique_ptr<IFileWatchBackend> CreateWin32FileWatchBackend(const std::filesystem::path& file);
+#endif
+
+/**
+ * @brief ファイルの変更を監視し、変更が落ち着いてからコールバックを呼び出す
+ *
+ * 保存の途中で届く複数の通知をまとめるため、最後の通知から debounce の間
+ * 新しい通知がなくなるまで待ってからコールバックを1回呼び出します。
+ * コールバックは監視スレッドから呼ばれます。
+ */
+class DISPLAYCONTROLLER_API FileWatcher {
+public:
+    using Callback = std::function<void()>;
+
+    struct Stats {
+        uint64_t events = 0;          // バックエンドから受け取った変更通知の数
+        uint64_t notifications = 0;   // コールバックを呼び出した回数
+    };
+
+    FileWatcher(std::unique_ptr<IFileWatchBackend> backend, std::chrono::milliseconds debounce, Callback onChanged);
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    Stats GetStats() const;
+
+private:
+    std::unique_ptr<IFileWatchBackend> m_backend;
+    Callback m_onChanged;
+    std::atomic<uint64_t> m_notifications{0};
+    DebouncedWatchLoop m_loop;  // 最後に宣言し最初に破棄する（監視スレッドが参照する他のメンバーより先に停止させる）
+};
+
+#endif // DISPLAYCONTROLLER_FILE_WATCHER_H
@@ -0,0 +1,29 @@
+#ifndef DISPLAYCONTROLLER_FNV1A_H
+#define DISPLAYCONTROLLER_FNV1A_H
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/**
+ * @brief バイト列のFNV-1a（64bit）ハッシュ値
+ *
+ * 設定ファイルの内容やEDIDのように、同じ内容かどうかを手早く判定するためのものです。
+ * 暗号学的な強度はありません。
+ */
+inline uint64_t Fnv1a64(std::span<const uint8_t> data)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (uint8_t byte : data) {
+        hash ^= byte;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+inline uint64_t Fnv1a64(std::string_view text)
+{
+    return Fnv1a64(std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(text.data()), text.size()));
+}
+
+#endif // DISPLAYCONTROLLER_FNV1A_H
@@ -0,0 +1,83 @@
+#ifndef DISPLAYCONTROLLER_IASYNCLIGHTSENSOR_H
+#define DISPLAYCONTROLLER_IASYNCLIGHTSENSOR_H
+
+#include "ILightSensor.h"
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 照度サンプルの品質
+enum class LightSampleQuality {
+    Good,           // 今回の読み取りで得た値
+    Stale,          // キャッシュなど、以前に読み取った値
+    Unavailable,    // 読み取りに失敗した（levelは無効）
+    Degraded        // 複数のセンサーのうち、直近の読み取りに失敗したセンサーの以前の値を含む
+};
+
+// 複数のセンサーをまとめた読み取り結果に含まれる、各センサーの値
+struct LightSourceLevel {
+    std::string name;
+    int level = 0;
+};
+
+/**
+ * @brief 照度の読み取り結果
+ */
+struct LightSample {
+    int level = 0;                                      // 0-100の範囲の照度値
+    std::chrono::steady_clock::time_point timestamp;    // 照度を読み取った時刻
+    LightSampleQuality quality = LightSampleQuality::Unavailable;
+    std::string error;                                  // Unavailableの場合の理由
+    std::vector<LightSourceLevel> sources;              // 複数のセンサーをまとめた場合の各センサーの値
+
+    bool IsUsable() const { return quality != LightSampleQuality::Unavailable; }
+};
+
+/**
+ * @brief 非同期に読み取りができる照度センサーのインターフェース
+ *
+ * ネットワーク経由のセンサーなど、読み取りに時間のかかるセンサーのための
+ * 拡張インターフェースです。StartRead()はすぐに戻り、読み取りが完了すると
+ * コールバックが呼び出されます。同じセンサーのコールバックが同時に複数
+ * 呼び出されることはありません。
+ */
+class LIGHTSENSOR_API IAsyncLightSensor : public ILightSensor {
+public:
+    using SampleCallback = std::function<void(const LightSample&)>;
+
+    /**
+     * @brief 読み取りを開始する（呼び出し元をブロックしない）
+     * @param callback 読み取り完了時に呼び出される（失敗時もUnavailableのサンプルで呼び出される）
+     */
+    virtual void StartRead(SampleCallback callback) = 0;
+
+    /**
+     * @brief 読み取りを開始し、結果をfutureで受け取る
+     */
+    std::future<LightSample> ReadAsync()
+    {
+        auto promise = std::make_shared<std::promise<LightSample>>();
+        auto future = promise->get_future();
+        StartRead([promise](const LightSample& sample) { promise->set_value(sample); });
+        return future;
+    }
+
+    /**
+     * @brief 同期的に照度レベルを取得（既存の呼び出し元との互換用）
+     * @throws std::runtime_error 読み取りに失敗した場合
+     */
+    int GetLightLevel() override
+    {
+        LightSample sample = ReadAsync().get();
+        if (!sample.IsUsable()) {
+            throw std::runtime_error(sample.error);
+        }
+        return sample.level;
+    }
+};
+
+#endif // DISPLAYCONTROLLER_IASYNCLIGHTSENSOR_H
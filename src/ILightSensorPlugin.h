@@ -6,10 +6,14 @@
 #include "ILightSensor.h"
 
 // DLLエクスポート/インポートマクロ
-#ifdef PLUGIN_EXPORTS
-    #define PLUGIN_API __declspec(dllexport)
+#ifdef _WIN32
+    #ifdef PLUGIN_EXPORTS
+        #define PLUGIN_API __declspec(dllexport)
+    #else
+        #define PLUGIN_API __declspec(dllimport)
+    #endif
 #else
-    #define PLUGIN_API __declspec(dllimport)
+    #define PLUGIN_API
 #endif
 
 using json = nlohmann::json;
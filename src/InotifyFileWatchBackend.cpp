@@ -0,0 +1,124 @@
+#include "FileWatcher.h"
+
+#ifdef __linux__
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+    class InotifyFileWatchBackend : public IFileWatchBackend {
+    public:
+        explicit InotifyFileWatchBackend(const std::filesystem::path& file)
+            : m_fileName(file.filename().string())
+        {
+            std::filesystem::path directory = file.parent_path();
+            if (directory.empty()) {
+                directory = ".";
+            }
+
+            m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            m_cancel = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (m_inotify < 0 || m_cancel < 0) {
+                Close();
+                throw DisplayControllerException("inotifyの初期化に失敗しました: " + std::string(std::strerror(errno)));
+            }
+
+            // 書き込みの完了と、一時ファイルからの置き換え（rename）を検出する
+            if (inotify_add_watch(m_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE) < 0) {
+                std::string error = std::strerror(errno);
+                Close();
+                throw DisplayControllerException("ディレクトリを監視できません: " + directory.string() + ": " + error);
+            }
+        }
+
+        ~InotifyFileWatchBackend() override
+        {
+            Close();
+        }
+
+        bool WaitForChange(std::chrono::milliseconds timeout) override
+        {
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            while (true) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+                int waitMs = static_cast<int>(std::clamp<long long>(remaining.count(), 0, INT_MAX));
+
+                pollfd fds[2] = {{m_cancel, POLLIN, 0}, {m_inotify, POLLIN, 0}};
+                int ready = poll(fds, 2, waitMs);
+                if (ready < 0 && errno == EINTR) {
+                    continue;
+                }
+                if (ready <= 0 || (fds[0].revents & POLLIN)) {
+                    return false;
+                }
+                if (ReadEvents()) {
+                    return true;
+                }
+                // 同じディレクトリの別のファイルの通知だった
+                if (waitMs == 0) {
+                    return false;
+                }
+            }
+        }
+
+        void Cancel() override
+        {
+            uint64_t value = 1;
+            // キャンセル済みの状態はeventfdが読み取られない限り残る
+            [[maybe_unused]] auto written = write(m_cancel, &value, sizeof(value));
+        }
+
+    private:
+        // 溜まっている通知をすべて読み、対象ファイルの通知が含まれていればtrue
+        bool ReadEvents()
+        {
+            bool matched = false;
+            alignas(inotify_event) char buffer[4096];
+            while (true) {
+                ssize_t length = read(m_inotify, buffer, sizeof(buffer));
+                if (length <= 0) {
+                    break;
+                }
+                for (char* p = buffer; p < buffer + length;) {
+                    auto* event = reinterpret_cast<inotify_event*>(p);
+                    if ((event->mask & IN_Q_OVERFLOW) ||
+                        (event->len > 0 && m_fileName == event->name)) {
+                        matched = true;
+                    }
+                    p += sizeof(inotify_event) + event->len;
+                }
+            }
+            return matched;
+        }
+
+        void Close()
+        {
+            if (m_inotify >= 0) {
+                close(m_inotify);
+                m_inotify = -1;
+            }
+            if (m_cancel >= 0) {
+                close(m_cancel);
+                m_cancel = -1;
+            }
+        }
+
+        std::string m_fileName;
+        int m_inotify = -1;
+        int m_cancel = -1;
+    };
+}
+
+std::unique_ptr<IFileWatchBackend> CreateInotifyFileWatchBackend(const std::filesystem::path& file)
+{
+    return std::make_unique<InotifyFileWatchBackend>(file);
+}
+
+#endif // __linux__
@@ -0,0 +1,73 @@
+#ifndef DISPLAYCONTROLLER_LATEST_VALUE_MAILBOX_H
+#define DISPLAYCONTROLLER_LATEST_VALUE_MAILBOX_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+/**
+ * @brief 最新の値だけを受け渡すロックフリーのメールボックス
+ *
+ * 書き込み側・受け渡し用・読み取り側の3つのバッファを入れ替える
+ * トリプルバッファです。書き込み側は1スレッド、読み取り側は1スレッドに
+ * 限られますが、どちらも相手を待つことはありません。読み取られる前に
+ * 次の値が書き込まれた場合、古い値は破棄されます。
+ */
+template <typename T>
+class LatestValueMailbox {
+public:
+    LatestValueMailbox() = default;
+
+    LatestValueMailbox(const LatestValueMailbox&) = delete;
+    LatestValueMailbox& operator=(const LatestValueMailbox&) = delete;
+
+    // 値を書き込む（書き込み側スレッドからのみ呼び出す）
+    void Publish(T value)
+    {
+        m_buffers[m_writeIndex] = std::move(value);
+        uint8_t previous = m_shared.exchange(static_cast<uint8_t>(m_writeIndex | kFreshFlag),
+            std::memory_order_acq_rel);
+        if (previous & kFreshFlag) {
+            m_overwritten.fetch_add(1, std::memory_order_relaxed);
+        }
+        m_writeIndex = previous & kIndexMask;
+    }
+
+    // 前回の読み取り以降に書き込まれた最新の値を取り出す（読み取り側スレッドからのみ呼び出す）
+    std::optional<T> TakeLatest()
+    {
+        if (!HasNew()) {
+            return std::nullopt;
+        }
+        uint8_t previous = m_shared.exchange(m_readIndex, std::memory_order_acq_rel);
+        m_readIndex = previous & kIndexMask;
+        return m_buffers[m_readIndex];
+    }
+
+    bool HasNew() const
+    {
+        return (m_shared.load(std::memory_order_acquire) & kFreshFlag) != 0;
+    }
+
+    // 読み取られずに上書きされた値の数
+    uint64_t GetOverwrittenCount() const
+    {
+        return m_overwritten.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFreshFlag = 0x4;
+
+    static_assert(std::atomic<uint8_t>::is_always_lock_free, "LatestValueMailbox requires lock-free atomics");
+
+    std::array<T, 3> m_buffers{};
+    uint8_t m_writeIndex = 0;                 // 書き込み側のみが参照
+    uint8_t m_readIndex = 2;                  // 読み取り側のみが参照
+    std::atomic<uint8_t> m_shared{1};         // 受け渡し用バッファの番号と未読フラグ
+    std::atomic<uint64_t> m_overwritten{0};
+};
+
+#endif // DISPLAYCONTROLLER_LATEST_VALUE_MAILBOX_H
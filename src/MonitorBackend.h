@@ -0,0 +1,89 @@
+#ifndef DISPLAYCONTROLLER_MONITOR_BACKEND_H
+#define DISPLAYCONTROLLER_MONITOR_BACKEND_H
+
+// DLLエクスポート/インポートマクロ
+#ifdef _WIN32
+    #ifdef DISPLAYCONTROLLER_EXPORTS
+        #define DISPLAYCONTROLLER_API __declspec(dllexport)
+    #else
+        #define DISPLAYCONTROLLER_API __declspec(dllimport)
+    #endif
+#else
+    #define DISPLAYCONTROLLER_API
+#endif
+
+// インターフェースのDLLエクスポート設定
+#define DISPLAYCONTROLLER_INTERFACE class DISPLAYCONTROLLER_API
+
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// 例外クラス
+class DISPLAYCONTROLLER_API DisplayControllerException : public std::runtime_error {
+public:
+    explicit DisplayControllerException(const std::string& message)
+        : std::runtime_error(message) {}
+};
+
+// Windows APIの呼び出しに失敗した場合の例外
+class DISPLAYCONTROLLER_API WindowsApiException : public DisplayControllerException {
+public:
+    explicit WindowsApiException(const std::string& message)
+        : DisplayControllerException(message) {}
+};
+
+// モニターID型
+#ifdef _WIN32
+using MonitorId = HMONITOR;
+#else
+// Windows以外ではHMONITOR相当の不透明なハンドルとして扱う
+using MonitorId = void*;
+#endif
+
+// 物理モニターハンドル（バックエンド固有の不透明なハンドル）
+using PhysicalMonitorHandle = void*;
+
+/**
+ * @brief DDC/CIによる物理モニター操作のバックエンド
+ *
+ * MonitorControllerはこのインターフェースを通して物理モニターを操作します。
+ * Windowsでは Dxva2 API を、Linuxでは i2c-dev や /sys/class/backlight を使用する実装を、テストでは偽の実装を差し込みます。
+ */
+DISPLAYCONTROLLER_INTERFACE IMonitorBackend {
+public:
+    virtual ~IMonitorBackend() = default;
+
+    /**
+     * @brief 物理モニターハンドルを開く
+     * @throws DisplayControllerException ハンドルを開けなかった場合
+     */
+    virtual PhysicalMonitorHandle OpenPhysicalMonitor(MonitorId id) = 0;
+
+    /**
+     * @brief 物理モニターハンドルを閉じる
+     */
+    virtual void ClosePhysicalMonitor(PhysicalMonitorHandle handle) = 0;
+
+    /**
+     * @brief 輝度の最小値・現在値・最大値を取得（DDC/CIの生値）
+     */
+    virtual bool GetBrightness(PhysicalMonitorHandle handle,
+        unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) = 0;
+
+    /**
+     * @brief 輝度を設定（DDC/CIの生値）
+     */
+    virtual bool SetBrightness(PhysicalMonitorHandle handle, unsigned long value) = 0;
+
+    /**
+     * @brief コントラストの最小値・現在値・最大値を取得（DDC/CIの生値）
+     */
+    virtual bool GetContrast(PhysicalMonitorHandle handle,
+        unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) = 0;
+};
+
+#endif // DISPLAYCONTROLLER_MONITOR_BACKEND_H
@@ -0,0 +1,42 @@
+#include "MonitorBrightnessMap.h"
+
+MonitorBrightnessMap::MonitorBrightnessMap(int minBrightness, int maxBrightness,
+                                           const ProfileTable& profiles, const MonitorKeyTable& monitorKeys)
+{
+    m_global.minBrightness = minBrightness;
+    m_global.maxBrightness = maxBrightness;
+    m_default = Compile({});
+
+    // 同じキーのモニターが複数あっても、変換表はキーごとに1回だけ計算する
+    std::unordered_map<std::string, Entry> byKey;
+    for (const auto& [id, keys] : monitorKeys) {
+        auto profile = profiles.find(keys.identity);
+        if (profile == profiles.end()) {
+            profile = profiles.find(keys.name);
+        }
+        if (profile == profiles.end()) {
+            continue;
+        }
+        auto it = byKey.find(profile->first);
+        if (it == byKey.end()) {
+            it = byKey.emplace(profile->first, Compile(profile->second)).first;
+        }
+        m_entries.emplace(id, it->second);
+    }
+}
+
+MonitorBrightnessMap::Entry MonitorBrightnessMap::Compile(const MonitorBrightnessProfile& profile) const
+{
+    MappingConfig curve = m_global;
+    curve.mappingPoints = profile.curve;
+    MonitorBrightnessRange range = profile.range.value_or(MonitorBrightnessRange{});
+
+    Entry entry;
+    entry.sensor = profile.sensor;
+    for (int level = 0; level < BrightnessLookupTable::kSize; ++level) {
+        int brightness = MapBrightnessReference(curve, level);
+        entry.table[static_cast<size_t>(level)] = static_cast<int>(
+            range.min + (static_cast<double>(brightness) / 100.0) * (range.max - range.min));
+    }
+    return entry;
+}
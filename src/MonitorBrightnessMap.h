@@ -0,0 +1,80 @@
+#ifndef DISPLAYCONTROLLER_MONITOR_BRIGHTNESS_MAP_H
+#define DISPLAYCONTROLLER_MONITOR_BRIGHTNESS_MAP_H
+
+#include "BrightnessMapping.h"
+#include "ConfigTypes.h"
+#include "MonitorBackend.h"
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// モニターごとの照度から輝度への変換設定（設定ファイルのモニターの識別子または名前で識別する）
+struct DISPLAYCONTROLLERLIB_API MonitorBrightnessProfile {
+    std::optional<MonitorBrightnessRange> range;    // 出力する輝度の範囲（未設定なら0-100）
+    std::vector<std::pair<int, int>> curve;         // 照度(0-100)と輝度(0-100)の対応点（空なら全体の輝度範囲で線形）
+    std::string sensor;                             // 割り当てたセンサーの名前（空ならまとめた値を使う）
+};
+
+/**
+ * @brief モニターごとの照度から輝度への変換表
+ *
+ * 全体の輝度範囲・モニターごとのカーブ・モニターごとの輝度範囲を合成し、
+ * 照度0-100の全101値について輝度を事前計算します。同期ループでは
+ * モニターごとに1回の検索と表の参照だけで目標の輝度が決まります。
+ *
+ * 設定はモニターの識別子（EDIDから作るMonitorIdentity::ToKey()）など接続し直しても変わらない
+ * キーで持ち、構築時に現在のMonitorIdへ対応付けます。識別子の設定がないモニターは、以前の
+ * 設定ファイルとの互換のためモニター名の設定を使います。構築後は変更されないため、複数のスレッドから
+ * 同時に参照できます。
+ */
+class DISPLAYCONTROLLERLIB_API MonitorBrightnessMap {
+public:
+    using ProfileTable = std::unordered_map<std::string, MonitorBrightnessProfile>;
+
+    // 接続中のモニターを設定と対応付けるキー
+    struct MonitorKeys {
+        std::string identity;   // MonitorIdentity::ToKey()（優先して使う）
+        std::string name;       // 人間が識別可能な名前（識別子の設定がない場合に使う）
+    };
+    using MonitorKeyTable = std::unordered_map<MonitorId, MonitorKeys>;
+
+    struct Entry {
+        std::array<int, BrightnessLookupTable::kSize> table;
+        std::string sensor;
+    };
+
+    /**
+     * @param minBrightness 全体の輝度範囲の最小値（カーブのないモニターの線形変換に使う）
+     * @param maxBrightness 全体の輝度範囲の最大値
+     * @param profiles キー（モニターの識別子または名前）ごとの変換設定
+     * @param monitorKeys 接続中のモニターのIDとキーの対応
+     */
+    MonitorBrightnessMap(int minBrightness, int maxBrightness,
+                         const ProfileTable& profiles, const MonitorKeyTable& monitorKeys);
+
+    // 設定のないモニターは全体の輝度範囲による線形変換
+    const Entry& Find(MonitorId id) const
+    {
+        auto it = m_entries.find(id);
+        return it != m_entries.end() ? it->second : m_default;
+    }
+
+    // 照度（0-100に丸められる）からモニターの目標輝度を求める
+    static int Map(const Entry& entry, int lightLevel)
+    {
+        return entry.table[static_cast<size_t>(std::clamp(lightLevel, 0, BrightnessLookupTable::kSize - 1))];
+    }
+
+private:
+    Entry Compile(const MonitorBrightnessProfile& profile) const;
+
+    MappingConfig m_global;
+    Entry m_default;
+    std::unordered_map<MonitorId, Entry> m_entries;
+};
+
+#endif // DISPLAYCONTROLLER_MONITOR_BRIGHTNESS_MAP_H
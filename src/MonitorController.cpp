@@ -1,29 +1,63 @@
 #include "MonitorController.h"
-#include <windows.h>
+#include <common/StringUtils.h>
 #include <memory>
-#include <physicalmonitorenumerationapi.h>
-#include <highlevelmonitorconfigurationapi.h>
-#include <shlobj_core.h>
 #include <fstream>
 #include <algorithm>
-#pragma comment(lib, "Dxva2.lib")
+#include <cmath>
+#include <cstdlib>
+#ifdef _WIN32
+#include <windows.h>
+#include <shlobj_core.h>
 #pragma comment(lib, "Shell32.lib")
+#endif
 
-// Windows API関数の宣言
-extern "C" {
-    BOOL WINAPI SetMonitorBrightness(HANDLE hMonitor, DWORD dwNewBrightness);
-    BOOL WINAPI DestroyPhysicalMonitor(HANDLE hMonitor);
+MonitorController::MonitorController()
+    : MonitorController(CreateDisplayBackend())
+{
 }
 
-MonitorController::MonitorController()
+MonitorController::MonitorController(std::unique_ptr<IDisplayBackend> backend)
+    : MonitorController(std::move(backend), GetDefaultSettingsPath())
+{
+}
+
+MonitorController::MonitorController(std::unique_ptr<IDisplayBackend> backend, std::filesystem::path settingsPath)
+    : m_backend(std::move(backend))
+    , m_settingsPath(std::move(settingsPath))
+    , m_topology([this] { return BuildTopology(); })
+{
+    if (!m_backend) {
+        throw DisplayControllerException("Monitor backend must not be null");
+    }
+    m_handleCache = std::make_unique<PhysicalMonitorCache>(*m_backend);
+    m_dispatcher = std::make_unique<BrightnessDispatcher>();
+
+    // 設定ファイルのベースディレクトリを作成
+    if (!m_settingsPath.empty()) {
+        std::error_code error;
+        std::filesystem::create_directories(m_settingsPath, error);
+    }
+    // マッピング設定は、接続中のモニターについて最初に参照したときに読み込む
+    m_mappings = std::make_unique<MonitorMappingRegistry>(m_settingsPath);
+}
+
+std::filesystem::path MonitorController::GetDefaultSettingsPath()
 {
-    // 設定ファイルのベースディレクトリを設定
+#ifdef _WIN32
     wchar_t appDataPath[MAX_PATH];
     if (SUCCEEDED(SHGetFolderPathW(nullptr, CSIDL_LOCAL_APPDATA, nullptr, 0, appDataPath))) {
-        m_settingsPath = std::filesystem::path(appDataPath) / L"DisplayController" / L"Settings";
-        std::filesystem::create_directories(m_settingsPath);
-        LoadMappingConfigs(); // 設定ファイルからマッピング設定を読み込む
+        return std::filesystem::path(appDataPath) / L"DisplayController" / L"Settings";
     }
+    return {};
+#else
+    if (const char* configHome = std::getenv("XDG_CONFIG_HOME"); configHome && *configHome) {
+        return std::filesystem::path(configHome) / "DisplayController" / "Settings";
+    }
+    if (const char* home = std::getenv("HOME"); home && *home) {
+        return std::filesystem::path(home) / ".config" / "DisplayController" / "Settings";
+    }
+    return {};
+#endif
 }
 
 MonitorController::~MonitorController() noexcept = default;
@@ -31,195 +65,120 @@ MonitorController::~MonitorController() noexcept = default;
 // IMonitorManager implementation
 std::vector<MonitorId> MonitorController::EnumerateMonitors()
 {
-    std::vector<MonitorId> monitors;
-    if (!::EnumDisplayMonitors(nullptr, nullptr,
-        [](HMONITOR hMonitor, HDC, LPRECT, LPARAM dwData) -> BOOL {
-            auto monitors = reinterpret_cast<std::vector<MonitorId>*>(dwData);
-            monitors->push_back(hMonitor);
-            return TRUE;
-        },
-        reinterpret_cast<LPARAM>(&monitors)))
-    {
-        throw WindowsApiException("Failed to enumerate monitors: " + std::to_string(GetLastError()));
-    }
-    return monitors;
+    return GetTopology()->GetIds();
 }
 
 bool MonitorController::GetMonitorInfo(MonitorId id, std::wstring& name, bool& isPrimary)
 {
-    MONITORINFOEXW monitorInfo = { sizeof(MONITORINFOEXW) };
-    if (!::GetMonitorInfoW(id, reinterpret_cast<LPMONITORINFO>(&monitorInfo))) {
-        return false;
+    if (const auto* monitor = GetTopology()->Find(id)) {
+        name = monitor->deviceName;
+        isPrimary = monitor->isPrimary;
+        return true;
     }
-
-    name = monitorInfo.szDevice;
-    isPrimary = (monitorInfo.dwFlags & MONITORINFOF_PRIMARY) != 0;
-    return true;
+    return false;
 }
 
 // IBrightnessMapper implementation
 int MonitorController::MapBrightness(MonitorId id, int normalizedBrightness)
 {
-    auto it = m_mappingConfigs.find(id);
-    if (it == m_mappingConfigs.end()) {
-        // デフォルトのマッピング（線形）を使用
-        return normalizedBrightness;
-    }
-
-    const auto& config = it->second;
-
-    // 範囲チェック
-    normalizedBrightness = std::clamp(normalizedBrightness, 0, 100);
-
-    // マッピングポイントがない場合は線形マッピング
-    if (config.mappingPoints.empty()) {
-        return config.minBrightness +
-            (config.maxBrightness - config.minBrightness) * normalizedBrightness / 100;
+    // 一覧にあるモニターは読み込み済みの変換表を使う
+    if (const auto* monitor = GetTopology()->Find(id)) {
+        return monitor->MapBrightness(normalizedBrightness);
     }
+    return m_mappings->Map(GetMonitorIdentity(id), normalizedBrightness);
+}
 
-    // カスタムマッピングポイントを使用
-    auto points = config.mappingPoints;
-    std::sort(points.begin(), points.end());
-
-    // 最小値以下または最大値以上の場合
-    if (normalizedBrightness <= points.front().first) {
-        return points.front().second;
+void MonitorController::SetMappingConfig(MonitorId id, const MappingConfig& config)
+{
+    auto identity = GetMonitorIdentity(id);
+    try {
+        m_mappings->SetConfig(identity, config); // 設定をファイルに保存
     }
-    if (normalizedBrightness >= points.back().first) {
-        return points.back().second;
+    catch (const DisplayControllerException&) {
+        // 保存に失敗しても変換表は変更されているため、一覧にも反映する
+        m_topology.UpdateMapping(id, m_mappings->GetTable(identity));
+        throw;
     }
+    m_topology.UpdateMapping(id, m_mappings->GetTable(identity));
+}
 
-    // 区間を見つけて線形補間
-    for (size_t i = 1; i < points.size(); ++i) {
-        if (normalizedBrightness <= points[i].first) {
-            const auto& p1 = points[i - 1];
-            const auto& p2 = points[i];
-            float t = static_cast<float>(normalizedBrightness - p1.first) /
-                     static_cast<float>(p2.first - p1.first);
-            return p1.second + static_cast<int>(t * (p2.second - p1.second));
-        }
+MappingConfig MonitorController::GetMappingConfig(MonitorId id)
+{
+    if (const auto* monitor = GetTopology()->Find(id)) {
+        return monitor->mapping ? monitor->mapping->GetConfig() : MappingConfig();
     }
-
-    return normalizedBrightness; // フォールバック
+    return m_mappings->GetConfig(GetMonitorIdentity(id));
 }
 
-void MonitorController::SetMappingConfig(MonitorId id, const MappingConfig& config)
+MonitorIdentity MonitorController::GetMonitorIdentity(MonitorId id)
 {
-    m_mappingConfigs[id] = config;
-    SaveMappingConfig(id, config); // 設定をファイルに保存
+    if (const auto* monitor = GetTopology()->Find(id)) {
+        return monitor->identity;
+    }
+    // 一覧にないモニター（構成の変更直後など）はその場で読み取る
+    for (const auto& display : m_backend->EnumerateDisplays()) {
+        if (display.id == id) {
+            return ReadMonitorDescriptor(display).identity;
+        }
+    }
+    return MakeMonitorIdentity(nullptr, std::to_string(reinterpret_cast<uintptr_t>(id)));
 }
 
-std::wstring MonitorController::GetMappingConfigFilePath(MonitorId id) const
+std::shared_ptr<const MonitorTopology> MonitorController::GetTopology()
 {
-    // モニターIDを使用してユニークなファイル名を生成
-    std::wstring filename = L"mapping_" + std::to_wstring(reinterpret_cast<uintptr_t>(id)) + L".json";
-    return (m_settingsPath / filename).wstring();
+    return m_topology.Get();
 }
 
-void MonitorController::SaveMappingConfig(MonitorId id, const MappingConfig& config)
+std::vector<MonitorTopology::Monitor> MonitorController::BuildTopology()
 {
-    try {
-        std::filesystem::path filepath = GetMappingConfigFilePath(id);
-
-        // nlohmann::jsonオブジェクトを作成
-        nlohmann::json j;
-        j["minBrightness"] = config.minBrightness;
-        j["maxBrightness"] = config.maxBrightness;
-
-        // マッピングポイントの配列を作成
-        nlohmann::json points = nlohmann::json::array();
-        for (const auto& point : config.mappingPoints) {
-            points.push_back({
-                {"input", point.first},
-                {"output", point.second}
-            });
-        }
-        j["mappingPoints"] = points;
-
-        // JSONをファイルに書き込み（整形して見やすく）
-        std::ofstream file(filepath);
-        if (!file) {
-            throw DisplayControllerException("Failed to open mapping config file for writing: " + filepath.string());
+    // 名前の重複はこの一覧の中で判定する
+    m_nameCounters.clear();
+
+    std::vector<MonitorTopology::Monitor> monitors;
+    for (const auto& display : m_backend->EnumerateDisplays()) {
+        MonitorTopology::Monitor monitor;
+        monitor.id = display.id;
+        monitor.deviceName = display.deviceName;
+        monitor.isPrimary = display.isPrimary;
+        monitor.bounds = display.bounds;
+        monitor.widthMm = display.widthMm;
+        monitor.heightMm = display.heightMm;
+
+        auto descriptor = ReadMonitorDescriptor(display);
+        monitor.identity = std::move(descriptor.identity);
+        monitor.edid = std::move(descriptor.edid);
+        // 物理サイズはEDIDの値を優先し、ない場合はOSから取得した値を使う
+        if (monitor.edid && monitor.edid->widthMm > 0 && monitor.edid->heightMm > 0) {
+            monitor.widthMm = monitor.edid->widthMm;
+            monitor.heightMm = monitor.edid->heightMm;
         }
+        monitor.name = GenerateHumanReadableName(monitor);
 
-        file << j.dump(2); // インデント2でフォーマット
-        file.flush();
+        // 以前はHMONITORの値をファイル名にしていたため、同じ値のファイルがあれば引き継ぐ
+        m_mappings->MigrateLegacyFile(monitor.identity, L"mapping_" + std::to_wstring(reinterpret_cast<uintptr_t>(display.id)) + L".json");
+        monitor.mapping = m_mappings->GetTable(monitor.identity);
 
-        if (!file) {
-            throw DisplayControllerException("Failed to write mapping config to file: " + filepath.string());
+        // ハンドルを開いて輝度範囲を問い合わせておく（最初の輝度設定を待たせない）
+        try {
+            monitor.handle = m_handleCache->Acquire(display.id);
         }
-    }
-    catch (const std::exception& e) {
-        throw DisplayControllerException(std::string("Failed to save mapping config: ") + e.what());
-    }
-}
-void MonitorController::LoadMappingConfigs()
-{
-    try {
-        // 既存のモニターを列挙
-        auto monitors = EnumerateMonitors();
-
-        for (const auto& id : monitors) {
-            std::filesystem::path filepath = GetMappingConfigFilePath(id);
-            if (!std::filesystem::exists(filepath)) {
-                continue; // 設定ファイルが存在しない場合はスキップ
-            }
-
-            std::ifstream file(filepath);
-            if (!file) {
-                continue; // ファイルが開けない場合はスキップ
-            }
-
-            try {
-                // JSONをパース
-                nlohmann::json j = nlohmann::json::parse(file);
-
-                MappingConfig config;
-
-                // 基本設定の読み込み
-                if (j.contains("minBrightness")) {
-                    config.minBrightness = j["minBrightness"].get<int>();
-                }
-                if (j.contains("maxBrightness")) {
-                    config.maxBrightness = j["maxBrightness"].get<int>();
-                }
-
-                // マッピングポイントの読み込み
-                if (j.contains("mappingPoints") && j["mappingPoints"].is_array()) {
-                    for (const auto& point : j["mappingPoints"]) {
-                        if (point.contains("input") && point.contains("output")) {
-                            config.mappingPoints.emplace_back(
-                                point["input"].get<int>(),
-                                point["output"].get<int>()
-                            );
-                        }
-                    }
-                }
-
-                m_mappingConfigs[id] = config;
-            }
-            catch (const nlohmann::json::exception&) {
-                // JSONパースエラーの場合は該当モニターの設定をスキップ
-                continue;
-            }
-            catch (const std::exception&) {
-                // その他のエラーの場合も該当モニターの設定をスキップ
-                continue;
-            }
+        catch (const DisplayControllerException&) {
+            // DDC/CIに対応していないモニターも一覧には含める
         }
+        monitors.push_back(std::move(monitor));
     }
-    catch (const std::exception&) {
-        // エラーが発生した場合は設定の読み込みを中止
-    }
+    return monitors;
 }
 
-MappingConfig MonitorController::GetMappingConfig(MonitorId id)
+MonitorController::MonitorDescriptor MonitorController::ReadMonitorDescriptor(const DisplayDescriptor& display)
 {
-    auto it = m_mappingConfigs.find(id);
-    if (it != m_mappingConfigs.end()) {
-        return it->second;
+    MonitorDescriptor descriptor;
+    if (!display.edid.empty()) {
+        // 同じEDIDは一度だけ解析する
+        descriptor.edid = m_edidCache.Parse(display.edid);
     }
-    return MappingConfig(); // デフォルト設定を返す
+    descriptor.identity = MakeMonitorIdentity(descriptor.edid.get(), display.connector);
+    return descriptor;
 }
 
 // IMonitorController implementation
@@ -230,15 +189,9 @@ bool MonitorController::SetBrightness(MonitorId id, int brightness)
     }
 
     try {
-        // Get physical monitor handle using RAII
-        std::unique_ptr<void, decltype(&DestroyPhysicalMonitor)> handle(
-            GetPhysicalMonitorHandle(id),
-            DestroyPhysicalMonitor
-        );
-
-        // Get brightness range
-        DWORD minBrightness = 0, currentBrightness = 0, maxBrightness = 0;
-        if (!::GetMonitorBrightness(handle.get(), &minBrightness, &currentBrightness, &maxBrightness)) {
+        // キャッシュ済みのハンドルと輝度範囲を使用
+        auto monitor = m_handleCache->Acquire(id);
+        if (!monitor->hasBrightnessRange) {
             return false;
         }
 
@@ -246,13 +199,18 @@ bool MonitorController::SetBrightness(MonitorId id, int brightness)
         int mappedBrightness = MapBrightness(id, brightness);
 
         // Convert percentage to actual brightness value
-        DWORD newBrightness = minBrightness +
-            static_cast<DWORD>((maxBrightness - minBrightness) * mappedBrightness / 100.0);
+        unsigned long newBrightness = monitor->minBrightness +
+            static_cast<unsigned long>((monitor->maxBrightness - monitor->minBrightness) * mappedBrightness / 100.0);
 
         // Set new brightness
-        return SetMonitorBrightness(handle.get(), newBrightness);
+        if (!m_backend->SetBrightness(monitor->handle, newBrightness)) {
+            // ハンドルが無効になっている可能性があるため、次回は開き直す
+            m_handleCache->Invalidate(id);
+            return false;
+        }
+        return true;
     }
-    catch (const WindowsApiException&) {
+    catch (const DisplayControllerException&) {
         return false;
     }
 }
@@ -260,15 +218,12 @@ bool MonitorController::SetBrightness(MonitorId id, int brightness)
 int MonitorController::GetBrightness(MonitorId id)
 {
     try {
-        // Get physical monitor handle using RAII
-        std::unique_ptr<void, decltype(&DestroyPhysicalMonitor)> handle(
-            GetPhysicalMonitorHandle(id),
-            DestroyPhysicalMonitor
-        );
+        auto monitor = m_handleCache->Acquire(id);
 
         // Get current brightness
-        DWORD minBrightness = 0, currentBrightness = 0, maxBrightness = 0;
-        if (!::GetMonitorBrightness(handle.get(), &minBrightness, &currentBrightness, &maxBrightness)) {
+        unsigned long minBrightness = 0, currentBrightness = 0, maxBrightness = 0;
+        if (!m_backend->GetBrightness(monitor->handle, minBrightness, currentBrightness, maxBrightness)) {
+            m_handleCache->Invalidate(id);
             return 0;
         }
 
@@ -279,7 +234,7 @@ int MonitorController::GetBrightness(MonitorId id)
 
         return 0;
     }
-    catch (const WindowsApiException&) {
+    catch (const DisplayControllerException&) {
         return 0;
     }
 }
@@ -290,79 +245,94 @@ bool MonitorController::SetUnifiedBrightness(int normalizedBrightness)
         return false;
     }
 
-    bool success = true;
-    auto monitors = EnumerateMonitors();
-    for (const auto& id : monitors) {
-        if (!SetBrightness(id, normalizedBrightness)) {
-            success = false;
-        }
+    // 作成済みのモニターの一覧を使い、呼び出しのたびにモニターを列挙しない
+    std::vector<std::pair<MonitorId, int>> targets;
+    for (const auto& id : GetTopology()->GetIds()) {
+        targets.emplace_back(id, normalizedBrightness);
     }
-    return success;
+    return DispatchBrightness(targets).AllSucceeded();
 }
 
-// Helper functions
-std::vector<MonitorController::MonitorInfo> MonitorController::GetMonitors()
+BrightnessDispatchResult MonitorController::DispatchBrightness(const std::vector<std::pair<MonitorId, int>>& targets)
 {
-    std::vector<MonitorInfo> monitors;
-    if (!EnumDisplayMonitors(nullptr, nullptr, MonitorEnumProc, reinterpret_cast<LPARAM>(&monitors))) {
-        throw WindowsApiException("Failed to enumerate monitors: " + std::to_string(GetLastError()));
+    auto deadline = m_dispatchDeadline.load();
+
+    if (m_dispatchMode.load() == DispatchMode::Concurrent && targets.size() > 1) {
+        std::vector<BrightnessDispatcher::Job> jobs;
+        jobs.reserve(targets.size());
+        for (const auto& [id, brightness] : targets) {
+            // 同じ通信経路のモニターへの書き込みは順番に送出する
+            jobs.push_back({id, m_backend->GetBusId(id),
+                [this, id = id, brightness = brightness] { return SetBrightness(id, brightness); }});
+        }
+        return m_dispatcher->Dispatch(std::move(jobs), deadline);
+    }
+
+    // 逐次送出（期限を過ぎた残りのモニターはタイムアウトとして扱う）
+    BrightnessDispatchResult result;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& [id, brightness] : targets) {
+        BrightnessDispatchResult::Entry entry;
+        entry.id = id;
+        auto entryStart = std::chrono::steady_clock::now();
+        if (deadline.count() > 0 && entryStart - start >= deadline) {
+            entry.timedOut = true;
+        } else {
+            entry.success = SetBrightness(id, brightness);
+            entry.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - entryStart);
+        }
+        result.entries.push_back(entry);
     }
-    return monitors;
+    result.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    return result;
 }
 
-BOOL CALLBACK MonitorController::MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LPRECT lprcMonitor, LPARAM dwData)
+void MonitorController::SetDispatchMode(DispatchMode mode)
 {
-    auto monitors = reinterpret_cast<std::vector<MonitorInfo>*>(dwData);
-
-    MONITORINFOEXW monitorInfo = { sizeof(MONITORINFOEXW) };
-    if (!::GetMonitorInfoW(hMonitor, reinterpret_cast<LPMONITORINFO>(&monitorInfo))) {
-        return TRUE; // Continue enumeration even if we fail to get info for one monitor
-    }
-
-    MonitorInfo info;
-    info.deviceName = monitorInfo.szDevice;
-    info.isPrimary = (monitorInfo.dwFlags & MONITORINFOF_PRIMARY) != 0;
-    info.bounds = monitorInfo.rcMonitor;
-    info.id = hMonitor;
-
-    // 物理サイズを取得
-    HDC hdc = ::CreateDCW(L"DISPLAY", monitorInfo.szDevice, nullptr, nullptr);
-    if (hdc) {
-        info.physicalSize.cx = ::GetDeviceCaps(hdc, HORZSIZE);  // 物理的な幅 (mm)
-        info.physicalSize.cy = ::GetDeviceCaps(hdc, VERTSIZE);  // 物理的な高さ (mm)
-        ::DeleteDC(hdc);
-    } else {
-        info.physicalSize = {0, 0};
-    }
-
-    monitors->push_back(info);
-    return TRUE;
+    m_dispatchMode = mode;
 }
 
-HANDLE MonitorController::GetPhysicalMonitorHandle(MonitorId id)
+void MonitorController::SetDispatchDeadline(std::chrono::milliseconds deadline)
 {
-    DWORD numberOfPhysicalMonitors = 0;
-    if (!::GetNumberOfPhysicalMonitorsFromHMONITOR(id, &numberOfPhysicalMonitors)) {
-        throw WindowsApiException("Failed to get number of physical monitors: " + std::to_string(::GetLastError()));
-    }
+    m_dispatchDeadline = deadline;
+}
 
-    if (numberOfPhysicalMonitors == 0) {
-        throw WindowsApiException("No physical monitors found");
-    }
+void MonitorController::OnDisplayChange()
+{
+    // モニターのID（WindowsではHMONITOR）が再割り当てされる可能性があるため、すべてのハンドルを開き直す
+    m_handleCache->InvalidateAll();
+    // モニターの一覧は次に参照したときに作り直す
+    // （マッピング設定は識別情報ごとに、解析済みのEDIDはハッシュ値ごとに保持しているため破棄しない）
+    m_topology.Invalidate();
+}
 
-    std::vector<PHYSICAL_MONITOR> physicalMonitors(numberOfPhysicalMonitors);
-    if (!::GetPhysicalMonitorsFromHMONITOR(id, numberOfPhysicalMonitors, physicalMonitors.data())) {
-        throw WindowsApiException("Failed to get physical monitors: " + std::to_string(::GetLastError()));
-    }
+MonitorTopologyChange MonitorController::RefreshTopology()
+{
+    m_handleCache->InvalidateAll();
+    return m_topology.Refresh();
+}
 
-    HANDLE handle = physicalMonitors[0].hPhysicalMonitor;
+PhysicalMonitorCache::Stats MonitorController::GetHandleCacheStats() const
+{
+    return m_handleCache->GetStats();
+}
 
-    // Clean up the remaining handles if any
-    for (DWORD i = 1; i < numberOfPhysicalMonitors; ++i) {
-        DestroyPhysicalMonitor(physicalMonitors[i].hPhysicalMonitor);
+// Helper functions
+std::vector<MonitorController::MonitorInfo> MonitorController::GetMonitors()
+{
+    std::vector<MonitorInfo> monitors;
+    for (const auto& monitor : GetTopology()->GetMonitors()) {
+        MonitorInfo info = {};
+        info.deviceName = monitor.deviceName;
+        info.isPrimary = monitor.isPrimary;
+        info.bounds = monitor.bounds;
+        info.id = monitor.id;
+        info.physicalSize = { monitor.widthMm, monitor.heightMm };
+        monitors.push_back(info);
     }
-
-    return handle;
+    return monitors;
 }
 
 MonitorController::MonitorCapabilities MonitorController::GetMonitorCapabilities(MonitorId id)
@@ -376,100 +346,30 @@ MonitorController::MonitorCapabilities MonitorController::GetMonitorCapabilities
     caps.displaySize = { 0, 0 };
 
     try {
-        // Get physical monitor handle using RAII
-        std::unique_ptr<void, decltype(&DestroyPhysicalMonitor)> handle(
-            GetPhysicalMonitorHandle(id),
-            DestroyPhysicalMonitor
-        );
+        auto monitor = m_handleCache->Acquire(id);
 
         // Test brightness control
-        DWORD minValue = 0, currentValue = 0, maxValue = 0;
-        if (::GetMonitorBrightness(handle.get(), &minValue, &currentValue, &maxValue)) {
-            caps.supportsBrightness = true;
-        }
+        caps.supportsBrightness = monitor->hasBrightnessRange;
 
         // Test contrast control
-        if (::GetMonitorContrast(handle.get(), &minValue, &currentValue, &maxValue)) {
+        unsigned long minValue = 0, currentValue = 0, maxValue = 0;
+        if (m_backend->GetContrast(monitor->handle, minValue, currentValue, maxValue)) {
             caps.supportsContrast = true;
         }
 
-        // Get display size using DPI
-        MONITORINFOEXW monitorInfo = { sizeof(MONITORINFOEXW) };
-        if (::GetMonitorInfoW(id, reinterpret_cast<LPMONITORINFO>(&monitorInfo))) {
-            HDC hdc = ::CreateDCW(L"DISPLAY", monitorInfo.szDevice, nullptr, nullptr);
-            if (hdc) {
-                caps.displaySize.cx = ::GetDeviceCaps(hdc, HORZSIZE);  // Physical width (mm)
-                caps.displaySize.cy = ::GetDeviceCaps(hdc, VERTSIZE);  // Physical height (mm)
-                ::DeleteDC(hdc);
-            }
+        // Physical size (mm) recorded when the topology was built
+        if (const auto* entry = GetTopology()->Find(id)) {
+            caps.displaySize = { entry->widthMm, entry->heightMm };
         }
     }
-    catch (const WindowsApiException&) {
+    catch (const DisplayControllerException&) {
         // If we fail to get the physical monitor handle, return the empty capabilities
     }
 
     return caps;
 }
 
-bool MonitorController::GetMonitorEDID(const std::wstring& deviceName, std::vector<BYTE>& edidData)
-{
-    HDEVINFO deviceInfo = SetupDiGetClassDevsW(&GUID_DEVCLASS_MONITOR, nullptr, nullptr, DIGCF_PRESENT);
-    if (deviceInfo == INVALID_HANDLE_VALUE) {
-        return false;
-    }
-
-    std::unique_ptr<void, decltype(&SetupDiDestroyDeviceInfoList)> deviceInfoGuard(
-        deviceInfo, SetupDiDestroyDeviceInfoList);
-
-    SP_DEVINFO_DATA deviceInfoData = { sizeof(SP_DEVINFO_DATA) };
-    for (DWORD i = 0; SetupDiEnumDeviceInfo(deviceInfo, i, &deviceInfoData); i++) {
-        DWORD propertyType;
-        BYTE buffer[2048];
-        DWORD size = sizeof(buffer);
-
-        if (SetupDiGetDeviceRegistryPropertyW(deviceInfo, &deviceInfoData, SPDRP_HARDWAREID,
-            &propertyType, buffer, size, &size)) {
-            std::wstring hardwareId = reinterpret_cast<wchar_t*>(buffer);
-            if (hardwareId.find(deviceName) != std::wstring::npos) {
-                // EDIDデータを取得
-                if (SetupDiGetDeviceRegistryPropertyW(deviceInfo, &deviceInfoData, SPDRP_PHYSICAL_DEVICE_OBJECT_NAME,
-                    &propertyType, buffer, size, &size)) {
-                    edidData.assign(buffer, buffer + size);
-                    return true;
-                }
-            }
-        }
-    }
-    return false;
-}
-
-bool MonitorController::ParseEDIDManufacturerInfo(const std::vector<BYTE>& edidData,
-    std::wstring& manufacturer, std::wstring& productCode)
-{
-    if (edidData.size() < 128) {
-        return false;
-    }
-
-    // 製造元IDを解析（3文字のASCIIコード）
-    unsigned short manufacturerId = (edidData[8] << 8) | edidData[9];
-    wchar_t manufacturerCode[4] = {
-        static_cast<wchar_t>((manufacturerId >> 10 & 0x1F) + 'A' - 1),
-        static_cast<wchar_t>((manufacturerId >> 5 & 0x1F) + 'A' - 1),
-        static_cast<wchar_t>((manufacturerId & 0x1F) + 'A' - 1),
-        L'\0'
-    };
-    manufacturer = manufacturerCode;
-
-    // 製品コードを16進数で取得
-    unsigned short productCodeValue = (edidData[11] << 8) | edidData[10];
-    std::wstringstream ss;
-    ss << std::hex << std::uppercase << std::setfill(L'0') << std::setw(4) << productCodeValue;
-    productCode = ss.str();
-
-    return true;
-}
-
-std::wstring MonitorController::ConvertSizeToInches(const SIZE& sizeInMm)
+std::wstring MonitorController::ConvertSizeToInches(const PhysicalSize& sizeInMm)
 {
     // 対角線の長さをインチに変換
     double diagonalMm = std::sqrt(
@@ -483,36 +383,37 @@ std::wstring MonitorController::ConvertSizeToInches(const SIZE& sizeInMm)
     return std::to_wstring(inches) + L"inch";
 }
 
-std::wstring MonitorController::GetMonitorRoleInfo(const MonitorInfo& info)
+std::wstring MonitorController::GetMonitorRoleInfo(const MonitorTopology::Monitor& monitor)
 {
     std::wstring role;
-    if (info.isPrimary) {
+    if (monitor.isPrimary) {
         role = L"Primary";
     }
     return role;
 }
 
-std::wstring MonitorController::GenerateHumanReadableName(const MonitorInfo& info)
+std::wstring MonitorController::GenerateHumanReadableName(const MonitorTopology::Monitor& monitor)
 {
     std::wstringstream nameStream;
 
-    // 製造元名とモデル名を追加
-    if (info.manufacturerName != L"Unknown") {
-        nameStream << info.manufacturerName;
-        if (info.productCode != L"Unknown") {
-            nameStream << L" " << info.productCode;
-        }
+    // モデル名、または製造元名と製品コードを追加
+    if (monitor.edid && !monitor.edid->name.empty()) {
+        nameStream << StringUtils::Utf8ToWide(monitor.edid->name);
+    } else if (monitor.edid) {
+        nameStream << StringUtils::Utf8ToWide(monitor.edid->manufacturer) << L" "
+                   << std::hex << std::uppercase << std::setfill(L'0') << std::setw(4) << monitor.edid->productCode
+                   << std::dec;
     } else {
         nameStream << L"Display " << std::to_wstring(m_nameCounters[L"Generic"]++);
     }
 
     // サイズ情報を追加
-    if (info.physicalSize.cx > 0 && info.physicalSize.cy > 0) {
-        nameStream << L" " << ConvertSizeToInches(info.physicalSize);
+    if (monitor.widthMm > 0 && monitor.heightMm > 0) {
+        nameStream << L" " << ConvertSizeToInches({ monitor.widthMm, monitor.heightMm });
     }
 
     // 役割情報を追加
-    std::wstring role = GetMonitorRoleInfo(info);
+    std::wstring role = GetMonitorRoleInfo(monitor);
     if (!role.empty()) {
         nameStream << L" " << role;
     }
@@ -531,25 +432,46 @@ std::wstring MonitorController::GenerateHumanReadableName(const MonitorInfo& inf
 
 void MonitorController::GetDetailedMonitorInfo(MonitorInfo& info)
 {
-    // 物理サイズを取得
-    auto caps = GetMonitorCapabilities(info.id);
-    info.physicalSize = caps.displaySize;
-
-    // EDID情報を取得
-    std::vector<BYTE> edidData;
-    if (GetMonitorEDID(info.deviceName, edidData)) {
-        ParseEDIDManufacturerInfo(edidData, info.manufacturerName, info.productCode);
+    const auto topology = GetTopology();
+    const auto* monitor = topology->Find(info.id);
+    if (!monitor) {
+        // 構成の変更前に取得したモニター
+        info.manufacturerName = L"Unknown";
+        info.productCode = L"Unknown";
+        info.modelName.clear();
+        info.serialNumber = L"Unknown";
+        info.humanReadableName = info.deviceName;
+        info.friendlyName = info.humanReadableName;
+        return;
+    }
+
+    info.physicalSize = { monitor->widthMm, monitor->heightMm };
+    if (monitor->edid) {
+        std::wstringstream productCode;
+        productCode << std::hex << std::uppercase << std::setfill(L'0') << std::setw(4) << monitor->edid->productCode;
+        info.manufacturerName = StringUtils::Utf8ToWide(monitor->edid->manufacturer);
+        info.productCode = productCode.str();
+        info.modelName = StringUtils::Utf8ToWide(monitor->edid->name);
     } else {
         info.manufacturerName = L"Unknown";
         info.productCode = L"Unknown";
+        info.modelName.clear();
     }
 
-    // シリアル番号は現時点では未実装
-    info.serialNumber = L"Unknown";
+    const auto& identity = monitor->identity;
+    if (!identity.serialString.empty()) {
+        info.serialNumber = StringUtils::Utf8ToWide(identity.serialString);
+    } else if (identity.serialNumber != 0) {
+        std::wstringstream serial;
+        serial << std::hex << std::uppercase << std::setfill(L'0') << std::setw(8) << identity.serialNumber;
+        info.serialNumber = serial.str();
+    } else {
+        info.serialNumber = L"Unknown";
+    }
 
-    // フレンドリーネームを生成
-    info.friendlyName = GenerateHumanReadableName(info);
-    info.humanReadableName = info.friendlyName;
+    // 名前は一覧の作成時に決めるため、ディスプレイ構成が変わるまで同じものを返す
+    info.humanReadableName = monitor->name;
+    info.friendlyName = info.humanReadableName;
 }
 
 std::wstring MonitorController::GetSettingsFilePath(const MonitorInfo& info) const
@@ -615,7 +537,7 @@ MonitorController::MonitorSettings MonitorController::LoadMonitorSettings(const
                 settings.contrast = j["contrast"].get<int>();
             }
             if (j.contains("colorTemperature")) {
-                settings.colorTemperature = j["colorTemperature"].get<DWORD>();
+                settings.colorTemperature = j["colorTemperature"].get<unsigned long>();
             }
         }
         catch (const nlohmann::json::exception& e) {
@@ -1,56 +1,28 @@
 #ifndef DISPLAYCONTROLLER_MONITOR_CONTROLLER_H
 #define DISPLAYCONTROLLER_MONITOR_CONTROLLER_H
 
-// DLLエクスポート/インポートマクロ
-#ifdef DISPLAYCONTROLLER_EXPORTS
-    #define DISPLAYCONTROLLER_API __declspec(dllexport)
-#else
-    #define DISPLAYCONTROLLER_API __declspec(dllimport)
-#endif
-
-// インターフェースのDLLエクスポート設定
-#define DISPLAYCONTROLLER_INTERFACE class DISPLAYCONTROLLER_API
-
-#include <windows.h>
+#include "MonitorBackend.h"
+#include "DisplayBackend.h"
+#include "PhysicalMonitorCache.h"
+#include "BrightnessDispatcher.h"
+#include "BrightnessMapping.h"
+#include "EdidParser.h"
+#include "MonitorIdentity.h"
+#include "MonitorMappingRegistry.h"
+#include "MonitorTopology.h"
 #include <vector>
 #include <string>
 #include <stdexcept>
 #include <filesystem>
 #include <memory>
 #include <map>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <sstream>
 #include <iomanip>
-#include <setupapi.h>
-#include <devguid.h>
 #include <nlohmann/json.hpp>
 
-#pragma comment(lib, "Setupapi.lib")
-
-// 例外クラス
-class DISPLAYCONTROLLER_API DisplayControllerException : public std::runtime_error {
-public:
-    explicit DisplayControllerException(const std::string& message)
-        : std::runtime_error(message) {}
-};
-
-class DISPLAYCONTROLLER_API WindowsApiException : public DisplayControllerException {
-public:
-    explicit WindowsApiException(const std::string& message)
-        : DisplayControllerException(message) {}
-};
-
-// モニターID型
-using MonitorId = HMONITOR;
-
-// 輝度マッピング設定
-struct MappingConfig {
-    int minBrightness;
-    int maxBrightness;
-    std::vector<std::pair<int, int>> mappingPoints;
-
-    MappingConfig() : minBrightness(0), maxBrightness(100) {}
-};
-
 // モニター管理インターフェース
 DISPLAYCONTROLLER_INTERFACE IMonitorManager {
 public:
@@ -80,20 +52,27 @@ public:
 // MonitorController クラス
 class DISPLAYCONTROLLER_API MonitorController : public IMonitorManager, public IBrightnessMapper, public IMonitorController {
 public:
+    // 物理サイズ（mm）
+    struct PhysicalSize {
+        int cx;
+        int cy;
+    };
+
     struct MonitorInfo {
         std::wstring deviceName;
         bool isPrimary;
-        RECT bounds;
+        MonitorTopology::Bounds bounds;
         MonitorId id;
 
         // 詳細な識別情報
         std::wstring manufacturerName;
         std::wstring productCode;
+        std::wstring modelName;         // EDIDのモニター名（例：DELL P2419H）。なければ空
         std::wstring serialNumber;
         std::wstring friendlyName;
 
         // 物理サイズ（mm）
-        SIZE physicalSize;
+        PhysicalSize physicalSize;
 
         // 人間が識別可能な名前（例：DELL P2419H 24inch Primary）
         std::wstring humanReadableName;
@@ -103,7 +82,13 @@ public:
     struct MonitorSettings {
         int brightness;
         int contrast;
-        DWORD colorTemperature;
+        unsigned long colorTemperature;
+    };
+
+    // 複数モニターへの輝度設定の送出方法
+    enum class DispatchMode {
+        Sequential,   // モニターごとに順番に設定
+        Concurrent    // ワーカープールで並行して設定
     };
 
     // Monitor capabilities
@@ -112,11 +97,22 @@ public:
         bool supportsContrast;
         bool supportsColorTemperature;
         std::string technologyType;
-        DWORD colorTemperature;
-        SIZE displaySize;  // in millimeters
+        unsigned long colorTemperature;
+        PhysicalSize displaySize;  // in millimeters
     };
 
+    // 実行環境に合ったバックエンドを使う
     MonitorController();
+    explicit MonitorController(std::unique_ptr<IDisplayBackend> backend);
+
+    /**
+     * @brief バックエンドと設定ファイルのディレクトリを指定して作成する
+     *
+     * テストやベンチマークでは、SimulatedDisplayBackendと一時ディレクトリを渡すことで
+     * OSのモニターや利用者の設定に触れずに動作させることができます。
+     * @throws DisplayControllerException backendがnullの場合
+     */
+    MonitorController(std::unique_ptr<IDisplayBackend> backend, std::filesystem::path settingsPath);
     ~MonitorController() noexcept override;
 
     // IMonitorManager の実装
@@ -140,32 +136,81 @@ public:
     void SaveMonitorSettings(const MonitorInfo& info, const MonitorSettings& settings);
     MonitorSettings LoadMonitorSettings(const MonitorInfo& info);
 
+    // 再起動や接続し直しで変わらないモニターの識別情報
+    MonitorIdentity GetMonitorIdentity(MonitorId id);
+
+    /**
+     * @brief 接続中のモニターの一覧
+     *
+     * 最初の呼び出しとディスプレイ構成の変更後の最初の呼び出しでだけモニターを列挙し、
+     * それ以外はOSへ問い合わせずに作成済みの一覧を返します。
+     */
+    std::shared_ptr<const MonitorTopology> GetTopology();
+
+    // 複数モニターへの輝度設定（モニターごとの結果を返す）
+    BrightnessDispatchResult DispatchBrightness(const std::vector<std::pair<MonitorId, int>>& targets);
+    void SetDispatchMode(DispatchMode mode);
+    void SetDispatchDeadline(std::chrono::milliseconds deadline);
+
+    // ディスプレイ構成の変更通知（キャッシュ済みの物理モニターハンドルとモニターの一覧を破棄する）
+    void OnDisplayChange();
+
+    /**
+     * @brief モニターの一覧をすぐに作り直し、前回の一覧との差分を返す
+     *
+     * モニターは識別情報で対応付けるため、IDが割り当て直されたモニターも接続し続けているものとして扱います。
+     */
+    MonitorTopologyChange RefreshTopology();
+    PhysicalMonitorCache::Stats GetHandleCacheStats() const;
+
 private:
-    static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LPRECT lprcMonitor, LPARAM dwData);
-    HANDLE GetPhysicalMonitorHandle(MonitorId id);
     // モニター情報取得用のヘルパー関数
     std::wstring GetSettingsFilePath(const MonitorInfo& info) const;
-    std::wstring GetMappingConfigFilePath(MonitorId id) const;
-    void SaveMappingConfig(MonitorId id, const MappingConfig& config);
-    void LoadMappingConfigs();
 
-    // EDID情報取得用のヘルパー関数
-    bool GetMonitorEDID(const std::wstring& deviceName, std::vector<BYTE>& edidData);
-    bool ParseEDIDManufacturerInfo(const std::vector<BYTE>& edidData, std::wstring& manufacturer, std::wstring& productCode);
+    // 設定ファイルの既定のディレクトリ（Windows: %LOCALAPPDATA%、その他: $XDG_CONFIG_HOME または ~/.config）
+    static std::filesystem::path GetDefaultSettingsPath();
+
+    // モニターの一覧の作成（バックエンドによるディスプレイの列挙はここでだけ行う）
+    std::vector<MonitorTopology::Monitor> BuildTopology();
+
+    // モニターごとの識別情報と解析済みのEDID
+    struct MonitorDescriptor {
+        MonitorIdentity identity;
+        std::shared_ptr<const EdidInfo> edid;   // EDIDを読み取れない場合はnullptr
+    };
+    MonitorDescriptor ReadMonitorDescriptor(const DisplayDescriptor& display);
 
     // 人間が識別可能な名前の生成
-    std::wstring GenerateHumanReadableName(const MonitorInfo& info);
-    std::wstring ConvertSizeToInches(const SIZE& sizeInMm);
-    std::wstring GetMonitorRoleInfo(const MonitorInfo& info);
+    std::wstring GenerateHumanReadableName(const MonitorTopology::Monitor& monitor);
+    std::wstring ConvertSizeToInches(const PhysicalSize& sizeInMm);
+    std::wstring GetMonitorRoleInfo(const MonitorTopology::Monitor& monitor);
+
+    // ディスプレイの列挙と物理モニター操作のバックエンドとハンドルキャッシュ
+    // （キャッシュはバックエンドを参照するため、バックエンドより後に宣言する）
+    std::unique_ptr<IDisplayBackend> m_backend;
+    std::unique_ptr<PhysicalMonitorCache> m_handleCache;
+
+    std::atomic<DispatchMode> m_dispatchMode{DispatchMode::Concurrent};
+    std::atomic<std::chrono::milliseconds> m_dispatchDeadline{std::chrono::milliseconds(2000)};
 
     // 設定ファイルのベースディレクトリ
     std::filesystem::path m_settingsPath;
 
-    // モニターごとのマッピング設定
-    std::map<MonitorId, MappingConfig> m_mappingConfigs;
+    // モニターの識別情報ごとのマッピング設定（接続中のモニターの設定だけを読み込む）
+    std::unique_ptr<MonitorMappingRegistry> m_mappings;
 
-    // 重複名の処理用のカウンター
+    // 解析済みのEDID（ハッシュ値ごとに保持し、ディスプレイ構成が変わっても破棄しない）
+    EdidCache m_edidCache;
+
+    // 重複名の処理用のカウンター（モニターの一覧の作成中だけ使う）
     std::map<std::wstring, int> m_nameCounters;
+
+    // 接続中のモニターの一覧（物理モニターハンドルを参照するため、ハンドルキャッシュより後に宣言する）
+    MonitorTopologyStore m_topology;
+
+    // 輝度設定の並行送出（期限切れの後も実行中のジョブが他のメンバーを参照するため、
+    // 最後に宣言し最初に破棄する。破棄時は実行中のジョブの完了を待つ）
+    std::unique_ptr<BrightnessDispatcher> m_dispatcher;
 };
 
 #endif // DISPLAYCONTROLLER_MONITOR_CONTROLLER_H
@@ -0,0 +1,49 @@
+#include "MonitorIdentity.h"
+#include <cstdio>
+
+namespace {
+    std::string Hex(uint32_t value, int digits)
+    {
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%0*X", digits, value);
+        return buffer;
+    }
+}
+
+std::string MonitorIdentity::ToKey() const
+{
+    if (!HasEdid()) {
+        return "@" + connector;
+    }
+
+    std::string key = manufacturer + "-" + Hex(productCode, 4);
+    if (!serialString.empty()) {
+        return key + "-" + serialString;
+    }
+    if (serialNumber != 0) {
+        return key + "-" + Hex(serialNumber, 8);
+    }
+    // 同じ型番のモニターを区別できないため、接続先で区別する
+    return key + "@" + connector;
+}
+
+MonitorIdentity MakeMonitorIdentity(const std::vector<uint8_t>& edid, std::string connector)
+{
+    auto info = ParseEdid(edid);
+    return MakeMonitorIdentity(info ? &*info : nullptr, std::move(connector));
+}
+
+MonitorIdentity MakeMonitorIdentity(const EdidInfo* edid, std::string connector)
+{
+    MonitorIdentity identity;
+    identity.connector = std::move(connector);
+    if (!edid) {
+        return identity;
+    }
+
+    identity.manufacturer = edid->manufacturer;
+    identity.productCode = edid->productCode;
+    identity.serialNumber = edid->serialNumber;
+    identity.serialString = edid->serial;
+    return identity;
+}
@@ -0,0 +1,53 @@
+#ifndef DISPLAYCONTROLLER_MONITOR_IDENTITY_H
+#define DISPLAYCONTROLLER_MONITOR_IDENTITY_H
+
+#include "EdidParser.h"
+#include "MonitorBackend.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 再起動や接続し直しで変わらないモニターの識別情報
+ *
+ * EDIDの製造元ID・製品コード・シリアル番号と、接続先（コネクター）から作ります。
+ * HMONITORのように起動のたびに変わる値は含みません。
+ *
+ * シリアル番号を持つモニターは、別の端子へつなぎ替えても同じモニターとして扱います。
+ * シリアル番号を持たないモニター（同じ型番のモニターを区別できない場合）と、
+ * EDIDを読み取れないモニターは、接続先で区別します。
+ */
+struct DISPLAYCONTROLLER_API MonitorIdentity {
+    std::string manufacturer;       // PNP ID（例: DEL）。EDIDを読み取れない場合は空
+    uint16_t productCode = 0;
+    uint32_t serialNumber = 0;      // 0は未設定
+    std::string serialString;       // シリアル番号の記述子（0xFF）。なければ空
+    std::string connector;          // OSごとの接続先の識別子
+
+    bool HasEdid() const { return !manufacturer.empty(); }
+    bool HasSerial() const { return serialNumber != 0 || !serialString.empty(); }
+
+    /**
+     * @brief 設定やファイル名に使うキー
+     *
+     * 例: "DEL-A0C4-7MT0195R1BPL"、"GSM-5B09@<接続先>"、"@<接続先>"
+     */
+    std::string ToKey() const;
+
+    bool operator==(const MonitorIdentity& other) const { return ToKey() == other.ToKey(); }
+    bool operator!=(const MonitorIdentity& other) const { return !(*this == other); }
+};
+
+/**
+ * @brief EDIDから識別情報を作る
+ *
+ * ヘッダーまたはチェックサムが不正な場合、128バイトに満たない場合は
+ * 接続先だけの識別情報を返します。
+ */
+DISPLAYCONTROLLER_API MonitorIdentity MakeMonitorIdentity(const std::vector<uint8_t>& edid, std::string connector);
+
+// 解析済みのEDIDから識別情報を作る（nullptrの場合は接続先だけの識別情報）
+DISPLAYCONTROLLER_API MonitorIdentity MakeMonitorIdentity(const EdidInfo* edid, std::string connector);
+
+#endif // DISPLAYCONTROLLER_MONITOR_IDENTITY_H
@@ -0,0 +1,156 @@
+#include "MonitorMappingRegistry.h"
+#include "AtomicFile.h"
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+namespace {
+    // ファイル名に使えない文字を置き換える
+    std::string SanitizeFileName(const std::string& key)
+    {
+        std::string name;
+        name.reserve(key.size());
+        for (char c : key) {
+            bool safe = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') ||
+                        c == '-' || c == '_';
+            name += safe ? c : '_';
+        }
+        return name;
+    }
+}
+
+MonitorMappingRegistry::MonitorMappingRegistry(std::filesystem::path directory)
+    : m_directory(std::move(directory))
+{
+}
+
+int MonitorMappingRegistry::Map(const MonitorIdentity& identity, int normalizedBrightness)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto& table = FindLocked(identity);
+    if (!table) {
+        // デフォルトのマッピング（線形）を使用
+        return normalizedBrightness;
+    }
+    return table->Map(normalizedBrightness);
+}
+
+std::shared_ptr<const BrightnessLookupTable> MonitorMappingRegistry::GetTable(const MonitorIdentity& identity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return FindLocked(identity);
+}
+
+MappingConfig MonitorMappingRegistry::GetConfig(const MonitorIdentity& identity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto& table = FindLocked(identity);
+    return table ? table->GetConfig() : MappingConfig();
+}
+
+void MonitorMappingRegistry::SetConfig(const MonitorIdentity& identity, const MappingConfig& config)
+{
+    nlohmann::json j;
+    j["minBrightness"] = config.minBrightness;
+    j["maxBrightness"] = config.maxBrightness;
+    nlohmann::json points = nlohmann::json::array();
+    for (const auto& point : config.mappingPoints) {
+        points.push_back({
+            {"input", point.first},
+            {"output", point.second}
+        });
+    }
+    j["mappingPoints"] = points;
+    // どのモニターの設定かをファイルから確認できるようにする
+    j["monitor"] = identity.ToKey();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tables.insert_or_assign(identity.ToKey(), std::make_shared<const BrightnessLookupTable>(config));
+    try {
+        std::filesystem::create_directories(m_directory);
+        WriteFileAtomically(GetFilePath(identity), j.dump(2));
+    }
+    catch (const std::exception& e) {
+        throw DisplayControllerException(std::string("Failed to save mapping config: ") + e.what());
+    }
+}
+
+void MonitorMappingRegistry::MigrateLegacyFile(const MonitorIdentity& identity, const std::filesystem::path& legacyFileName)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::error_code ec;
+    auto legacyPath = m_directory / legacyFileName;
+    if (!std::filesystem::exists(legacyPath, ec)) {
+        return;
+    }
+
+    auto path = GetFilePath(identity);
+    if (!std::filesystem::exists(path, ec)) {
+        std::filesystem::rename(legacyPath, path, ec);
+        if (!ec) {
+            // 読み込み済みの「設定なし」を破棄する
+            m_tables.erase(identity.ToKey());
+            return;
+        }
+    }
+    std::filesystem::remove(legacyPath, ec);
+}
+
+std::filesystem::path MonitorMappingRegistry::GetFilePath(const MonitorIdentity& identity) const
+{
+    return m_directory / ("mapping_" + SanitizeFileName(identity.ToKey()) + ".json");
+}
+
+void MonitorMappingRegistry::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tables.clear();
+}
+
+const std::shared_ptr<const BrightnessLookupTable>& MonitorMappingRegistry::FindLocked(const MonitorIdentity& identity)
+{
+    auto key = identity.ToKey();
+    auto it = m_tables.find(key);
+    if (it == m_tables.end()) {
+        std::shared_ptr<const BrightnessLookupTable> table;
+        if (auto config = LoadFile(GetFilePath(identity))) {
+            table = std::make_shared<const BrightnessLookupTable>(*config);
+        }
+        it = m_tables.emplace(std::move(key), std::move(table)).first;
+    }
+    return it->second;
+}
+
+std::optional<MappingConfig> MonitorMappingRegistry::LoadFile(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    if (!file) {
+        return std::nullopt; // 設定ファイルが存在しない場合
+    }
+
+    try {
+        nlohmann::json j = nlohmann::json::parse(file);
+
+        MappingConfig config;
+        if (j.contains("minBrightness")) {
+            config.minBrightness = j["minBrightness"].get<int>();
+        }
+        if (j.contains("maxBrightness")) {
+            config.maxBrightness = j["maxBrightness"].get<int>();
+        }
+        if (j.contains("mappingPoints") && j["mappingPoints"].is_array()) {
+            for (const auto& point : j["mappingPoints"]) {
+                if (point.contains("input") && point.contains("output")) {
+                    config.mappingPoints.emplace_back(
+                        point["input"].get<int>(),
+                        point["output"].get<int>()
+                    );
+                }
+            }
+        }
+        return config;
+    }
+    catch (const std::exception&) {
+        // 壊れた設定ファイルは設定なしとして扱う
+        return std::nullopt;
+    }
+}
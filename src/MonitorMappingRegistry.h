@@ -0,0 +1,70 @@
+#ifndef DISPLAYCONTROLLER_MONITOR_MAPPING_REGISTRY_H
+#define DISPLAYCONTROLLER_MONITOR_MAPPING_REGISTRY_H
+
+#include "BrightnessMapping.h"
+#include "MonitorIdentity.h"
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief モニターの識別情報ごとの輝度マッピング設定
+ *
+ * 設定はモニターごとに mapping_<識別キー>.json として保存します。
+ * ファイルは最初に参照されたときに読み込むため、接続中のモニターの設定だけを読みます。
+ * 読み込んだ設定は変換表へ事前計算して保持し、ファイルがないことも記録して
+ * 同じモニターについてファイルを何度も探さないようにします。
+ *
+ * 複数のスレッドから同時に呼び出せます。
+ */
+class DISPLAYCONTROLLER_API MonitorMappingRegistry {
+public:
+    explicit MonitorMappingRegistry(std::filesystem::path directory);
+
+    // コピー禁止
+    MonitorMappingRegistry(const MonitorMappingRegistry&) = delete;
+    MonitorMappingRegistry& operator=(const MonitorMappingRegistry&) = delete;
+
+    // 設定のないモニターはそのままの値（線形）を返す
+    int Map(const MonitorIdentity& identity, int normalizedBrightness);
+
+    // 事前計算した変換表（設定のないモニターはnullptr）
+    std::shared_ptr<const BrightnessLookupTable> GetTable(const MonitorIdentity& identity);
+
+    // 設定のないモニターはデフォルトの設定を返す
+    MappingConfig GetConfig(const MonitorIdentity& identity);
+
+    /**
+     * @brief 設定を変更して保存する
+     * @throws DisplayControllerException 保存に失敗した場合（保持している設定は変更される）
+     */
+    void SetConfig(const MonitorIdentity& identity, const MappingConfig& config);
+
+    /**
+     * @brief 以前の形式（ファイル名にHMONITORの値を含む）の設定を引き継ぐ
+     *
+     * 識別情報の設定ファイルがまだない場合だけ、古いファイルの名前を変更して引き継ぎます。
+     * 古いファイルは引き継いだかどうかに関わらず削除します。
+     */
+    void MigrateLegacyFile(const MonitorIdentity& identity, const std::filesystem::path& legacyFileName);
+
+    std::filesystem::path GetFilePath(const MonitorIdentity& identity) const;
+
+    // 読み込み済みの設定を破棄する（次に参照したときにファイルから読み直す）
+    void Clear();
+
+private:
+    // m_mutexを保持した状態で呼ぶ
+    const std::shared_ptr<const BrightnessLookupTable>& FindLocked(const MonitorIdentity& identity);
+    static std::optional<MappingConfig> LoadFile(const std::filesystem::path& path);
+
+    std::filesystem::path m_directory;
+    std::mutex m_mutex;
+    // 識別キーごとの変換表（nullptrは設定ファイルがないことを表す）
+    std::unordered_map<std::string, std::shared_ptr<const BrightnessLookupTable>> m_tables;
+};
+
+#endif // DISPLAYCONTROLLER_MONITOR_MAPPING_REGISTRY_H
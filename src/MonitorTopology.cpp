@@ -0,0 +1,136 @@
+#include "MonitorTopology.h"
+#include <algorithm>
+#include <deque>
+
+bool MonitorTopologyChange::HasMonitorChanges() const
+{
+    if (!added.empty() || !removed.empty()) {
+        return true;
+    }
+    for (const auto& [before, after] : retained) {
+        if (before != after) {
+            return true;
+        }
+    }
+    return false;
+}
+
+MonitorTopology::MonitorTopology(std::vector<Monitor> monitors, uint64_t generation)
+    : m_monitors(std::move(monitors))
+    , m_generation(generation)
+{
+    m_ids.reserve(m_monitors.size());
+    for (size_t i = 0; i < m_monitors.size(); ++i) {
+        m_ids.push_back(m_monitors[i].id);
+        m_indices.emplace(m_monitors[i].id, i);
+    }
+}
+
+const MonitorTopology::Monitor* MonitorTopology::Find(MonitorId id) const
+{
+    auto it = m_indices.find(id);
+    return it != m_indices.end() ? &m_monitors[it->second] : nullptr;
+}
+
+std::shared_ptr<const MonitorTopology> MonitorTopology::WithMapping(
+    MonitorId id, std::shared_ptr<const BrightnessLookupTable> mapping) const
+{
+    auto monitors = m_monitors;
+    auto it = m_indices.find(id);
+    if (it != m_indices.end()) {
+        monitors[it->second].mapping = std::move(mapping);
+    }
+    return std::make_shared<const MonitorTopology>(std::move(monitors), m_generation);
+}
+
+MonitorTopologyStore::MonitorTopologyStore(Builder builder)
+    : m_builder(std::move(builder))
+{
+}
+
+std::shared_ptr<const MonitorTopology> MonitorTopologyStore::Get()
+{
+    auto topology = m_topology.load();
+    if (topology && topology->GetGeneration() == m_generation.load()) {
+        return topology;
+    }
+
+    std::lock_guard<std::mutex> lock(m_buildMutex);
+    return GetLocked();
+}
+
+std::shared_ptr<const MonitorTopology> MonitorTopologyStore::GetLocked()
+{
+    while (true) {
+        // 待っている間に別のスレッドが作り直していればそれを使う
+        uint64_t generation = m_generation.load();
+        auto topology = m_topology.load();
+        if (topology && topology->GetGeneration() == generation) {
+            return topology;
+        }
+
+        auto monitors = m_builder();
+        ++m_buildCount;
+        topology = std::make_shared<const MonitorTopology>(std::move(monitors), generation);
+        m_topology = topology;
+
+        m_roster.clear();
+        for (const auto& monitor : topology->GetMonitors()) {
+            m_roster.emplace_back(monitor.id, monitor.identity.ToKey());
+        }
+        if (m_generation.load() == generation) {
+            return topology;
+        }
+        // 作成中に構成が変わったため、もう一度作り直す
+    }
+}
+
+void MonitorTopologyStore::Invalidate()
+{
+    ++m_generation;
+    // 古い構成の物理モニターハンドルを早く閉じられるよう、参照を手放す
+    m_topology.store(nullptr);
+}
+
+MonitorTopologyChange MonitorTopologyStore::Refresh()
+{
+    std::lock_guard<std::mutex> lock(m_buildMutex);
+    Roster before = m_roster;
+    Invalidate();
+
+    MonitorTopologyChange change;
+    change.topology = GetLocked();
+
+    // 同じ識別子のモニターが複数ある場合は列挙順に対応付ける
+    std::unordered_map<std::string, std::deque<MonitorId>> remaining;
+    for (const auto& [id, key] : before) {
+        remaining[key].push_back(id);
+    }
+    for (const auto& monitor : change.topology->GetMonitors()) {
+        auto it = remaining.find(monitor.identity.ToKey());
+        if (it == remaining.end() || it->second.empty()) {
+            change.added.push_back(monitor.id);
+            continue;
+        }
+        change.retained.emplace_back(it->second.front(), monitor.id);
+        it->second.pop_front();
+    }
+    for (const auto& [id, key] : before) {
+        auto& ids = remaining[key];
+        auto it = std::find(ids.begin(), ids.end(), id);
+        if (it != ids.end()) {
+            change.removed.push_back(id);
+            ids.erase(it);
+        }
+    }
+    return change;
+}
+
+void MonitorTopologyStore::UpdateMapping(MonitorId id, std::shared_ptr<const BrightnessLookupTable> mapping)
+{
+    std::lock_guard<std::mutex> lock(m_buildMutex);
+    auto topology = m_topology.load();
+    if (topology) {
+        m_topology = topology->WithMapping(id, std::move(mapping));
+    }
+}
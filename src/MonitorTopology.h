@@ -0,0 +1,148 @@
+#ifndef DISPLAYCONTROLLER_MONITOR_TOPOLOGY_H
+#define DISPLAYCONTROLLER_MONITOR_TOPOLOGY_H
+
+#include "BrightnessMapping.h"
+#include "EdidParser.h"
+#include "MonitorBackend.h"
+#include "MonitorIdentity.h"
+#include "PhysicalMonitorCache.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief ある時点で接続されているモニターの一覧（変更しないスナップショット）
+ *
+ * モニターの列挙・EDIDの読み取り・物理モニターハンドルのオープン・マッピング設定の読み込みを
+ * まとめて一度だけ行った結果を保持します。輝度の適用などの頻繁に呼ばれる処理は
+ * このスナップショットだけを参照し、OSへモニターを問い合わせません。
+ */
+class DISPLAYCONTROLLER_API MonitorTopology {
+public:
+    // モニターの表示領域（仮想スクリーン座標）
+    struct Bounds {
+        long left = 0;
+        long top = 0;
+        long right = 0;
+        long bottom = 0;
+    };
+
+    struct Monitor {
+        MonitorId id = nullptr;
+        std::wstring deviceName;
+        bool isPrimary = false;
+        Bounds bounds;
+
+        // 物理サイズ（mm、0は不明）
+        int widthMm = 0;
+        int heightMm = 0;
+
+        MonitorIdentity identity;
+        std::shared_ptr<const EdidInfo> edid;                       // EDIDを読み取れない場合はnullptr
+        std::wstring name;                                          // 人間が識別可能な名前（一覧の中で重複しない）
+        std::shared_ptr<const PhysicalMonitorCache::Entry> handle;  // 開けなかった場合はnullptr
+        std::shared_ptr<const BrightnessLookupTable> mapping;       // 設定がない場合はnullptr（線形）
+
+        bool SupportsBrightness() const { return handle && handle->hasBrightnessRange; }
+        int MapBrightness(int normalizedBrightness) const
+        {
+            return mapping ? mapping->Map(normalizedBrightness) : normalizedBrightness;
+        }
+    };
+
+    MonitorTopology() = default;
+    MonitorTopology(std::vector<Monitor> monitors, uint64_t generation);
+
+    const std::vector<Monitor>& GetMonitors() const { return m_monitors; }
+    const std::vector<MonitorId>& GetIds() const { return m_ids; }
+    uint64_t GetGeneration() const { return m_generation; }
+
+    // 一覧にないモニターの場合はnullptr
+    const Monitor* Find(MonitorId id) const;
+
+    // 指定したモニターのマッピングだけを差し替えたスナップショットを作る
+    std::shared_ptr<const MonitorTopology> WithMapping(MonitorId id, std::shared_ptr<const BrightnessLookupTable> mapping) const;
+
+private:
+    std::vector<Monitor> m_monitors;
+    std::vector<MonitorId> m_ids;
+    std::unordered_map<MonitorId, size_t> m_indices;
+    uint64_t m_generation = 0;
+};
+
+/**
+ * @brief ディスプレイ構成の変更前後の差分
+ *
+ * モニターは識別子（MonitorIdentity::ToKey()）で対応付けます。Windowsは解像度の変更などでも
+ * モニターのIDを割り当て直すため、接続し続けているモニターも変更前と変更後のIDの組で表します。
+ */
+struct MonitorTopologyChange {
+    std::shared_ptr<const MonitorTopology> topology;          // 変更後のスナップショット
+    std::vector<MonitorId> added;                             // 接続されたモニター（変更後のID）
+    std::vector<MonitorId> removed;                           // 取り外されたモニター（変更前のID）
+    std::vector<std::pair<MonitorId, MonitorId>> retained;    // 接続し続けているモニター（変更前, 変更後）
+
+    // 接続・取り外し・IDの割り当て直しのいずれかがあればtrue
+    bool HasMonitorChanges() const;
+};
+
+/**
+ * @brief 最新のスナップショットを保持し、ディスプレイ構成の変更時だけ作り直す
+ *
+ * Get() は作成済みのスナップショットがあればロックを取らずに返します。
+ * Invalidate() の後に最初に呼ばれた Get() が一度だけ作り直し、同時に呼ばれた他のスレッドは
+ * その完了を待ちます。作成中に Invalidate() された場合は、古い構成の結果を捨てて作り直します。
+ *
+ * 複数のスレッドから同時に呼び出せます。
+ */
+class DISPLAYCONTROLLER_API MonitorTopologyStore {
+public:
+    using Builder = std::function<std::vector<MonitorTopology::Monitor>()>;
+
+    explicit MonitorTopologyStore(Builder builder);
+
+    // コピー禁止
+    MonitorTopologyStore(const MonitorTopologyStore&) = delete;
+    MonitorTopologyStore& operator=(const MonitorTopologyStore&) = delete;
+
+    /**
+     * @brief 最新のスナップショットを取得（必要な場合は作り直す）
+     * @throws 作成関数が投げた例外（保持しているスナップショットは変更しない）
+     */
+    std::shared_ptr<const MonitorTopology> Get();
+
+    // 次のGet()で作り直す（ディスプレイ構成の変更時）
+    void Invalidate();
+
+    /**
+     * @brief すぐに作り直し、前回作成したスナップショットとの差分を返す
+     * @throws 作成関数が投げた例外（次のRefresh()は同じ変更前の一覧と比較する）
+     */
+    MonitorTopologyChange Refresh();
+
+    // 作成済みのスナップショットのマッピングだけを差し替える（OSへの問い合わせは行わない）
+    void UpdateMapping(MonitorId id, std::shared_ptr<const BrightnessLookupTable> mapping);
+
+    size_t GetBuildCount() const { return m_buildCount; }
+
+private:
+    using Roster = std::vector<std::pair<MonitorId, std::string>>;
+
+    // m_buildMutexを取得した状態で呼び出す
+    std::shared_ptr<const MonitorTopology> GetLocked();
+
+    Builder m_builder;
+    std::mutex m_buildMutex;
+    Roster m_roster;  // 最後に作成したスナップショットのIDと識別子（ハンドルは保持しない）
+    std::atomic<uint64_t> m_generation{1};
+    std::atomic<std::shared_ptr<const MonitorTopology>> m_topology;
+    std::atomic<size_t> m_buildCount{0};
+};
+
+#endif // DISPLAYCONTROLLER_MONITOR_TOPOLOGY_H
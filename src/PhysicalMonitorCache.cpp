@@ -0,0 +1,95 @@
+#include "PhysicalMonitorCache.h"
+
+PhysicalMonitorCache::PhysicalMonitorCache(IMonitorBackend& backend)
+    : m_backend(backend)
+{
+}
+
+PhysicalMonitorCache::~PhysicalMonitorCache()
+{
+    InvalidateAll();
+}
+
+std::shared_ptr<const PhysicalMonitorCache::Entry> PhysicalMonitorCache::Acquire(MonitorId id)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(id);
+        if (it != m_entries.end()) {
+            ++m_stats.hits;
+            return it->second;
+        }
+        ++m_stats.misses;
+    }
+
+    // ハンドルのオープンと範囲の問い合わせはDDC/CI通信を伴うためロック外で行う
+    PhysicalMonitorHandle handle = m_backend.OpenPhysicalMonitor(id);
+    auto entry = OpenEntry(handle);
+
+    // 輝度範囲を取得できなかったハンドルはキャッシュせず、次回開き直す
+    if (!entry->hasBrightnessRange) {
+        return entry;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // 別スレッドが先に登録していた場合はそちらを優先する（こちらのハンドルは参照が切れた時点で閉じられる）
+    return m_entries.try_emplace(id, entry).first->second;
+}
+
+std::shared_ptr<const PhysicalMonitorCache::Entry> PhysicalMonitorCache::OpenEntry(PhysicalMonitorHandle handle)
+{
+    // 参照がすべて解放された時点でハンドルを閉じる
+    IMonitorBackend* backend = &m_backend;
+    std::shared_ptr<Entry> entry(new Entry(), [backend](Entry* e) {
+        backend->ClosePhysicalMonitor(e->handle);
+        delete e;
+    });
+    entry->handle = handle;
+
+    unsigned long minValue = 0, currentValue = 0, maxValue = 0;
+    if (m_backend.GetBrightness(handle, minValue, currentValue, maxValue)) {
+        entry->hasBrightnessRange = true;
+        entry->minBrightness = minValue;
+        entry->maxBrightness = maxValue;
+    }
+
+    return entry;
+}
+
+void PhysicalMonitorCache::Invalidate(MonitorId id)
+{
+    std::shared_ptr<const Entry> released;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(id);
+        if (it == m_entries.end()) {
+            return;
+        }
+        released = std::move(it->second);
+        m_entries.erase(it);
+        ++m_stats.invalidations;
+    }
+    // ハンドルのクローズはロック外で行う
+}
+
+void PhysicalMonitorCache::InvalidateAll()
+{
+    std::unordered_map<MonitorId, std::shared_ptr<const Entry>> released;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.invalidations += m_entries.size();
+        released.swap(m_entries);
+    }
+}
+
+size_t PhysicalMonitorCache::Size() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+PhysicalMonitorCache::Stats PhysicalMonitorCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
@@ -0,0 +1,62 @@
+#ifndef DISPLAYCONTROLLER_PHYSICAL_MONITOR_CACHE_H
+#define DISPLAYCONTROLLER_PHYSICAL_MONITOR_CACHE_H
+
+#include "MonitorBackend.h"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @brief 物理モニターハンドルと輝度範囲のキャッシュ
+ *
+ * 輝度の設定・取得のたびにハンドルを開いて範囲を問い合わせ、閉じる処理を避けるため、
+ * モニターごとにハンドルと輝度範囲を保持します。ディスプレイ構成が変わった場合は
+ * InvalidateAll() で破棄します。取得済みのエントリは破棄後も参照が残っている間は有効です。
+ */
+class DISPLAYCONTROLLER_API PhysicalMonitorCache {
+public:
+    struct Entry {
+        PhysicalMonitorHandle handle = nullptr;
+        bool hasBrightnessRange = false;
+        unsigned long minBrightness = 0;
+        unsigned long maxBrightness = 0;
+    };
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t invalidations = 0;
+    };
+
+    explicit PhysicalMonitorCache(IMonitorBackend& backend);
+    ~PhysicalMonitorCache();
+
+    // コピー禁止
+    PhysicalMonitorCache(const PhysicalMonitorCache&) = delete;
+    PhysicalMonitorCache& operator=(const PhysicalMonitorCache&) = delete;
+
+    /**
+     * @brief キャッシュ済みのエントリを取得（未キャッシュの場合はハンドルを開いて輝度範囲を問い合わせる）
+     * @throws DisplayControllerException ハンドルを開けなかった場合
+     */
+    std::shared_ptr<const Entry> Acquire(MonitorId id);
+
+    // 指定したモニターのエントリを破棄
+    void Invalidate(MonitorId id);
+
+    // すべてのエントリを破棄（ディスプレイ構成の変更時）
+    void InvalidateAll();
+
+    size_t Size() const;
+    Stats GetStats() const;
+
+private:
+    std::shared_ptr<const Entry> OpenEntry(PhysicalMonitorHandle handle);
+
+    IMonitorBackend& m_backend;
+    mutable std::mutex m_mutex;
+    std::unordered_map<MonitorId, std::shared_ptr<const Entry>> m_entries;
+    Stats m_stats;
+};
+
+#endif // DISPLAYCONTROLLER_PHYSICAL_MONITOR_CACHE_H
@@ -0,0 +1,382 @@
+#include "SensorFusion.h"
+#include "SyncLightSensorAdapter.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+    // 正規分布の標準偏差に換算するための中央絶対偏差の係数
+    constexpr double MAD_TO_SIGMA = 1.4826;
+
+    struct Reading {
+        size_t index;
+        int level;
+        double weight;
+    };
+
+    double Median(std::vector<double> values)
+    {
+        std::sort(values.begin(), values.end());
+        size_t middle = values.size() / 2;
+        if (values.size() % 2 == 1) {
+            return values[middle];
+        }
+        return (values[middle - 1] + values[middle]) / 2.0;
+    }
+
+    double MedianLevel(const std::vector<Reading>& readings)
+    {
+        std::vector<double> levels;
+        levels.reserve(readings.size());
+        for (const auto& reading : readings) {
+            levels.push_back(reading.level);
+        }
+        return Median(std::move(levels));
+    }
+
+    LightSample StoppedSample()
+    {
+        LightSample sample;
+        sample.timestamp = std::chrono::steady_clock::now();
+        sample.error = "センサーが停止しました";
+        return sample;
+    }
+}
+
+SensorFusion::SensorFusion(std::vector<Source> sources, Options options)
+    : m_options(options)
+{
+    if (sources.empty()) {
+        throw std::invalid_argument("センサーが指定されていません");
+    }
+    for (auto& source : sources) {
+        if (!source.sensor) {
+            throw std::invalid_argument("センサーがnullです");
+        }
+        if (source.weight < 0) {
+            throw std::invalid_argument("センサーの重みは0以上である必要があります");
+        }
+        SourceState state;
+        state.name = source.name;
+        state.weight = source.weight;
+        m_states.push_back(std::move(state));
+        m_sensors.push_back(MakeAsyncLightSensor(std::move(source.sensor)));
+    }
+    m_timer = std::thread(&SensorFusion::TimerLoop, this);
+}
+
+SensorFusion::~SensorFusion()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_roundStarted.notify_all();
+    if (m_timer.joinable()) {
+        m_timer.join();
+    }
+
+    // 読み取り中のコールバックが状態を参照するため、状態より先にセンサーを1つずつ破棄する
+    for (auto& sensor : m_sensors) {
+        sensor.reset();
+    }
+
+    // 読み取りが完了しなかった要求にも必ず結果を返す
+    std::vector<SampleCallback> waiters;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        waiters.swap(m_waiters);
+    }
+    Deliver(waiters, StoppedSample());
+}
+
+void SensorFusion::StartRead(SampleCallback callback)
+{
+    struct SourceRead {
+        size_t index;
+        uint64_t generation;
+        std::shared_ptr<IAsyncLightSensor> sensor;
+    };
+    std::vector<SourceRead> toStart;
+    std::vector<SampleCallback> finished;
+    LightSample result;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) {
+            finished.push_back(std::move(callback));
+            result = StoppedSample();
+        }
+        else {
+            m_waiters.push_back(std::move(callback));
+            if (m_roundActive) {
+                // 進行中の読み取りの結果をまとめて受け取る
+                return;
+            }
+
+            // 前回の読み取りがまだ終わっていないセンサーと、休止中のセンサーは読み取らない
+            auto now = Clock::now();
+            ++m_round;
+            for (size_t i = 0; i < m_states.size(); ++i) {
+                auto& state = m_states[i];
+                if (!state.inFlight && now >= state.suspendedUntil) {
+                    state.inFlight = true;
+                    state.startedRound = m_round;
+                    toStart.push_back({i, state.generation, m_sensors[i]});
+                }
+            }
+
+            if (toStart.empty()) {
+                std::tie(finished, result) = FinishRoundLocked(now);
+            }
+            else {
+                m_roundActive = true;
+                m_pending = toStart.size();
+                m_deadline = now + m_options.readTimeout;
+            }
+        }
+    }
+
+    if (!toStart.empty()) {
+        m_roundStarted.notify_all();
+    }
+    Deliver(finished, result);
+
+    for (auto& read : toStart) {
+        try {
+            read.sensor->StartRead([this, index = read.index, generation = read.generation](const LightSample& sample) {
+                OnSourceSample(index, generation, sample);
+            });
+        }
+        catch (const std::exception& e) {
+            LightSample failed;
+            failed.timestamp = Clock::now();
+            failed.error = e.what();
+            OnSourceSample(read.index, read.generation, failed);
+        }
+    }
+}
+
+bool SensorFusion::ReplaceSource(Source source)
+{
+    if (!source.sensor) {
+        throw std::invalid_argument("センサーがnullです");
+    }
+    if (source.weight < 0) {
+        throw std::invalid_argument("センサーの重みは0以上である必要があります");
+    }
+    std::shared_ptr<IAsyncLightSensor> sensor = MakeAsyncLightSensor(std::move(source.sensor));
+
+    std::vector<SampleCallback> finished;
+    LightSample result;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_states.begin(), m_states.end(), [&](const SourceState& state) {
+            return state.name == source.name;
+        });
+        if (it == m_states.end()) {
+            return false;
+        }
+        size_t index = static_cast<size_t>(it - m_states.begin());
+
+        // 以前のセンサーの読み取りは応答しなかったものとして扱い、進行中の読み取りを待たせない
+        bool pendingInRound = it->inFlight && m_roundActive && it->startedRound == m_round;
+        SourceState state;
+        state.name = it->name;
+        state.weight = source.weight;
+        state.generation = it->generation + 1;
+        *it = std::move(state);
+        sensor.swap(m_sensors[index]);
+        if (pendingInRound && --m_pending == 0) {
+            std::tie(finished, result) = FinishRoundLocked(Clock::now());
+        }
+    }
+    // 以前のセンサーはロックの外で破棄する（読み取り中の結果を破棄時に返すセンサーがあるため）
+    sensor.reset();
+    Deliver(finished, result);
+    return true;
+}
+
+void SensorFusion::OnSourceSample(size_t index, uint64_t generation, const LightSample& sample)
+{
+    std::vector<SampleCallback> finished;
+    LightSample result;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto& state = m_states[index];
+        if (state.generation != generation) {
+            // 差し替える前のセンサーの結果は使わない
+            return;
+        }
+        state.inFlight = false;
+        if (sample.IsUsable()) {
+            state.lastSample = sample;
+            state.consecutiveFailures = 0;
+        }
+        else {
+            ++state.failures;
+            // 続けて失敗するセンサーは、休止期間が過ぎるまで読み取らない
+            if (++state.consecutiveFailures >= m_options.maxConsecutiveFailures) {
+                state.suspendedUntil = Clock::now() + m_options.suspendDuration;
+            }
+        }
+
+        // タイムアウト後に届いた以前の読み取りの結果は、次の読み取りで使う
+        if (m_roundActive && state.startedRound == m_round && --m_pending == 0) {
+            std::tie(finished, result) = FinishRoundLocked(Clock::now());
+        }
+    }
+    Deliver(finished, result);
+}
+
+void SensorFusion::TimerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_stopping) {
+        if (!m_roundActive) {
+            m_roundStarted.wait(lock, [this] { return m_stopping || m_roundActive; });
+            continue;
+        }
+
+        auto now = Clock::now();
+        if (now < m_deadline) {
+            m_roundStarted.wait_until(lock, m_deadline);
+            continue;
+        }
+
+        // 応答しないセンサーを待たずに、届いた値でまとめる
+        auto [finished, result] = FinishRoundLocked(now);
+        lock.unlock();
+        Deliver(finished, result);
+        lock.lock();
+    }
+}
+
+std::pair<std::vector<IAsyncLightSensor::SampleCallback>, LightSample> SensorFusion::FinishRoundLocked(Clock::time_point now)
+{
+    m_roundActive = false;
+    m_pending = 0;
+
+    LightSample result;
+    result.timestamp = now;
+
+    // 失敗したセンサーと値が古くなったセンサーを除く
+    std::vector<Reading> readings;
+    for (size_t i = 0; i < m_states.size(); ++i) {
+        auto& state = m_states[i];
+        state.usedInLastRead = false;
+        state.rejectedAsOutlier = false;
+        if (state.lastSample && now - state.lastSample->timestamp <= m_options.maxSampleAge) {
+            readings.push_back({i, state.lastSample->level, state.weight});
+            result.sources.push_back({state.name, state.lastSample->level});
+        }
+    }
+
+    std::vector<SampleCallback> waiters;
+    waiters.swap(m_waiters);
+    if (readings.empty()) {
+        result.quality = LightSampleQuality::Unavailable;
+        result.error = "利用できる照度センサーがありません";
+        return {std::move(waiters), std::move(result)};
+    }
+
+    // 中央値から中央絶対偏差の閾値倍を超えて離れた値を外れ値として除く
+    if (m_options.outlierThreshold > 0 && readings.size() >= 3) {
+        double median = MedianLevel(readings);
+        std::vector<double> deviations;
+        for (const auto& reading : readings) {
+            deviations.push_back(std::abs(reading.level - median));
+        }
+        double limit = std::max(m_options.outlierThreshold * MAD_TO_SIGMA * Median(deviations),
+                                static_cast<double>(m_options.outlierMinDeviation));
+        std::vector<Reading> accepted;
+        for (const auto& reading : readings) {
+            if (std::abs(reading.level - median) > limit) {
+                m_states[reading.index].rejectedAsOutlier = true;
+            }
+            else {
+                accepted.push_back(reading);
+            }
+        }
+        readings.swap(accepted);
+    }
+
+    double level = 0;
+    switch (m_options.strategy) {
+    case FusionStrategy::Median:
+    case FusionStrategy::Nearest:
+        level = MedianLevel(readings);
+        break;
+    case FusionStrategy::WeightedMean: {
+        double weighted = 0;
+        double totalWeight = 0;
+        for (const auto& reading : readings) {
+            weighted += reading.level * reading.weight;
+            totalWeight += reading.weight;
+        }
+        level = totalWeight > 0 ? weighted / totalWeight : MedianLevel(readings);
+        break;
+    }
+    case FusionStrategy::Max:
+        for (const auto& reading : readings) {
+            level = std::max(level, static_cast<double>(reading.level));
+        }
+        break;
+    }
+
+    // まとめた値の時刻と品質は、使った値のうち最も古いもの・最も悪いものに合わせる
+    // （直近の読み取りに失敗したセンサーの前回の値を使った場合は、キャッシュの値よりも悪いものとする）
+    result.level = std::clamp(static_cast<int>(std::lround(level)), 0, 100);
+    result.quality = LightSampleQuality::Good;
+    for (const auto& reading : readings) {
+        auto& state = m_states[reading.index];
+        state.usedInLastRead = true;
+        result.timestamp = std::min(result.timestamp, state.lastSample->timestamp);
+        if (state.consecutiveFailures > 0) {
+            result.quality = LightSampleQuality::Degraded;
+        }
+        else if (state.lastSample->quality != LightSampleQuality::Good && result.quality == LightSampleQuality::Good) {
+            result.quality = LightSampleQuality::Stale;
+        }
+    }
+    return {std::move(waiters), std::move(result)};
+}
+
+void SensorFusion::Deliver(std::vector<SampleCallback>& callbacks, const LightSample& sample)
+{
+    for (auto& callback : callbacks) {
+        try {
+            callback(sample);
+        }
+        catch (...) {
+            // 呼び出し元の例外で他の呼び出し元への通知を止めない
+        }
+    }
+}
+
+std::vector<SensorFusion::SourceStatus> SensorFusion::GetStatus() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto now = Clock::now();
+    std::vector<SourceStatus> status;
+    for (const auto& state : m_states) {
+        SourceStatus entry;
+        entry.name = state.name;
+        entry.lastSample = state.lastSample;
+        entry.usedInLastRead = state.usedInLastRead;
+        entry.rejectedAsOutlier = state.rejectedAsOutlier;
+        entry.suspended = now < state.suspendedUntil;
+        entry.failures = state.failures;
+        status.push_back(std::move(entry));
+    }
+    return status;
+}
+
+FusionStrategy SensorFusion::ParseStrategy(const std::string& name)
+{
+    if (name == "median") return FusionStrategy::Median;
+    if (name == "weighted_mean") return FusionStrategy::WeightedMean;
+    if (name == "max") return FusionStrategy::Max;
+    if (name == "nearest") return FusionStrategy::Nearest;
+    throw std::invalid_argument("不明なセンサーのまとめ方です: " + name);
+}
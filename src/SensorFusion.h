@@ -0,0 +1,134 @@
+#ifndef DISPLAYCONTROLLER_SENSOR_FUSION_H
+#define DISPLAYCONTROLLER_SENSOR_FUSION_H
+
+#include "IAsyncLightSensor.h"
+#include "MonitorBackend.h"
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// 複数センサーの値のまとめ方
+enum class FusionStrategy {
+    Median,         // 中央値
+    WeightedMean,   // 重み付き平均
+    Max,            // 最大値
+    Nearest         // モニターごとに割り当てたセンサーの値（割り当てのないモニターは中央値）
+};
+
+/**
+ * @brief 複数の照度センサーを1つのセンサーとして扱う
+ *
+ * すべてのセンサーを同時に読み取り、設定した方法で1つの照度にまとめます。
+ * 3つ以上の値がある場合は、中央値から大きく外れた値（中央絶対偏差の閾値倍を超えるもの）を
+ * 外れ値として除きます。読み取りに失敗したセンサーや、値が古くなったセンサーは自動的に除き、
+ * 続けて失敗したセンサーはしばらく読み取りを休止します。
+ *
+ * 読み取りは、開始したすべてのセンサーが応答するか、読み取りのタイムアウトに達した時点で
+ * 完了します。応答しないセンサーは次の読み取りで待たず、前回の値が新しければそれを使います。
+ * 直近の読み取りに失敗したセンサーの前回の値を使った場合、結果の品質はDegradedになります。
+ * まとめる前の各センサーの値はLightSample::sourcesに入ります。
+ */
+class DISPLAYCONTROLLER_API SensorFusion : public IAsyncLightSensor {
+public:
+    struct Source {
+        std::unique_ptr<ILightSensor> sensor;
+        std::string name;
+        double weight = 1.0;
+    };
+
+    struct Options {
+        FusionStrategy strategy = FusionStrategy::Median;
+        double outlierThreshold = 3.0;                                  // 0なら外れ値を除かない
+        int outlierMinDeviation = 5;                                    // 値がほぼ揃っている場合に除かない最小の差
+        std::chrono::milliseconds maxSampleAge{std::chrono::minutes(5)};
+        std::chrono::milliseconds readTimeout{std::chrono::seconds(10)};
+        int maxConsecutiveFailures = 3;                                 // この回数続けて失敗すると休止する
+        std::chrono::milliseconds suspendDuration{std::chrono::minutes(1)};
+    };
+
+    // センサーごとの状態
+    struct SourceStatus {
+        std::string name;
+        std::optional<LightSample> lastSample;  // 直近に読み取れた値
+        bool usedInLastRead = false;            // 直近の読み取りで値をまとめるのに使った
+        bool rejectedAsOutlier = false;         // 直近の読み取りで外れ値として除いた
+        bool suspended = false;                 // 連続した失敗で読み取りを休止している
+        uint64_t failures = 0;
+    };
+
+    /**
+     * @throws std::invalid_argument センサーがない・nullのセンサーがある・重みが負の場合
+     */
+    SensorFusion(std::vector<Source> sources, Options options);
+    ~SensorFusion() override;
+
+    // コピー禁止
+    SensorFusion(const SensorFusion&) = delete;
+    SensorFusion& operator=(const SensorFusion&) = delete;
+
+    void StartRead(SampleCallback callback) override;
+
+    /**
+     * @brief 名前が一致するセンサーだけを差し替える
+     *
+     * 他のセンサーの値や状態はそのまま使い続けます。差し替えたセンサーの以前の値と失敗の記録は捨て、
+     * 差し替える前のセンサーで読み取り中だった結果は使いません。
+     * @return 名前が一致するセンサーがない場合はfalse
+     * @throws std::invalid_argument センサーがnull・重みが負の場合
+     */
+    bool ReplaceSource(Source source);
+
+    std::vector<SourceStatus> GetStatus() const;
+
+    /**
+     * @brief 設定文字列からまとめ方へ変換
+     * @throws std::invalid_argument 不明な名前の場合
+     */
+    static FusionStrategy ParseStrategy(const std::string& name);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct SourceState {
+        std::string name;
+        double weight = 1.0;
+        bool inFlight = false;
+        uint64_t startedRound = 0;
+        uint64_t generation = 0;                // 差し替えるたびに増やし、以前のセンサーの結果を区別する
+        std::optional<LightSample> lastSample;
+        int consecutiveFailures = 0;
+        uint64_t failures = 0;
+        Clock::time_point suspendedUntil{};
+        bool usedInLastRead = false;
+        bool rejectedAsOutlier = false;
+    };
+
+    void OnSourceSample(size_t index, uint64_t generation, const LightSample& sample);
+    void TimerLoop();
+    // m_mutexを保持した状態で呼ぶ。待っている呼び出し元とまとめた結果を返す
+    std::pair<std::vector<SampleCallback>, LightSample> FinishRoundLocked(Clock::time_point now);
+    static void Deliver(std::vector<SampleCallback>& callbacks, const LightSample& sample);
+
+    Options m_options;
+
+    mutable std::mutex m_mutex;
+    // 差し替えと読み取りの開始が重なっても、開始したセンサーを読み取りの間は破棄しないよう共有で持つ
+    std::vector<std::shared_ptr<IAsyncLightSensor>> m_sensors;
+    std::condition_variable m_roundStarted;
+    std::vector<SourceState> m_states;
+    std::vector<SampleCallback> m_waiters;
+    bool m_roundActive = false;
+    uint64_t m_round = 0;
+    size_t m_pending = 0;
+    Clock::time_point m_deadline{};
+    bool m_stopping = false;
+    std::thread m_timer;
+};
+
+#endif // DISPLAYCONTROLLER_SENSOR_FUSION_H
@@ -0,0 +1,233 @@
+#include "SimulatedDisplayBackend.h"
+#include "MonitorIdentity.h"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+SimulatedDisplayBackend::SimulatedDisplayBackend(DisplayChangeSignal* signal)
+    : m_signal(signal)
+{
+}
+
+MonitorId SimulatedDisplayBackend::Connect(MonitorSpec spec)
+{
+    MonitorId id;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        id = AllocateId();
+        m_monitors.push_back({id, std::move(spec), 0});
+    }
+    Notify();
+    return id;
+}
+
+void SimulatedDisplayBackend::Disconnect(MonitorId id)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = std::find_if(m_monitors.begin(), m_monitors.end(),
+            [id](const ConnectedMonitor& monitor) { return monitor.id == id; });
+        if (it == m_monitors.end()) {
+            throw std::invalid_argument("接続されていないモニターです");
+        }
+        m_monitors.erase(it);
+    }
+    Notify();
+}
+
+void SimulatedDisplayBackend::ReassignIds()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& monitor : m_monitors) {
+            monitor.id = AllocateId();
+        }
+    }
+    Notify();
+}
+
+void SimulatedDisplayBackend::NotifyUnchanged()
+{
+    Notify();
+}
+
+std::vector<MonitorId> SimulatedDisplayBackend::GetConnectedIds() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<MonitorId> ids;
+    ids.reserve(m_monitors.size());
+    for (const auto& monitor : m_monitors) {
+        ids.push_back(monitor.id);
+    }
+    return ids;
+}
+
+std::vector<MonitorTopology::Monitor> SimulatedDisplayBackend::BuildMonitors()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<MonitorTopology::Monitor> monitors;
+    monitors.reserve(m_monitors.size());
+    for (const auto& connected : m_monitors) {
+        MonitorTopology::Monitor monitor;
+        monitor.id = connected.id;
+        monitor.isPrimary = connected.spec.isPrimary;
+        monitor.bounds = connected.spec.bounds;
+        monitor.edid = m_edidCache.Parse(connected.spec.edid);
+        monitor.identity = MakeMonitorIdentity(monitor.edid.get(), connected.spec.connector);
+        if (monitor.edid) {
+            monitor.widthMm = monitor.edid->widthMm;
+            monitor.heightMm = monitor.edid->heightMm;
+        }
+
+        // EDIDのモニター名は印字可能なASCII文字だけで構成される
+        const std::string& name = monitor.edid && !monitor.edid->name.empty()
+            ? monitor.edid->name : connected.spec.connector;
+        monitor.name.assign(name.begin(), name.end());
+        monitor.deviceName = monitor.name;
+        monitors.push_back(std::move(monitor));
+    }
+    return monitors;
+}
+
+void SimulatedDisplayBackend::SetLatency(MonitorId id, std::chrono::milliseconds latency)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto* monitor = FindLocked(id);
+    if (!monitor) {
+        throw std::invalid_argument("接続されていないモニターです");
+    }
+    monitor->spec.latency = latency;
+}
+
+unsigned long SimulatedDisplayBackend::GetBrightnessValue(MonitorId id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return GetLocked(id).spec.brightness;
+}
+
+uint64_t SimulatedDisplayBackend::GetWriteCount(MonitorId id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return GetLocked(id).writes;
+}
+
+std::vector<DisplayDescriptor> SimulatedDisplayBackend::EnumerateDisplays()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<DisplayDescriptor> displays;
+    displays.reserve(m_monitors.size());
+    for (const auto& connected : m_monitors) {
+        DisplayDescriptor display;
+        display.id = connected.id;
+        display.deviceName.assign(connected.spec.connector.begin(), connected.spec.connector.end());
+        display.connector = connected.spec.connector;
+        display.isPrimary = connected.spec.isPrimary;
+        display.bounds = connected.spec.bounds;
+        display.edid = connected.spec.edid;
+        displays.push_back(std::move(display));
+    }
+    return displays;
+}
+
+PhysicalMonitorHandle SimulatedDisplayBackend::OpenPhysicalMonitor(MonitorId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto* monitor = FindLocked(id);
+    if (!monitor) {
+        throw DisplayControllerException("接続されていないモニターです");
+    }
+    if (!monitor->spec.supportsDdc) {
+        throw DisplayControllerException("DDC/CIに対応していないモニターです");
+    }
+    return id;
+}
+
+void SimulatedDisplayBackend::ClosePhysicalMonitor(PhysicalMonitorHandle)
+{
+}
+
+bool SimulatedDisplayBackend::GetBrightness(PhysicalMonitorHandle handle,
+    unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue)
+{
+    return Access(handle, [&](ConnectedMonitor& monitor) {
+        minValue = 0;
+        currentValue = monitor.spec.brightness;
+        maxValue = monitor.spec.maxBrightness;
+    });
+}
+
+bool SimulatedDisplayBackend::SetBrightness(PhysicalMonitorHandle handle, unsigned long value)
+{
+    return Access(handle, [&](ConnectedMonitor& monitor) {
+        monitor.spec.brightness = std::min(value, monitor.spec.maxBrightness);
+        ++monitor.writes;
+    });
+}
+
+bool SimulatedDisplayBackend::GetContrast(PhysicalMonitorHandle handle,
+    unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue)
+{
+    return Access(handle, [&](ConnectedMonitor&) {
+        minValue = 0;
+        currentValue = 50;
+        maxValue = 100;
+    });
+}
+
+bool SimulatedDisplayBackend::Access(PhysicalMonitorHandle handle, const std::function<void(ConnectedMonitor&)>& operation)
+{
+    MonitorId id = static_cast<MonitorId>(handle);
+    std::chrono::milliseconds latency{0};
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        const auto* monitor = FindLocked(id);
+        if (!monitor) {
+            return false;
+        }
+        latency = monitor->spec.latency;
+    }
+
+    // 他のモニターへの操作を待たせないよう、ロックの外で待つ
+    if (latency.count() > 0) {
+        std::this_thread::sleep_for(latency);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto* monitor = FindLocked(id);
+    if (!monitor) {
+        // 待っている間に取り外された
+        return false;
+    }
+    operation(*monitor);
+    return true;
+}
+
+SimulatedDisplayBackend::ConnectedMonitor* SimulatedDisplayBackend::FindLocked(MonitorId id)
+{
+    auto it = std::find_if(m_monitors.begin(), m_monitors.end(),
+        [id](const ConnectedMonitor& monitor) { return monitor.id == id; });
+    return it != m_monitors.end() ? &*it : nullptr;
+}
+
+const SimulatedDisplayBackend::ConnectedMonitor& SimulatedDisplayBackend::GetLocked(MonitorId id) const
+{
+    auto it = std::find_if(m_monitors.begin(), m_monitors.end(),
+        [id](const ConnectedMonitor& monitor) { return monitor.id == id; });
+    if (it == m_monitors.end()) {
+        throw std::invalid_argument("接続されていないモニターです");
+    }
+    return *it;
+}
+
+MonitorId SimulatedDisplayBackend::AllocateId()
+{
+    // 取り外したモニターのIDは再利用しない
+    return reinterpret_cast<MonitorId>(m_nextId++);
+}
+
+void SimulatedDisplayBackend::Notify()
+{
+    if (m_signal) {
+        m_signal->Notify();
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef DISPLAYCONTROLLER_SIMULATED_DISPLAY_BACKEND_H
+#define DISPLAYCONTROLLER_SIMULATED_DISPLAY_BACKEND_H
+
+#include "DisplayBackend.h"
+#include "DisplayChangeWatcher.h"
+#include "EdidParser.h"
+#include "MonitorTopology.h"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief メモリ上で再現するディスプレイ構成
+ *
+ * モニターの接続・取り外し・IDの割り当て直しを再現し、変更のたびにDisplayChangeSignalへ通知します。
+ * IDisplayBackendとしてMonitorControllerへ渡すと、モニターごとに設定した遅延で輝度の読み書きに
+ * 応答するため、センサーの読み取りから輝度の書き込みまでの流れをハードウェアなしで動作させられます。
+ * BuildMonitors() を MonitorTopologyStore の作成関数として使うこともできます。
+ *
+ * 複数のスレッドから同時に呼び出せます。
+ */
+class DISPLAYCONTROLLER_API SimulatedDisplayBackend : public IDisplayBackend {
+public:
+    struct MonitorSpec {
+        std::vector<uint8_t> edid;      // 空の場合はEDIDを読み取れないモニター
+        std::string connector;          // 接続先（シリアル番号のないモニターの識別に使う）
+        bool isPrimary = false;
+        MonitorTopology::Bounds bounds;
+
+        // DDC/CI（輝度の読み書き）に対応しているか
+        bool supportsDdc = true;
+        unsigned long maxBrightness = 100;
+        unsigned long brightness = 50;
+        // 輝度の読み書き1回あたりの応答時間（実機のDDC/CIでは数十ミリ秒）
+        std::chrono::milliseconds latency{0};
+    };
+
+    // signalがnullptrの場合は変更を通知しない
+    explicit SimulatedDisplayBackend(DisplayChangeSignal* signal = nullptr);
+
+    // モニターを接続し、割り当てたIDを返す
+    MonitorId Connect(MonitorSpec spec);
+
+    /**
+     * @brief モニターを取り外す
+     * @throws std::invalid_argument 接続されていないIDの場合
+     */
+    void Disconnect(MonitorId id);
+
+    // 接続中のすべてのモニターへ新しいIDを割り当てる（解像度の変更などでOSがHMONITORを割り当て直す場合）
+    void ReassignIds();
+
+    // 変更を伴わない通知だけを送る（ディスプレイの設定画面を開いた場合など）
+    void NotifyUnchanged();
+
+    std::vector<MonitorId> GetConnectedIds() const;
+
+    // 接続中のモニターの一覧を作る（接続した順）
+    std::vector<MonitorTopology::Monitor> BuildMonitors();
+
+    /**
+     * @brief 輝度の読み書きの応答時間を変更する
+     * @throws std::invalid_argument 接続されていないIDの場合
+     */
+    void SetLatency(MonitorId id, std::chrono::milliseconds latency);
+
+    /**
+     * @brief モニターに設定されている輝度（生値）と、輝度の書き込みに成功した回数
+     * @throws std::invalid_argument 接続されていないIDの場合
+     */
+    unsigned long GetBrightnessValue(MonitorId id) const;
+    uint64_t GetWriteCount(MonitorId id) const;
+
+    // IDisplayBackend の実装（物理モニターハンドルはモニターのIDで、取り外したモニターへの操作は失敗する）
+    std::vector<DisplayDescriptor> EnumerateDisplays() override;
+    PhysicalMonitorHandle OpenPhysicalMonitor(MonitorId id) override;
+    void ClosePhysicalMonitor(PhysicalMonitorHandle handle) override;
+    bool GetBrightness(PhysicalMonitorHandle handle,
+        unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override;
+    bool SetBrightness(PhysicalMonitorHandle handle, unsigned long value) override;
+    bool GetContrast(PhysicalMonitorHandle handle,
+        unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override;
+
+private:
+    struct ConnectedMonitor {
+        MonitorId id = nullptr;
+        MonitorSpec spec;
+        uint64_t writes = 0;
+    };
+
+    MonitorId AllocateId();
+    void Notify();
+    // m_mutexを保持した状態で呼ぶ
+    ConnectedMonitor* FindLocked(MonitorId id);
+    const ConnectedMonitor& GetLocked(MonitorId id) const;
+    // 応答時間を待ってから、まだ接続されている場合にだけ操作する
+    bool Access(PhysicalMonitorHandle handle, const std::function<void(ConnectedMonitor&)>& operation);
+
+    DisplayChangeSignal* m_signal;
+    mutable std::mutex m_mutex;
+    std::vector<ConnectedMonitor> m_monitors;
+    std::uintptr_t m_nextId = 1;
+    EdidCache m_edidCache;
+};
+
+#endif // DISPLAYCONTROLLER_SIMULATED_DISPLAY_BACKEND_H
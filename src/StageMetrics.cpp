@@ -0,0 +1,30 @@
+#include "StageMetrics.h"
+#include <algorithm>
+
+void StageMetrics::Record(std::chrono::steady_clock::duration latency, bool success)
+{
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(latency);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_snapshot.runs;
+    if (!success) {
+        ++m_snapshot.failures;
+    }
+    m_snapshot.lastLatency = micros;
+    m_snapshot.maxLatency = std::max(m_snapshot.maxLatency, micros);
+    m_totalLatency += micros;
+    m_snapshot.averageLatency = m_totalLatency / static_cast<long long>(m_snapshot.runs);
+}
+
+StageMetrics::Snapshot StageMetrics::GetSnapshot() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_snapshot;
+}
+
+void StageMetrics::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_snapshot = Snapshot();
+    m_totalLatency = std::chrono::microseconds(0);
+}
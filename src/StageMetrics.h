@@ -0,0 +1,34 @@
+#ifndef DISPLAYCONTROLLER_STAGE_METRICS_H
+#define DISPLAYCONTROLLER_STAGE_METRICS_H
+
+#include "MonitorBackend.h"
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @brief パイプラインの各段の所要時間を集計する
+ *
+ * センサー読み取りや輝度適用など、1回の処理にかかった時間と成否を記録します。
+ */
+class DISPLAYCONTROLLER_API StageMetrics {
+public:
+    struct Snapshot {
+        uint64_t runs = 0;                          // 処理回数
+        uint64_t failures = 0;                      // 失敗した回数
+        std::chrono::microseconds lastLatency{0};   // 直近の所要時間
+        std::chrono::microseconds maxLatency{0};    // 最大の所要時間
+        std::chrono::microseconds averageLatency{0};
+    };
+
+    void Record(std::chrono::steady_clock::duration latency, bool success);
+    Snapshot GetSnapshot() const;
+    void Reset();
+
+private:
+    mutable std::mutex m_mutex;
+    Snapshot m_snapshot;
+    std::chrono::microseconds m_totalLatency{0};
+};
+
+#endif // DISPLAYCONTROLLER_STAGE_METRICS_H
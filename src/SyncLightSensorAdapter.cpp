@@ -0,0 +1,105 @@
+#include "SyncLightSensorAdapter.h"
+
+SyncLightSensorAdapter::SyncLightSensorAdapter(std::unique_ptr<ILightSensor> sensor)
+    : m_sensor(std::move(sensor))
+{
+    if (!m_sensor) {
+        throw std::invalid_argument("センサーがnullです");
+    }
+    m_worker = std::thread(&SyncLightSensorAdapter::WorkerLoop, this);
+}
+
+SyncLightSensorAdapter::~SyncLightSensorAdapter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_requested.notify_all();
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+
+    // 読み取られなかった要求にも必ず結果を返す
+    LightSample stopped;
+    stopped.timestamp = std::chrono::steady_clock::now();
+    stopped.error = "センサーが停止しました";
+    for (auto& callback : m_waiters) {
+        try {
+            callback(stopped);
+        }
+        catch (...) {
+            // 破棄中のため呼び出し元の例外は無視する
+        }
+    }
+}
+
+void SyncLightSensorAdapter::StartRead(SampleCallback callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_waiters.push_back(std::move(callback));
+    }
+    m_requested.notify_one();
+}
+
+void SyncLightSensorAdapter::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_requested.wait(lock, [this] { return m_stopping || !m_waiters.empty(); });
+        if (m_stopping) {
+            return;
+        }
+
+        lock.unlock();
+        LightSample sample = ReadSample();
+        lock.lock();
+
+        // 読み取り中に追加された要求にも同じ結果を返す
+        std::vector<SampleCallback> waiters;
+        waiters.swap(m_waiters);
+
+        lock.unlock();
+        for (auto& callback : waiters) {
+            try {
+                callback(sample);
+            }
+            catch (...) {
+                // 呼び出し元の例外で読み取りスレッドを止めない
+            }
+        }
+        lock.lock();
+    }
+}
+
+LightSample SyncLightSensorAdapter::ReadSample()
+{
+    LightSample sample;
+    try {
+        sample.level = m_sensor->GetLightLevel();
+        sample.quality = LightSampleQuality::Good;
+    }
+    catch (const std::exception& e) {
+        sample.quality = LightSampleQuality::Unavailable;
+        sample.error = e.what();
+    }
+    catch (...) {
+        sample.quality = LightSampleQuality::Unavailable;
+        sample.error = "照度の読み取りに失敗しました";
+    }
+    sample.timestamp = std::chrono::steady_clock::now();
+    return sample;
+}
+
+std::unique_ptr<IAsyncLightSensor> MakeAsyncLightSensor(std::unique_ptr<ILightSensor> sensor)
+{
+    if (!sensor) {
+        throw std::invalid_argument("センサーがnullです");
+    }
+    if (auto* async = dynamic_cast<IAsyncLightSensor*>(sensor.get())) {
+        sensor.release();
+        return std::unique_ptr<IAsyncLightSensor>(async);
+    }
+    return std::make_unique<SyncLightSensorAdapter>(std::move(sensor));
+}
@@ -0,0 +1,52 @@
+#ifndef DISPLAYCONTROLLER_SYNCLIGHTSENSORADAPTER_H
+#define DISPLAYCONTROLLER_SYNCLIGHTSENSORADAPTER_H
+
+#include "IAsyncLightSensor.h"
+#include "MonitorBackend.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 同期的な照度センサーを非同期インターフェースで使うためのアダプター
+ *
+ * DummyLightSensorなど、GetLightLevel()しか持たない既存のプラグインを
+ * 専用のスレッドで読み取ります。読み取り中に要求された読み取りは、
+ * 進行中の読み取り結果をまとめて受け取ります。
+ */
+class DISPLAYCONTROLLER_API SyncLightSensorAdapter : public IAsyncLightSensor {
+public:
+    explicit SyncLightSensorAdapter(std::unique_ptr<ILightSensor> sensor);
+    ~SyncLightSensorAdapter() override;
+
+    // コピー禁止
+    SyncLightSensorAdapter(const SyncLightSensorAdapter&) = delete;
+    SyncLightSensorAdapter& operator=(const SyncLightSensorAdapter&) = delete;
+
+    void StartRead(SampleCallback callback) override;
+
+private:
+    void WorkerLoop();
+    LightSample ReadSample();
+
+    std::unique_ptr<ILightSensor> m_sensor;
+
+    std::mutex m_mutex;
+    std::condition_variable m_requested;
+    std::vector<SampleCallback> m_waiters;
+    bool m_stopping = false;
+    std::thread m_worker;
+};
+
+/**
+ * @brief センサーを非同期インターフェースとして扱う
+ *
+ * 既にIAsyncLightSensorを実装しているセンサーはそのまま返し、
+ * それ以外はSyncLightSensorAdapterで包みます。
+ * @throws std::invalid_argument sensorがnullの場合
+ */
+DISPLAYCONTROLLER_API std::unique_ptr<IAsyncLightSensor> MakeAsyncLightSensor(std::unique_ptr<ILightSensor> sensor);
+
+#endif // DISPLAYCONTROLLER_SYNCLIGHTSENSORADAPTER_H
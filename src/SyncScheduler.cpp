@@ -0,0 +1,87 @@
+#include "SyncScheduler.h"
+#include <algorithm>
+
+SyncScheduler::SyncScheduler(std::chrono::milliseconds interval)
+    : m_interval(interval)
+    , m_lastTick(Clock::now())
+{
+}
+
+void SyncScheduler::SetInterval(std::chrono::milliseconds interval)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interval = interval;
+    }
+    m_wakeup.notify_all();
+}
+
+std::chrono::milliseconds SyncScheduler::GetInterval() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_interval;
+}
+
+SyncScheduler::WakeReason SyncScheduler::WaitForNextTick()
+{
+    return WaitForNextTick(std::nullopt);
+}
+
+SyncScheduler::WakeReason SyncScheduler::WaitForNextTick(std::optional<Clock::time_point> frameDeadline)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        if (m_stopped) {
+            return WakeReason::Stopped;
+        }
+
+        auto now = Clock::now();
+        if (m_notified) {
+            m_notified = false;
+            m_lastTick = now;
+            return WakeReason::Notified;
+        }
+
+        // 更新間隔が変更された場合も、ここで新しい期限が計算される
+        auto deadline = m_lastTick + m_interval;
+        if (now >= deadline) {
+            m_lastTick = now;
+            return WakeReason::Timeout;
+        }
+
+        if (frameDeadline) {
+            if (now >= *frameDeadline) {
+                return WakeReason::Frame;
+            }
+            deadline = std::min(deadline, *frameDeadline);
+        }
+
+        m_wakeup.wait_until(lock, deadline);
+    }
+}
+
+void SyncScheduler::Notify()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_notified = true;
+    }
+    m_wakeup.notify_all();
+}
+
+void SyncScheduler::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopped = true;
+    }
+    m_wakeup.notify_all();
+}
+
+void SyncScheduler::Reset()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopped = false;
+    m_notified = false;
+    m_lastTick = Clock::now();
+}
@@ -0,0 +1,65 @@
+#ifndef DISPLAYCONTROLLER_SYNC_SCHEDULER_H
+#define DISPLAYCONTROLLER_SYNC_SCHEDULER_H
+
+#include "MonitorBackend.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+
+/**
+ * @brief 同期ループの待機を管理するスケジューラ
+ *
+ * 更新間隔だけ待機しますが、停止要求・即時更新要求・更新間隔の変更があった
+ * 場合は待機中でもすぐに起床します。sleep_for による固定待機と異なり、
+ * 停止までの遅延は待機時間に依存しません。
+ */
+class DISPLAYCONTROLLER_API SyncScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class WakeReason {
+        Timeout,    // 更新間隔が経過した
+        Frame,      // 更新間隔より前の途中フレームの時刻に達した
+        Notified,   // 即時更新が要求された
+        Stopped     // 停止が要求された
+    };
+
+    explicit SyncScheduler(std::chrono::milliseconds interval);
+
+    // 更新間隔の変更（待機中の場合は新しい間隔で待ち直す）
+    void SetInterval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds GetInterval() const;
+
+    /**
+     * @brief 次の更新タイミングまで待機する
+     * @return 起床した理由
+     */
+    WakeReason WaitForNextTick();
+
+    /**
+     * @brief 次の更新タイミングか途中フレームの時刻のうち早い方まで待機する
+     * @param frameDeadline 輝度遷移などの途中フレームの時刻（nulloptなら更新間隔のみ）
+     * @return 起床した理由（途中フレームで起床した場合は更新間隔の計測を続ける）
+     */
+    WakeReason WaitForNextTick(std::optional<Clock::time_point> frameDeadline);
+
+    // 即時更新の要求（設定の再読み込みやセンサーからの通知など）
+    void Notify();
+
+    // 停止の要求（待機中のスレッドはすぐに起床する）
+    void Stop();
+
+    // 停止状態を解除し、更新間隔の計測を開始し直す
+    void Reset();
+
+private:
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wakeup;
+    std::chrono::milliseconds m_interval;
+    Clock::time_point m_lastTick;
+    bool m_notified = false;
+    bool m_stopped = false;
+};
+
+#endif // DISPLAYCONTROLLER_SYNC_SCHEDULER_H
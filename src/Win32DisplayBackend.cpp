@@ -0,0 +1,173 @@
+#include "DisplayBackend.h"
+
+#ifdef _WIN32
+
+#include "Dxva2MonitorBackend.h"
+#include <common/StringUtils.h>
+#include <algorithm>
+#include <cwctype>
+#include <unordered_map>
+#include <windows.h>
+#include <setupapi.h>
+
+#pragma comment(lib, "Setupapi.lib")
+
+namespace {
+    using EdidMap = std::unordered_map<std::wstring, std::vector<uint8_t>>;
+
+    std::wstring ToLower(std::wstring text)
+    {
+        std::transform(text.begin(), text.end(), text.begin(), ::towlower);
+        return text;
+    }
+
+    // 接続中のすべてのモニターのEDIDを一度のデバイスツリーの走査で読む（キーは小文字のインターフェースパス）
+    EdidMap ReadAllMonitorEdids()
+    {
+        // GUID_DEVINTERFACE_MONITOR
+        static const GUID monitorInterface = { 0xe6f07b5f, 0xee97, 0x4a90, { 0xb0, 0x76, 0x33, 0xf5, 0x7b, 0xf4, 0xea, 0xa7 } };
+
+        EdidMap edids;
+        HDEVINFO deviceInfo = SetupDiGetClassDevsW(&monitorInterface, nullptr, nullptr, DIGCF_PRESENT | DIGCF_DEVICEINTERFACE);
+        if (deviceInfo == INVALID_HANDLE_VALUE) {
+            return edids;
+        }
+        std::unique_ptr<void, decltype(&SetupDiDestroyDeviceInfoList)> deviceInfoGuard(
+            deviceInfo, SetupDiDestroyDeviceInfoList);
+
+        SP_DEVICE_INTERFACE_DATA interfaceData = { sizeof(SP_DEVICE_INTERFACE_DATA) };
+        for (DWORD i = 0; SetupDiEnumDeviceInterfaces(deviceInfo, nullptr, &monitorInterface, i, &interfaceData); i++) {
+            DWORD requiredSize = 0;
+            SetupDiGetDeviceInterfaceDetailW(deviceInfo, &interfaceData, nullptr, 0, &requiredSize, nullptr);
+            if (requiredSize < sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W)) {
+                continue;
+            }
+            std::vector<BYTE> detailBuffer(requiredSize);
+            auto detail = reinterpret_cast<SP_DEVICE_INTERFACE_DETAIL_DATA_W*>(detailBuffer.data());
+            detail->cbSize = sizeof(SP_DEVICE_INTERFACE_DETAIL_DATA_W);
+            SP_DEVINFO_DATA deviceInfoData = { sizeof(SP_DEVINFO_DATA) };
+            if (!SetupDiGetDeviceInterfaceDetailW(deviceInfo, &interfaceData, detail, requiredSize, nullptr, &deviceInfoData)) {
+                continue;
+            }
+
+            // EDIDはデバイスのハードウェアキーの"EDID"値に保存されている
+            HKEY key = SetupDiOpenDevRegKey(deviceInfo, &deviceInfoData, DICS_FLAG_GLOBAL, 0, DIREG_DEV, KEY_READ);
+            if (key == INVALID_HANDLE_VALUE) {
+                continue;
+            }
+            // 拡張ブロックを含めて読む（最大256ブロック）
+            std::vector<uint8_t> edid(128 * 256);
+            DWORD size = static_cast<DWORD>(edid.size());
+            LSTATUS status = RegQueryValueExW(key, L"EDID", nullptr, nullptr, edid.data(), &size);
+            RegCloseKey(key);
+            if (status != ERROR_SUCCESS) {
+                continue;
+            }
+            edid.resize(size);
+            edids.insert_or_assign(ToLower(detail->DevicePath), std::move(edid));
+        }
+        return edids;
+    }
+
+    std::vector<MonitorId> EnumerateDisplayMonitors()
+    {
+        std::vector<MonitorId> monitors;
+        if (!::EnumDisplayMonitors(nullptr, nullptr,
+            [](HMONITOR hMonitor, HDC, LPRECT, LPARAM dwData) -> BOOL {
+                auto monitors = reinterpret_cast<std::vector<MonitorId>*>(dwData);
+                monitors->push_back(hMonitor);
+                return TRUE;
+            },
+            reinterpret_cast<LPARAM>(&monitors)))
+        {
+            throw WindowsApiException("Failed to enumerate monitors: " + std::to_string(GetLastError()));
+        }
+        return monitors;
+    }
+
+    /**
+     * @brief EnumDisplayMonitors・SetupAPI・Dxva2を使用するWindowsのバックエンド
+     *
+     * Dxva2では物理モニターごとにDDC/CIの経路が分かれるため、HMONITORをそのままバスIDとして扱います。
+     */
+    class Win32DisplayBackend : public IDisplayBackend {
+    public:
+        std::vector<DisplayDescriptor> EnumerateDisplays() override
+        {
+            // デバイスツリーは列挙ごとに一度だけ走査する
+            auto edids = ReadAllMonitorEdids();
+
+            std::vector<DisplayDescriptor> displays;
+            for (MonitorId id : EnumerateDisplayMonitors()) {
+                DisplayDescriptor display;
+                display.id = id;
+                display.connector = std::to_string(reinterpret_cast<uintptr_t>(id));
+
+                MONITORINFOEXW monitorInfo = { sizeof(MONITORINFOEXW) };
+                if (::GetMonitorInfoW(id, reinterpret_cast<LPMONITORINFO>(&monitorInfo))) {
+                    display.deviceName = monitorInfo.szDevice;
+                    display.connector = StringUtils::WideToUtf8(monitorInfo.szDevice);
+                    display.isPrimary = (monitorInfo.dwFlags & MONITORINFOF_PRIMARY) != 0;
+                    const RECT& rc = monitorInfo.rcMonitor;
+                    display.bounds = { rc.left, rc.top, rc.right, rc.bottom };
+
+                    HDC hdc = ::CreateDCW(L"DISPLAY", monitorInfo.szDevice, nullptr, nullptr);
+                    if (hdc) {
+                        display.widthMm = ::GetDeviceCaps(hdc, HORZSIZE);   // 物理的な幅 (mm)
+                        display.heightMm = ::GetDeviceCaps(hdc, VERTSIZE);  // 物理的な高さ (mm)
+                        ::DeleteDC(hdc);
+                    }
+
+                    // 接続先のモニターのデバイスインターフェースのパス（アダプターの出力ごとに決まる）
+                    DISPLAY_DEVICEW device = { sizeof(DISPLAY_DEVICEW) };
+                    if (::EnumDisplayDevicesW(monitorInfo.szDevice, 0, &device, EDD_GET_DEVICE_INTERFACE_NAME)) {
+                        display.connector = StringUtils::WideToUtf8(device.DeviceID);
+                        auto it = edids.find(ToLower(device.DeviceID));
+                        if (it != edids.end()) {
+                            display.edid = it->second;
+                        }
+                    }
+                }
+                displays.push_back(std::move(display));
+            }
+            return displays;
+        }
+
+        PhysicalMonitorHandle OpenPhysicalMonitor(MonitorId id) override
+        {
+            return m_dxva2.OpenPhysicalMonitor(id);
+        }
+
+        void ClosePhysicalMonitor(PhysicalMonitorHandle handle) override
+        {
+            m_dxva2.ClosePhysicalMonitor(handle);
+        }
+
+        bool GetBrightness(PhysicalMonitorHandle handle,
+            unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override
+        {
+            return m_dxva2.GetBrightness(handle, minValue, currentValue, maxValue);
+        }
+
+        bool SetBrightness(PhysicalMonitorHandle handle, unsigned long value) override
+        {
+            return m_dxva2.SetBrightness(handle, value);
+        }
+
+        bool GetContrast(PhysicalMonitorHandle handle,
+            unsigned long& minValue, unsigned long& currentValue, unsigned long& maxValue) override
+        {
+            return m_dxva2.GetContrast(handle, minValue, currentValue, maxValue);
+        }
+
+    private:
+        Dxva2MonitorBackend m_dxva2;
+    };
+}
+
+std::unique_ptr<IDisplayBackend> CreateWin32DisplayBackend()
+{
+    return std::make_unique<Win32DisplayBackend>();
+}
+
+#endif // _WIN32
@@ -0,0 +1,160 @@
+#include "FileWatcher.h"
+
+#ifdef _WIN32
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <windows.h>
+
+namespace {
+    class Win32FileWatchBackend : public IFileWatchBackend {
+    public:
+        explicit Win32FileWatchBackend(const std::filesystem::path& file)
+            : m_fileName(file.filename().wstring())
+        {
+            std::filesystem::path directory = file.parent_path();
+            if (directory.empty()) {
+                directory = L".";
+            }
+
+            m_directory = CreateFileW(
+                directory.c_str(),
+                FILE_LIST_DIRECTORY,
+                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                nullptr,
+                OPEN_EXISTING,
+                FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+                nullptr);
+            m_changed = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            m_cancel = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            if (m_directory == INVALID_HANDLE_VALUE || !m_changed || !m_cancel) {
+                DWORD error = GetLastError();
+                Close();
+                throw DisplayControllerException("ディレクトリを監視できません: " + directory.string() +
+                    " (エラーコード: " + std::to_string(error) + ")");
+            }
+        }
+
+        ~Win32FileWatchBackend() override
+        {
+            Close();
+        }
+
+        bool WaitForChange(std::chrono::milliseconds timeout) override
+        {
+            auto deadline = std::chrono::steady_clock::now() + timeout;
+            while (true) {
+                if (!m_pending && !StartRead()) {
+                    return false;
+                }
+
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now());
+                DWORD waitMs = static_cast<DWORD>(std::clamp<long long>(remaining.count(), 0, INFINITE - 1));
+
+                HANDLE handles[2] = {m_cancel, m_changed};
+                DWORD result = WaitForMultipleObjects(2, handles, FALSE, waitMs);
+                if (result != WAIT_OBJECT_0 + 1) {
+                    // キャンセル・タイムアウト・エラー
+                    return false;
+                }
+
+                DWORD bytes = 0;
+                m_pending = false;
+                if (!GetOverlappedResult(m_directory, &m_overlapped, &bytes, FALSE)) {
+                    return false;
+                }
+                // バッファが溢れた場合は通知の内容が失われているため、変更ありとして扱う
+                if (bytes == 0 || ContainsTarget(bytes)) {
+                    return true;
+                }
+                // 同じディレクトリの別のファイルの通知だった
+                if (waitMs == 0) {
+                    return false;
+                }
+            }
+        }
+
+        void Cancel() override
+        {
+            SetEvent(m_cancel);
+        }
+
+    private:
+        bool StartRead()
+        {
+            ZeroMemory(&m_overlapped, sizeof(m_overlapped));
+            m_overlapped.hEvent = m_changed;
+            ResetEvent(m_changed);
+            // 書き込み（LAST_WRITE・SIZE）と一時ファイルからの置き換え（FILE_NAME）を検出する
+            m_pending = ReadDirectoryChangesW(
+                m_directory,
+                m_buffer.data(),
+                static_cast<DWORD>(m_buffer.size()),
+                FALSE,
+                FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_FILE_NAME,
+                nullptr,
+                &m_overlapped,
+                nullptr) != FALSE;
+            return m_pending;
+        }
+
+        bool ContainsTarget(DWORD bytes) const
+        {
+            const BYTE* p = m_buffer.data();
+            const BYTE* end = p + bytes;
+            while (p < end) {
+                auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(p);
+                std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+                if (CompareStringOrdinal(name.c_str(), static_cast<int>(name.size()),
+                        m_fileName.c_str(), static_cast<int>(m_fileName.size()), TRUE) == CSTR_EQUAL) {
+                    return true;
+                }
+                if (info->NextEntryOffset == 0) {
+                    break;
+                }
+                p += info->NextEntryOffset;
+            }
+            return false;
+        }
+
+        void Close()
+        {
+            if (m_directory != INVALID_HANDLE_VALUE) {
+                if (m_pending) {
+                    // 実行中の読み取りが終わるまで待ってからバッファを解放する
+                    CancelIoEx(m_directory, &m_overlapped);
+                    DWORD bytes = 0;
+                    GetOverlappedResult(m_directory, &m_overlapped, &bytes, TRUE);
+                    m_pending = false;
+                }
+                CloseHandle(m_directory);
+                m_directory = INVALID_HANDLE_VALUE;
+            }
+            if (m_changed) {
+                CloseHandle(m_changed);
+                m_changed = nullptr;
+            }
+            if (m_cancel) {
+                CloseHandle(m_cancel);
+                m_cancel = nullptr;
+            }
+        }
+
+        std::wstring m_fileName;
+        HANDLE m_directory = INVALID_HANDLE_VALUE;
+        HANDLE m_changed = nullptr;
+        HANDLE m_cancel = nullptr;
+        OVERLAPPED m_overlapped{};
+        bool m_pending = false;
+        alignas(DWORD) std::array<BYTE, 16 * 1024> m_buffer{};
+    };
+}
+
+std::unique_ptr<IFileWatchBackend> CreateWin32FileWatchBackend(const std::filesystem::path& file)
+{
+    return std::make_unique<Win32FileWatchBackend>(file);
+}
+
+#endif // _WIN32
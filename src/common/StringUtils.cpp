@@ -2,6 +2,10 @@
 #include <stdexcept>
 #include <vector>
 #include <iostream>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
 
 std::string StringUtils::WideToUtf8(const std::wstring& wide) {
     if (wide.empty()) {
@@ -154,3 +158,107 @@ void StringUtils::OutputMessage(const std::string& message) {
     DWORD written;
     WriteConsoleW(hStdout, wide.c_str(), static_cast<DWORD>(wide.length()), &written, nullptr);
 }
+
+#else
+
+namespace {
+    // 不正なバイト列・サロゲートの代わりに使う文字（WindowsのAPIと同じ扱い）
+    constexpr char32_t kReplacementCharacter = 0xFFFD;
+
+    void AppendUtf8(std::string& utf8, char32_t code)
+    {
+        if (code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+            code = kReplacementCharacter;
+        }
+        if (code < 0x80) {
+            utf8.push_back(static_cast<char>(code));
+        } else if (code < 0x800) {
+            utf8.push_back(static_cast<char>(0xC0 | (code >> 6)));
+            utf8.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else if (code < 0x10000) {
+            utf8.push_back(static_cast<char>(0xE0 | (code >> 12)));
+            utf8.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            utf8.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        } else {
+            utf8.push_back(static_cast<char>(0xF0 | (code >> 18)));
+            utf8.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+            utf8.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+            utf8.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+        }
+    }
+}
+
+// Windows以外ではwchar_tはUTF-32として扱う
+std::string StringUtils::WideToUtf8(const std::wstring& wide) {
+    std::string utf8;
+    utf8.reserve(wide.size());
+    for (wchar_t ch : wide) {
+        AppendUtf8(utf8, static_cast<char32_t>(ch));
+    }
+    return utf8;
+}
+
+std::wstring StringUtils::Utf8ToWide(const std::string& utf8) {
+    std::wstring wide;
+    wide.reserve(utf8.size());
+    size_t i = 0;
+    while (i < utf8.size()) {
+        auto lead = static_cast<unsigned char>(utf8[i]);
+        size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x06 ? 2 : (lead >> 4) == 0x0E ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        if (length == 0 || i + length > utf8.size()) {
+            wide.push_back(static_cast<wchar_t>(kReplacementCharacter));
+            ++i;
+            continue;
+        }
+
+        char32_t code = length == 1 ? lead : lead & (0x7F >> length);
+        bool valid = true;
+        for (size_t j = 1; j < length; ++j) {
+            auto next = static_cast<unsigned char>(utf8[i + j]);
+            if ((next & 0xC0) != 0x80) {
+                valid = false;
+                break;
+            }
+            code = (code << 6) | (next & 0x3F);
+        }
+        // 冗長な表現・サロゲート・範囲外の値は不正として扱う
+        static constexpr char32_t kMinimum[] = {0, 0, 0x80, 0x800, 0x10000};
+        if (!valid || code < kMinimum[length] || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+            wide.push_back(static_cast<wchar_t>(kReplacementCharacter));
+            ++i;
+            continue;
+        }
+        wide.push_back(static_cast<wchar_t>(code));
+        i += length;
+    }
+    return wide;
+}
+
+std::string StringUtils::SystemToUtf8(const std::string& system) {
+    // システムのエンコーディングはUTF-8とみなす
+    return WideToUtf8(Utf8ToWide(system));
+}
+
+std::string StringUtils::GetLastErrorMessage() {
+    return std::strerror(errno);
+}
+
+void StringUtils::OutputErrorMessage(const std::string& message) {
+    if (message.empty()) {
+        return;
+    }
+    std::cerr << message << std::endl;
+}
+
+void StringUtils::OutputExceptionMessage(const std::exception& e) {
+    OutputErrorMessage(e.what());
+}
+
+void StringUtils::OutputMessage(const std::string& message) {
+    if (message.empty()) {
+        return;
+    }
+    std::cout << message << std::endl;
+}
+
+#endif // _WIN32
@@ -2,7 +2,10 @@
 #define DISPLAYCONTROLLER_STRING_UTILS_H
 
 #include <string>
+#include <stdexcept>
+#ifdef _WIN32
 #include <windows.h>
+#endif
 
 class StringUtils {
 public:
@@ -37,7 +40,7 @@ public:
     static void OutputMessage(const std::string& message);
 
 private:
-    // Windows APIのエラーメッセージを取得
+    // 直前のOSのエラーメッセージを取得（Windows: GetLastError、その他: errno）
     static std::string GetLastErrorMessage();
 };
 
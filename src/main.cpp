@@ -26,6 +26,7 @@ void PrintMonitorInfo(const MonitorController::MonitorInfo& info, MonitorControl
         StringUtils::OutputMessage("Product Code: " + StringUtils::WideToUtf8(info.productCode));
         StringUtils::OutputMessage("Serial Number: " + StringUtils::WideToUtf8(info.serialNumber));
         StringUtils::OutputMessage("Friendly Name: " + StringUtils::WideToUtf8(info.friendlyName));
+        StringUtils::OutputMessage("Monitor ID: " + controller.GetMonitorIdentity(info.id).ToKey());
 
         // Load and display saved settings
         auto settings = controller.LoadMonitorSettings(info);
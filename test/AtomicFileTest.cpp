@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "AtomicFile.h"
+#include "BackupRing.h"
+#include "TestSupport.h"
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    std::string ReadFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        return ss.str();
+    }
+
+    size_t CountFiles(const std::filesystem::path &directory)
+    {
+        size_t count = 0;
+        for ([[maybe_unused]] const auto &entry : std::filesystem::directory_iterator(directory))
+        {
+            ++count;
+        }
+        return count;
+    }
+}
+
+TEST(AtomicFileTest, ReplacesContentWithoutLeavingTempFile)
+{
+    TempDirectory directory("AtomicFileTest");
+    auto target = directory.Path() / "config.json";
+    WriteFileAtomically(target, R"({"monitors": []})");
+    WriteFileAtomically(target, "{}");
+
+    EXPECT_EQ(ReadFile(target), "{}");
+    EXPECT_EQ(CountFiles(directory.Path()), 1u);
+}
+
+TEST(AtomicFileTest, FailedWriteKeepsOriginal)
+{
+    TempDirectory directory("AtomicFileTest");
+    auto target = directory.Path() / "config.json";
+    WriteFileAtomically(target, "original");
+
+    // 置き換え先がディレクトリのため名前の変更に失敗する
+    auto blocked = directory.Path() / "blocked";
+    std::filesystem::create_directories(blocked / "child");
+    EXPECT_THROW(WriteFileAtomically(blocked, "new"), std::system_error);
+    EXPECT_FALSE(std::filesystem::exists(directory.Path() / "blocked.tmp"));
+
+    EXPECT_THROW(WriteFileAtomically(directory.Path() / "missing" / "config.json", "new"), std::system_error);
+    EXPECT_EQ(ReadFile(target), "original");
+}
+
+TEST(BackupRingTest, KeepsNewestBackupsUpToCapacity)
+{
+    TempDirectory directory("AtomicFileTest");
+    auto target = directory.Path() / "config.json";
+    BackupRing backups(target, 3);
+
+    auto start = BackupRing::Clock::now();
+    for (int i = 0; i < 5; ++i)
+    {
+        backups.Create(std::to_string(i), start + std::chrono::seconds(i));
+    }
+
+    auto list = backups.List();
+    ASSERT_EQ(list.size(), 3u);
+    EXPECT_EQ(ReadFile(list[0]), "4");
+    EXPECT_EQ(ReadFile(list[1]), "3");
+    EXPECT_EQ(ReadFile(list[2]), "2");
+}
+
+TEST(BackupRingTest, BackupsAtSameTimeDoNotOverwrite)
+{
+    TempDirectory directory("AtomicFileTest");
+    auto target = directory.Path() / "config.json";
+    BackupRing backups(target, 10);
+
+    auto now = BackupRing::Clock::now();
+    auto first = backups.Create("first", now);
+    auto second = backups.Create("second", now);
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(backups.List().size(), 2u);
+    EXPECT_EQ(ReadFile(first), "first");
+    EXPECT_EQ(ReadFile(second), "second");
+}
+
+TEST(BackupRingTest, ListIgnoresUnrelatedFiles)
+{
+    TempDirectory directory("AtomicFileTest");
+    auto target = directory.Path() / "config.json";
+    BackupRing backups(target, 10);
+    backups.Create("{}");
+
+    std::ofstream(target) << "{}";
+    std::ofstream(directory.Path() / "other_backup_20240101_000000_000.json") << "{}";
+    std::ofstream(directory.Path() / "config_backup_20240101_000000_000.json.tmp") << "{}";
+
+    EXPECT_EQ(backups.List().size(), 1u);
+}
+
+TEST(BackupRingTest, ZeroCapacityThrows)
+{
+    EXPECT_THROW(BackupRing("config.json", 0), std::invalid_argument);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "BrightnessDispatcher.h"
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    MonitorId MakeMonitorId(std::uintptr_t value)
+    {
+        return reinterpret_cast<MonitorId>(value);
+    }
+
+    // DDC/CI書き込みの遅延を模擬するジョブ
+    BrightnessDispatcher::Job MakeSlowJob(std::uintptr_t monitor, std::uintptr_t bus,
+                                          std::chrono::milliseconds latency, bool result = true)
+    {
+        return {MakeMonitorId(monitor), bus, [latency, result] {
+                    std::this_thread::sleep_for(latency);
+                    return result;
+                }};
+    }
+}
+
+TEST(BrightnessDispatcherTest, WritesToDifferentBusesInParallel)
+{
+    BrightnessDispatcher dispatcher(4);
+    std::vector<BrightnessDispatcher::Job> jobs;
+    for (std::uintptr_t i = 1; i <= 4; ++i)
+    {
+        jobs.push_back(MakeSlowJob(i, i, 100ms));
+    }
+
+    auto result = dispatcher.Dispatch(std::move(jobs), 2000ms);
+
+    EXPECT_TRUE(result.AllSucceeded());
+    ASSERT_EQ(result.entries.size(), 4u);
+    // 逐次実行なら400ms以上かかる
+    EXPECT_LT(result.elapsed, 300ms);
+}
+
+TEST(BrightnessDispatcherTest, SerializesWritesOnSameBus)
+{
+    BrightnessDispatcher dispatcher(4);
+    std::atomic<int> inFlight{0};
+    std::atomic<int> maxInFlight{0};
+
+    std::vector<BrightnessDispatcher::Job> jobs;
+    for (std::uintptr_t i = 1; i <= 3; ++i)
+    {
+        jobs.push_back({MakeMonitorId(i), 7, [&] {
+                            int current = ++inFlight;
+                            int expected = maxInFlight.load();
+                            while (current > expected && !maxInFlight.compare_exchange_weak(expected, current))
+                            {
+                            }
+                            std::this_thread::sleep_for(30ms);
+                            --inFlight;
+                            return true;
+                        }});
+    }
+
+    auto result = dispatcher.Dispatch(std::move(jobs), 2000ms);
+
+    EXPECT_TRUE(result.AllSucceeded());
+    EXPECT_EQ(maxInFlight.load(), 1);
+    EXPECT_GE(result.elapsed, 90ms);
+}
+
+TEST(BrightnessDispatcherTest, ReportsPerMonitorFailures)
+{
+    BrightnessDispatcher dispatcher(2);
+    std::vector<BrightnessDispatcher::Job> jobs;
+    jobs.push_back(MakeSlowJob(1, 1, 1ms, true));
+    jobs.push_back(MakeSlowJob(2, 2, 1ms, false));
+    jobs.push_back({MakeMonitorId(3), 3, []() -> bool { throw std::runtime_error("DDC error"); }});
+
+    auto result = dispatcher.Dispatch(std::move(jobs), 2000ms);
+
+    ASSERT_EQ(result.entries.size(), 3u);
+    EXPECT_FALSE(result.AllSucceeded());
+    EXPECT_EQ(result.entries[0].id, MakeMonitorId(1));
+    EXPECT_TRUE(result.entries[0].success);
+    EXPECT_FALSE(result.entries[1].success);
+    EXPECT_FALSE(result.entries[2].success);
+    EXPECT_FALSE(result.entries[2].timedOut);
+}
+
+TEST(BrightnessDispatcherTest, MarksUnfinishedWritesAsTimedOut)
+{
+    BrightnessDispatcher dispatcher(2);
+    std::vector<BrightnessDispatcher::Job> jobs;
+    jobs.push_back(MakeSlowJob(1, 1, 1ms));
+    jobs.push_back(MakeSlowJob(2, 2, 500ms));
+    // 同じバスの後続ジョブは期限内に着手されない
+    jobs.push_back(MakeSlowJob(3, 2, 1ms));
+
+    auto result = dispatcher.Dispatch(std::move(jobs), 100ms);
+
+    ASSERT_EQ(result.entries.size(), 3u);
+    EXPECT_TRUE(result.entries[0].success);
+    EXPECT_TRUE(result.entries[1].timedOut);
+    EXPECT_TRUE(result.entries[2].timedOut);
+    EXPECT_LT(result.elapsed, 400ms);
+}
@@ -0,0 +1,52 @@
+// 輝度マッピングのマイクロベンチマーク
+// 基準実装（呼び出しごとにコピーと並べ替えを行う）と事前計算した変換表を比較する
+#include "BrightnessMapping.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <unordered_map>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int kIterations = 2000000;
+
+    template <typename Func>
+    double MeasureNanosecondsPerCall(Func func)
+    {
+        // 最適化で呼び出しが消えないよう結果を積算する
+        volatile long long sink = 0;
+        auto start = Clock::now();
+        for (int i = 0; i < kIterations; ++i)
+        {
+            sink = sink + func(i % 101);
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        return elapsed / kIterations;
+    }
+}
+
+int main()
+{
+    MappingConfig config;
+    config.mappingPoints = {{100, 100}, {0, 5}, {20, 15}, {40, 35}, {60, 55}, {80, 80}};
+
+    // 変更前と同じく、モニターごとの設定をマップから引いて計算する経路
+    MonitorId id = reinterpret_cast<MonitorId>(static_cast<uintptr_t>(0x1000));
+    std::unordered_map<MonitorId, MappingConfig> configs{{id, config}};
+    std::unordered_map<MonitorId, BrightnessLookupTable> tables;
+    tables.insert_or_assign(id, BrightnessLookupTable(config));
+
+    double reference = MeasureNanosecondsPerCall([&](int input) {
+        return MapBrightnessReference(configs.find(id)->second, input);
+    });
+    double table = MeasureNanosecondsPerCall([&](int input) {
+        return tables.find(id)->second.Map(input);
+    });
+
+    std::printf("reference : %8.2f ns/call\n", reference);
+    std::printf("lookup    : %8.2f ns/call\n", table);
+    std::printf("speedup   : %8.1fx\n", reference / table);
+    return 0;
+}
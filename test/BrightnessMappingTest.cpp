@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "BrightnessMapping.h"
+#include <random>
+
+namespace
+{
+    // 乱数でマッピング設定を生成する（順不同・重複入力を含む）
+    MappingConfig MakeRandomConfig(std::mt19937 &rng)
+    {
+        std::uniform_int_distribution<int> value(0, 100);
+        std::uniform_int_distribution<int> count(0, 8);
+
+        MappingConfig config;
+        config.minBrightness = value(rng);
+        config.maxBrightness = value(rng);
+        int points = count(rng);
+        for (int i = 0; i < points; ++i)
+        {
+            config.mappingPoints.emplace_back(value(rng), value(rng));
+        }
+        return config;
+    }
+}
+
+TEST(BrightnessMappingTest, LinearMappingWithoutPoints)
+{
+    MappingConfig config;
+    config.minBrightness = 20;
+    config.maxBrightness = 80;
+    BrightnessLookupTable table(config);
+
+    EXPECT_EQ(table.Map(0), 20);
+    EXPECT_EQ(table.Map(50), 50);
+    EXPECT_EQ(table.Map(100), 80);
+}
+
+TEST(BrightnessMappingTest, InterpolatesUnsortedPoints)
+{
+    MappingConfig config;
+    config.mappingPoints = {{100, 90}, {0, 10}, {50, 30}};
+    BrightnessLookupTable table(config);
+
+    EXPECT_EQ(table.Map(0), 10);
+    EXPECT_EQ(table.Map(25), 20);
+    EXPECT_EQ(table.Map(50), 30);
+    EXPECT_EQ(table.Map(75), 60);
+    EXPECT_EQ(table.Map(100), 90);
+}
+
+TEST(BrightnessMappingTest, OutOfRangeInputIsClamped)
+{
+    MappingConfig config;
+    config.mappingPoints = {{10, 5}, {90, 95}};
+    BrightnessLookupTable table(config);
+
+    EXPECT_EQ(table.Map(-20), MapBrightnessReference(config, -20));
+    EXPECT_EQ(table.Map(150), MapBrightnessReference(config, 150));
+    EXPECT_EQ(table.Map(-20), 5);
+    EXPECT_EQ(table.Map(150), 95);
+}
+
+TEST(BrightnessMappingTest, TableMatchesReferenceForRandomConfigs)
+{
+    std::mt19937 rng(12345);
+    for (int trial = 0; trial < 1000; ++trial)
+    {
+        MappingConfig config = MakeRandomConfig(rng);
+        BrightnessLookupTable table(config);
+        for (int input = -5; input <= 105; ++input)
+        {
+            ASSERT_EQ(table.Map(input), MapBrightnessReference(config, input))
+                << "trial=" << trial << " input=" << input;
+        }
+    }
+}
+
+TEST(BrightnessMappingTest, KeepsOriginalConfig)
+{
+    MappingConfig config;
+    config.minBrightness = 5;
+    config.mappingPoints = {{60, 40}, {20, 10}};
+    BrightnessLookupTable table(config);
+
+    EXPECT_EQ(table.GetConfig().minBrightness, 5);
+    EXPECT_EQ(table.GetConfig().mappingPoints, config.mappingPoints);
+}
@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include "BrightnessTransition.h"
+#include <algorithm>
+#include <cstdint>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    using Clock = BrightnessTransitionEngine::Clock;
+
+    MonitorId MakeId(uintptr_t value)
+    {
+        return reinterpret_cast<MonitorId>(value);
+    }
+
+    // 遷移が終わるまでフレーム時刻どおりにAdvance()を呼び、出力された値を集める
+    std::vector<int> RunToCompletion(BrightnessTransitionEngine &engine, MonitorId id, Clock::time_point now)
+    {
+        std::vector<int> values;
+        while (auto next = engine.GetNextFrameTime())
+        {
+            now = std::max(now, *next);
+            for (const auto &[frameId, value] : engine.Advance(now))
+            {
+                if (frameId == id)
+                {
+                    values.push_back(value);
+                }
+            }
+        }
+        return values;
+    }
+}
+
+class BrightnessTransitionTest : public ::testing::Test
+{
+protected:
+    BrightnessTransitionEngine engine{1000ms, EasingCurve::Linear};
+    MonitorId monitor = MakeId(1);
+    Clock::time_point start = Clock::time_point{} + 1h;
+
+    // 初期値を設定し、遷移の起点を作る
+    void Prime(int value)
+    {
+        engine.SetTarget(monitor, value, start);
+        engine.Advance(start);
+    }
+};
+
+TEST_F(BrightnessTransitionTest, FirstTargetIsAppliedImmediately)
+{
+    engine.SetTarget(monitor, 70, start);
+    auto frames = engine.Advance(start);
+
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].second, 70);
+    EXPECT_FALSE(engine.IsActive());
+    EXPECT_FALSE(engine.GetNextFrameTime().has_value());
+}
+
+TEST_F(BrightnessTransitionTest, RampReachesTargetMonotonically)
+{
+    Prime(0);
+    engine.SetTarget(monitor, 100, start);
+    auto values = RunToCompletion(engine, monitor, start);
+
+    ASSERT_FALSE(values.empty());
+    EXPECT_EQ(values.back(), 100);
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+    EXPECT_EQ(engine.GetCurrentValue(monitor), 100);
+}
+
+TEST_F(BrightnessTransitionTest, LastFrameIsMarkedFinal)
+{
+    Prime(40);
+    engine.SetTarget(monitor, 41, start);
+
+    // 値が1しか変わらない遷移でも、目標値に達したフレームを最後のフレームとして出力する
+    std::vector<BrightnessTransitionEngine::Frame> frames;
+    auto now = start;
+    while (auto next = engine.GetNextFrameTime())
+    {
+        now = std::max(now, *next);
+        auto advanced = engine.AdvanceFrames(now);
+        frames.insert(frames.end(), advanced.begin(), advanced.end());
+    }
+
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].brightness, 41);
+    EXPECT_TRUE(frames[0].final);
+}
+
+TEST_F(BrightnessTransitionTest, RetargetToCurrentValueEmitsFinalFrame)
+{
+    Prime(0);
+    engine.SetTarget(monitor, 100, start);
+    engine.Advance(start);
+    engine.Advance(start + 500ms);
+    ASSERT_EQ(engine.GetCurrentValue(monitor), 50);
+
+    // 途中の値がちょうど新しい目標値の場合も、最後のフレームとして出力する
+    engine.SetTarget(monitor, 50, start + 500ms);
+    auto frames = engine.AdvanceFrames(start + 500ms);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].brightness, 50);
+    EXPECT_TRUE(frames[0].final);
+    EXPECT_FALSE(engine.IsActive());
+}
+
+TEST_F(BrightnessTransitionTest, WritesFewerFramesThanNaiveStepping)
+{
+    Prime(0);
+    engine.SetTarget(monitor, 100, start);
+    auto values = RunToCompletion(engine, monitor, start);
+
+    // 1ずつ書き込むと100回だが、100msのフレーム間隔なら1秒で高々11回
+    EXPECT_LE(values.size(), 11u);
+}
+
+TEST_F(BrightnessTransitionTest, FrameIntervalFollowsMeasuredWriteLatency)
+{
+    Prime(0);
+    engine.RecordWriteLatency(monitor, 400ms);
+    engine.SetTarget(monitor, 100, start);
+
+    engine.Advance(start);
+    auto next = engine.GetNextFrameTime();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(*next - start, 400ms);
+
+    auto values = RunToCompletion(engine, monitor, start);
+    EXPECT_LE(values.size(), 4u);
+    EXPECT_EQ(values.back(), 100);
+}
+
+TEST_F(BrightnessTransitionTest, UnchangedValuesAreNotEmitted)
+{
+    Prime(50);
+    engine.SetTarget(monitor, 52, start);
+    auto values = RunToCompletion(engine, monitor, start);
+
+    // 2段階しか変化しないため、出力は重複なしで高々2回
+    EXPECT_LE(values.size(), 2u);
+    EXPECT_EQ(std::adjacent_find(values.begin(), values.end()), values.end());
+    EXPECT_EQ(values.back(), 52);
+}
+
+TEST_F(BrightnessTransitionTest, NewTargetCancelsRampFromCurrentValue)
+{
+    Prime(0);
+    engine.SetTarget(monitor, 100, start);
+    engine.Advance(start);
+    engine.Advance(start + 500ms);
+    int midway = *engine.GetCurrentValue(monitor);
+    EXPECT_EQ(midway, 50);
+
+    // 途中で目標値が下がった場合は、その時点の値から下げ始める
+    engine.SetTarget(monitor, 20, start + 500ms);
+    auto values = RunToCompletion(engine, monitor, start + 500ms);
+
+    ASSERT_FALSE(values.empty());
+    EXPECT_LE(values.front(), midway);
+    EXPECT_TRUE(std::is_sorted(values.rbegin(), values.rend()));
+    EXPECT_EQ(values.back(), 20);
+}
+
+TEST_F(BrightnessTransitionTest, SameTargetDoesNotRestartRamp)
+{
+    Prime(0);
+    engine.SetTarget(monitor, 100, start);
+    engine.Advance(start);
+    engine.Advance(start + 500ms);
+
+    engine.SetTarget(monitor, 100, start + 500ms);
+    auto frames = engine.Advance(start + 1000ms);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].second, 100);
+}
+
+TEST_F(BrightnessTransitionTest, ZeroDurationJumpsToTarget)
+{
+    engine.SetDuration(0ms);
+    Prime(10);
+    engine.SetTarget(monitor, 90, start);
+
+    auto frames = engine.Advance(start);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].second, 90);
+    EXPECT_FALSE(engine.IsActive());
+}
+
+TEST_F(BrightnessTransitionTest, MonitorsRampIndependently)
+{
+    MonitorId other = MakeId(2);
+    engine.SetTarget(other, 100, start);
+    Prime(0);
+    engine.RecordWriteLatency(other, 300ms);
+
+    engine.SetTarget(monitor, 100, start);
+    engine.SetTarget(other, 0, start);
+    engine.Advance(start);
+
+    engine.Advance(start + 100ms);
+    EXPECT_EQ(engine.GetCurrentValue(monitor), 10);
+    // 書き込みの遅いモニターはまだ次のフレームに達していない
+    EXPECT_EQ(engine.GetCurrentValue(other), 100);
+}
+
+TEST_F(BrightnessTransitionTest, RemappedRampContinuesUnderNewId)
+{
+    Prime(20);
+    engine.SetTarget(monitor, 80, start);
+    auto midway = start + 500ms;
+    engine.Advance(midway);
+    int before = *engine.GetCurrentValue(monitor);
+
+    // ディスプレイ構成の変更でIDが割り当て直されても、遷移は最初からやり直さない
+    MonitorId renamed = MakeId(2);
+    engine.RemapMonitors({{monitor, renamed}}, midway);
+    EXPECT_FALSE(engine.GetCurrentValue(monitor).has_value());
+    EXPECT_EQ(engine.GetCurrentValue(renamed), before);
+
+    auto frames = engine.Advance(midway + 100ms);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].first, renamed);
+    EXPECT_GT(frames[0].second, before);
+    EXPECT_EQ(RunToCompletion(engine, renamed, midway + 100ms).back(), 80);
+}
+
+TEST_F(BrightnessTransitionTest, RemappedIdleMonitorResendsCurrentValue)
+{
+    Prime(40);
+    MonitorId renamed = MakeId(2);
+    engine.RemapMonitors({{monitor, renamed}}, start + 1s);
+
+    // 新しいIDへはまだ書き込んでいないため、値が変わらなくても一度だけ出力する
+    auto frames = engine.Advance(start + 1s);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0].first, renamed);
+    EXPECT_EQ(frames[0].second, 40);
+    EXPECT_FALSE(engine.IsActive());
+    EXPECT_TRUE(engine.Advance(start + 2s).empty());
+}
+
+TEST_F(BrightnessTransitionTest, RemapDropsDisconnectedMonitors)
+{
+    Prime(40);
+    MonitorId other = MakeId(2);
+    engine.SetTarget(other, 60, start);
+    engine.Advance(start);
+
+    // IDが変わらないモニターは再送しない
+    engine.RemapMonitors({{other, other}}, start + 1s);
+    EXPECT_FALSE(engine.GetCurrentValue(monitor).has_value());
+    EXPECT_EQ(engine.GetCurrentValue(other), 60);
+    EXPECT_TRUE(engine.Advance(start + 1s).empty());
+}
+
+TEST(BrightnessTransitionEasingTest, CurvesAreAnchoredAtEndpoints)
+{
+    for (auto curve : {EasingCurve::Linear, EasingCurve::EaseIn, EasingCurve::EaseOut, EasingCurve::EaseInOut})
+    {
+        EXPECT_DOUBLE_EQ(BrightnessTransitionEngine::ApplyEasing(curve, 0.0), 0.0);
+        EXPECT_DOUBLE_EQ(BrightnessTransitionEngine::ApplyEasing(curve, 1.0), 1.0);
+    }
+    EXPECT_LT(BrightnessTransitionEngine::ApplyEasing(EasingCurve::EaseIn, 0.5), 0.5);
+    EXPECT_GT(BrightnessTransitionEngine::ApplyEasing(EasingCurve::EaseOut, 0.5), 0.5);
+    EXPECT_DOUBLE_EQ(BrightnessTransitionEngine::ApplyEasing(EasingCurve::EaseInOut, 0.5), 0.5);
+}
+
+TEST(BrightnessTransitionEasingTest, ParsesConfigNames)
+{
+    EXPECT_EQ(BrightnessTransitionEngine::ParseEasingCurve("linear"), EasingCurve::Linear);
+    EXPECT_EQ(BrightnessTransitionEngine::ParseEasingCurve("ease_in"), EasingCurve::EaseIn);
+    EXPECT_EQ(BrightnessTransitionEngine::ParseEasingCurve("ease_out"), EasingCurve::EaseOut);
+    EXPECT_EQ(BrightnessTransitionEngine::ParseEasingCurve("ease_in_out"), EasingCurve::EaseInOut);
+    EXPECT_THROW(BrightnessTransitionEngine::ParseEasingCurve("bounce"), std::invalid_argument);
+}
@@ -0,0 +1,264 @@
+#include <gtest/gtest.h>
+#include "BrightnessWriteScheduler.h"
+#include <chrono>
+#include <cstdint>
+
+namespace
+{
+    MonitorId MakeMonitorId(std::uintptr_t value)
+    {
+        return reinterpret_cast<MonitorId>(value);
+    }
+
+    // 取り出した書き込みをすべて成功として反映する
+    std::vector<std::pair<MonitorId, int>> Flush(BrightnessWriteScheduler &scheduler)
+    {
+        auto writes = scheduler.TakePendingWrites();
+        for (const auto &[id, brightness] : writes)
+        {
+            scheduler.OnWriteCompleted(id, brightness, true);
+        }
+        return writes;
+    }
+}
+
+TEST(BrightnessWriteSchedulerTest, FirstRequestIsAlwaysWritten)
+{
+    BrightnessWriteScheduler scheduler(5);
+    scheduler.Track(MakeMonitorId(1));
+    scheduler.Submit(MakeMonitorId(1), 40);
+
+    auto writes = Flush(scheduler);
+    ASSERT_EQ(writes.size(), 1u);
+    EXPECT_EQ(writes[0].second, 40);
+    EXPECT_EQ(scheduler.GetLastWritten(MakeMonitorId(1)), 40);
+}
+
+TEST(BrightnessWriteSchedulerTest, SuppressesWritesWithinDeadband)
+{
+    BrightnessWriteScheduler scheduler(2);
+    auto id = MakeMonitorId(1);
+    scheduler.Track(id);
+
+    scheduler.Submit(id, 50);
+    Flush(scheduler);
+
+    scheduler.Submit(id, 50);
+    EXPECT_TRUE(Flush(scheduler).empty());
+    scheduler.Submit(id, 52);
+    EXPECT_TRUE(Flush(scheduler).empty());
+    scheduler.Submit(id, 53);
+    EXPECT_EQ(Flush(scheduler).size(), 1u);
+
+    auto stats = scheduler.GetStats();
+    EXPECT_EQ(stats.writesIssued, 2u);
+    EXPECT_EQ(stats.writesSuppressed, 2u);
+}
+
+TEST(BrightnessWriteSchedulerTest, ZeroDeadbandOnlySuppressesIdenticalValues)
+{
+    BrightnessWriteScheduler scheduler(0);
+    auto id = MakeMonitorId(1);
+    scheduler.Track(id);
+
+    scheduler.Submit(id, 50);
+    Flush(scheduler);
+    scheduler.Submit(id, 50);
+    EXPECT_TRUE(Flush(scheduler).empty());
+    scheduler.Submit(id, 51);
+    EXPECT_EQ(Flush(scheduler).size(), 1u);
+}
+
+TEST(BrightnessWriteSchedulerTest, ExactRequestBypassesDeadband)
+{
+    BrightnessWriteScheduler scheduler(2);
+    auto id = MakeMonitorId(1);
+    scheduler.Track(id);
+
+    scheduler.Submit(id, 48);
+    Flush(scheduler);
+
+    // 遷移の最後のフレームは不感帯以内でも書き込む
+    scheduler.Submit(id, 50, true);
+    auto writes = Flush(scheduler);
+    ASSERT_EQ(writes.size(), 1u);
+    EXPECT_EQ(writes[0].second, 50);
+
+    // 同じ値は書き込まない
+    scheduler.Submit(id, 50, true);
+    EXPECT_TRUE(Flush(scheduler).empty());
+    // 通常の要求には不感帯が適用される
+    scheduler.Submit(id, 51);
+    EXPECT_TRUE(Flush(scheduler).empty());
+}
+
+TEST(BrightnessWriteSchedulerTest, CoalescesBurstIntoLatestValue)
+{
+    BrightnessWriteScheduler scheduler(0);
+    auto id = MakeMonitorId(1);
+    scheduler.Track(id);
+
+    scheduler.Submit(id, 10);
+    scheduler.Submit(id, 20);
+    scheduler.Submit(id, 30);
+
+    auto writes = Flush(scheduler);
+    ASSERT_EQ(writes.size(), 1u);
+    EXPECT_EQ(writes[0].second, 30);
+    EXPECT_EQ(scheduler.GetStats().requestsCoalesced, 2u);
+}
+
+TEST(BrightnessWriteSchedulerTest, RetriesFailedWriteAfterBackoff)
+{
+    BrightnessWriteScheduler scheduler(5);
+    auto id = MakeMonitorId(1);
+    scheduler.Track(id);
+    auto now = BrightnessWriteScheduler::Clock::now();
+
+    scheduler.Submit(id, 50);
+    Flush(scheduler);
+
+    scheduler.Submit(id, 70);
+    auto writes = scheduler.TakePendingWrites(now);
+    ASSERT_EQ(writes.size(), 1u);
+    scheduler.OnWriteCompleted(id, 70, false, now);
+
+    // 待機時間が過ぎるまでは再送しない
+    EXPECT_FALSE(scheduler.GetLastWritten(id).has_value());
+    EXPECT_EQ(scheduler.GetNextRetryTime(), now + std::chrono::seconds(1));
+    EXPECT_TRUE(scheduler.TakePendingWrites(now + std::chrono::milliseconds(999)).empty());
+
+    // 状態が不明になったため、不感帯以内の値でも再送される
+    writes = scheduler.TakePendingWrites(now + std::chrono::seconds(1));
+    ASSERT_EQ(writes.size(), 1u);
+    EXPECT_EQ(writes[0].second, 70);
+    EXPECT_EQ(scheduler.GetStats().writesFailed, 1u);
+}
+
+TEST(BrightnessWriteSchedulerTest, BackoffDoublesUntilMaximum)
+{
+    BrightnessWriteScheduler scheduler(0);
+    scheduler.SetRetryPolicy({10, std::chrono::milliseconds(100), std::chrono::milliseconds(350)});
+    auto id = MakeMonitorId(1);
+    scheduler.Track(id);
+    auto now = BrightnessWriteScheduler::Clock::now();
+
+    scheduler.Submit(id, 50);
+    std::vector<std::chrono::milliseconds> waits;
+    for (int i = 0; i < 4; ++i)
+    {
+        auto writes = scheduler.TakePendingWrites(now);
+        ASSERT_EQ(writes.size(), 1u);
+        scheduler.OnWriteCompleted(id, 50, false, now);
+        auto next = scheduler.GetNextRetryTime();
+        ASSERT_TRUE(next.has_value());
+        waits.push_back(std::chrono::duration_cast<std::chrono::milliseconds>(*next - now));
+        now = *next;
+    }
+    std::vector<std::chrono::milliseconds> expected{
+        std::chrono::milliseconds(100), std::chrono::milliseconds(200),
+        std::chrono::milliseconds(350), std::chrono::milliseconds(350)};
+    EXPECT_EQ(waits, expected);
+
+    // 成功したら待機時間は元に戻る
+    ASSERT_EQ(scheduler.TakePendingWrites(now).size(), 1u);
+    scheduler.OnWriteCompleted(id, 50, true, now);
+    EXPECT_FALSE(scheduler.GetNextRetryTime().has_value());
+    scheduler.Submit(id, 60);
+    EXPECT_EQ(scheduler.TakePendingWrites(now).size(), 1u);
+}
+
+TEST(BrightnessWriteSchedulerTest, AbandonsWriteAfterMaxRetries)
+{
+    BrightnessWriteScheduler scheduler(0);
+    scheduler.SetRetryPolicy({2, std::chrono::milliseconds(10), std::chrono::milliseconds(10)});
+    auto id = MakeMonitorId(1);
+    scheduler.Track(id);
+    auto now = BrightnessWriteScheduler::Clock::now();
+
+    scheduler.Submit(id, 50);
+    // 最初の書き込みと2回の再送が失敗したら、次の要求まで書き込まない
+    for (int i = 0; i < 3; ++i)
+    {
+        auto writes = scheduler.TakePendingWrites(now);
+        ASSERT_EQ(writes.size(), 1u);
+        scheduler.OnWriteCompleted(id, 50, false, now);
+        now += std::chrono::milliseconds(10);
+    }
+    EXPECT_TRUE(scheduler.TakePendingWrites(now + std::chrono::hours(1)).empty());
+    EXPECT_FALSE(scheduler.GetNextRetryTime().has_value());
+
+    auto stats = scheduler.GetStats();
+    EXPECT_EQ(stats.writesFailed, 3u);
+    EXPECT_EQ(stats.writesAbandoned, 1u);
+
+    // 新しい要求は待機時間の後に書き込む
+    scheduler.Submit(id, 60);
+    EXPECT_TRUE(scheduler.TakePendingWrites(now - std::chrono::milliseconds(1)).empty());
+    EXPECT_EQ(scheduler.TakePendingWrites(now).size(), 1u);
+}
+
+TEST(BrightnessWriteSchedulerTest, IgnoresUntrackedAndForgottenMonitors)
+{
+    BrightnessWriteScheduler scheduler(0);
+    auto id = MakeMonitorId(1);
+
+    EXPECT_FALSE(scheduler.Submit(id, 50));
+    EXPECT_TRUE(Flush(scheduler).empty());
+
+    scheduler.Track(id);
+    EXPECT_TRUE(scheduler.Submit(id, 50));
+    auto writes = scheduler.TakePendingWrites();
+    ASSERT_EQ(writes.size(), 1u);
+
+    // 送出中に取り外されたモニターの結果で状態を作り直さない
+    scheduler.Forget(id);
+    scheduler.OnWriteCompleted(id, 50, false);
+    EXPECT_FALSE(scheduler.GetNextRetryTime().has_value());
+    EXPECT_TRUE(scheduler.TakePendingWrites(BrightnessWriteScheduler::Clock::now() + std::chrono::hours(1)).empty());
+    scheduler.OnWriteCompleted(id, 50, true);
+    EXPECT_FALSE(scheduler.GetLastWritten(id).has_value());
+    EXPECT_FALSE(scheduler.Submit(id, 60));
+}
+
+TEST(BrightnessWriteSchedulerTest, NewerRequestWinsOverRetry)
+{
+    BrightnessWriteScheduler scheduler(0);
+    auto id = MakeMonitorId(1);
+    scheduler.Track(id);
+
+    scheduler.Submit(id, 50);
+    auto writes = scheduler.TakePendingWrites();
+    scheduler.Submit(id, 60);
+    scheduler.OnWriteCompleted(id, 50, false);
+
+    // 待機時間の後は失敗した値ではなく新しい値を書き込む
+    writes = scheduler.TakePendingWrites(*scheduler.GetNextRetryTime());
+    ASSERT_EQ(writes.size(), 1u);
+    EXPECT_EQ(writes[0].second, 60);
+}
+
+TEST(BrightnessWriteSchedulerTest, TracksMonitorsIndependently)
+{
+    BrightnessWriteScheduler scheduler(1);
+    scheduler.Track(MakeMonitorId(1));
+    scheduler.Track(MakeMonitorId(2));
+    scheduler.Submit(MakeMonitorId(1), 50);
+    scheduler.Submit(MakeMonitorId(2), 50);
+    EXPECT_EQ(Flush(scheduler).size(), 2u);
+
+    scheduler.Submit(MakeMonitorId(1), 50);
+    scheduler.Submit(MakeMonitorId(2), 80);
+    auto writes = Flush(scheduler);
+    ASSERT_EQ(writes.size(), 1u);
+    EXPECT_EQ(writes[0].first, MakeMonitorId(2));
+}
+
+TEST(BrightnessWriteSchedulerTest, RejectsInvalidDeadband)
+{
+    EXPECT_THROW(BrightnessWriteScheduler(-1), std::invalid_argument);
+    BrightnessWriteScheduler scheduler;
+    EXPECT_THROW(scheduler.SetDeadband(101), std::invalid_argument);
+    EXPECT_THROW(scheduler.SetRetryPolicy({-1, std::chrono::seconds(1), std::chrono::seconds(2)}), std::invalid_argument);
+    EXPECT_THROW(scheduler.SetRetryPolicy({1, std::chrono::seconds(2), std::chrono::seconds(1)}), std::invalid_argument);
+}
@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+#include "ConfigDiff.h"
+
+namespace
+{
+    nlohmann::json MakeConfig()
+    {
+        return nlohmann::json::parse(R"({
+            "monitors": [
+                {"name": "Left", "brightness_range": {"min": 10, "max": 90}},
+                {"name": "Right", "brightness_range": {"min": 0, "max": 100}}
+            ],
+            "plugins": {
+                "SwitchBotLightSensor": {
+                    "global_settings": {"token": "TOKEN", "secret": "SECRET"},
+                    "devices": [
+                        {"id": "SB-1", "name": "Living", "type": "Light Sensor"},
+                        {"id": "SB-2", "name": "Bedroom", "type": "Light Sensor"}
+                    ]
+                },
+                "DummyLightSensor": {
+                    "devices": [
+                        {"id": "D-1", "name": "Dummy", "type": "Light Sensor"}
+                    ]
+                }
+            },
+            "brightness_daemon": {
+                "update_interval_ms": 5000,
+                "min_brightness": 0,
+                "max_brightness": 100,
+                "write_deadband": 1,
+                "transition_duration_ms": 0
+            }
+        })");
+    }
+
+    ConfigDiff Diff(const nlohmann::json &before, const nlohmann::json &after)
+    {
+        ConfigSnapshot previous(before);
+        ConfigSnapshot current(after);
+        return DiffConfigSnapshots(&previous, current);
+    }
+}
+
+TEST(ConfigDiffTest, IdenticalConfigsHaveNoChanges)
+{
+    auto diff = Diff(MakeConfig(), MakeConfig());
+    EXPECT_FALSE(diff.HasChanges());
+}
+
+TEST(ConfigDiffTest, WithoutPreviousSnapshotEverythingChanges)
+{
+    ConfigSnapshot current(MakeConfig());
+    auto diff = DiffConfigSnapshots(nullptr, current);
+
+    EXPECT_TRUE(diff.updateInterval);
+    EXPECT_TRUE(diff.brightnessRange);
+    EXPECT_TRUE(diff.transition);
+    EXPECT_EQ(diff.changedMonitors, (std::vector<std::string>{"Left", "Right"}));
+    EXPECT_EQ(diff.changedDevices.size(), 3u);
+}
+
+TEST(ConfigDiffTest, DetectsOnlyChangedDaemonSettings)
+{
+    auto after = MakeConfig();
+    after["brightness_daemon"]["update_interval_ms"] = 10000;
+    after["brightness_daemon"]["max_brightness"] = 80;
+
+    auto diff = Diff(MakeConfig(), after);
+    EXPECT_TRUE(diff.updateInterval);
+    EXPECT_TRUE(diff.brightnessRange);
+    EXPECT_FALSE(diff.writeDeadband);
+    EXPECT_FALSE(diff.transition);
+    EXPECT_TRUE(diff.changedMonitors.empty());
+    EXPECT_TRUE(diff.changedDevices.empty());
+}
+
+TEST(ConfigDiffTest, DetectsChangedAddedAndRemovedMonitors)
+{
+    auto after = MakeConfig();
+    after["monitors"][0]["brightness_range"]["max"] = 70;
+    after["monitors"].erase(1);
+    after["monitors"].push_back({{"name", "Center"}, {"brightness_range", {{"min", 0}, {"max", 100}}}});
+
+    auto diff = Diff(MakeConfig(), after);
+    EXPECT_EQ(diff.changedMonitors, (std::vector<std::string>{"Left", "Center", "Right"}));
+    EXPECT_FALSE(diff.HasDaemonChanges());
+}
+
+TEST(ConfigDiffTest, DetectsSensorFusionAndMonitorSensorChanges)
+{
+    auto after = MakeConfig();
+    after["brightness_daemon"]["sensor_fusion"] = {{"strategy", "nearest"}};
+    after["monitors"][1]["sensor"] = "Bedroom";
+
+    auto diff = Diff(MakeConfig(), after);
+    EXPECT_TRUE(diff.sensorFusion);
+    EXPECT_TRUE(diff.HasDaemonChanges());
+    EXPECT_FALSE(diff.updateInterval);
+    EXPECT_EQ(diff.changedMonitors, (std::vector<std::string>{"Right"}));
+}
+
+TEST(ConfigDiffTest, DetectsBrightnessCurveChanges)
+{
+    auto after = MakeConfig();
+    after["monitors"][0]["brightness_curve"] = {{{"light", 0}, {"brightness", 10}}, {{"light", 100}, {"brightness", 90}}};
+
+    auto diff = Diff(MakeConfig(), after);
+    EXPECT_EQ(diff.changedMonitors, (std::vector<std::string>{"Left"}));
+    EXPECT_FALSE(diff.HasDaemonChanges());
+}
+
+TEST(ConfigDiffTest, DetectsOnlyTheChangedDevice)
+{
+    auto after = MakeConfig();
+    after["plugins"]["SwitchBotLightSensor"]["devices"][1]["cache_ttl_ms"] = 1000;
+
+    auto diff = Diff(MakeConfig(), after);
+    ASSERT_EQ(diff.changedDevices.size(), 1u);
+    EXPECT_TRUE(diff.IsDeviceChanged("SwitchBotLightSensor", "Bedroom"));
+    EXPECT_FALSE(diff.IsDeviceChanged("SwitchBotLightSensor", "Living"));
+    EXPECT_FALSE(diff.IsDeviceChanged("DummyLightSensor", "Dummy"));
+}
+
+TEST(ConfigDiffTest, GlobalSettingsChangeAffectsAllDevicesOfThePlugin)
+{
+    auto after = MakeConfig();
+    after["plugins"]["SwitchBotLightSensor"]["global_settings"]["token"] = "NEW";
+
+    auto diff = Diff(MakeConfig(), after);
+    EXPECT_EQ(diff.changedDevices.size(), 2u);
+    EXPECT_TRUE(diff.IsDeviceChanged("SwitchBotLightSensor", "Living"));
+    EXPECT_TRUE(diff.IsDeviceChanged("SwitchBotLightSensor", "Bedroom"));
+    EXPECT_FALSE(diff.IsDeviceChanged("DummyLightSensor", "Dummy"));
+}
+
+TEST(ConfigDiffTest, DetectsRemovedDevice)
+{
+    auto after = MakeConfig();
+    after["plugins"]["DummyLightSensor"]["devices"] = nlohmann::json::array();
+
+    auto diff = Diff(MakeConfig(), after);
+    ASSERT_EQ(diff.changedDevices.size(), 1u);
+    EXPECT_TRUE(diff.IsDeviceChanged("DummyLightSensor", "Dummy"));
+}
@@ -0,0 +1,248 @@
+#include <gtest/gtest.h>
+#include "ConfigManager.h"
+#include "AtomicFile.h"
+#include "TestSupport.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    std::string ReadFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path);
+        std::stringstream ss;
+        ss << file.rdbuf();
+        return ss.str();
+    }
+
+    // 設定ファイルの場所を一時ディレクトリへ向け、検証を通る設定を読み込む
+    class ConfigManagerTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            setenv("XDG_CONFIG_HOME", m_directory.Path().c_str(), 1);
+            m_configPath = ConfigManager::Instance().GetConfigFilePath();
+            std::filesystem::create_directories(m_configPath.parent_path());
+            WriteFileAtomically(m_configPath, R"({
+                "monitors": [],
+                "plugins": {
+                    "DummyLightSensor": {
+                        "devices": [{"id": "D-1", "name": "Dummy", "type": "Light Sensor"}]
+                    }
+                },
+                "brightness_daemon": {"update_interval_ms": 5000, "min_brightness": 0, "max_brightness": 100}
+            })");
+            ConfigManager::Instance().Load();
+        }
+
+        void TearDown() override
+        {
+            unsetenv("XDG_CONFIG_HOME");
+        }
+
+        ConfigManager &Config() { return ConfigManager::Instance(); }
+
+        // 設定が見つからない場合に報告される位置
+        template <typename Get>
+        std::string ErrorPath(Get get)
+        {
+            try
+            {
+                get();
+            }
+            catch (const ConfigException &e)
+            {
+                return e.GetValidationResult().path;
+            }
+            return "(no error)";
+        }
+
+        TempDirectory m_directory{"ConfigManagerTest"};
+        std::filesystem::path m_configPath;
+    };
+}
+
+TEST_F(ConfigManagerTest, CommitSavesAllChangesAtOnce)
+{
+    auto before = ReadFile(m_configPath);
+
+    auto update = Config().BeginUpdate();
+    update.SetUpdateInterval(2000);
+    update.AddMonitor("DELL P2419H", {10, 90});
+    EXPECT_TRUE(update.HasMonitor("DELL P2419H"));
+
+    // 確定するまではファイルにも公開中の設定にも反映しない
+    EXPECT_EQ(ReadFile(m_configPath), before);
+    EXPECT_EQ(Config().GetUpdateInterval(), 5000);
+    EXPECT_FALSE(Config().HasMonitor("DELL P2419H"));
+
+    update.Commit();
+    EXPECT_EQ(Config().GetUpdateInterval(), 2000);
+    EXPECT_EQ(Config().GetMonitorBrightnessRange("DELL P2419H").max, 90);
+
+    auto saved = nlohmann::json::parse(ReadFile(m_configPath));
+    EXPECT_EQ(saved["brightness_daemon"]["update_interval_ms"], 2000);
+    EXPECT_EQ(saved["monitors"].size(), 1u);
+
+    // 終了した更新は使えない
+    EXPECT_THROW(update.SetUpdateInterval(3000), ConfigException);
+    EXPECT_THROW(update.Commit(), ConfigException);
+}
+
+TEST_F(ConfigManagerTest, RollbackDiscardsChanges)
+{
+    auto before = ReadFile(m_configPath);
+
+    auto update = Config().BeginUpdate();
+    update.SetMinBrightness(30);
+    update.AddMonitor("DELL P2419H", {10, 90});
+    update.Rollback();
+
+    // 確定せずに破棄した更新も変更を残さない
+    {
+        auto discarded = Config().BeginUpdate();
+        discarded.SetMaxBrightness(80);
+    }
+
+    EXPECT_EQ(ReadFile(m_configPath), before);
+    EXPECT_EQ(Config().GetMinBrightness(), 0);
+    EXPECT_EQ(Config().GetMaxBrightness(), 100);
+    EXPECT_FALSE(Config().HasMonitor("DELL P2419H"));
+}
+
+TEST_F(ConfigManagerTest, FailedCommitLeavesFileUnchanged)
+{
+    auto before = ReadFile(m_configPath);
+
+    // 一時ファイルの場所をディレクトリでふさぎ、保存を失敗させる
+    auto blocker = m_configPath;
+    blocker += ".tmp";
+    std::filesystem::create_directory(blocker);
+
+    auto update = Config().BeginUpdate();
+    update.SetUpdateInterval(2000);
+    EXPECT_THROW(update.Commit(), ConfigException);
+
+    EXPECT_EQ(ReadFile(m_configPath), before);
+    EXPECT_EQ(Config().GetUpdateInterval(), 5000);
+
+    // 失敗した変更は次の保存に混ざらない
+    std::filesystem::remove(blocker);
+    Config().SetMaxBrightness(80);
+    auto saved = nlohmann::json::parse(ReadFile(m_configPath));
+    EXPECT_EQ(saved["brightness_daemon"]["update_interval_ms"], 5000);
+    EXPECT_EQ(saved["brightness_daemon"]["max_brightness"], 80);
+}
+
+TEST_F(ConfigManagerTest, UpdateDoesNotBlockOtherWriters)
+{
+    auto update = Config().BeginUpdate();
+    update.SetUpdateInterval(2000);
+
+    // 更新中も他のスレッドからの変更は待たされない
+    auto writer = std::async(std::launch::async, [this] { Config().SetMinBrightness(30); });
+    ASSERT_EQ(writer.wait_for(5s), std::future_status::ready);
+    writer.get();
+
+    // 開始後に保存された変更を上書きしない
+    EXPECT_THROW(update.Commit(), ConfigException);
+    EXPECT_EQ(Config().GetMinBrightness(), 30);
+    EXPECT_EQ(Config().GetUpdateInterval(), 5000);
+}
+
+TEST_F(ConfigManagerTest, ReadersSeeConsistentValuesDuringReloadsAndWrites)
+{
+    // 読み取りはロックを取らずに公開中のスナップショットを参照するため、
+    // 再読み込みや保存と並行して呼んでも、常に検証済みの値が返る
+    std::atomic<bool> stop{false};
+    std::atomic<int> readerErrors{0};
+    std::atomic<uint64_t> reads{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&] {
+            while (!stop)
+            {
+                try
+                {
+                    auto snapshot = Config().GetSnapshot();
+                    int interval = Config().GetUpdateInterval();
+                    int minBrightness = Config().GetMinBrightness();
+                    int maxBrightness = Config().GetMaxBrightness();
+                    if (interval < 1000 || minBrightness < 0 || maxBrightness > 100 ||
+                        snapshot->GetRaw()["brightness_daemon"]["min_brightness"] > snapshot->GetRaw()["brightness_daemon"]["max_brightness"])
+                    {
+                        ++readerErrors;
+                    }
+                    Config().GetMonitorNames();
+                    ++reads;
+                }
+                catch (const std::exception &)
+                {
+                    ++readerErrors;
+                }
+            }
+        });
+    }
+
+    // 別のプロセスによる書き換えを再読み込みするスレッドと、Set*で保存するスレッド
+    // （書き換えはConfigManagerの一時ファイルとは別の名前から置き換える）
+    auto external = m_configPath;
+    external += ".external";
+    std::thread reloader([&] {
+        for (int i = 0; i < 50; ++i)
+        {
+            auto config = nlohmann::json::parse(ReadFile(m_configPath));
+            config["brightness_daemon"]["update_interval_ms"] = 1000 + i;
+            WriteFileAtomically(external, config.dump(2));
+            std::filesystem::rename(external, m_configPath);
+            Config().Load();
+        }
+    });
+    std::thread writer([&] {
+        for (int i = 0; i < 50; ++i)
+        {
+            Config().SetMaxBrightness(60 + i % 40);
+            Config().SetMinBrightness(i % 50);
+        }
+    });
+    reloader.join();
+    writer.join();
+    ASSERT_TRUE(WaitUntil([&] { return reads.load() > 0; }));
+    stop = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(readerErrors.load(), 0);
+    EXPECT_LE(Config().GetMinBrightness(), Config().GetMaxBrightness());
+
+    // 最後の保存はそのまま読み込める
+    Config().SetMaxBrightness(70);
+    Config().Load();
+    EXPECT_EQ(Config().GetMaxBrightness(), 70);
+}
+
+TEST_F(ConfigManagerTest, MissingPluginSettingsReportWhereTheLookupStopped)
+{
+    EXPECT_EQ(ErrorPath([&] { Config().GetPluginConfig("Missing", "token"); }), "plugins.Missing");
+    EXPECT_EQ(ErrorPath([&] { Config().GetPluginConfig("DummyLightSensor", "token"); }),
+              "plugins.DummyLightSensor.global_settings");
+    EXPECT_EQ(ErrorPath([&] { Config().GetPluginConfig("DummyLightSensor", "token", "Missing"); }),
+              "plugins.DummyLightSensor.devices");
+    EXPECT_EQ(ErrorPath([&] { Config().GetPluginConfig("DummyLightSensor", "token", "Dummy"); }),
+              "plugins.DummyLightSensor.devices[0].token");
+    EXPECT_EQ(Config().GetPluginConfig("DummyLightSensor", "type", "Dummy"), "Light Sensor");
+    EXPECT_EQ(ErrorPath([&] { Config().GetDeviceCalibration("SB-1"); }), "plugins.SwitchBotLightSensor");
+}
@@ -0,0 +1,228 @@
+// 設定の検証のマイクロベンチマーク
+// 変更前の実装（手書きの検査で、成功時もパスの文字列を作る）とコンパイル済みのスキーマを比較する
+#include "ConfigSchema.h"
+#include "ConfigValidation.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using ConfigValidation::ValidateNumber;
+using ConfigValidation::ValidateString;
+using ConfigValidation::ValidateValue;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    nlohmann::json MakeConfig(int monitorCount, int deviceCount)
+    {
+        nlohmann::json monitors = nlohmann::json::array();
+        for (int i = 0; i < monitorCount; ++i)
+        {
+            monitors.push_back({{"name", "Monitor " + std::to_string(i)},
+                                {"brightness_range", {{"min", i % 50}, {"max", 50 + i % 50}}}});
+        }
+
+        nlohmann::json devices = nlohmann::json::array();
+        for (int i = 0; i < deviceCount; ++i)
+        {
+            devices.push_back({{"id", "ID-" + std::to_string(i)},
+                               {"name", "Sensor " + std::to_string(i)},
+                               {"type", "Light Sensor"},
+                               {"description", ""}});
+        }
+
+        return {{"monitors", monitors},
+                {"plugins", {{"SwitchBotLightSensor", {{"global_settings", {{"token", "TOKEN"}}}, {"devices", devices}}}}},
+                {"brightness_daemon", {{"update_interval_ms", 5000}, {"min_brightness", 0}, {"max_brightness", 100}}}};
+    }
+
+    // 変更前のConfigManager::ValidateConfig()のうち、件数に比例するmonitorsとpluginsの検査
+    void LegacyValidate(const nlohmann::json &config)
+    {
+        // monitorsセクションの検証（オプショナル）
+        if (config.contains("monitors"))
+        {
+            auto result = ValidateValue(config["monitors"], "monitors", "array");
+            if (!result.isValid)
+                throw ConfigException(result);
+
+            const auto &monitors = config["monitors"];
+            for (size_t i = 0; i < monitors.size(); ++i)
+            {
+                const auto &monitor = monitors[i];
+                std::string monitorPath = "monitors[" + std::to_string(i) + "]";
+
+                // nameフィールドの検証
+                if (!monitor.contains("name"))
+                {
+                    throw ConfigException(ConfigValidationResult{
+                        false, monitorPath + ".name", "string", "undefined", "",
+                        "モニター名が指定されていません"});
+                }
+                auto nameResult = ValidateString(monitor["name"], monitorPath + ".name");
+                if (!nameResult.isValid)
+                    throw ConfigException(nameResult);
+
+                // brightness_rangeの検証
+                if (!monitor.contains("brightness_range"))
+                {
+                    throw ConfigException(ConfigValidationResult{
+                        false, monitorPath + ".brightness_range", "object", "undefined", "",
+                        "brightness_rangeが指定されていません"});
+                }
+                auto rangeResult = ValidateValue(monitor["brightness_range"], monitorPath + ".brightness_range", "object");
+                if (!rangeResult.isValid)
+                    throw ConfigException(rangeResult);
+
+                const auto &range = monitor["brightness_range"];
+                std::string rangePath = monitorPath + ".brightness_range";
+
+                // minの検証
+                if (!range.contains("min"))
+                {
+                    throw ConfigException(ConfigValidationResult{
+                        false, rangePath + ".min", "number", "undefined", "",
+                        "最小輝度が指定されていません"});
+                }
+                auto minResult = ValidateNumber(range["min"], rangePath + ".min", 0, 100);
+                if (!minResult.isValid)
+                    throw ConfigException(minResult);
+
+                // maxの検証
+                if (!range.contains("max"))
+                {
+                    throw ConfigException(ConfigValidationResult{
+                        false, rangePath + ".max", "number", "undefined", "",
+                        "最大輝度が指定されていません"});
+                }
+                auto maxResult = ValidateNumber(range["max"], rangePath + ".max", 0, 100);
+                if (!maxResult.isValid)
+                    throw ConfigException(maxResult);
+
+                // min <= maxの検証
+                int minBrightness = range["min"].get<int>();
+                int maxBrightness = range["max"].get<int>();
+                if (minBrightness > maxBrightness)
+                {
+                    throw ConfigException(ConfigValidationResult{
+                        false, rangePath, "", "",
+                        "min: " + std::to_string(minBrightness) + ", max: " + std::to_string(maxBrightness),
+                        "最小輝度は最大輝度以下である必要があります"});
+                }
+            }
+        }
+
+        // プラグインセクションの検証
+        if (!config.contains("plugins"))
+        {
+            throw ConfigException(ConfigValidationResult{
+                false, "plugins", "object", "undefined", "",
+                "設定ファイルにpluginsセクションがありません"});
+        }
+
+        const auto &plugins = config["plugins"];
+        for (auto &[pluginName, pluginConfig] : plugins.items())
+        {
+            std::string pluginPath = "plugins." + pluginName;
+
+            // プラグイン設定の基本構造を検証
+            if (!pluginConfig.contains("devices") && !pluginConfig.contains("global_settings"))
+            {
+                throw ConfigException(ConfigValidationResult{
+                    false, pluginPath, "", "", "",
+                    "devices または global_settings セクションがありません"});
+            }
+
+            // global_settingsの検証
+            if (pluginConfig.contains("global_settings"))
+            {
+                auto result = ValidateValue(pluginConfig["global_settings"], pluginPath + ".global_settings", "object");
+                if (!result.isValid)
+                    throw ConfigException(result);
+            }
+
+            // devicesの検証
+            if (pluginConfig.contains("devices"))
+            {
+                auto result = ValidateValue(pluginConfig["devices"], pluginPath + ".devices", "array");
+                if (!result.isValid)
+                    throw ConfigException(result);
+
+                const auto &devices = pluginConfig["devices"];
+                for (size_t i = 0; i < devices.size(); ++i)
+                {
+                    const auto &device = devices[i];
+                    std::string devicePath = pluginPath + ".devices[" + std::to_string(i) + "]";
+
+                    // 必須フィールドの存在チェック
+                    for (const auto &field : {"id", "name", "type"})
+                    {
+                        if (!device.contains(field))
+                        {
+                            throw ConfigException(ConfigValidationResult{
+                                false, devicePath + "." + field, "string", "undefined", "",
+                                std::string(field) + "が指定されていません"});
+                        }
+                    }
+
+                    // 各フィールドの型と値の検証
+                    auto idResult = ValidateString(device["id"], devicePath + ".id");
+                    if (!idResult.isValid)
+                        throw ConfigException(idResult);
+
+                    auto nameResult = ValidateString(device["name"], devicePath + ".name");
+                    if (!nameResult.isValid)
+                        throw ConfigException(nameResult);
+
+                    auto typeResult = ValidateString(device["type"], devicePath + ".type");
+                    if (!typeResult.isValid)
+                        throw ConfigException(typeResult);
+
+                    if (device.contains("description"))
+                    {
+                        auto descResult = ValidateString(device["description"], devicePath + ".description", true);
+                        if (!descResult.isValid)
+                            throw ConfigException(descResult);
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename Func>
+    double MeasureMicrosecondsPerCall(int iterations, Func func)
+    {
+        // 最適化で呼び出しが消えないよう結果を積算する
+        volatile size_t sink = 0;
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            sink = sink + func();
+        }
+        auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        return elapsed / iterations;
+    }
+}
+
+int main()
+{
+    const auto &schema = ConfigSchema::Default();
+    for (int count : {10, 1000, 10000})
+    {
+        auto config = MakeConfig(count, count);
+        int iterations = count >= 10000 ? 20 : 2000;
+
+        double legacy = MeasureMicrosecondsPerCall(iterations, [&] {
+            LegacyValidate(config);
+            return size_t{1};
+        });
+        double compiled = MeasureMicrosecondsPerCall(iterations, [&] {
+            return schema.Validate(config).size() + 1;
+        });
+
+        std::printf("%5d monitors/devices: legacy %10.1f us/call, schema %10.1f us/call (%.1fx)\n",
+                    count, legacy, compiled, legacy / compiled);
+    }
+    return 0;
+}
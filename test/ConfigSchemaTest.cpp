@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+#include "ConfigSchema.h"
+#include <algorithm>
+
+namespace
+{
+    nlohmann::json MakeValidConfig()
+    {
+        return nlohmann::json::parse(R"({
+            "monitors": [
+                {"name": "DELL P2419H", "brightness_range": {"min": 10, "max": 90}, "sensor": "Living",
+                 "brightness_curve": [{"light": 0, "brightness": 0}, {"light": 50, "brightness": 70}]}
+            ],
+            "plugins": {
+                "SwitchBotLightSensor": {
+                    "global_settings": {"token": "TOKEN", "secret": ""},
+                    "devices": [
+                        {"id": "SB-1", "name": "Living", "type": "Light Sensor", "description": "", "weight": 2,
+                         "cache_ttl_ms": 60000, "stale_while_revalidate_ms": 300000, "max_fallback_age_ms": 900000}
+                    ]
+                },
+                "DummyLightSensor": {
+                    "devices": [
+                        {"id": "D-1", "name": "Dummy", "type": "Light Sensor"}
+                    ]
+                }
+            },
+            "brightness_daemon": {
+                "update_interval_ms": 5000,
+                "min_brightness": 0,
+                "max_brightness": 100,
+                "write_deadband": 2,
+                "transition_duration_ms": 500,
+                "transition_curve": "ease_in_out",
+                "sensor_fusion": {"strategy": "median", "outlier_threshold": 3.5, "max_sample_age_ms": 300000, "read_timeout_ms": 10000}
+            }
+        })");
+    }
+
+    std::vector<std::string> Paths(const std::vector<ConfigValidationResult> &errors)
+    {
+        std::vector<std::string> paths;
+        for (const auto &error : errors)
+        {
+            paths.push_back(error.path);
+        }
+        std::sort(paths.begin(), paths.end());
+        return paths;
+    }
+}
+
+TEST(ConfigSchemaTest, ValidConfigHasNoErrors)
+{
+    EXPECT_TRUE(ConfigSchema::Default().Validate(MakeValidConfig()).empty());
+}
+
+TEST(ConfigSchemaTest, ReportsAllErrorsAtOnce)
+{
+    auto config = MakeValidConfig();
+    config["monitors"][0]["brightness_range"]["max"] = 150;
+    config["plugins"]["SwitchBotLightSensor"]["devices"][0]["id"] = "";
+    config["plugins"]["DummyLightSensor"]["devices"][0].erase("type");
+    config["brightness_daemon"]["update_interval_ms"] = "fast";
+    config["brightness_daemon"]["transition_curve"] = "bounce";
+
+    auto errors = ConfigSchema::Default().Validate(config);
+
+    EXPECT_EQ(Paths(errors), (std::vector<std::string>{
+                                 "brightness_daemon.transition_curve",
+                                 "brightness_daemon.update_interval_ms",
+                                 "monitors[0].brightness_range.max",
+                                 "plugins.DummyLightSensor.devices[0].type",
+                                 "plugins.SwitchBotLightSensor.devices[0].id",
+                             }));
+    for (const auto &error : errors)
+    {
+        EXPECT_FALSE(error.isValid);
+        EXPECT_FALSE(error.message.empty());
+    }
+}
+
+TEST(ConfigSchemaTest, ErrorDetailsMatchTheFailedCheck)
+{
+    auto config = MakeValidConfig();
+    config["brightness_daemon"]["update_interval_ms"] = 10;
+    config["plugins"]["DummyLightSensor"]["devices"][0].erase("type");
+    config["monitors"][0]["name"] = 1;
+
+    auto errors = ConfigSchema::Default().Validate(config);
+    ASSERT_EQ(errors.size(), 3u);
+
+    // 検査の順序は設定ファイルのセクションの順（monitors、plugins、brightness_daemon）
+    EXPECT_EQ(errors[0].path, "monitors[0].name");
+    EXPECT_EQ(errors[0].expectedType, "string");
+    EXPECT_EQ(errors[0].actualType, "number");
+    EXPECT_EQ(errors[0].message, "文字列である必要があります");
+
+    EXPECT_EQ(errors[1].path, "plugins.DummyLightSensor.devices[0].type");
+    EXPECT_EQ(errors[1].actualType, "undefined");
+    EXPECT_EQ(errors[1].message, "typeが指定されていません");
+
+    EXPECT_EQ(errors[2].path, "brightness_daemon.update_interval_ms");
+    EXPECT_EQ(errors[2].value, "10");
+    EXPECT_EQ(errors[2].message, "1000から2147483647の範囲である必要があります");
+}
+
+TEST(ConfigSchemaTest, ValidatesSensorFusionSettings)
+{
+    auto config = MakeValidConfig();
+    config["brightness_daemon"]["sensor_fusion"]["strategy"] = "average";
+    config["brightness_daemon"]["sensor_fusion"]["read_timeout_ms"] = 10;
+    config["plugins"]["DummyLightSensor"]["devices"][0]["weight"] = -1;
+
+    auto errors = ConfigSchema::Default().Validate(config);
+    EXPECT_EQ(Paths(errors), (std::vector<std::string>{
+                                 "brightness_daemon.sensor_fusion.read_timeout_ms",
+                                 "brightness_daemon.sensor_fusion.strategy",
+                                 "plugins.DummyLightSensor.devices[0].weight",
+                             }));
+}
+
+TEST(ConfigSchemaTest, ValidatesLightLevelCacheSettings)
+{
+    auto config = MakeValidConfig();
+    auto &device = config["plugins"]["SwitchBotLightSensor"]["devices"][0];
+    device["cache_ttl_ms"] = -1;
+    device["stale_while_revalidate_ms"] = "5m";
+    device["max_fallback_age_ms"] = 3000000000.0;
+
+    auto errors = ConfigSchema::Default().Validate(config);
+    EXPECT_EQ(Paths(errors), (std::vector<std::string>{
+                                 "plugins.SwitchBotLightSensor.devices[0].cache_ttl_ms",
+                                 "plugins.SwitchBotLightSensor.devices[0].max_fallback_age_ms",
+                                 "plugins.SwitchBotLightSensor.devices[0].stale_while_revalidate_ms",
+                             }));
+}
+
+TEST(ConfigSchemaTest, ValidatesBrightnessCurvePoints)
+{
+    auto config = MakeValidConfig();
+    config["monitors"][0]["brightness_curve"][1]["brightness"] = 120;
+    config["monitors"][0]["brightness_curve"].push_back({{"light", 80}});
+
+    auto errors = ConfigSchema::Default().Validate(config);
+    EXPECT_EQ(Paths(errors), (std::vector<std::string>{
+                                 "monitors[0].brightness_curve[1].brightness",
+                                 "monitors[0].brightness_curve[2].brightness",
+                             }));
+}
+
+TEST(ConfigSchemaTest, MissingSectionsAreReported)
+{
+    auto errors = ConfigSchema::Default().Validate(nlohmann::json::object());
+    EXPECT_EQ(Paths(errors), (std::vector<std::string>{"brightness_daemon", "plugins"}));
+}
+
+TEST(ConfigSchemaTest, CrossFieldConstraintsRunOnlyWhenFieldsAreValid)
+{
+    auto config = MakeValidConfig();
+    config["brightness_daemon"]["min_brightness"] = 80;
+    config["brightness_daemon"]["max_brightness"] = 20;
+
+    auto errors = ConfigSchema::Default().Validate(config);
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0].path, "brightness_daemon");
+    EXPECT_EQ(errors[0].value, "min_brightness: 80, max_brightness: 20");
+
+    // 値自体が不正な場合は大小関係を確認しない
+    config["brightness_daemon"]["max_brightness"] = "20";
+    errors = ConfigSchema::Default().Validate(config);
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0].path, "brightness_daemon.max_brightness");
+}
+
+TEST(ConfigSchemaTest, PluginNeedsDevicesOrGlobalSettings)
+{
+    auto config = MakeValidConfig();
+    config["plugins"]["Empty"] = nlohmann::json::object();
+    config["plugins"]["GlobalOnly"] = {{"global_settings", {{"token", "TOKEN"}}}};
+
+    auto errors = ConfigSchema::Default().Validate(config);
+    ASSERT_EQ(errors.size(), 1u);
+    EXPECT_EQ(errors[0].path, "plugins.Empty");
+    EXPECT_EQ(errors[0].message, "devices または global_settings セクションがありません");
+}
+
+TEST(ConfigSchemaTest, CustomSchemaValidatesNestedArrays)
+{
+    ConfigSchema schema;
+    auto item = schema.Object({{"value", schema.Number(0, 10), "valueが指定されていません"}});
+    schema.SetRoot(schema.Object({{"items", schema.Array(item), "itemsが指定されていません"}}));
+
+    auto errors = schema.Validate(nlohmann::json::parse(R"({"items": [{"value": 1}, {"value": 11}, {}]})"));
+    EXPECT_EQ(Paths(errors), (std::vector<std::string>{"items[1].value", "items[2].value"}));
+    EXPECT_TRUE(schema.Validate(nlohmann::json::parse(R"({"items": []})")).empty());
+}
+
+TEST(ConfigSchemaTest, ExceptionCarriesEveryError)
+{
+    auto config = MakeValidConfig();
+    config["monitors"][0]["name"] = "";
+    config["brightness_daemon"]["write_deadband"] = -1;
+
+    ConfigException e(ConfigSchema::Default().Validate(config));
+    ASSERT_EQ(e.GetValidationResults().size(), 2u);
+    EXPECT_EQ(e.GetValidationResult().path, "monitors[0].name");
+    std::string message = e.what();
+    EXPECT_NE(message.find("2件"), std::string::npos);
+    EXPECT_NE(message.find("monitors[0].name"), std::string::npos);
+    EXPECT_NE(message.find("brightness_daemon.write_deadband"), std::string::npos);
+}
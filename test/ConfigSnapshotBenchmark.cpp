@@ -0,0 +1,81 @@
+// 設定の検索のマイクロベンチマーク
+// 変更前の実装（JSONのデバイス配列を名前で線形探索する）とスナップショットのインデックスを比較する
+#include "ConfigSnapshot.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    constexpr int kIterations = 20000;
+
+    nlohmann::json MakeConfig(int deviceCount)
+    {
+        nlohmann::json devices = nlohmann::json::array();
+        for (int i = 0; i < deviceCount; ++i)
+        {
+            devices.push_back({{"id", "ID-" + std::to_string(i)},
+                               {"name", "Sensor " + std::to_string(i)},
+                               {"type", i % 2 == 0 ? "Light Sensor" : "Thermometer"}});
+        }
+        return {{"plugins", {{"SwitchBotLightSensor", {{"global_settings", {{"token", "TOKEN"}}}, {"devices", devices}}}}}};
+    }
+
+    // 変更前のConfigManager::GetPluginConfig()と同じ探索
+    std::string LinearLookup(const nlohmann::json &config, const std::string &deviceName)
+    {
+        const auto &devices = config["plugins"]["SwitchBotLightSensor"]["devices"];
+        for (const auto &device : devices)
+        {
+            if (device["name"] == deviceName)
+            {
+                return device["id"].get<std::string>();
+            }
+        }
+        return {};
+    }
+
+    template <typename Func>
+    double MeasureNanosecondsPerCall(const std::vector<std::string> &names, Func func)
+    {
+        // 最適化で呼び出しが消えないよう結果を積算する
+        volatile size_t sink = 0;
+        auto start = Clock::now();
+        for (int i = 0; i < kIterations; ++i)
+        {
+            sink = sink + func(names[static_cast<size_t>(i) % names.size()]);
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        return elapsed / kIterations;
+    }
+}
+
+int main()
+{
+    for (int deviceCount : {10, 1000, 5000})
+    {
+        auto config = MakeConfig(deviceCount);
+        ConfigSnapshot snapshot(config);
+
+        // 配列全体に散らばった名前を検索する
+        std::vector<std::string> names;
+        for (int i = 0; i < 64; ++i)
+        {
+            names.push_back("Sensor " + std::to_string((i * 7919) % deviceCount));
+        }
+
+        double linear = MeasureNanosecondsPerCall(names, [&](const std::string &name) {
+            return LinearLookup(config, name).size();
+        });
+        double indexed = MeasureNanosecondsPerCall(names, [&](const std::string &name) {
+            return snapshot.FindPluginSetting("SwitchBotLightSensor", "id", name)->size();
+        });
+
+        std::printf("%5d devices: linear %10.1f ns/call, snapshot %6.1f ns/call (%.0fx)\n",
+                    deviceCount, linear, indexed, linear / indexed);
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include "ConfigSnapshotStore.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // 何番目の再読み込みかを、すべての項目から読み取れる設定
+    nlohmann::json MakeConfig(int version)
+    {
+        int minBrightness = version % 50;
+        return nlohmann::json{
+            {"version", version},
+            {"monitors", nlohmann::json::array({
+                {{"name", "Monitor " + std::to_string(version)},
+                 {"brightness_range", {{"min", minBrightness}, {"max", minBrightness + 50}}}}})},
+            {"plugins", {
+                {"SwitchBotLightSensor", {
+                    {"global_settings", {{"token", "token-" + std::to_string(version)}}},
+                    {"devices", nlohmann::json::array({
+                        {{"id", "SB-" + std::to_string(version)}, {"name", "Sensor"}, {"type", "Light Sensor"}}})}}}}},
+            {"brightness_daemon", {
+                {"update_interval_ms", 1000 + version},
+                {"min_brightness", minBrightness},
+                {"max_brightness", minBrightness + 50}}}};
+    }
+
+    std::shared_ptr<const ConfigSnapshot> MakeSnapshot(int version)
+    {
+        return std::make_shared<const ConfigSnapshot>(MakeConfig(version));
+    }
+
+    // スナップショットのすべての項目が同じ再読み込みのものであることを確認する
+    bool IsConsistent(const ConfigSnapshot &snapshot, int &version)
+    {
+        version = snapshot.GetRaw()["version"].get<int>();
+        std::string suffix = std::to_string(version);
+        const auto &daemon = snapshot.GetDaemonSettings();
+        const auto *device = snapshot.FindDevice("SwitchBotLightSensor", "Sensor");
+        const auto *token = snapshot.FindPluginSetting("SwitchBotLightSensor", "token");
+        const auto *monitor = snapshot.FindMonitor("Monitor " + suffix);
+        return daemon.updateIntervalMs == 1000 + version &&
+               daemon.minBrightness == version % 50 &&
+               daemon.maxBrightness == version % 50 + 50 &&
+               device && device->id == "SB-" + suffix &&
+               snapshot.FindDeviceById("SwitchBotLightSensor", "SB-" + suffix) == device &&
+               token && *token == "token-" + suffix &&
+               monitor && monitor->brightnessRange &&
+               monitor->brightnessRange->min == version % 50;
+    }
+}
+
+TEST(ConfigSnapshotStoreTest, AcquireReturnsNullBeforeFirstPublish)
+{
+    ConfigSnapshotStore store;
+    EXPECT_EQ(store.Acquire(), nullptr);
+    EXPECT_EQ(store.GetGeneration(), 0u);
+}
+
+TEST(ConfigSnapshotStoreTest, PublishReplacesSnapshotAndReturnsPrevious)
+{
+    ConfigSnapshotStore store;
+    EXPECT_EQ(store.Publish(MakeSnapshot(1)), nullptr);
+
+    auto first = store.Acquire();
+    auto previous = store.Publish(MakeSnapshot(2));
+    EXPECT_EQ(previous, first);
+    EXPECT_EQ(store.GetGeneration(), 2u);
+    EXPECT_EQ(store.Acquire()->GetRaw()["version"], 2);
+}
+
+TEST(ConfigSnapshotStoreTest, HeldSnapshotOutlivesReplacement)
+{
+    ConfigSnapshotStore store;
+    store.Publish(MakeSnapshot(1));
+    auto held = store.Acquire();
+
+    // 差し替え後も取得済みのスナップショットは変わらず、インデックスも有効なまま
+    store.Publish(MakeSnapshot(2));
+    store.Publish(MakeSnapshot(3));
+
+    int version = 0;
+    EXPECT_TRUE(IsConsistent(*held, version));
+    EXPECT_EQ(version, 1);
+    EXPECT_EQ(store.Acquire()->GetRaw()["version"], 3);
+}
+
+TEST(ConfigSnapshotStoreTest, ReadersNeverSeeTornSnapshotsDuringReloads)
+{
+    constexpr int kReaders = 4;
+    constexpr int kReloaders = 2;
+    constexpr int kReloadsPerThread = 200;
+
+    ConfigSnapshotStore store;
+    store.Publish(MakeSnapshot(0));
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> nextVersion{1};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> inconsistent{0};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < kReaders; ++i)
+    {
+        readers.emplace_back([&] {
+            while (!stop.load())
+            {
+                auto snapshot = store.Acquire();
+                int version = 0;
+                if (!snapshot || !IsConsistent(*snapshot, version))
+                {
+                    ++inconsistent;
+                }
+                ++reads;
+            }
+        });
+    }
+
+    std::vector<std::thread> reloaders;
+    for (int i = 0; i < kReloaders; ++i)
+    {
+        reloaders.emplace_back([&] {
+            for (int n = 0; n < kReloadsPerThread; ++n)
+            {
+                // 公開前に新しいスナップショットを組み立てる（読み取り側を待たせない）
+                store.Publish(MakeSnapshot(nextVersion.fetch_add(1)));
+            }
+        });
+    }
+
+    for (auto &reloader : reloaders)
+    {
+        reloader.join();
+    }
+    stop = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(inconsistent.load(), 0u);
+    EXPECT_GT(reads.load(), 0u);
+    EXPECT_EQ(store.GetGeneration(), static_cast<uint64_t>(kReloaders * kReloadsPerThread + 1));
+}
+
+TEST(ConfigSnapshotStoreTest, SingleReloaderIsObservedInOrder)
+{
+    constexpr int kReloads = 500;
+
+    ConfigSnapshotStore store;
+    store.Publish(MakeSnapshot(0));
+
+    std::atomic<bool> stop{false};
+    std::atomic<bool> wentBackwards{false};
+
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 3; ++i)
+    {
+        readers.emplace_back([&] {
+            int lastVersion = 0;
+            while (!stop.load())
+            {
+                int version = store.Acquire()->GetRaw()["version"].get<int>();
+                if (version < lastVersion)
+                {
+                    wentBackwards = true;
+                }
+                lastVersion = version;
+            }
+        });
+    }
+
+    for (int version = 1; version <= kReloads; ++version)
+    {
+        store.Publish(MakeSnapshot(version));
+    }
+    stop = true;
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_FALSE(wentBackwards.load());
+    EXPECT_EQ(store.Acquire()->GetRaw()["version"], kReloads);
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include "ConfigSnapshot.h"
+
+namespace
+{
+    nlohmann::json MakeConfig()
+    {
+        return nlohmann::json::parse(R"({
+            "monitors": [
+                {"name": "DELL P2419H", "brightness_range": {"min": 10, "max": 90}, "sensor": "Living",
+                 "brightness_curve": [{"light": 0, "brightness": 5}, {"light": 100, "brightness": 90}]},
+                {"name": "No Range"},
+                {"name": "Inverted", "brightness_range": {"min": 80, "max": 20}}
+            ],
+            "plugins": {
+                "SwitchBotLightSensor": {
+                    "global_settings": {"token": "TOKEN", "secret": "", "daily_request_limit": 100},
+                    "devices": [
+                        {"id": "SB-1", "name": "Living", "type": "Light Sensor",
+                         "calibration": {"min_raw_value": 100, "max_raw_value": 800}},
+                        {"id": "SB-2", "name": "Bedroom", "type": "Light Sensor", "weight": 0.5,
+                         "calibration": {"min_raw_value": 900, "max_raw_value": 800}},
+                        {"id": "SB-3", "name": "Living", "type": "Thermometer"}
+                    ]
+                },
+                "DummyLightSensor": {
+                    "devices": [
+                        {"id": "D-1", "name": "Dummy", "type": "Light Sensor"}
+                    ]
+                }
+            },
+            "brightness_daemon": {
+                "update_interval_ms": 5000,
+                "min_brightness": 0,
+                "max_brightness": 100,
+                "sync_on_startup": true,
+                "transition_curve": "linear",
+                "sensor_fusion": {"strategy": "weighted_mean", "outlier_threshold": 2.5}
+            }
+        })");
+    }
+}
+
+TEST(ConfigSnapshotTest, IndexesDevicesByNameIdAndType)
+{
+    ConfigSnapshot snapshot(MakeConfig());
+
+    const auto *living = snapshot.FindDeviceByName("Living");
+    ASSERT_NE(living, nullptr);
+    // 同じ名前が複数ある場合は最初のデバイス
+    EXPECT_EQ(living->id, "SB-1");
+    EXPECT_EQ(living->pluginName, "SwitchBotLightSensor");
+    EXPECT_EQ(living->index, 0u);
+
+    const auto *byId = snapshot.FindDeviceById("SwitchBotLightSensor", "SB-2");
+    ASSERT_NE(byId, nullptr);
+    EXPECT_EQ(byId->name, "Bedroom");
+    EXPECT_EQ(snapshot.FindDeviceById("DummyLightSensor", "SB-2"), nullptr);
+    EXPECT_EQ(snapshot.FindDeviceByName("Missing"), nullptr);
+
+    // プラグイン名の順（設定ファイルの読み込み結果と同じ順序）に並ぶ
+    const auto &sensors = snapshot.GetDevicesByType("Light Sensor");
+    ASSERT_EQ(sensors.size(), 3u);
+    EXPECT_EQ(sensors[0]->id, "D-1");
+    EXPECT_EQ(sensors[1]->id, "SB-1");
+    EXPECT_EQ(sensors[2]->id, "SB-2");
+    EXPECT_TRUE(snapshot.GetDevicesByType("Unknown").empty());
+}
+
+TEST(ConfigSnapshotTest, ResolvesStringPluginSettings)
+{
+    ConfigSnapshot snapshot(MakeConfig());
+
+    const auto *token = snapshot.FindPluginSetting("SwitchBotLightSensor", "token");
+    ASSERT_NE(token, nullptr);
+    EXPECT_EQ(*token, "TOKEN");
+
+    const auto *id = snapshot.FindPluginSetting("SwitchBotLightSensor", "id", "Bedroom");
+    ASSERT_NE(id, nullptr);
+    EXPECT_EQ(*id, "SB-2");
+
+    // 空文字列と文字列以外の値は含めない（呼び出し元で詳細なエラーにする）
+    EXPECT_EQ(snapshot.FindPluginSetting("SwitchBotLightSensor", "secret"), nullptr);
+    EXPECT_EQ(snapshot.FindPluginSetting("SwitchBotLightSensor", "daily_request_limit"), nullptr);
+    EXPECT_EQ(snapshot.FindPluginSetting("Missing", "token"), nullptr);
+
+    const auto *plugin = snapshot.FindPlugin("SwitchBotLightSensor");
+    ASSERT_NE(plugin, nullptr);
+    EXPECT_EQ(plugin->globalSettings["daily_request_limit"], 100);
+    EXPECT_TRUE(snapshot.FindPlugin("DummyLightSensor")->globalSettings.empty());
+}
+
+TEST(ConfigSnapshotTest, ValidatesCalibrationAtBuild)
+{
+    ConfigSnapshot snapshot(MakeConfig());
+
+    const auto *living = snapshot.FindDeviceById("SwitchBotLightSensor", "SB-1");
+    EXPECT_FALSE(living->calibrationError.has_value());
+    EXPECT_EQ(living->calibration.minRawValue, 100);
+    EXPECT_EQ(living->calibration.maxRawValue, 800);
+
+    const auto *bedroom = snapshot.FindDeviceById("SwitchBotLightSensor", "SB-2");
+    ASSERT_TRUE(bedroom->calibrationError.has_value());
+    EXPECT_EQ(bedroom->calibrationError->path, "plugins.SwitchBotLightSensor.devices[1].calibration");
+
+    // calibrationがなければ既定値
+    const auto *thermometer = snapshot.FindDeviceById("SwitchBotLightSensor", "SB-3");
+    EXPECT_EQ(thermometer->calibration.maxRawValue, CalibrationSettings().maxRawValue);
+}
+
+TEST(ConfigSnapshotTest, IndexesMonitors)
+{
+    ConfigSnapshot snapshot(MakeConfig());
+
+    EXPECT_EQ(snapshot.GetMonitorNames(), (std::vector<std::string>{"DELL P2419H", "No Range", "Inverted"}));
+
+    const auto *dell = snapshot.FindMonitor("DELL P2419H");
+    ASSERT_NE(dell, nullptr);
+    ASSERT_TRUE(dell->brightnessRange.has_value());
+    EXPECT_EQ(dell->brightnessRange->min, 10);
+    EXPECT_EQ(dell->brightnessRange->max, 90);
+    EXPECT_EQ(dell->sensor, "Living");
+    EXPECT_EQ(dell->brightnessCurve, (std::vector<std::pair<int, int>>{{0, 5}, {100, 90}}));
+    EXPECT_TRUE(snapshot.FindMonitor("No Range")->brightnessCurve.empty());
+    EXPECT_TRUE(snapshot.FindMonitor("No Range")->sensor.empty());
+
+    EXPECT_FALSE(snapshot.FindMonitor("No Range")->brightnessRange.has_value());
+    EXPECT_FALSE(snapshot.FindMonitor("Inverted")->brightnessRange.has_value());
+    EXPECT_EQ(snapshot.FindMonitor("Missing"), nullptr);
+}
+
+TEST(ConfigSnapshotTest, ParsesDaemonSettings)
+{
+    ConfigSnapshot snapshot(MakeConfig());
+    const auto &daemon = snapshot.GetDaemonSettings();
+
+    EXPECT_EQ(daemon.updateIntervalMs, 5000);
+    EXPECT_EQ(daemon.minBrightness, 0);
+    EXPECT_EQ(daemon.maxBrightness, 100);
+    EXPECT_EQ(daemon.syncOnStartup, true);
+    EXPECT_EQ(daemon.transitionCurve, EasingCurve::Linear);
+    EXPECT_FALSE(daemon.writeDeadband.has_value());
+    EXPECT_FALSE(daemon.transitionDurationMs.has_value());
+    EXPECT_EQ(daemon.fusionStrategy, FusionStrategy::WeightedMean);
+    EXPECT_EQ(daemon.outlierThreshold, 2.5);
+    EXPECT_FALSE(daemon.maxSampleAgeMs.has_value());
+}
+
+TEST(ConfigSnapshotTest, ParsesDeviceWeights)
+{
+    ConfigSnapshot snapshot(MakeConfig());
+    EXPECT_EQ(snapshot.FindDeviceById("SwitchBotLightSensor", "SB-2")->weight, 0.5);
+    EXPECT_EQ(snapshot.FindDeviceById("SwitchBotLightSensor", "SB-1")->weight, 1.0);
+}
+
+TEST(ConfigSnapshotTest, ToleratesMalformedSections)
+{
+    auto config = MakeConfig();
+    config["plugins"]["Broken"] = {{"devices", "not an array"}};
+    config["monitors"].push_back({{"name", 42}});
+    config["brightness_daemon"]["transition_curve"] = "bouncy";
+
+    ConfigSnapshot snapshot(config);
+    EXPECT_NE(snapshot.FindPlugin("Broken"), nullptr);
+    EXPECT_EQ(snapshot.GetMonitorNames().size(), 3u);
+    EXPECT_FALSE(snapshot.GetDaemonSettings().transitionCurve.has_value());
+
+    ConfigSnapshot empty(nlohmann::json::array());
+    EXPECT_EQ(empty.FindDeviceByName("Living"), nullptr);
+    EXPECT_TRUE(empty.GetMonitorNames().empty());
+}
@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include "ConfigSourceKey.h"
+
+namespace
+{
+    const std::filesystem::file_time_type MODIFIED_TIME{std::chrono::seconds(1700000000)};
+    const std::string SOURCE = R"({"brightness_daemon": {"update_interval_ms": 5000}})";
+}
+
+TEST(ConfigSourceKeyTest, SameContentAndTimeGiveSameKey)
+{
+    EXPECT_EQ(ConfigSourceKey::Compute(SOURCE, MODIFIED_TIME), ConfigSourceKey::Compute(std::string(SOURCE), MODIFIED_TIME));
+}
+
+TEST(ConfigSourceKeyTest, ContentChangeOfSameSizeChangesKey)
+{
+    // 更新日時が変わらない（精度が粗い）場合も、内容が違えばハッシュで区別する
+    std::string edited = SOURCE;
+    edited[edited.find("5000")] = '6';
+    EXPECT_NE(ConfigSourceKey::Compute(SOURCE, MODIFIED_TIME), ConfigSourceKey::Compute(edited, MODIFIED_TIME));
+}
+
+TEST(ConfigSourceKeyTest, ModifiedTimeChangesKey)
+{
+    EXPECT_NE(ConfigSourceKey::Compute(SOURCE, MODIFIED_TIME),
+              ConfigSourceKey::Compute(SOURCE, MODIFIED_TIME + std::chrono::seconds(1)));
+}
+
+TEST(ConfigSourceKeyTest, HashIsFnv1a64OfContent)
+{
+    // FNV-1aの参照値（EDIDのハッシュと同じ関数を使う）
+    EXPECT_EQ(Fnv1a64(std::string_view()), 0xcbf29ce484222325ull);
+    EXPECT_EQ(Fnv1a64(std::string_view("a")), 0xaf63dc4c8601ec8cull);
+    EXPECT_EQ(Fnv1a64(std::string_view("foobar")), 0x85944171f73967e8ull);
+
+    const uint8_t bytes[] = {'f', 'o', 'o', 'b', 'a', 'r'};
+    EXPECT_EQ(Fnv1a64(bytes), Fnv1a64(std::string_view("foobar")));
+    EXPECT_EQ(ConfigSourceKey::Compute(SOURCE, MODIFIED_TIME).hash, Fnv1a64(SOURCE));
+}
@@ -0,0 +1,299 @@
+#include <gtest/gtest.h>
+#include "DdcCiProtocol.h"
+#include "DisplayBackend.h"
+#include "EdidSamples.h"
+#include "SimulatedDisplayBackend.h"
+#include "TestSupport.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    void WriteFile(const std::filesystem::path &path, const std::string &content)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+    }
+
+    std::string ReadFile(const std::filesystem::path &path)
+    {
+        std::ifstream file(path);
+        std::string content;
+        std::getline(file, content);
+        return content;
+    }
+
+    // モニターが返すVCP値の取得要求への応答
+    std::vector<uint8_t> MakeGetVcpReply(uint8_t code, uint16_t maximum, uint16_t current, uint8_t result = 0x00)
+    {
+        std::vector<uint8_t> reply = {
+            0x6E, 0x88, 0x02, result, code, 0x00,
+            static_cast<uint8_t>(maximum >> 8), static_cast<uint8_t>(maximum & 0xFF),
+            static_cast<uint8_t>(current >> 8), static_cast<uint8_t>(current & 0xFF),
+        };
+        uint8_t checksum = 0x50;
+        for (uint8_t byte : reply)
+        {
+            checksum ^= byte;
+        }
+        reply.push_back(checksum);
+        return reply;
+    }
+
+    SimulatedDisplayBackend::MonitorSpec Dell(const std::string &connector = "DP-1")
+    {
+        return {EdidSamples::DellP2419H(), connector, true, {}};
+    }
+
+    SimulatedDisplayBackend::MonitorSpec LgUltraFine(const std::string &connector = "DP-2")
+    {
+        return {EdidSamples::LgUltraFine(), connector, false, {}};
+    }
+}
+
+TEST(DdcCiProtocolTest, EncodesGetVcpRequestWithChecksum)
+{
+    // チェックサムは宛先アドレス（0x6E）を含めたすべてのバイトの排他的論理和
+    EXPECT_EQ(EncodeDdcGetVcpRequest(kVcpBrightness), (std::vector<uint8_t>{0x51, 0x82, 0x01, 0x10, 0xAC}));
+}
+
+TEST(DdcCiProtocolTest, EncodesSetVcpRequestBigEndian)
+{
+    auto request = EncodeDdcSetVcpRequest(kVcpBrightness, 0x0150);
+    ASSERT_EQ(request.size(), 7u);
+    EXPECT_EQ(request[0], 0x51);
+    EXPECT_EQ(request[1], 0x84);
+    EXPECT_EQ(request[2], 0x03);
+    EXPECT_EQ(request[3], 0x10);
+    EXPECT_EQ(request[4], 0x01);
+    EXPECT_EQ(request[5], 0x50);
+
+    uint8_t checksum = 0x6E;
+    for (size_t i = 0; i < 6; ++i)
+    {
+        checksum ^= request[i];
+    }
+    EXPECT_EQ(request[6], checksum);
+}
+
+TEST(DdcCiProtocolTest, DecodesGetVcpReply)
+{
+    auto value = DecodeDdcGetVcpReply(MakeGetVcpReply(kVcpBrightness, 100, 75), kVcpBrightness);
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(value->maximum, 100);
+    EXPECT_EQ(value->current, 75);
+}
+
+TEST(DdcCiProtocolTest, RejectsCorruptedOrUnsupportedReplies)
+{
+    auto corrupted = MakeGetVcpReply(kVcpBrightness, 100, 75);
+    corrupted[9] ^= 0x01;
+    EXPECT_FALSE(DecodeDdcGetVcpReply(corrupted, kVcpBrightness).has_value());
+
+    // 対応していないVCPコード
+    EXPECT_FALSE(DecodeDdcGetVcpReply(MakeGetVcpReply(kVcpContrast, 100, 50, 0x01), kVcpContrast).has_value());
+
+    // 別のVCPコードへの応答
+    EXPECT_FALSE(DecodeDdcGetVcpReply(MakeGetVcpReply(kVcpContrast, 100, 50), kVcpBrightness).has_value());
+
+    // 処理中を表すnullメッセージ
+    EXPECT_FALSE(DecodeDdcGetVcpReply({0x6E, 0x80, 0xBE, 0, 0, 0, 0, 0, 0, 0, 0}, kVcpBrightness).has_value());
+
+    EXPECT_FALSE(DecodeDdcGetVcpReply({0x6E, 0x88, 0x02}, kVcpBrightness).has_value());
+}
+
+TEST(CompositeDisplayBackendTest, AssignsDistinctIdsAndRoutesOperations)
+{
+    auto first = std::make_unique<SimulatedDisplayBackend>();
+    auto second = std::make_unique<SimulatedDisplayBackend>();
+    auto *firstBackend = first.get();
+    auto *secondBackend = second.get();
+    // どちらの子のバックエンドでも最初のモニターのIDは同じ値になる
+    MonitorId dell = firstBackend->Connect(Dell());
+    MonitorId lg = secondBackend->Connect(LgUltraFine());
+    ASSERT_EQ(dell, lg);
+
+    std::vector<std::unique_ptr<IDisplayBackend>> backends;
+    backends.push_back(std::move(first));
+    backends.push_back(std::move(second));
+    auto composite = CreateCompositeDisplayBackend(std::move(backends));
+
+    auto displays = composite->EnumerateDisplays();
+    ASSERT_EQ(displays.size(), 2u);
+    EXPECT_NE(displays[0].id, displays[1].id);
+    EXPECT_EQ(displays[0].connector, "DP-1");
+    EXPECT_EQ(displays[1].connector, "DP-2");
+    EXPECT_NE(composite->GetBusId(displays[0].id), composite->GetBusId(displays[1].id));
+
+    // 列挙し直しても同じIDを返す
+    auto again = composite->EnumerateDisplays();
+    EXPECT_EQ(again[0].id, displays[0].id);
+    EXPECT_EQ(again[1].id, displays[1].id);
+
+    auto handle = composite->OpenPhysicalMonitor(displays[1].id);
+    EXPECT_TRUE(composite->SetBrightness(handle, 80));
+    composite->ClosePhysicalMonitor(handle);
+    EXPECT_EQ(secondBackend->GetBrightnessValue(lg), 80u);
+    EXPECT_EQ(firstBackend->GetBrightnessValue(dell), 50u);
+}
+
+TEST(CompositeDisplayBackendTest, RejectsUnknownIdsAndNullBackends)
+{
+    std::vector<std::unique_ptr<IDisplayBackend>> backends;
+    backends.push_back(std::make_unique<SimulatedDisplayBackend>());
+    auto composite = CreateCompositeDisplayBackend(std::move(backends));
+    EXPECT_THROW(composite->OpenPhysicalMonitor(reinterpret_cast<MonitorId>(42)), DisplayControllerException);
+
+    std::vector<std::unique_ptr<IDisplayBackend>> withNull;
+    withNull.push_back(nullptr);
+    EXPECT_THROW(CreateCompositeDisplayBackend(std::move(withNull)), std::invalid_argument);
+}
+
+TEST(SimulatedDisplayBackendTest, ReadsAndWritesBrightness)
+{
+    SimulatedDisplayBackend backend;
+    auto spec = Dell();
+    spec.maxBrightness = 200;
+    spec.brightness = 120;
+    MonitorId id = backend.Connect(spec);
+
+    auto handle = backend.OpenPhysicalMonitor(id);
+    unsigned long minValue = 1, currentValue = 0, maxValue = 0;
+    ASSERT_TRUE(backend.GetBrightness(handle, minValue, currentValue, maxValue));
+    EXPECT_EQ(minValue, 0u);
+    EXPECT_EQ(currentValue, 120u);
+    EXPECT_EQ(maxValue, 200u);
+
+    // 最大値を超える値は最大値に丸められる
+    EXPECT_TRUE(backend.SetBrightness(handle, 500));
+    EXPECT_EQ(backend.GetBrightnessValue(id), 200u);
+    EXPECT_EQ(backend.GetWriteCount(id), 1u);
+    backend.ClosePhysicalMonitor(handle);
+}
+
+TEST(SimulatedDisplayBackendTest, FailsOperationsOnDisconnectedOrUnsupportedMonitors)
+{
+    SimulatedDisplayBackend backend;
+    MonitorId dell = backend.Connect(Dell());
+    auto spec = LgUltraFine();
+    spec.supportsDdc = false;
+    MonitorId lg = backend.Connect(spec);
+
+    EXPECT_THROW(backend.OpenPhysicalMonitor(lg), DisplayControllerException);
+
+    auto handle = backend.OpenPhysicalMonitor(dell);
+    backend.Disconnect(dell);
+    EXPECT_FALSE(backend.SetBrightness(handle, 10));
+    EXPECT_THROW(backend.OpenPhysicalMonitor(dell), DisplayControllerException);
+    EXPECT_THROW(backend.GetBrightnessValue(dell), std::invalid_argument);
+}
+
+TEST(SimulatedDisplayBackendTest, DelaysOperationsByConfiguredLatency)
+{
+    SimulatedDisplayBackend backend;
+    MonitorId id = backend.Connect(Dell());
+    backend.SetLatency(id, 30ms);
+    auto handle = backend.OpenPhysicalMonitor(id);
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(backend.SetBrightness(handle, 70));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 30ms);
+    EXPECT_EQ(backend.GetBrightnessValue(id), 70u);
+
+    EXPECT_THROW(backend.SetLatency(reinterpret_cast<MonitorId>(99), 1ms), std::invalid_argument);
+}
+
+TEST(SimulatedDisplayBackendTest, EnumeratesConnectedDisplays)
+{
+    SimulatedDisplayBackend backend;
+    backend.Connect(Dell());
+    MonitorId lg = backend.Connect(LgUltraFine());
+    backend.ReassignIds();
+
+    auto displays = backend.EnumerateDisplays();
+    ASSERT_EQ(displays.size(), 2u);
+    EXPECT_EQ(displays[0].connector, "DP-1");
+    EXPECT_TRUE(displays[0].isPrimary);
+    EXPECT_EQ(displays[0].edid, EdidSamples::DellP2419H());
+    EXPECT_EQ(displays[1].deviceName, L"DP-2");
+    EXPECT_NE(displays[1].id, lg);
+}
+
+#ifdef __linux__
+TEST(BacklightDisplayBackendTest, PrefersFirmwareInterfaceAndWritesBrightness)
+{
+    TempDirectory root("DisplayBackendTest");
+    WriteFile(root.Path() / "acpi_video0" / "type", "firmware\n");
+    WriteFile(root.Path() / "acpi_video0" / "max_brightness", "15\n");
+    WriteFile(root.Path() / "acpi_video0" / "actual_brightness", "9\n");
+    WriteFile(root.Path() / "acpi_video0" / "brightness", "9\n");
+    WriteFile(root.Path() / "intel_backlight" / "type", "raw\n");
+    WriteFile(root.Path() / "intel_backlight" / "max_brightness", "96000\n");
+    WriteFile(root.Path() / "intel_backlight" / "brightness", "48000\n");
+
+    auto backend = CreateBacklightDisplayBackend(root.Path());
+    auto displays = backend->EnumerateDisplays();
+    ASSERT_EQ(displays.size(), 1u);
+    EXPECT_EQ(displays[0].deviceName, L"acpi_video0");
+    EXPECT_TRUE(displays[0].isPrimary);
+
+    auto handle = backend->OpenPhysicalMonitor(displays[0].id);
+    unsigned long minValue = 0, currentValue = 0, maxValue = 0;
+    ASSERT_TRUE(backend->GetBrightness(handle, minValue, currentValue, maxValue));
+    EXPECT_EQ(currentValue, 9u);
+    EXPECT_EQ(maxValue, 15u);
+
+    EXPECT_TRUE(backend->SetBrightness(handle, 12));
+    EXPECT_EQ(ReadFile(root.Path() / "acpi_video0" / "brightness"), "12");
+    EXPECT_FALSE(backend->GetContrast(handle, minValue, currentValue, maxValue));
+    backend->ClosePhysicalMonitor(handle);
+}
+
+TEST(BacklightDisplayBackendTest, ReturnsNoDisplayWithoutBacklight)
+{
+    TempDirectory root("DisplayBackendTest");
+    auto backend = CreateBacklightDisplayBackend(root.Path() / "missing");
+    EXPECT_TRUE(backend->EnumerateDisplays().empty());
+    EXPECT_THROW(backend->OpenPhysicalMonitor(reinterpret_cast<MonitorId>(1)), DisplayControllerException);
+}
+
+TEST(DdcCiDisplayBackendTest, EnumeratesConnectedExternalConnectors)
+{
+    TempDirectory drm("DisplayBackendTest");
+    auto edid = EdidSamples::DellP2419H();
+    WriteFile(drm.Path() / "card0-DP-1" / "status", "connected\n");
+    WriteFile(drm.Path() / "card0-DP-1" / "edid", std::string(edid.begin(), edid.end()));
+    std::filesystem::create_directories(drm.Path() / "i2c" / "i2c-5");
+    std::filesystem::create_directory_symlink(drm.Path() / "i2c" / "i2c-5", drm.Path() / "card0-DP-1" / "ddc");
+    // DisplayPortのAUXチャネル
+    WriteFile(drm.Path() / "card0-DP-2" / "status", "connected\n");
+    std::filesystem::create_directories(drm.Path() / "card0-DP-2" / "i2c-7");
+    // 内蔵パネルと未接続のコネクターは含めない
+    WriteFile(drm.Path() / "card0-eDP-1" / "status", "connected\n");
+    std::filesystem::create_directories(drm.Path() / "card0-eDP-1" / "i2c-3");
+    WriteFile(drm.Path() / "card0-HDMI-A-1" / "status", "disconnected\n");
+    std::filesystem::create_directories(drm.Path() / "card0-HDMI-A-1" / "i2c-4");
+    std::filesystem::create_directories(drm.Path() / "card0");
+
+    auto backend = CreateDdcCiDisplayBackend(drm.Path(), drm.Path() / "dev");
+    auto displays = backend->EnumerateDisplays();
+    ASSERT_EQ(displays.size(), 2u);
+    EXPECT_EQ(displays[0].connector, "card0-DP-1");
+    EXPECT_EQ(displays[0].edid, edid);
+    EXPECT_EQ(backend->GetBusId(displays[0].id), 5u);
+    EXPECT_EQ(displays[1].connector, "card0-DP-2");
+    EXPECT_TRUE(displays[1].edid.empty());
+    EXPECT_EQ(backend->GetBusId(displays[1].id), 7u);
+
+    // コネクターごとのIDは列挙し直しても変わらない
+    EXPECT_EQ(backend->EnumerateDisplays()[1].id, displays[1].id);
+
+    // I2Cデバイスがない場合は開けない
+    EXPECT_THROW(backend->OpenPhysicalMonitor(displays[0].id), DisplayControllerException);
+}
+#endif
@@ -0,0 +1,315 @@
+#include <gtest/gtest.h>
+#include "BrightnessTransition.h"
+#include "DisplayChangeWatcher.h"
+#include "EdidSamples.h"
+#include "SimulatedDisplayBackend.h"
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    SimulatedDisplayBackend::MonitorSpec Dell(const std::string &connector = "DP-1")
+    {
+        return {EdidSamples::DellP2419H(), connector, true, {}};
+    }
+
+    SimulatedDisplayBackend::MonitorSpec LgUltraFine(const std::string &connector = "DP-2")
+    {
+        return {EdidSamples::LgUltraFine(), connector, false, {}};
+    }
+
+    // EDIDを読み取れないモニター（接続先だけで識別される）
+    SimulatedDisplayBackend::MonitorSpec Generic(const std::string &connector)
+    {
+        return {{}, connector, false, {}};
+    }
+
+    // 監視スレッドから届いた変更を順に受け取る
+    class ChangeRecorder
+    {
+    public:
+        void Record(const MonitorTopologyChange &change)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_changes.push_back(change);
+            }
+            m_changed.notify_all();
+        }
+
+        bool WaitFor(size_t count, std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            return m_changed.wait_for(lock, timeout, [&] { return m_changes.size() >= count; });
+        }
+
+        std::vector<MonitorTopologyChange> Get()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_changes;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_changed;
+        std::vector<MonitorTopologyChange> m_changes;
+    };
+
+    // シミュレーターの構成から一覧を作り、変更を監視する一式
+    // （シミュレーターが監視より先に破棄されないよう、メンバーの順序に意味がある）
+    class SimulatedDisplay
+    {
+    public:
+        explicit SimulatedDisplay(std::chrono::milliseconds debounce = 50ms)
+            : m_signal(std::make_unique<DisplayChangeSignal>())
+            , backend(m_signal.get())
+            , store([this] { return backend.BuildMonitors(); })
+        {
+            store.Get();
+            watcher = std::make_unique<DisplayChangeWatcher>(
+                std::move(m_signal), debounce,
+                [this] { return store.Refresh(); },
+                [this](const MonitorTopologyChange &change) { changes.Record(change); });
+        }
+
+    private:
+        std::unique_ptr<DisplayChangeSignal> m_signal;
+
+    public:
+        SimulatedDisplayBackend backend;
+        MonitorTopologyStore store;
+        ChangeRecorder changes;
+        std::unique_ptr<DisplayChangeWatcher> watcher;
+    };
+}
+
+TEST(DisplayChangeSignalTest, WaitsForNotification)
+{
+    DisplayChangeSignal signal;
+    EXPECT_FALSE(signal.WaitForChange(10ms));
+
+    signal.Notify();
+    signal.Notify();
+    EXPECT_TRUE(signal.WaitForChange(0ms));
+    EXPECT_TRUE(signal.WaitForChange(0ms));
+    EXPECT_FALSE(signal.WaitForChange(0ms));
+
+    signal.Notify();
+    signal.Cancel();
+    EXPECT_FALSE(signal.WaitForChange(1h));
+}
+
+TEST(MonitorTopologyRefreshTest, ReportsConnectedAndDisconnectedMonitors)
+{
+    SimulatedDisplayBackend backend;
+    MonitorTopologyStore store([&] { return backend.BuildMonitors(); });
+
+    MonitorId dell = backend.Connect(Dell());
+    auto initial = store.Refresh();
+    EXPECT_EQ(initial.added, std::vector<MonitorId>{dell});
+    EXPECT_TRUE(initial.retained.empty());
+
+    MonitorId lg = backend.Connect(LgUltraFine());
+    auto connected = store.Refresh();
+    EXPECT_EQ(connected.added, std::vector<MonitorId>{lg});
+    EXPECT_TRUE(connected.removed.empty());
+    ASSERT_EQ(connected.retained.size(), 1u);
+    EXPECT_EQ(connected.retained[0], std::make_pair(dell, dell));
+    EXPECT_EQ(connected.topology->Find(lg)->name, L"LG ULTRAFINE");
+
+    backend.Disconnect(dell);
+    auto disconnected = store.Refresh();
+    EXPECT_TRUE(disconnected.added.empty());
+    EXPECT_EQ(disconnected.removed, std::vector<MonitorId>{dell});
+    EXPECT_EQ(disconnected.topology->GetIds(), std::vector<MonitorId>{lg});
+}
+
+TEST(MonitorTopologyRefreshTest, MatchesReassignedIdsByIdentity)
+{
+    SimulatedDisplayBackend backend;
+    MonitorTopologyStore store([&] { return backend.BuildMonitors(); });
+    MonitorId dell = backend.Connect(Dell());
+    MonitorId generic = backend.Connect(Generic("HDMI-1"));
+    store.Get();
+
+    backend.ReassignIds();
+    auto change = store.Refresh();
+    auto ids = backend.GetConnectedIds();
+
+    EXPECT_TRUE(change.added.empty());
+    EXPECT_TRUE(change.removed.empty());
+    ASSERT_EQ(change.retained.size(), 2u);
+    EXPECT_EQ(change.retained[0], std::make_pair(dell, ids[0]));
+    EXPECT_EQ(change.retained[1], std::make_pair(generic, ids[1]));
+    EXPECT_TRUE(change.HasMonitorChanges());
+
+    // 構成が変わらなければ差分はない
+    auto unchanged = store.Refresh();
+    EXPECT_FALSE(unchanged.HasMonitorChanges());
+    EXPECT_EQ(unchanged.retained.size(), 2u);
+}
+
+TEST(MonitorTopologyRefreshTest, ReconnectedMonitorIsRetained)
+{
+    SimulatedDisplayBackend backend;
+    MonitorTopologyStore store([&] { return backend.BuildMonitors(); });
+    MonitorId dell = backend.Connect(Dell("DP-1"));
+    store.Get();
+
+    // シリアル番号を持つモニターは別の端子へつなぎ替えても同じモニター
+    backend.Disconnect(dell);
+    MonitorId moved = backend.Connect(Dell("DP-3"));
+    // シリアル番号を持たないモニターは別の端子では別のモニター
+    MonitorId generic = backend.Connect(Generic("HDMI-1"));
+    auto change = store.Refresh();
+
+    EXPECT_EQ(change.added, std::vector<MonitorId>{generic});
+    EXPECT_TRUE(change.removed.empty());
+    ASSERT_EQ(change.retained.size(), 1u);
+    EXPECT_EQ(change.retained[0], std::make_pair(dell, moved));
+}
+
+TEST(MonitorTopologyRefreshTest, FailedRefreshKeepsPreviousRoster)
+{
+    SimulatedDisplayBackend backend;
+    bool fail = false;
+    MonitorTopologyStore store([&] {
+        if (fail)
+        {
+            throw DisplayControllerException("enumeration failed");
+        }
+        return backend.BuildMonitors();
+    });
+    MonitorId dell = backend.Connect(Dell());
+    store.Get();
+
+    MonitorId lg = backend.Connect(LgUltraFine());
+    fail = true;
+    EXPECT_THROW(store.Refresh(), DisplayControllerException);
+
+    // 失敗前の一覧と比較するため、接続されたモニターを取りこぼさない
+    fail = false;
+    auto change = store.Refresh();
+    EXPECT_EQ(change.added, std::vector<MonitorId>{lg});
+    ASSERT_EQ(change.retained.size(), 1u);
+    EXPECT_EQ(change.retained[0].first, dell);
+}
+
+TEST(DisplayChangeWatcherTest, CoalescesBurstIntoOneRefresh)
+{
+    SimulatedDisplay display(100ms);
+
+    // モニターの接続では短い間に複数の通知が届く
+    MonitorId dell = display.backend.Connect(Dell());
+    display.backend.NotifyUnchanged();
+    MonitorId lg = display.backend.Connect(LgUltraFine());
+
+    ASSERT_TRUE(display.changes.WaitFor(1, 2s));
+    std::this_thread::sleep_for(200ms);
+    auto changes = display.changes.Get();
+    ASSERT_EQ(changes.size(), 1u);
+    EXPECT_EQ(changes[0].added, (std::vector<MonitorId>{dell, lg}));
+
+    auto stats = display.watcher->GetStats();
+    EXPECT_EQ(stats.events, 3u);
+    EXPECT_EQ(stats.refreshes, 1u);
+    EXPECT_EQ(stats.added, 2u);
+    EXPECT_EQ(display.store.GetBuildCount(), 2u);
+}
+
+TEST(DisplayChangeWatcherTest, ReplaysHotPlugSequence)
+{
+    SimulatedDisplay display(20ms);
+    MonitorId dell = display.backend.Connect(Dell());
+    ASSERT_TRUE(display.changes.WaitFor(1, 2s));
+
+    MonitorId lg = display.backend.Connect(LgUltraFine());
+    ASSERT_TRUE(display.changes.WaitFor(2, 2s));
+
+    display.backend.ReassignIds();
+    ASSERT_TRUE(display.changes.WaitFor(3, 2s));
+
+    auto ids = display.backend.GetConnectedIds();
+    display.backend.Disconnect(ids[1]);
+    ASSERT_TRUE(display.changes.WaitFor(4, 2s));
+
+    auto changes = display.changes.Get();
+    ASSERT_EQ(changes.size(), 4u);
+    EXPECT_EQ(changes[0].added, std::vector<MonitorId>{dell});
+    EXPECT_EQ(changes[1].added, std::vector<MonitorId>{lg});
+    EXPECT_EQ(changes[2].retained, (std::vector<std::pair<MonitorId, MonitorId>>{{dell, ids[0]}, {lg, ids[1]}}));
+    EXPECT_TRUE(changes[2].added.empty());
+    EXPECT_EQ(changes[3].removed, std::vector<MonitorId>{ids[1]});
+
+    auto stats = display.watcher->GetStats();
+    EXPECT_EQ(stats.added, 2u);
+    EXPECT_EQ(stats.removed, 1u);
+}
+
+TEST(DisplayChangeWatcherTest, TransitionSurvivesTopologyChange)
+{
+    SimulatedDisplay display(20ms);
+    BrightnessTransitionEngine transitions(1000ms, EasingCurve::Linear);
+    auto start = BrightnessTransitionEngine::Clock::time_point{} + 1h;
+
+    MonitorId dell = display.backend.Connect(Dell());
+    ASSERT_TRUE(display.changes.WaitFor(1, 2s));
+    transitions.SetTarget(dell, 20, start);
+    transitions.Advance(start);
+    transitions.SetTarget(dell, 80, start);
+    transitions.Advance(start + 500ms);
+
+    // 遷移の途中でモニターが追加され、既存のモニターのIDも割り当て直された
+    display.backend.ReassignIds();
+    display.backend.Connect(LgUltraFine());
+    ASSERT_TRUE(display.changes.WaitFor(2, 2s));
+    auto change = display.changes.Get()[1];
+    transitions.RemapMonitors(change.retained, start + 500ms);
+
+    MonitorId renamed = display.backend.GetConnectedIds()[0];
+    ASSERT_NE(renamed, dell);
+    EXPECT_TRUE(transitions.IsActive());
+    EXPECT_EQ(transitions.GetCurrentValue(renamed), 50);
+
+    auto frames = transitions.Advance(start + 1s);
+    ASSERT_EQ(frames.size(), 1u);
+    EXPECT_EQ(frames[0], std::make_pair(renamed, 80));
+}
+
+TEST(DisplayChangeWatcherTest, KeepsWatchingAfterRefreshFailure)
+{
+    auto signal = std::make_unique<DisplayChangeSignal>();
+    auto *raw = signal.get();
+    std::atomic<int> attempts{0};
+    ChangeRecorder changes;
+    DisplayChangeWatcher watcher(
+        std::move(signal), 10ms,
+        [&] {
+            if (++attempts == 1)
+            {
+                throw DisplayControllerException("enumeration failed");
+            }
+            return MonitorTopologyChange{};
+        },
+        [&](const MonitorTopologyChange &change) { changes.Record(change); });
+
+    raw->Notify();
+    std::this_thread::sleep_for(100ms);
+    raw->Notify();
+    ASSERT_TRUE(changes.WaitFor(1, 2s));
+    EXPECT_EQ(attempts.load(), 2);
+    EXPECT_EQ(watcher.GetStats().refreshes, 1u);
+}
+
+TEST(DisplayChangeWatcherTest, RejectsMissingArguments)
+{
+    auto refresh = [] { return MonitorTopologyChange{}; };
+    auto callback = [](const MonitorTopologyChange &) {};
+    EXPECT_THROW(DisplayChangeWatcher(nullptr, 10ms, refresh, callback), std::invalid_argument);
+    EXPECT_THROW(DisplayChangeWatcher(std::make_unique<DisplayChangeSignal>(), -1ms, refresh, callback),
+                 std::invalid_argument);
+}
@@ -0,0 +1,343 @@
+#include <gtest/gtest.h>
+#include "EdidParser.h"
+#include "EdidSamples.h"
+#include <random>
+
+namespace
+{
+    constexpr size_t kBlockSize = 128;
+
+    void FixChecksum(std::vector<uint8_t> &edid, size_t block)
+    {
+        uint8_t sum = 0;
+        size_t offset = block * kBlockSize;
+        for (size_t i = 0; i < kBlockSize - 1; ++i)
+        {
+            sum = static_cast<uint8_t>(sum + edid[offset + i]);
+        }
+        edid[offset + kBlockSize - 1] = static_cast<uint8_t>(0x100 - sum);
+    }
+
+    // 拡張ブロックを末尾に追加し、基本ブロックの拡張数とチェックサムを更新する
+    void AppendExtension(std::vector<uint8_t> &edid, std::vector<uint8_t> block)
+    {
+        block.resize(kBlockSize, 0);
+        edid.insert(edid.end(), block.begin(), block.end());
+        edid[126] = static_cast<uint8_t>(edid.size() / kBlockSize - 1);
+        FixChecksum(edid, 0);
+        FixChecksum(edid, edid.size() / kBlockSize - 1);
+    }
+
+    // DisplayIDの拡張ブロック（データブロックを並べたもの）
+    std::vector<uint8_t> MakeDisplayIdBlock(uint8_t version, const std::vector<uint8_t> &dataBlocks)
+    {
+        std::vector<uint8_t> block = {0x70, version, static_cast<uint8_t>(dataBlocks.size()), 0x01, 0x00};
+        block.insert(block.end(), dataBlocks.begin(), dataBlocks.end());
+        return block;
+    }
+
+    std::vector<uint8_t> MakeProductIdBlock(uint8_t tag, uint32_t serial, const std::string &name)
+    {
+        std::vector<uint8_t> block = {tag, 0x00, static_cast<uint8_t>(12 + name.size()),
+                                      0x00, 0x00, 0x00,             // OUI
+                                      0x34, 0x12,                   // 製品コード
+                                      static_cast<uint8_t>(serial), static_cast<uint8_t>(serial >> 8),
+                                      static_cast<uint8_t>(serial >> 16), static_cast<uint8_t>(serial >> 24),
+                                      0x01, 0x20,                   // 週・年
+                                      static_cast<uint8_t>(name.size())};
+        block.insert(block.end(), name.begin(), name.end());
+        return block;
+    }
+
+    bool IsPrintable(const std::string &text)
+    {
+        for (char c : text)
+        {
+            if (c < 0x20 || c > 0x7E)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST(EdidParserTest, ParsesBaseBlock)
+{
+    auto info = ParseEdid(EdidSamples::DellP2419H());
+    ASSERT_TRUE(info.has_value());
+
+    EXPECT_EQ(info->version, 1);
+    EXPECT_EQ(info->revision, 4);
+    EXPECT_EQ(info->manufacturer, "DEL");
+    EXPECT_EQ(info->productCode, 0xA0C4);
+    EXPECT_EQ(info->serialNumber, 0x4C4C3142u);
+    EXPECT_EQ(info->manufactureWeek, 12);
+    EXPECT_EQ(info->manufactureYear, 2019);
+    EXPECT_FALSE(info->isModelYear);
+    EXPECT_TRUE(info->isDigital);
+    EXPECT_EQ(info->name, "DELL P2419H");
+    EXPECT_EQ(info->serial, "7MT0195R1BPL");
+    EXPECT_TRUE(info->text.empty());
+    EXPECT_TRUE(info->extensions.empty());
+    EXPECT_FALSE(info->hasDisplayId);
+}
+
+TEST(EdidParserTest, ParsesPreferredTimingAndPhysicalSize)
+{
+    auto info = ParseEdid(EdidSamples::DellP2419H());
+    ASSERT_TRUE(info.has_value());
+    ASSERT_TRUE(info->preferredTiming.has_value());
+
+    EXPECT_EQ(info->preferredTiming->pixelClockKHz, 148500u);
+    EXPECT_EQ(info->preferredTiming->horizontalActive, 1920);
+    EXPECT_EQ(info->preferredTiming->verticalActive, 1080);
+    // 詳細タイミングのmm単位のサイズを基本ブロックのcm単位のサイズより優先する
+    EXPECT_EQ(info->widthMm, 527);
+    EXPECT_EQ(info->heightMm, 296);
+}
+
+TEST(EdidParserTest, FallsBackToBaseBlockSize)
+{
+    auto edid = EdidSamples::DellP2419H();
+    // 詳細タイミングのサイズを消す
+    edid[54 + 12] = 0;
+    edid[54 + 13] = 0;
+    edid[54 + 14] = 0;
+    FixChecksum(edid, 0);
+
+    auto info = ParseEdid(edid);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->widthMm, 530);
+    EXPECT_EQ(info->heightMm, 300);
+
+    // 片方が0の場合は縦横比なのでサイズは不明
+    edid[22] = 0;
+    FixChecksum(edid, 0);
+    info = ParseEdid(edid);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->widthMm, 0);
+    EXPECT_EQ(info->heightMm, 0);
+}
+
+TEST(EdidParserTest, ParsesModelYearWithoutSerial)
+{
+    auto info = ParseEdid(EdidSamples::LgUltraFine());
+    ASSERT_TRUE(info.has_value());
+
+    EXPECT_EQ(info->manufacturer, "GSM");
+    EXPECT_EQ(info->serialNumber, 0u);
+    EXPECT_TRUE(info->serial.empty());
+    EXPECT_EQ(info->name, "LG ULTRAFINE");
+    EXPECT_TRUE(info->isModelYear);
+    EXPECT_EQ(info->manufactureWeek, 0);
+    EXPECT_EQ(info->manufactureYear, 2020);
+}
+
+TEST(EdidParserTest, RejectsInvalidBaseBlock)
+{
+    auto edid = EdidSamples::DellP2419H();
+
+    auto badChecksum = edid;
+    badChecksum[127] ^= 0x01;
+    EXPECT_FALSE(ParseEdid(badChecksum).has_value());
+
+    auto badHeader = edid;
+    badHeader[0] = 0x01;
+    FixChecksum(badHeader, 0);
+    EXPECT_FALSE(ParseEdid(badHeader).has_value());
+
+    auto truncated = edid;
+    truncated.resize(100);
+    EXPECT_FALSE(ParseEdid(truncated).has_value());
+    EXPECT_FALSE(ParseEdid({}).has_value());
+}
+
+TEST(EdidParserTest, DisplayIdFillsMissingFields)
+{
+    auto edid = EdidSamples::LgUltraFine();
+    // DisplayID 2.0: 製品識別情報と、1mm単位のディスプレイパラメーター
+    auto product = MakeProductIdBlock(0x20, 0x00ABCDEF, "ULTRAFINE 5K");
+    std::vector<uint8_t> parameters = {0x21, 0x80, 0x04, 0x58, 0x02, 0x54, 0x01};
+    std::vector<uint8_t> dataBlocks = product;
+    dataBlocks.insert(dataBlocks.end(), parameters.begin(), parameters.end());
+    AppendExtension(edid, MakeDisplayIdBlock(0x20, dataBlocks));
+
+    auto info = ParseEdid(edid);
+    ASSERT_TRUE(info.has_value());
+    ASSERT_EQ(info->extensions.size(), 1u);
+    EXPECT_EQ(info->extensions[0].tag, 0x70);
+    EXPECT_TRUE(info->extensions[0].checksumValid);
+    EXPECT_TRUE(info->hasDisplayId);
+
+    // 基本ブロックにないシリアル番号を補い、基本ブロックにあるモニター名はそのまま
+    EXPECT_EQ(info->serialNumber, 0x00ABCDEFu);
+    EXPECT_EQ(info->name, "LG ULTRAFINE");
+    EXPECT_EQ(info->widthMm, 600);
+    EXPECT_EQ(info->heightMm, 340);
+}
+
+TEST(EdidParserTest, DisplayIdVersion1UsesTenthsOfMillimeters)
+{
+    auto edid = EdidSamples::LgUltraFine();
+    // モニター名の記述子を消して、DisplayIDの製品名を使わせる
+    edid[75] = 0x10;
+    FixChecksum(edid, 0);
+
+    auto product = MakeProductIdBlock(0x00, 0, "DISPLAYID NAME");
+    // 597.0mm x 336.0mm
+    std::vector<uint8_t> parameters = {0x01, 0x00, 0x04, 0x52, 0x17, 0x20, 0x0D};
+    std::vector<uint8_t> dataBlocks = product;
+    dataBlocks.insert(dataBlocks.end(), parameters.begin(), parameters.end());
+    AppendExtension(edid, MakeDisplayIdBlock(0x13, dataBlocks));
+
+    auto info = ParseEdid(edid);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_EQ(info->name, "DISPLAYID NAME");
+    EXPECT_EQ(info->widthMm, 597);
+    EXPECT_EQ(info->heightMm, 336);
+}
+
+TEST(EdidParserTest, SkipsCorruptedExtensions)
+{
+    auto edid = EdidSamples::LgUltraFine();
+    AppendExtension(edid, MakeDisplayIdBlock(0x20, MakeProductIdBlock(0x20, 0x1234, "X")));
+    AppendExtension(edid, {0x02, 0x03});
+    // DisplayIDブロックのチェックサムを壊す
+    edid[kBlockSize + 10] ^= 0xFF;
+
+    auto info = ParseEdid(edid);
+    ASSERT_TRUE(info.has_value());
+    ASSERT_EQ(info->extensions.size(), 2u);
+    EXPECT_FALSE(info->extensions[0].checksumValid);
+    EXPECT_EQ(info->extensions[1].tag, 0x02);
+    EXPECT_TRUE(info->extensions[1].checksumValid);
+    EXPECT_FALSE(info->hasDisplayId);
+    EXPECT_EQ(info->serialNumber, 0u);
+}
+
+TEST(EdidParserTest, ReadsOnlyAvailableExtensions)
+{
+    auto edid = EdidSamples::DellP2419H();
+    // 拡張ブロックが3つあると宣言しているが、データは基本ブロックだけ
+    edid[126] = 3;
+    FixChecksum(edid, 0);
+
+    auto info = ParseEdid(edid);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_TRUE(info->extensions.empty());
+}
+
+TEST(EdidParserTest, IgnoresOverrunningDisplayIdBlocks)
+{
+    auto edid = EdidSamples::LgUltraFine();
+    // データブロックの長さが区間の外まで続いている
+    std::vector<uint8_t> overrun = {0x20, 0x00, 0xF0, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04};
+    auto block = MakeDisplayIdBlock(0x20, overrun);
+    block[2] = 0xFF;
+    AppendExtension(edid, block);
+
+    auto info = ParseEdid(edid);
+    ASSERT_TRUE(info.has_value());
+    EXPECT_TRUE(info->hasDisplayId);
+    EXPECT_EQ(info->serialNumber, 0u);
+}
+
+TEST(EdidParserTest, HashDistinguishesBlobs)
+{
+    auto dell = EdidSamples::DellP2419H();
+    auto lg = EdidSamples::LgUltraFine();
+    EXPECT_EQ(HashEdid(dell), HashEdid(EdidSamples::DellP2419H()));
+    EXPECT_NE(HashEdid(dell), HashEdid(lg));
+}
+
+TEST(EdidParserTest, CacheParsesEachBlobOnce)
+{
+    EdidCache cache;
+    auto first = cache.Parse(EdidSamples::DellP2419H());
+    auto second = cache.Parse(EdidSamples::DellP2419H());
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(cache.GetParseCount(), 1u);
+
+    cache.Parse(EdidSamples::LgUltraFine());
+    EXPECT_EQ(cache.GetParseCount(), 2u);
+
+    // 不正なEDIDも解析結果（nullptr）を保持する
+    std::vector<uint8_t> invalid(128, 0x00);
+    EXPECT_EQ(cache.Parse(invalid), nullptr);
+    EXPECT_EQ(cache.Parse(invalid), nullptr);
+    EXPECT_EQ(cache.GetParseCount(), 3u);
+
+    cache.Clear();
+    cache.Parse(EdidSamples::DellP2419H());
+    EXPECT_EQ(cache.GetParseCount(), 4u);
+}
+
+// 実際のEDIDを壊したものや任意のバイト列を解析しても、範囲外を読まずに妥当な値を返す
+TEST(EdidParserTest, FuzzedInputs)
+{
+    std::mt19937 random(20241017);
+    std::uniform_int_distribution<int> byte(0, 255);
+    const std::vector<std::vector<uint8_t>> seeds = {EdidSamples::DellP2419H(), EdidSamples::LgUltraFine()};
+
+    for (int iteration = 0; iteration < 20000; ++iteration)
+    {
+        auto edid = seeds[iteration % seeds.size()];
+        // 拡張ブロックの数をランダムにして、DisplayIDらしいブロックを混ぜる
+        size_t extensions = random() % 4;
+        for (size_t i = 0; i < extensions; ++i)
+        {
+            std::vector<uint8_t> block(kBlockSize);
+            for (auto &value : block)
+            {
+                value = static_cast<uint8_t>(byte(random));
+            }
+            if (random() % 2 == 0)
+            {
+                block[0] = 0x70;
+            }
+            edid.insert(edid.end(), block.begin(), block.end());
+        }
+        if (random() % 4 == 0)
+        {
+            edid.resize(random() % (edid.size() + 1));
+        }
+
+        // ランダムな位置を書き換える
+        int mutations = static_cast<int>(random() % 16);
+        for (int i = 0; i < mutations && !edid.empty(); ++i)
+        {
+            edid[random() % edid.size()] = static_cast<uint8_t>(byte(random));
+        }
+
+        // 多くの入力がチェックサムで弾かれないよう、ほとんどの場合はチェックサムを直す
+        if (random() % 8 != 0 && edid.size() >= kBlockSize)
+        {
+            if (random() % 2 == 0)
+            {
+                edid[126] = static_cast<uint8_t>(extensions);
+            }
+            for (size_t block = 0; block < edid.size() / kBlockSize; ++block)
+            {
+                FixChecksum(edid, block);
+            }
+        }
+
+        auto info = ParseEdid(edid);
+        if (!info)
+        {
+            continue;
+        }
+        EXPECT_EQ(info->manufacturer.size(), 3u);
+        EXPECT_TRUE(IsPrintable(info->name));
+        EXPECT_TRUE(IsPrintable(info->serial));
+        EXPECT_TRUE(IsPrintable(info->text));
+        EXPECT_LE(info->serial.size(), 13u);
+        EXPECT_LE(info->text.size(), 13u);
+        EXPECT_GE(info->widthMm, 0);
+        EXPECT_GE(info->heightMm, 0);
+        EXPECT_LE(info->extensions.size(), edid.size() / kBlockSize - 1);
+        EXPECT_TRUE(info->manufactureWeek >= 0 && info->manufactureWeek <= 54);
+    }
+}
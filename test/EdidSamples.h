@@ -0,0 +1,41 @@
+#ifndef DISPLAYCONTROLLER_TEST_EDID_SAMPLES_H
+#define DISPLAYCONTROLLER_TEST_EDID_SAMPLES_H
+
+#include <cstdint>
+#include <vector>
+
+// テスト用に取得したEDID（基本ブロックのみ）
+namespace EdidSamples
+{
+    // DELL P2419H（シリアル番号と、シリアル番号の記述子を持つ）
+    inline std::vector<uint8_t> DellP2419H()
+    {
+        return {
+            0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x10, 0xAC, 0xC4, 0xA0, 0x42, 0x31, 0x4C, 0x4C,
+            0x0C, 0x1D, 0x01, 0x04, 0xB5, 0x35, 0x1E, 0x78, 0x3A, 0x0D, 0xC9, 0xA0, 0x57, 0x47, 0x98, 0x27,
+            0x12, 0x48, 0x4C, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+            0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x3A, 0x80, 0x18, 0x71, 0x38, 0x2D, 0x40, 0x58, 0x2C,
+            0x45, 0x00, 0x0F, 0x28, 0x21, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x37, 0x4D, 0x54,
+            0x30, 0x31, 0x39, 0x35, 0x52, 0x31, 0x42, 0x50, 0x4C, 0x0A, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x44,
+            0x45, 0x4C, 0x4C, 0x20, 0x50, 0x32, 0x34, 0x31, 0x39, 0x48, 0x0A, 0x20, 0x00, 0x00, 0x00, 0xFD,
+            0x00, 0x38, 0x4C, 0x1E, 0x53, 0x11, 0x00, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x94,
+        };
+    }
+
+    // LG ULTRAFINE（シリアル番号を持たない）
+    inline std::vector<uint8_t> LgUltraFine()
+    {
+        return {
+            0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x1E, 0x6D, 0x09, 0x5B, 0x00, 0x00, 0x00, 0x00,
+            0xFF, 0x1E, 0x01, 0x04, 0xB5, 0x35, 0x1E, 0x78, 0x3A, 0x0D, 0xC9, 0xA0, 0x57, 0x47, 0x98, 0x27,
+            0x12, 0x48, 0x4C, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+            0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x02, 0x3A, 0x80, 0x18, 0x71, 0x38, 0x2D, 0x40, 0x58, 0x2C,
+            0x45, 0x00, 0x0F, 0x28, 0x21, 0x00, 0x00, 0x1E, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x4C, 0x47, 0x20,
+            0x55, 0x4C, 0x54, 0x52, 0x41, 0x46, 0x49, 0x4E, 0x45, 0x0A, 0x00, 0x00, 0x00, 0xFD, 0x00, 0x38,
+            0x4C, 0x1E, 0x53, 0x11, 0x00, 0x0A, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0x10,
+            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x49,
+        };
+    }
+}
+
+#endif // DISPLAYCONTROLLER_TEST_EDID_SAMPLES_H
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include "FileWatcher.h"
+#include "TestSupport.h"
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // 通知のタイミングをテストから操作するバックエンド
+    class FakeFileWatchBackend : public IFileWatchBackend
+    {
+    public:
+        void Touch()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_pending;
+            }
+            m_changed.notify_all();
+        }
+
+        bool WaitForChange(std::chrono::milliseconds timeout) override
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_changed.wait_for(lock, timeout, [this] { return m_cancelled || m_pending > 0; });
+            if (m_cancelled || m_pending == 0)
+            {
+                return false;
+            }
+            --m_pending;
+            return true;
+        }
+
+        void Cancel() override
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_cancelled = true;
+            }
+            m_changed.notify_all();
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_changed;
+        int m_pending = 0;
+        bool m_cancelled = false;
+    };
+
+    // コールバックの呼び出し回数を待てるカウンター
+    class CallCounter
+    {
+    public:
+        void Increment()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                ++m_count;
+            }
+            m_changed.notify_all();
+        }
+
+        bool WaitFor(int count, std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            return m_changed.wait_for(lock, timeout, [&] { return m_count >= count; });
+        }
+
+        int Get()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_count;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_changed;
+        int m_count = 0;
+    };
+
+    void WriteFile(const std::filesystem::path &path, const std::string &content)
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << content;
+    }
+}
+
+TEST(FileWatcherTest, CoalescesBurstOfEventsIntoOneNotification)
+{
+    auto backend = std::make_unique<FakeFileWatchBackend>();
+    auto *fake = backend.get();
+    CallCounter calls;
+    FileWatcher watcher(std::move(backend), 100ms, [&] { calls.Increment(); });
+
+    // 保存中に続けて届く通知は1回にまとめる
+    for (int i = 0; i < 5; ++i)
+    {
+        fake->Touch();
+        std::this_thread::sleep_for(10ms);
+    }
+
+    ASSERT_TRUE(calls.WaitFor(1, 2s));
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(calls.Get(), 1);
+    EXPECT_EQ(watcher.GetStats().events, 5u);
+    EXPECT_EQ(watcher.GetStats().notifications, 1u);
+}
+
+TEST(FileWatcherTest, SeparateEditsNotifySeparately)
+{
+    auto backend = std::make_unique<FakeFileWatchBackend>();
+    auto *fake = backend.get();
+    CallCounter calls;
+    FileWatcher watcher(std::move(backend), 20ms, [&] { calls.Increment(); });
+
+    fake->Touch();
+    ASSERT_TRUE(calls.WaitFor(1, 2s));
+    fake->Touch();
+    ASSERT_TRUE(calls.WaitFor(2, 2s));
+    EXPECT_EQ(watcher.GetStats().notifications, 2u);
+}
+
+TEST(FileWatcherTest, CallbackExceptionDoesNotStopWatching)
+{
+    auto backend = std::make_unique<FakeFileWatchBackend>();
+    auto *fake = backend.get();
+    CallCounter calls;
+    FileWatcher watcher(std::move(backend), 0ms, [&] {
+        calls.Increment();
+        throw std::runtime_error("reload failed");
+    });
+
+    fake->Touch();
+    ASSERT_TRUE(calls.WaitFor(1, 2s));
+    fake->Touch();
+    EXPECT_TRUE(calls.WaitFor(2, 2s));
+}
+
+TEST(FileWatcherTest, DestructorStopsWhileIdle)
+{
+    auto start = std::chrono::steady_clock::now();
+    {
+        FileWatcher watcher(std::make_unique<FakeFileWatchBackend>(), 100ms, [] {});
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+}
+
+TEST(FileWatcherTest, PlatformBackendDetectsWritesToTargetFileOnly)
+{
+    TempDirectory directory("FileWatcherTest");
+    auto target = directory.Path() / "config.json";
+    WriteFile(target, "{}");
+
+    auto backend = CreateFileWatchBackend(target);
+
+    // 同じディレクトリの別のファイルは無視する
+    WriteFile(directory.Path() / "config_backup.json", "{}");
+    EXPECT_FALSE(backend->WaitForChange(200ms));
+
+    WriteFile(target, R"({"brightness_daemon": {}})");
+    EXPECT_TRUE(backend->WaitForChange(2s));
+}
+
+TEST(FileWatcherTest, PlatformBackendDetectsReplaceByRename)
+{
+    TempDirectory directory("FileWatcherTest");
+    auto target = directory.Path() / "config.json";
+    WriteFile(target, "{}");
+
+    auto backend = CreateFileWatchBackend(target);
+
+    // 一時ファイルに書いてから置き換えるエディターの保存方法
+    auto temp = directory.Path() / "config.json.tmp";
+    WriteFile(temp, R"({"monitors": []})");
+    std::filesystem::rename(temp, target);
+
+    EXPECT_TRUE(backend->WaitForChange(2s));
+}
+
+TEST(FileWatcherTest, PlatformBackendCancelWakesWaiter)
+{
+    TempDirectory directory("FileWatcherTest");
+    auto backend = CreateFileWatchBackend(directory.Path() / "config.json");
+
+    std::thread canceller([&] {
+        std::this_thread::sleep_for(50ms);
+        backend->Cancel();
+    });
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(backend->WaitForChange(10s));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 5s);
+    canceller.join();
+}
+
+TEST(FileWatcherTest, PollingBackendDetectsChanges)
+{
+    TempDirectory directory("FileWatcherTest");
+    auto target = directory.Path() / "config.json";
+    WriteFile(target, "{}");
+
+    auto backend = CreatePollingFileWatchBackend(target, 10ms);
+    EXPECT_FALSE(backend->WaitForChange(50ms));
+
+    // サイズが変わる書き込みは更新日時の精度によらず検出できる
+    WriteFile(target, R"({"monitors": []})");
+    EXPECT_TRUE(backend->WaitForChange(2s));
+    EXPECT_FALSE(backend->WaitForChange(50ms));
+}
@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include "HttpClient.h"
+#include "MockHttpServer.h"
+#include <regex>
+#include <set>
+
+class HttpClientTest : public ::testing::Test
+{
+protected:
+    MockHttpServer server{[](const MockHttpServer::Request &) {
+        MockHttpServer::Response response;
+        response.body = R"({"statusCode":100,"body":{"lightLevel":10}})";
+        return response;
+    }};
+
+    std::string Url(const std::string &path = "/v1.1/devices/test/status") const
+    {
+        return server.GetBaseUrl() + path;
+    }
+};
+
+TEST_F(HttpClientTest, ParsesJsonResponse)
+{
+    HttpClient client("test-token", "test-secret");
+    auto response = client.Get(Url());
+    EXPECT_EQ(response["statusCode"].get<int>(), 100);
+    EXPECT_EQ(response["body"]["lightLevel"].get<int>(), 10);
+}
+
+TEST_F(HttpClientTest, ReusesConnectionAcrossRequests)
+{
+    HttpClient client("test-token", "test-secret");
+    for (int i = 0; i < 5; ++i)
+    {
+        client.Get(Url());
+    }
+
+    EXPECT_EQ(server.GetRequestCount(), 5u);
+    EXPECT_EQ(server.GetConnectionCount(), 1u);
+
+    auto stats = client.GetStats();
+    EXPECT_EQ(stats.requests, 5u);
+    EXPECT_EQ(stats.newConnections, 1u);
+    EXPECT_EQ(stats.reusedConnections, 4u);
+    EXPECT_DOUBLE_EQ(stats.ReuseRate(), 0.8);
+}
+
+TEST_F(HttpClientTest, ClientsShareConnectionCache)
+{
+    HttpClient first("test-token", "test-secret");
+    HttpClient second("test-token", "test-secret");
+
+    first.Get(Url());
+    second.Get(Url());
+    first.Get(Url());
+
+    // 別のセンサーのクライアントでも同じ接続が使われる
+    EXPECT_EQ(server.GetConnectionCount(), 1u);
+    EXPECT_EQ(second.GetStats().reusedConnections, 1u);
+}
+
+TEST_F(HttpClientTest, ReconnectsWhenServerClosesConnection)
+{
+    server.SetHandler([](const MockHttpServer::Request &) {
+        MockHttpServer::Response response;
+        response.closeConnection = true;
+        return response;
+    });
+
+    HttpClient client("test-token", "test-secret");
+    client.Get(Url());
+    client.Get(Url());
+
+    EXPECT_EQ(server.GetConnectionCount(), 2u);
+    EXPECT_EQ(client.GetStats().newConnections, 2u);
+}
+
+TEST_F(HttpClientTest, SendsSignedHeadersWithFreshNonce)
+{
+    HttpClient client("test-token", "test-secret");
+    client.Get(Url());
+    client.Get(Url());
+
+    auto requests = server.GetRequests();
+    ASSERT_EQ(requests.size(), 2u);
+
+    const std::regex uuid("[0-9a-f]{8}-[0-9a-f]{4}-4[0-9a-f]{3}-[89ab][0-9a-f]{3}-[0-9a-f]{12}");
+    std::set<std::string> nonces;
+    for (const auto &request : requests)
+    {
+        EXPECT_EQ(request.GetHeader("authorization"), "test-token");
+        EXPECT_EQ(request.GetHeader("content-type"), "application/json");
+        EXPECT_FALSE(request.GetHeader("t").empty());
+        EXPECT_FALSE(request.GetHeader("sign").empty());
+        EXPECT_TRUE(std::regex_match(request.GetHeader("nonce"), uuid)) << request.GetHeader("nonce");
+        nonces.insert(request.GetHeader("nonce"));
+    }
+    EXPECT_EQ(nonces.size(), 2u);
+}
+
+TEST_F(HttpClientTest, HttpErrorThrowsAndIsCounted)
+{
+    server.SetHandler([](const MockHttpServer::Request &) {
+        MockHttpServer::Response response;
+        response.status = 401;
+        return response;
+    });
+
+    HttpClient client("test-token", "test-secret");
+    EXPECT_THROW(client.Get(Url()), HttpException);
+    EXPECT_EQ(client.GetStats().failures, 1u);
+}
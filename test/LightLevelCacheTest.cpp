@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include "LightLevelCache.h"
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+class LightLevelCacheTest : public ::testing::Test
+{
+protected:
+    LightLevelCache::Clock::time_point now = LightLevelCache::Clock::time_point{} + 1h;
+    std::atomic<int> fetchCount{0};
+    std::atomic<int> nextValue{10};
+    std::atomic<bool> failFetch{false};
+
+    LightLevelCache::TimeSource Now()
+    {
+        return [this] { return now; };
+    }
+
+    LightLevelCache::Fetcher Fetcher()
+    {
+        return [this] {
+            ++fetchCount;
+            if (failFetch) {
+                throw std::runtime_error("fetch failed");
+            }
+            return nextValue.load();
+        };
+    }
+
+    static CachePolicy Policy(std::chrono::milliseconds ttl, std::chrono::milliseconds stale)
+    {
+        CachePolicy policy;
+        policy.ttl = ttl;
+        policy.staleWhileRevalidate = stale;
+        return policy;
+    }
+
+    // 裏での再取得が終わるまで待つ
+    static void WaitForRefresh(const LightLevelCache &cache, uint64_t expected)
+    {
+        auto deadline = std::chrono::steady_clock::now() + 5s;
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            auto stats = cache.GetStats();
+            if (stats.refreshes + stats.refreshFailures >= expected)
+            {
+                return;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        FAIL() << "background refresh did not finish";
+    }
+};
+
+TEST_F(LightLevelCacheTest, ServesFreshValueWithinTtl)
+{
+    LightLevelCache cache(Fetcher(), Policy(60s, 300s), Now());
+
+    EXPECT_EQ(cache.Get(), 10);
+    nextValue = 20;
+    now += 59s;
+    EXPECT_EQ(cache.Get(), 10);
+
+    EXPECT_EQ(fetchCount, 1);
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_DOUBLE_EQ(stats.HitRate(), 0.5);
+}
+
+TEST_F(LightLevelCacheTest, ServesStaleValueWhileRevalidating)
+{
+    LightLevelCache cache(Fetcher(), Policy(60s, 300s), Now());
+    EXPECT_EQ(cache.Get(), 10);
+
+    nextValue = 20;
+    now += 61s;
+    // 古い値がすぐに返り、裏で再取得される
+    EXPECT_EQ(cache.Get(), 10);
+    WaitForRefresh(cache, 1);
+
+    EXPECT_EQ(cache.Get(), 20);
+    EXPECT_EQ(fetchCount, 2);
+    auto stats = cache.GetStats();
+    EXPECT_EQ(stats.staleHits, 1u);
+    EXPECT_EQ(stats.refreshes, 1u);
+    EXPECT_EQ(stats.hits, 1u);
+}
+
+TEST_F(LightLevelCacheTest, KeepsStaleValueWhenRefreshFails)
+{
+    LightLevelCache cache(Fetcher(), Policy(60s, 300s), Now());
+    EXPECT_EQ(cache.Get(), 10);
+
+    failFetch = true;
+    now += 61s;
+    EXPECT_EQ(cache.Get(), 10);
+    WaitForRefresh(cache, 1);
+
+    // 失敗しても古い値を返し、再取得を再び試みる
+    EXPECT_EQ(cache.Get(), 10);
+    WaitForRefresh(cache, 2);
+    EXPECT_EQ(cache.GetStats().refreshFailures, 2u);
+}
+
+TEST_F(LightLevelCacheTest, FetchesInlineAfterStaleWindow)
+{
+    LightLevelCache cache(Fetcher(), Policy(60s, 300s), Now());
+    EXPECT_EQ(cache.Get(), 10);
+
+    nextValue = 30;
+    now += 361s;
+    EXPECT_EQ(cache.Get(), 30);
+
+    failFetch = true;
+    now += 361s;
+    EXPECT_THROW(cache.Get(), std::runtime_error);
+    EXPECT_EQ(cache.GetStats().misses, 3u);
+}
+
+TEST_F(LightLevelCacheTest, FallbackValueExpiresAfterMaxAge)
+{
+    auto policy = Policy(60s, 300s);
+    policy.maxFallbackAge = 900s;
+    LightLevelCache cache(Fetcher(), policy, Now());
+    EXPECT_FALSE(cache.GetFallbackValue().has_value());
+    EXPECT_EQ(cache.Get(), 10);
+
+    // 取得期間を過ぎて取得に失敗しても、最大期間内は最後の値を代わりに使える
+    failFetch = true;
+    now += 361s;
+    EXPECT_THROW(cache.Get(), std::runtime_error);
+    EXPECT_EQ(cache.GetFallbackValue(), 10);
+
+    // 応答しなくなったセンサーの値をいつまでも使い続けない
+    now += 539s;
+    EXPECT_THROW(cache.Get(), std::runtime_error);
+    EXPECT_FALSE(cache.GetFallbackValue().has_value());
+
+    // 再び取得できれば代替値も新しくなる
+    failFetch = false;
+    nextValue = 40;
+    EXPECT_EQ(cache.Get(), 40);
+    EXPECT_EQ(cache.GetFallbackValue(), 40);
+}
+
+TEST_F(LightLevelCacheTest, ZeroTtlDisablesCaching)
+{
+    LightLevelCache cache(Fetcher(), Policy(0ms, 300s), Now());
+
+    cache.Get();
+    cache.Get();
+    EXPECT_EQ(fetchCount, 2);
+    EXPECT_EQ(cache.GetStats().hits, 0u);
+}
+
+TEST_F(LightLevelCacheTest, ConcurrentMissesFetchOnce)
+{
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    LightLevelCache cache([&] {
+        ++fetchCount;
+        released.wait();
+        return 42;
+    }, Policy(60s, 0ms), Now());
+
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 4; ++i)
+    {
+        results.push_back(std::async(std::launch::async, [&cache] { return cache.Get(); }));
+    }
+    std::this_thread::sleep_for(50ms);
+    release.set_value();
+
+    for (auto &result : results)
+    {
+        EXPECT_EQ(result.get(), 42);
+    }
+    EXPECT_EQ(fetchCount, 1);
+}
+
+TEST_F(LightLevelCacheTest, InvalidateForcesFetch)
+{
+    LightLevelCache cache(Fetcher(), Policy(60s, 300s), Now());
+    cache.Get();
+    nextValue = 50;
+    cache.Invalidate();
+    EXPECT_EQ(cache.Get(), 50);
+}
+
+TEST_F(LightLevelCacheTest, RejectsNegativePolicy)
+{
+    EXPECT_THROW(LightLevelCache(Fetcher(), Policy(-1ms, 0ms)), std::invalid_argument);
+}
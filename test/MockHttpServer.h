@@ -0,0 +1,288 @@
+#ifndef DISPLAYCONTROLLER_TEST_MOCK_HTTP_SERVER_H
+#define DISPLAYCONTROLLER_TEST_MOCK_HTTP_SERVER_H
+
+// テスト用のローカルHTTPサーバー
+// 127.0.0.1の空いているポートで待ち受け、HTTP/1.1のkeep-aliveに対応する。
+// 受け付けた接続数とリクエストを記録し、応答はハンドラーで差し替えられる。
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "Ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class MockHttpServer
+{
+public:
+    struct Request
+    {
+        std::string method;
+        std::string path;
+        std::map<std::string, std::string> headers;   // ヘッダー名は小文字
+
+        std::string GetHeader(const std::string &name) const
+        {
+            auto it = headers.find(name);
+            return it == headers.end() ? std::string() : it->second;
+        }
+    };
+
+    struct Response
+    {
+        int status = 200;
+        std::string body = "{}";
+        bool closeConnection = false;   // 応答後に接続を閉じる
+        bool dropConnection = false;    // 応答せずに接続を閉じる（障害の模擬）
+    };
+
+    using Handler = std::function<Response(const Request &)>;
+
+    explicit MockHttpServer(Handler handler = nullptr)
+        : m_handler(std::move(handler))
+    {
+#ifdef _WIN32
+        WSADATA wsaData;
+        WSAStartup(MAKEWORD(2, 2), &wsaData);
+#endif
+        m_listenSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (m_listenSocket == kInvalidSocket)
+        {
+            throw std::runtime_error("socket() failed");
+        }
+
+        int reuse = 1;
+        setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char *>(&reuse), sizeof(reuse));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        if (bind(m_listenSocket, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 ||
+            listen(m_listenSocket, 16) != 0)
+        {
+            CloseSocket(m_listenSocket);
+            throw std::runtime_error("bind()/listen() failed");
+        }
+
+        socklen_t length = sizeof(address);
+        getsockname(m_listenSocket, reinterpret_cast<sockaddr *>(&address), &length);
+        m_port = ntohs(address.sin_port);
+
+        m_acceptThread = std::thread(&MockHttpServer::AcceptLoop, this);
+    }
+
+    ~MockHttpServer()
+    {
+        m_stopping = true;
+#ifdef _WIN32
+        closesocket(m_listenSocket);
+#else
+        shutdown(m_listenSocket, SHUT_RDWR);
+        close(m_listenSocket);
+#endif
+        if (m_acceptThread.joinable())
+        {
+            m_acceptThread.join();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto client : m_clients)
+            {
+#ifdef _WIN32
+                shutdown(client, SD_BOTH);
+#else
+                shutdown(client, SHUT_RDWR);
+#endif
+            }
+        }
+        for (auto &thread : m_clientThreads)
+        {
+            if (thread.joinable())
+            {
+                thread.join();
+            }
+        }
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+
+    MockHttpServer(const MockHttpServer &) = delete;
+    MockHttpServer &operator=(const MockHttpServer &) = delete;
+
+    uint16_t GetPort() const { return m_port; }
+    std::string GetBaseUrl() const { return "http://127.0.0.1:" + std::to_string(m_port); }
+
+    void SetHandler(Handler handler)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_handler = std::move(handler);
+    }
+
+    size_t GetConnectionCount() const { return m_connections; }
+
+    size_t GetRequestCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_requests.size();
+    }
+
+    std::vector<Request> GetRequests() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_requests;
+    }
+
+private:
+#ifdef _WIN32
+    using Socket = SOCKET;
+    static constexpr Socket kInvalidSocket = INVALID_SOCKET;
+    static void CloseSocket(Socket socket) { closesocket(socket); }
+#else
+    using Socket = int;
+    static constexpr Socket kInvalidSocket = -1;
+    static void CloseSocket(Socket socket) { close(socket); }
+#endif
+
+    void AcceptLoop()
+    {
+        while (!m_stopping)
+        {
+            Socket client = accept(m_listenSocket, nullptr, nullptr);
+            if (client == kInvalidSocket)
+            {
+                continue;
+            }
+            if (m_stopping)
+            {
+                CloseSocket(client);
+                break;
+            }
+
+            ++m_connections;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_clients.push_back(client);
+            m_clientThreads.emplace_back(&MockHttpServer::ServeClient, this, client);
+        }
+    }
+
+    void ServeClient(Socket client)
+    {
+        std::string buffer;
+        char chunk[4096];
+        while (!m_stopping)
+        {
+            size_t headerEnd = buffer.find("\r\n\r\n");
+            if (headerEnd == std::string::npos)
+            {
+                auto received = recv(client, chunk, static_cast<int>(sizeof(chunk)), 0);
+                if (received <= 0)
+                {
+                    break;
+                }
+                buffer.append(chunk, static_cast<size_t>(received));
+                continue;
+            }
+
+            Request request = ParseRequest(buffer.substr(0, headerEnd));
+            buffer.erase(0, headerEnd + 4);
+
+            Handler handler;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_requests.push_back(request);
+                handler = m_handler;
+            }
+
+            Response response = handler ? handler(request) : Response();
+            if (response.dropConnection)
+            {
+                break;
+            }
+
+            std::string reply = "HTTP/1.1 " + std::to_string(response.status) + " Mock\r\n"
+                "Content-Type: application/json\r\n"
+                "Content-Length: " + std::to_string(response.body.size()) + "\r\n" +
+                (response.closeConnection ? "Connection: close\r\n" : "Connection: keep-alive\r\n") +
+                "\r\n" + response.body;
+            send(client, reply.data(), static_cast<int>(reply.size()), 0);
+
+            if (response.closeConnection)
+            {
+                break;
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_clients.erase(std::remove(m_clients.begin(), m_clients.end(), client), m_clients.end());
+        }
+        CloseSocket(client);
+    }
+
+    static Request ParseRequest(const std::string &head)
+    {
+        Request request;
+        size_t lineEnd = head.find("\r\n");
+        std::string requestLine = head.substr(0, lineEnd);
+        size_t firstSpace = requestLine.find(' ');
+        size_t secondSpace = requestLine.find(' ', firstSpace + 1);
+        request.method = requestLine.substr(0, firstSpace);
+        request.path = requestLine.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+
+        size_t position = lineEnd == std::string::npos ? head.size() : lineEnd + 2;
+        while (position < head.size())
+        {
+            size_t next = head.find("\r\n", position);
+            if (next == std::string::npos)
+            {
+                next = head.size();
+            }
+            std::string line = head.substr(position, next - position);
+            size_t colon = line.find(':');
+            if (colon != std::string::npos)
+            {
+                std::string name = line.substr(0, colon);
+                std::transform(name.begin(), name.end(), name.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                std::string value = line.substr(colon + 1);
+                value.erase(0, value.find_first_not_of(' '));
+                request.headers[name] = value;
+            }
+            position = next + 2;
+        }
+        return request;
+    }
+
+    Handler m_handler;
+    Socket m_listenSocket = kInvalidSocket;
+    uint16_t m_port = 0;
+    std::atomic<bool> m_stopping{false};
+    std::atomic<size_t> m_connections{0};
+    std::thread m_acceptThread;
+
+    mutable std::mutex m_mutex;
+    std::vector<Request> m_requests;
+    std::vector<Socket> m_clients;
+    std::vector<std::thread> m_clientThreads;
+};
+
+#endif // DISPLAYCONTROLLER_TEST_MOCK_HTTP_SERVER_H
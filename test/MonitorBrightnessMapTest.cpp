@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "MonitorBrightnessMap.h"
+#include <cstdint>
+
+namespace
+{
+    MonitorId MakeId(uintptr_t value)
+    {
+        return reinterpret_cast<MonitorId>(value);
+    }
+
+    MonitorBrightnessRange MakeRange(int min, int max)
+    {
+        MonitorBrightnessRange range;
+        range.min = min;
+        range.max = max;
+        return range;
+    }
+
+    int Map(const MonitorBrightnessMap &map, MonitorId id, int level)
+    {
+        return MonitorBrightnessMap::Map(map.Find(id), level);
+    }
+}
+
+TEST(MonitorBrightnessMapTest, UnconfiguredMonitorsUseGlobalRange)
+{
+    MonitorBrightnessMap map(20, 80, {}, {{MakeId(1), {"ID-1", "DELL P2419H"}}});
+
+    EXPECT_EQ(Map(map, MakeId(1), 0), 20);
+    EXPECT_EQ(Map(map, MakeId(1), 50), 50);
+    EXPECT_EQ(Map(map, MakeId(2), 100), 80);
+    // 範囲外の照度は0-100に丸める
+    EXPECT_EQ(Map(map, MakeId(2), 150), 80);
+    EXPECT_EQ(Map(map, MakeId(2), -10), 20);
+}
+
+TEST(MonitorBrightnessMapTest, ScalesGlobalMappingIntoMonitorRange)
+{
+    MonitorBrightnessMap::ProfileTable profiles;
+    profiles["Left"].range = MakeRange(10, 60);
+
+    MonitorBrightnessMap map(0, 100, profiles, {{MakeId(1), {"ID-1", "Left"}}, {MakeId(2), {"ID-2", "Right"}}});
+
+    EXPECT_EQ(Map(map, MakeId(1), 0), 10);
+    EXPECT_EQ(Map(map, MakeId(1), 50), 35);
+    EXPECT_EQ(Map(map, MakeId(1), 100), 60);
+    EXPECT_EQ(Map(map, MakeId(2), 50), 50);
+}
+
+TEST(MonitorBrightnessMapTest, CurveReplacesGlobalLinearMapping)
+{
+    MonitorBrightnessMap::ProfileTable profiles;
+    profiles["Left"].curve = {{100, 100}, {0, 0}, {50, 80}};
+    profiles["Left"].range = MakeRange(0, 50);
+
+    MonitorBrightnessMap map(20, 100, profiles, {{MakeId(1), {"ID-1", "Left"}}});
+
+    EXPECT_EQ(Map(map, MakeId(1), 0), 0);
+    EXPECT_EQ(Map(map, MakeId(1), 50), 40);
+    EXPECT_EQ(Map(map, MakeId(1), 100), 50);
+}
+
+TEST(MonitorBrightnessMapTest, TableMatchesReferenceComposition)
+{
+    MonitorBrightnessMap::ProfileTable profiles;
+    profiles["Left"].curve = {{0, 5}, {30, 40}, {70, 60}, {100, 95}};
+    profiles["Left"].range = MakeRange(15, 85);
+    MonitorBrightnessMap map(0, 100, profiles, {{MakeId(1), {"ID-1", "Left"}}});
+
+    MappingConfig curve;
+    curve.mappingPoints = profiles["Left"].curve;
+    for (int level = 0; level <= 100; ++level)
+    {
+        int brightness = MapBrightnessReference(curve, level);
+        int expected = static_cast<int>(15 + (brightness / 100.0) * 70);
+        EXPECT_EQ(Map(map, MakeId(1), level), expected) << "level " << level;
+    }
+}
+
+TEST(MonitorBrightnessMapTest, CarriesAssignedSensor)
+{
+    MonitorBrightnessMap::ProfileTable profiles;
+    profiles["Left"].sensor = "Window";
+
+    MonitorBrightnessMap map(0, 100, profiles, {{MakeId(1), {"ID-1", "Left"}}, {MakeId(2), {"ID-2", "Left"}}});
+
+    EXPECT_EQ(map.Find(MakeId(1)).sensor, "Window");
+    EXPECT_EQ(map.Find(MakeId(2)).sensor, "Window");
+    EXPECT_TRUE(map.Find(MakeId(3)).sensor.empty());
+}
+
+TEST(MonitorBrightnessMapTest, ProfilesFollowMonitorKeysAcrossIds)
+{
+    // ディスプレイ構成の変更でIDが変わっても、同じキーのモニターには同じ変換表を使う
+    MonitorBrightnessMap::ProfileTable profiles;
+    profiles["Left"].range = MakeRange(30, 40);
+
+    MonitorBrightnessMap before(0, 100, profiles, {{MakeId(1), {"DEL-A0C4-7MT0195R1BPL", "Left"}}});
+    MonitorBrightnessMap after(0, 100, profiles, {{MakeId(7), {"DEL-A0C4-7MT0195R1BPL", "Left"}}});
+
+    EXPECT_EQ(Map(before, MakeId(1), 100), 40);
+    EXPECT_EQ(Map(after, MakeId(7), 100), 40);
+    EXPECT_EQ(Map(after, MakeId(1), 100), 100);
+}
+
+TEST(MonitorBrightnessMapTest, IdentityKeyTakesPrecedenceOverName)
+{
+    // 同じ型番のモニターは名前が同じでも、識別子の設定で個別に変換する
+    MonitorBrightnessMap::ProfileTable profiles;
+    profiles["DEL-A0C4-7MT0195R1BPL"].range = MakeRange(10, 20);
+    profiles["DELL P2419H"].range = MakeRange(30, 40);
+
+    MonitorBrightnessMap map(0, 100, profiles,
+                             {{MakeId(1), {"DEL-A0C4-7MT0195R1BPL", "DELL P2419H"}},
+                              {MakeId(2), {"DEL-A0C4-7MT0195R2CQM", "DELL P2419H"}},
+                              {MakeId(3), {"GSM-5B09@DISPLAY3", "LG ULTRAFINE"}}});
+
+    EXPECT_EQ(Map(map, MakeId(1), 100), 20);
+    // 識別子の設定がなければ、以前の設定ファイルと同じくモニター名の設定を使う
+    EXPECT_EQ(Map(map, MakeId(2), 100), 40);
+    EXPECT_EQ(Map(map, MakeId(3), 100), 100);
+}
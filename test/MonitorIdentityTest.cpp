@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "MonitorIdentity.h"
+#include "MonitorMappingRegistry.h"
+#include "EdidSamples.h"
+#include "TestSupport.h"
+#include <fstream>
+
+namespace
+{
+    const char *kDisplayPort = R"(\\?\DISPLAY#DEL40F3#5&1a2b3c4d&0&UID4352#{e6f07b5f-ee97-4a90-b076-33f57bf4eaa7})";
+    const char *kHdmi = R"(\\?\DISPLAY#DEL40F3#5&1a2b3c4d&0&UID4353#{e6f07b5f-ee97-4a90-b076-33f57bf4eaa7})";
+
+    MappingConfig MakeMapping()
+    {
+        MappingConfig config;
+        config.minBrightness = 10;
+        config.maxBrightness = 90;
+        config.mappingPoints = {{0, 10}, {100, 90}};
+        return config;
+    }
+}
+
+TEST(MonitorIdentityTest, ParsesEdidFields)
+{
+    auto identity = MakeMonitorIdentity(EdidSamples::DellP2419H(), kDisplayPort);
+
+    EXPECT_TRUE(identity.HasEdid());
+    EXPECT_EQ(identity.manufacturer, "DEL");
+    EXPECT_EQ(identity.productCode, 0xA0C4);
+    EXPECT_EQ(identity.serialNumber, 0x4C4C3142u);
+    EXPECT_EQ(identity.serialString, "7MT0195R1BPL");
+    EXPECT_EQ(identity.ToKey(), "DEL-A0C4-7MT0195R1BPL");
+}
+
+TEST(MonitorIdentityTest, SerialNumberKeepsIdentityAcrossConnectors)
+{
+    auto displayPort = MakeMonitorIdentity(EdidSamples::DellP2419H(), kDisplayPort);
+    auto hdmi = MakeMonitorIdentity(EdidSamples::DellP2419H(), kHdmi);
+    EXPECT_EQ(displayPort, hdmi);
+}
+
+TEST(MonitorIdentityTest, MonitorsWithoutSerialAreDistinguishedByConnector)
+{
+    auto first = MakeMonitorIdentity(EdidSamples::LgUltraFine(), kDisplayPort);
+    auto second = MakeMonitorIdentity(EdidSamples::LgUltraFine(), kHdmi);
+
+    EXPECT_EQ(first.manufacturer, "GSM");
+    EXPECT_EQ(first.productCode, 0x5B09);
+    EXPECT_FALSE(first.HasSerial());
+    EXPECT_NE(first, second);
+    EXPECT_EQ(first.ToKey(), std::string("GSM-5B09@") + kDisplayPort);
+}
+
+TEST(MonitorIdentityTest, InvalidEdidFallsBackToConnector)
+{
+    auto corrupted = EdidSamples::DellP2419H();
+    corrupted[20] ^= 0x01;
+    auto truncated = EdidSamples::DellP2419H();
+    truncated.resize(100);
+
+    EXPECT_FALSE(IsValidEdidBaseBlock(corrupted));
+    EXPECT_FALSE(MakeMonitorIdentity(corrupted, kDisplayPort).HasEdid());
+    EXPECT_EQ(MakeMonitorIdentity(truncated, kDisplayPort).ToKey(), std::string("@") + kDisplayPort);
+    EXPECT_EQ(MakeMonitorIdentity({}, "").ToKey(), "@");
+}
+
+TEST(MonitorMappingRegistryTest, SavesAndReloadsByIdentity)
+{
+    TempDirectory directory("MonitorIdentityTest");
+    auto identity = MakeMonitorIdentity(EdidSamples::DellP2419H(), kDisplayPort);
+    {
+        MonitorMappingRegistry registry(directory.Path());
+        registry.SetConfig(identity, MakeMapping());
+        EXPECT_EQ(registry.GetFilePath(identity).filename(), "mapping_DEL-A0C4-7MT0195R1BPL.json");
+    }
+
+    // 接続先が変わっても同じモニターの設定を読み込む
+    MonitorMappingRegistry registry(directory.Path());
+    auto moved = MakeMonitorIdentity(EdidSamples::DellP2419H(), kHdmi);
+    EXPECT_EQ(registry.GetConfig(moved).mappingPoints, MakeMapping().mappingPoints);
+    EXPECT_EQ(registry.Map(moved, 50), 50);
+    EXPECT_EQ(registry.Map(moved, 0), 10);
+}
+
+TEST(MonitorMappingRegistryTest, SharesPrecomputedTable)
+{
+    TempDirectory directory("MonitorIdentityTest");
+    MonitorMappingRegistry registry(directory.Path());
+    auto identity = MakeMonitorIdentity(EdidSamples::DellP2419H(), kDisplayPort);
+    EXPECT_EQ(registry.GetTable(identity), nullptr);
+
+    registry.SetConfig(identity, MakeMapping());
+    auto table = registry.GetTable(identity);
+    ASSERT_NE(table, nullptr);
+    EXPECT_EQ(table->Map(0), 10);
+    // 設定を変更するまでは同じ変換表を返す
+    EXPECT_EQ(registry.GetTable(identity), table);
+}
+
+TEST(MonitorMappingRegistryTest, UnknownMonitorUsesLinearMapping)
+{
+    TempDirectory directory("MonitorIdentityTest");
+    MonitorMappingRegistry registry(directory.Path());
+    auto identity = MakeMonitorIdentity(EdidSamples::LgUltraFine(), kDisplayPort);
+
+    EXPECT_EQ(registry.Map(identity, 37), 37);
+    EXPECT_TRUE(registry.GetConfig(identity).mappingPoints.empty());
+    // 参照しただけではファイルを作らない
+    EXPECT_TRUE(std::filesystem::is_empty(directory.Path()));
+}
+
+TEST(MonitorMappingRegistryTest, LoadsFilesLazily)
+{
+    TempDirectory directory("MonitorIdentityTest");
+    auto identity = MakeMonitorIdentity(EdidSamples::DellP2419H(), kDisplayPort);
+    MonitorMappingRegistry registry(directory.Path());
+    EXPECT_EQ(registry.Map(identity, 0), 0);
+
+    // 設定がないことも記録するため、後から置かれたファイルはClear()まで読まない
+    MonitorMappingRegistry writer(directory.Path());
+    writer.SetConfig(identity, MakeMapping());
+    EXPECT_EQ(registry.Map(identity, 0), 0);
+    registry.Clear();
+    EXPECT_EQ(registry.Map(identity, 0), 10);
+}
+
+TEST(MonitorMappingRegistryTest, SanitizesConnectorInFileName)
+{
+    TempDirectory directory("MonitorIdentityTest");
+    MonitorMappingRegistry registry(directory.Path());
+    auto identity = MakeMonitorIdentity(EdidSamples::LgUltraFine(), kDisplayPort);
+
+    auto name = registry.GetFilePath(identity).filename().string();
+    EXPECT_EQ(name.find_first_of("\\?#{}&@"), std::string::npos);
+    registry.SetConfig(identity, MakeMapping());
+    EXPECT_TRUE(std::filesystem::exists(registry.GetFilePath(identity)));
+}
+
+TEST(MonitorMappingRegistryTest, MigratesLegacyHandleFile)
+{
+    TempDirectory directory("MonitorIdentityTest");
+    {
+        std::ofstream legacy(directory.Path() / "mapping_65537.json");
+        legacy << R"({"minBrightness": 0, "maxBrightness": 100, "mappingPoints": [{"input": 0, "output": 30}, {"input": 100, "output": 80}]})";
+    }
+    {
+        std::ofstream stale(directory.Path() / "mapping_131073.json");
+        stale << "{}";
+    }
+
+    MonitorMappingRegistry registry(directory.Path());
+    auto dell = MakeMonitorIdentity(EdidSamples::DellP2419H(), kDisplayPort);
+    registry.MigrateLegacyFile(dell, "mapping_65537.json");
+
+    EXPECT_EQ(registry.Map(dell, 0), 30);
+    EXPECT_FALSE(std::filesystem::exists(directory.Path() / "mapping_65537.json"));
+
+    // 既に設定のあるモニターでは古いファイルを削除するだけ
+    registry.MigrateLegacyFile(dell, "mapping_131073.json");
+    EXPECT_FALSE(std::filesystem::exists(directory.Path() / "mapping_131073.json"));
+    EXPECT_EQ(registry.Map(dell, 0), 30);
+}
@@ -0,0 +1,226 @@
+#include <gtest/gtest.h>
+#include "MonitorTopology.h"
+#include <atomic>
+#include <cstdint>
+#include <set>
+#include <thread>
+
+namespace
+{
+    MonitorId MakeMonitorId(std::uintptr_t value)
+    {
+        return reinterpret_cast<MonitorId>(value);
+    }
+
+    MonitorTopology::Monitor MakeMonitor(std::uintptr_t value, const std::wstring &name)
+    {
+        MonitorTopology::Monitor monitor;
+        monitor.id = MakeMonitorId(value);
+        monitor.name = name;
+        monitor.identity = MakeMonitorIdentity(nullptr, "connector" + std::to_string(value));
+        return monitor;
+    }
+
+    std::shared_ptr<const BrightnessLookupTable> MakeTable(int minBrightness, int maxBrightness)
+    {
+        MappingConfig config;
+        config.minBrightness = minBrightness;
+        config.maxBrightness = maxBrightness;
+        config.mappingPoints = {{0, minBrightness}, {100, maxBrightness}};
+        return std::make_shared<const BrightnessLookupTable>(config);
+    }
+
+    // ハンドルの開閉を記録する偽のDDCバックエンド
+    class FakeMonitorBackend : public IMonitorBackend
+    {
+    public:
+        PhysicalMonitorHandle OpenPhysicalMonitor(MonitorId id) override
+        {
+            openHandles.insert(id);
+            return id;
+        }
+
+        void ClosePhysicalMonitor(PhysicalMonitorHandle handle) override { openHandles.erase(handle); }
+
+        bool GetBrightness(PhysicalMonitorHandle, unsigned long &minValue, unsigned long &currentValue, unsigned long &maxValue) override
+        {
+            minValue = 0;
+            currentValue = 50;
+            maxValue = 100;
+            return true;
+        }
+
+        bool SetBrightness(PhysicalMonitorHandle, unsigned long) override { return true; }
+
+        bool GetContrast(PhysicalMonitorHandle, unsigned long &, unsigned long &, unsigned long &) override { return false; }
+
+        std::set<PhysicalMonitorHandle> openHandles;
+    };
+}
+
+TEST(MonitorTopologyTest, FindsMonitorsById)
+{
+    MonitorTopology topology({MakeMonitor(1, L"A"), MakeMonitor(2, L"B")}, 7);
+
+    ASSERT_EQ(topology.GetIds().size(), 2u);
+    EXPECT_EQ(topology.GetIds()[0], MakeMonitorId(1));
+    EXPECT_EQ(topology.GetIds()[1], MakeMonitorId(2));
+    EXPECT_EQ(topology.GetGeneration(), 7u);
+
+    const auto *monitor = topology.Find(MakeMonitorId(2));
+    ASSERT_NE(monitor, nullptr);
+    EXPECT_EQ(monitor->name, L"B");
+    EXPECT_EQ(topology.Find(MakeMonitorId(3)), nullptr);
+}
+
+TEST(MonitorTopologyTest, MapsLinearlyWithoutMapping)
+{
+    auto monitor = MakeMonitor(1, L"A");
+    EXPECT_EQ(monitor.MapBrightness(42), 42);
+    EXPECT_FALSE(monitor.SupportsBrightness());
+
+    monitor.mapping = MakeTable(20, 80);
+    EXPECT_EQ(monitor.MapBrightness(0), 20);
+    EXPECT_EQ(monitor.MapBrightness(100), 80);
+}
+
+TEST(MonitorTopologyTest, WithMappingReplacesOnlyTargetMonitor)
+{
+    MonitorTopology topology({MakeMonitor(1, L"A"), MakeMonitor(2, L"B")}, 3);
+    auto updated = topology.WithMapping(MakeMonitorId(2), MakeTable(10, 90));
+
+    EXPECT_EQ(updated->GetGeneration(), 3u);
+    EXPECT_EQ(updated->Find(MakeMonitorId(1))->mapping, nullptr);
+    EXPECT_EQ(updated->Find(MakeMonitorId(2))->MapBrightness(0), 10);
+    // 元のスナップショットは変更しない
+    EXPECT_EQ(topology.Find(MakeMonitorId(2))->mapping, nullptr);
+}
+
+TEST(MonitorTopologyStoreTest, BuildsOnceUntilInvalidated)
+{
+    int builds = 0;
+    MonitorTopologyStore store([&] {
+        ++builds;
+        return std::vector<MonitorTopology::Monitor>{MakeMonitor(1, L"A")};
+    });
+
+    auto first = store.Get();
+    auto second = store.Get();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(builds, 1);
+
+    store.Invalidate();
+    auto third = store.Get();
+    EXPECT_NE(third, first);
+    EXPECT_EQ(builds, 2);
+    EXPECT_EQ(store.GetBuildCount(), 2u);
+}
+
+TEST(MonitorTopologyStoreTest, ConcurrentReadersShareOneBuild)
+{
+    std::atomic<int> builds{0};
+    MonitorTopologyStore store([&] {
+        ++builds;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return std::vector<MonitorTopology::Monitor>{MakeMonitor(1, L"A")};
+    });
+
+    std::vector<std::thread> threads;
+    std::atomic<int> found{0};
+    for (int i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&] {
+            for (int j = 0; j < 100; ++j)
+            {
+                if (store.Get()->Find(MakeMonitorId(1)))
+                {
+                    ++found;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(builds.load(), 1);
+    EXPECT_EQ(found.load(), 800);
+}
+
+TEST(MonitorTopologyStoreTest, RebuildsWhenInvalidatedDuringBuild)
+{
+    int builds = 0;
+    MonitorTopologyStore *storePtr = nullptr;
+    MonitorTopologyStore store([&] {
+        ++builds;
+        if (builds == 1)
+        {
+            // 列挙中にディスプレイ構成が変わった
+            storePtr->Invalidate();
+            return std::vector<MonitorTopology::Monitor>{MakeMonitor(1, L"old")};
+        }
+        return std::vector<MonitorTopology::Monitor>{MakeMonitor(2, L"new")};
+    });
+    storePtr = &store;
+
+    auto topology = store.Get();
+    EXPECT_EQ(builds, 2);
+    EXPECT_EQ(topology->Find(MakeMonitorId(1)), nullptr);
+    EXPECT_NE(topology->Find(MakeMonitorId(2)), nullptr);
+    EXPECT_EQ(store.Get(), topology);
+}
+
+TEST(MonitorTopologyStoreTest, RetriesAfterBuildFailure)
+{
+    int builds = 0;
+    MonitorTopologyStore store([&] {
+        if (++builds == 1)
+        {
+            throw DisplayControllerException("enumeration failed");
+        }
+        return std::vector<MonitorTopology::Monitor>{MakeMonitor(1, L"A")};
+    });
+
+    EXPECT_THROW(store.Get(), DisplayControllerException);
+    EXPECT_NE(store.Get()->Find(MakeMonitorId(1)), nullptr);
+    EXPECT_EQ(builds, 2);
+}
+
+TEST(MonitorTopologyStoreTest, UpdatesMappingWithoutRebuilding)
+{
+    int builds = 0;
+    MonitorTopologyStore store([&] {
+        ++builds;
+        return std::vector<MonitorTopology::Monitor>{MakeMonitor(1, L"A")};
+    });
+
+    // 作成前の差し替えは次の作成時に読み込まれるため何もしない
+    store.UpdateMapping(MakeMonitorId(1), MakeTable(10, 90));
+    EXPECT_EQ(builds, 0);
+
+    EXPECT_EQ(store.Get()->Find(MakeMonitorId(1))->MapBrightness(0), 0);
+    store.UpdateMapping(MakeMonitorId(1), MakeTable(10, 90));
+    EXPECT_EQ(store.Get()->Find(MakeMonitorId(1))->MapBrightness(0), 10);
+    EXPECT_EQ(builds, 1);
+}
+
+TEST(MonitorTopologyStoreTest, InvalidateReleasesHandles)
+{
+    FakeMonitorBackend backend;
+    PhysicalMonitorCache cache(backend);
+    MonitorTopologyStore store([&] {
+        auto monitor = MakeMonitor(1, L"A");
+        monitor.handle = cache.Acquire(monitor.id);
+        return std::vector<MonitorTopology::Monitor>{monitor};
+    });
+
+    EXPECT_TRUE(store.Get()->Find(MakeMonitorId(1))->SupportsBrightness());
+    EXPECT_EQ(backend.openHandles.size(), 1u);
+
+    // ディスプレイ構成の変更時はキャッシュと一覧の両方が参照を手放し、ハンドルが閉じられる
+    cache.InvalidateAll();
+    EXPECT_EQ(backend.openHandles.size(), 1u);
+    store.Invalidate();
+    EXPECT_TRUE(backend.openHandles.empty());
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include "PhysicalMonitorCache.h"
+#include <cstdint>
+#include <set>
+
+namespace
+{
+    // テスト用のモニターID
+    MonitorId MakeMonitorId(std::uintptr_t value)
+    {
+        return reinterpret_cast<MonitorId>(value);
+    }
+
+    // 呼び出し回数を記録する偽のDDCバックエンド
+    class FakeMonitorBackend : public IMonitorBackend
+    {
+    public:
+        PhysicalMonitorHandle OpenPhysicalMonitor(MonitorId id) override
+        {
+            if (failingMonitors.count(id))
+            {
+                throw DisplayControllerException("open failed");
+            }
+            ++openCount;
+            auto handle = reinterpret_cast<PhysicalMonitorHandle>(nextHandle++);
+            openHandles.insert(handle);
+            return handle;
+        }
+
+        void ClosePhysicalMonitor(PhysicalMonitorHandle handle) override
+        {
+            ++closeCount;
+            openHandles.erase(handle);
+        }
+
+        bool GetBrightness(PhysicalMonitorHandle, unsigned long &minValue, unsigned long &currentValue, unsigned long &maxValue) override
+        {
+            ++rangeQueryCount;
+            if (!supportsBrightness)
+            {
+                return false;
+            }
+            minValue = 10;
+            currentValue = 50;
+            maxValue = 90;
+            return true;
+        }
+
+        bool SetBrightness(PhysicalMonitorHandle, unsigned long) override { return true; }
+
+        bool GetContrast(PhysicalMonitorHandle, unsigned long &, unsigned long &, unsigned long &) override { return false; }
+
+        int openCount = 0;
+        int closeCount = 0;
+        int rangeQueryCount = 0;
+        bool supportsBrightness = true;
+        std::uintptr_t nextHandle = 0x1000;
+        std::set<PhysicalMonitorHandle> openHandles;
+        std::set<MonitorId> failingMonitors;
+    };
+}
+
+class PhysicalMonitorCacheTest : public ::testing::Test
+{
+protected:
+    FakeMonitorBackend backend;
+};
+
+TEST_F(PhysicalMonitorCacheTest, ReusesHandleAndRangeAcrossCalls)
+{
+    PhysicalMonitorCache cache(backend);
+    auto id = MakeMonitorId(1);
+
+    auto first = cache.Acquire(id);
+    auto second = cache.Acquire(id);
+
+    EXPECT_EQ(first->handle, second->handle);
+    EXPECT_TRUE(first->hasBrightnessRange);
+    EXPECT_EQ(first->minBrightness, 10u);
+    EXPECT_EQ(first->maxBrightness, 90u);
+    EXPECT_EQ(backend.openCount, 1);
+    EXPECT_EQ(backend.rangeQueryCount, 1);
+    EXPECT_EQ(cache.GetStats().hits, 1u);
+    EXPECT_EQ(cache.GetStats().misses, 1u);
+}
+
+TEST_F(PhysicalMonitorCacheTest, KeepsSeparateEntriesPerMonitor)
+{
+    PhysicalMonitorCache cache(backend);
+
+    auto a = cache.Acquire(MakeMonitorId(1));
+    auto b = cache.Acquire(MakeMonitorId(2));
+
+    EXPECT_NE(a->handle, b->handle);
+    EXPECT_EQ(cache.Size(), 2u);
+    EXPECT_EQ(backend.openCount, 2);
+}
+
+TEST_F(PhysicalMonitorCacheTest, InvalidateAllReopensHandles)
+{
+    PhysicalMonitorCache cache(backend);
+    auto id = MakeMonitorId(1);
+
+    auto before = cache.Acquire(id)->handle;
+    cache.InvalidateAll();
+    EXPECT_EQ(cache.Size(), 0u);
+    EXPECT_EQ(backend.closeCount, 1);
+
+    auto after = cache.Acquire(id)->handle;
+    EXPECT_NE(before, after);
+    EXPECT_EQ(backend.openCount, 2);
+}
+
+TEST_F(PhysicalMonitorCacheTest, InvalidatedEntryStaysOpenWhileReferenced)
+{
+    PhysicalMonitorCache cache(backend);
+    auto id = MakeMonitorId(1);
+
+    auto entry = cache.Acquire(id);
+    cache.Invalidate(id);
+
+    // 使用中のハンドルは参照が解放されるまで閉じられない
+    EXPECT_EQ(backend.closeCount, 0);
+    EXPECT_EQ(backend.openHandles.count(entry->handle), 1u);
+
+    entry.reset();
+    EXPECT_EQ(backend.closeCount, 1);
+    EXPECT_TRUE(backend.openHandles.empty());
+}
+
+TEST_F(PhysicalMonitorCacheTest, DoesNotCacheMonitorWithoutBrightnessSupport)
+{
+    backend.supportsBrightness = false;
+    PhysicalMonitorCache cache(backend);
+    auto id = MakeMonitorId(1);
+
+    EXPECT_FALSE(cache.Acquire(id)->hasBrightnessRange);
+    EXPECT_EQ(cache.Size(), 0u);
+    EXPECT_TRUE(backend.openHandles.empty());
+
+    // 対応した場合は次回の取得でキャッシュされる
+    backend.supportsBrightness = true;
+    EXPECT_TRUE(cache.Acquire(id)->hasBrightnessRange);
+    EXPECT_EQ(cache.Size(), 1u);
+}
+
+TEST_F(PhysicalMonitorCacheTest, PropagatesOpenFailure)
+{
+    auto id = MakeMonitorId(1);
+    backend.failingMonitors.insert(id);
+    PhysicalMonitorCache cache(backend);
+
+    EXPECT_THROW(cache.Acquire(id), DisplayControllerException);
+    EXPECT_EQ(cache.Size(), 0u);
+}
+
+TEST_F(PhysicalMonitorCacheTest, ClosesAllHandlesOnDestruction)
+{
+    {
+        PhysicalMonitorCache cache(backend);
+        cache.Acquire(MakeMonitorId(1));
+        cache.Acquire(MakeMonitorId(2));
+    }
+    EXPECT_EQ(backend.closeCount, 2);
+    EXPECT_TRUE(backend.openHandles.empty());
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "ResilientFetcher.h"
+#include "SwitchBotException.h"
+#include "HttpClient.h"
+#include "MockHttpServer.h"
+#include <atomic>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// 障害を注入できるローカルのSwitchBot APIに対してリトライとサーキットブレーカーを検証する
+class ResilientFetcherTest : public ::testing::Test
+{
+protected:
+    enum class Fault
+    {
+        None,
+        ServerError,
+        Drop
+    };
+
+    std::atomic<Fault> fault{Fault::None};
+    MockHttpServer server{[this](const MockHttpServer::Request &) {
+        MockHttpServer::Response response;
+        switch (fault.load())
+        {
+        case Fault::ServerError:
+            response.status = 500;
+            break;
+        case Fault::Drop:
+            response.dropConnection = true;
+            break;
+        case Fault::None:
+            response.body = R"({"statusCode":100,"body":{"lightLevel":7}})";
+            break;
+        }
+        return response;
+    }};
+    HttpClient client{"test-token", "test-secret"};
+    ResilientFetcher::Clock::time_point now = ResilientFetcher::Clock::time_point{} + 1h;
+    std::vector<std::pair<CircuitState, CircuitState>> transitions;
+
+    std::unique_ptr<ResilientFetcher> MakeFetcher(int retryCount = 2, double jitter = 0.0)
+    {
+        ResiliencePolicy policy;
+        policy.retryCount = retryCount;
+        policy.initialBackoff = 1s;
+        policy.maxBackoff = 8s;
+        policy.jitter = jitter;
+        policy.openDuration = 30s;
+
+        auto fetcher = std::make_unique<ResilientFetcher>(
+            [this] { return client.Get(server.GetBaseUrl() + "/status")["body"]["lightLevel"].get<int>(); },
+            policy,
+            [this] { return now; },
+            12345);
+        fetcher->GetCircuitBreaker().SetStateListener([this](CircuitState from, CircuitState to) {
+            transitions.emplace_back(from, to);
+        });
+        return fetcher;
+    }
+};
+
+TEST_F(ResilientFetcherTest, BacksOffExponentiallyWithoutCallingApi)
+{
+    auto fetcher = MakeFetcher(5);
+    fault = Fault::ServerError;
+
+    EXPECT_THROW(fetcher->Fetch(), HttpException);
+    EXPECT_EQ(fetcher->GetStats().currentBackoff, 1s);
+
+    // 待機中はAPIを呼ばずに即座に失敗する
+    EXPECT_THROW(fetcher->Fetch(), ServiceUnavailableException);
+    EXPECT_EQ(server.GetRequestCount(), 1u);
+
+    now += 1s;
+    EXPECT_THROW(fetcher->Fetch(), HttpException);
+    EXPECT_EQ(fetcher->GetStats().currentBackoff, 2s);
+
+    now += 2s;
+    EXPECT_THROW(fetcher->Fetch(), HttpException);
+    EXPECT_EQ(fetcher->GetStats().currentBackoff, 4s);
+
+    auto stats = fetcher->GetStats();
+    EXPECT_EQ(stats.attempts, 3u);
+    EXPECT_EQ(stats.failures, 3u);
+    EXPECT_EQ(stats.skipped, 1u);
+    EXPECT_EQ(server.GetRequestCount(), 3u);
+}
+
+TEST_F(ResilientFetcherTest, RecoversAndResetsBackoff)
+{
+    auto fetcher = MakeFetcher(5);
+    fault = Fault::Drop;
+    EXPECT_THROW(fetcher->Fetch(), HttpException);
+
+    fault = Fault::None;
+    now += 1s;
+    EXPECT_EQ(fetcher->Fetch(), 7);
+    EXPECT_EQ(fetcher->Fetch(), 7);
+    EXPECT_EQ(fetcher->GetStats().currentBackoff, 0ms);
+}
+
+TEST_F(ResilientFetcherTest, CircuitOpensDuringOutageAndProbesAfterCooldown)
+{
+    auto fetcher = MakeFetcher(2);
+    fault = Fault::ServerError;
+
+    // retryCount + 1回の連続失敗でOpenになる
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_THROW(fetcher->Fetch(), HttpException);
+        now += 10s;
+    }
+    EXPECT_EQ(fetcher->GetCircuitBreaker().GetState(), CircuitState::Open);
+
+    // Open中はバックオフが過ぎていてもAPIを呼ばない
+    auto requests = server.GetRequestCount();
+    EXPECT_THROW(fetcher->Fetch(), ServiceUnavailableException);
+    EXPECT_EQ(server.GetRequestCount(), requests);
+
+    // 待機時間が過ぎたら1回だけ確認し、成功すればClosedに戻る
+    fault = Fault::None;
+    now += 30s;
+    EXPECT_EQ(fetcher->Fetch(), 7);
+    EXPECT_EQ(fetcher->GetCircuitBreaker().GetState(), CircuitState::Closed);
+
+    std::vector<std::pair<CircuitState, CircuitState>> expected = {
+        {CircuitState::Closed, CircuitState::Open},
+        {CircuitState::Open, CircuitState::HalfOpen},
+        {CircuitState::HalfOpen, CircuitState::Closed}};
+    EXPECT_EQ(transitions, expected);
+
+    auto stats = fetcher->GetStats();
+    EXPECT_EQ(stats.circuit.trips, 1u);
+    EXPECT_EQ(stats.circuit.rejected, 1u);
+}
+
+TEST_F(ResilientFetcherTest, FailedProbeReopensCircuit)
+{
+    auto fetcher = MakeFetcher(0);
+    fault = Fault::Drop;
+
+    EXPECT_THROW(fetcher->Fetch(), HttpException);
+    EXPECT_EQ(fetcher->GetCircuitBreaker().GetState(), CircuitState::Open);
+
+    now += 31s;
+    EXPECT_THROW(fetcher->Fetch(), HttpException);
+    EXPECT_EQ(fetcher->GetCircuitBreaker().GetState(), CircuitState::Open);
+    EXPECT_EQ(fetcher->GetStats().circuit.trips, 2u);
+
+    // 再びOpenになった時点から待機する
+    now += 10s;
+    EXPECT_THROW(fetcher->Fetch(), ServiceUnavailableException);
+}
+
+TEST_F(ResilientFetcherTest, JitterShortensBackoffWithinBounds)
+{
+    auto fetcher = MakeFetcher(10, 0.5);
+    fault = Fault::ServerError;
+
+    for (int i = 1; i <= 4; ++i)
+    {
+        EXPECT_THROW(fetcher->Fetch(), HttpException);
+        auto backoff = fetcher->GetStats().currentBackoff;
+        auto full = ResilientFetcher::BackoffFor(ResiliencePolicy{10, 1s, 8s, 0.5, 30s}, i);
+        EXPECT_LE(backoff, full);
+        EXPECT_GE(backoff, full / 2);
+        now += backoff;
+    }
+}
+
+TEST(ResilientFetcherBackoffTest, CapsAtMaximum)
+{
+    ResiliencePolicy policy;
+    policy.initialBackoff = 1s;
+    policy.maxBackoff = 5s;
+
+    EXPECT_EQ(ResilientFetcher::BackoffFor(policy, 0), 0ms);
+    EXPECT_EQ(ResilientFetcher::BackoffFor(policy, 1), 1s);
+    EXPECT_EQ(ResilientFetcher::BackoffFor(policy, 3), 4s);
+    EXPECT_EQ(ResilientFetcher::BackoffFor(policy, 4), 5s);
+    EXPECT_EQ(ResilientFetcher::BackoffFor(policy, 1000), 5s);
+}
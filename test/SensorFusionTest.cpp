@@ -0,0 +1,326 @@
+#include <gtest/gtest.h>
+#include "SensorFusion.h"
+#include <atomic>
+#include <mutex>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct FakeState
+    {
+        std::mutex mutex;
+        int level = 0;
+        LightSampleQuality quality = LightSampleQuality::Good;
+        Clock::duration age{0};
+        bool hang = false;
+        std::atomic<int> reads{0};
+        std::vector<IAsyncLightSensor::SampleCallback> hanging;
+    };
+
+    // 値・品質・応答の有無をテストから操作できるセンサー（読み取り結果はその場で返す）
+    class FakeAsyncSensor : public IAsyncLightSensor
+    {
+    public:
+        explicit FakeAsyncSensor(std::shared_ptr<FakeState> state) : m_state(std::move(state)) {}
+
+        ~FakeAsyncSensor() override
+        {
+            LightSample stopped;
+            stopped.timestamp = Clock::now();
+            stopped.error = "stopped";
+            for (auto &callback : m_state->hanging)
+            {
+                callback(stopped);
+            }
+        }
+
+        void StartRead(SampleCallback callback) override
+        {
+            ++m_state->reads;
+            LightSample sample;
+            {
+                std::lock_guard<std::mutex> lock(m_state->mutex);
+                if (m_state->hang)
+                {
+                    m_state->hanging.push_back(std::move(callback));
+                    return;
+                }
+                sample.level = m_state->level;
+                sample.quality = m_state->quality;
+                sample.timestamp = Clock::now() - m_state->age;
+                if (sample.quality == LightSampleQuality::Unavailable)
+                {
+                    sample.error = "read failed";
+                }
+            }
+            callback(sample);
+        }
+
+    private:
+        std::shared_ptr<FakeState> m_state;
+    };
+
+    std::shared_ptr<FakeState> MakeState(int level)
+    {
+        auto state = std::make_shared<FakeState>();
+        state->level = level;
+        return state;
+    }
+
+    SensorFusion::Source MakeSource(const std::string &name, std::shared_ptr<FakeState> state, double weight = 1.0)
+    {
+        return {std::make_unique<FakeAsyncSensor>(std::move(state)), name, weight};
+    }
+
+    std::unique_ptr<SensorFusion> MakeFusion(std::vector<std::pair<std::string, std::shared_ptr<FakeState>>> states,
+                                             SensorFusion::Options options = {})
+    {
+        std::vector<SensorFusion::Source> sources;
+        for (auto &[name, state] : states)
+        {
+            sources.push_back(MakeSource(name, state));
+        }
+        return std::make_unique<SensorFusion>(std::move(sources), options);
+    }
+
+    LightSample Read(SensorFusion &fusion)
+    {
+        auto future = fusion.ReadAsync();
+        if (future.wait_for(5s) != std::future_status::ready)
+        {
+            ADD_FAILURE() << "読み取りが完了しませんでした";
+            return {};
+        }
+        return future.get();
+    }
+}
+
+TEST(SensorFusionTest, MedianOfReadings)
+{
+    auto fusion = MakeFusion({{"a", MakeState(10)}, {"b", MakeState(40)}, {"c", MakeState(30)}});
+
+    auto sample = Read(*fusion);
+    EXPECT_EQ(sample.quality, LightSampleQuality::Good);
+    EXPECT_EQ(sample.level, 30);
+    ASSERT_EQ(sample.sources.size(), 3u);
+    EXPECT_EQ(sample.sources[0].name, "a");
+    EXPECT_EQ(sample.sources[1].level, 40);
+}
+
+TEST(SensorFusionTest, WeightedMeanAndMax)
+{
+    auto a = MakeState(20);
+    auto b = MakeState(80);
+
+    SensorFusion::Options options;
+    options.strategy = FusionStrategy::WeightedMean;
+    std::vector<SensorFusion::Source> sources;
+    sources.push_back(MakeSource("a", a, 3.0));
+    sources.push_back(MakeSource("b", b, 1.0));
+    SensorFusion weighted(std::move(sources), options);
+    EXPECT_EQ(Read(weighted).level, 35);
+
+    options.strategy = FusionStrategy::Max;
+    auto max = MakeFusion({{"a", a}, {"b", b}}, options);
+    EXPECT_EQ(Read(*max).level, 80);
+}
+
+TEST(SensorFusionTest, RejectsOutliers)
+{
+    SensorFusion::Options options;
+    options.strategy = FusionStrategy::WeightedMean;
+    auto fusion = MakeFusion({{"a", MakeState(40)}, {"b", MakeState(44)}, {"c", MakeState(42)}, {"lamp", MakeState(100)}}, options);
+
+    auto sample = Read(*fusion);
+    EXPECT_EQ(sample.level, 42);
+    // 外れ値もモニターごとの割り当て用に各センサーの値には残す
+    EXPECT_EQ(sample.sources.size(), 4u);
+
+    auto status = fusion->GetStatus();
+    EXPECT_TRUE(status[3].rejectedAsOutlier);
+    EXPECT_FALSE(status[3].usedInLastRead);
+    EXPECT_TRUE(status[0].usedInLastRead);
+}
+
+TEST(SensorFusionTest, NearlyEqualReadingsAreNotOutliers)
+{
+    // 中央絶対偏差が0でも、最小の差以内の値は除かない
+    SensorFusion::Options options;
+    options.strategy = FusionStrategy::Max;
+    auto fusion = MakeFusion({{"a", MakeState(50)}, {"b", MakeState(50)}, {"c", MakeState(53)}}, options);
+    EXPECT_EQ(Read(*fusion).level, 53);
+}
+
+TEST(SensorFusionTest, DropsFailedAndStaleSensors)
+{
+    auto failed = MakeState(0);
+    failed->quality = LightSampleQuality::Unavailable;
+    auto stale = MakeState(90);
+    stale->age = 10min;
+
+    auto fusion = MakeFusion({{"good", MakeState(30)}, {"failed", failed}, {"stale", stale}});
+    auto sample = Read(*fusion);
+    EXPECT_EQ(sample.level, 30);
+    ASSERT_EQ(sample.sources.size(), 1u);
+    EXPECT_EQ(sample.sources[0].name, "good");
+}
+
+TEST(SensorFusionTest, UnavailableWhenNoSensorIsUsable)
+{
+    auto failed = MakeState(0);
+    failed->quality = LightSampleQuality::Unavailable;
+    auto fusion = MakeFusion({{"failed", failed}});
+
+    auto sample = Read(*fusion);
+    EXPECT_FALSE(sample.IsUsable());
+    EXPECT_FALSE(sample.error.empty());
+}
+
+TEST(SensorFusionTest, CachedReadingsMakeResultStale)
+{
+    auto cached = MakeState(50);
+    cached->quality = LightSampleQuality::Stale;
+    auto fusion = MakeFusion({{"fresh", MakeState(50)}, {"cached", cached}});
+    EXPECT_EQ(Read(*fusion).quality, LightSampleQuality::Stale);
+}
+
+TEST(SensorFusionTest, PreviousValueOfFailedSensorMakesResultDegraded)
+{
+    auto flaky = MakeState(50);
+    auto fusion = MakeFusion({{"good", MakeState(30)}, {"flaky", flaky}});
+    EXPECT_EQ(Read(*fusion).quality, LightSampleQuality::Good);
+
+    // 読み取りに失敗しても前回の値は使うが、今回読み取った値だけではないことを示す
+    {
+        std::lock_guard<std::mutex> lock(flaky->mutex);
+        flaky->quality = LightSampleQuality::Unavailable;
+    }
+    auto sample = Read(*fusion);
+    EXPECT_EQ(sample.level, 40);
+    EXPECT_EQ(sample.sources.size(), 2u);
+    EXPECT_EQ(sample.quality, LightSampleQuality::Degraded);
+    EXPECT_TRUE(sample.IsUsable());
+
+    {
+        std::lock_guard<std::mutex> lock(flaky->mutex);
+        flaky->quality = LightSampleQuality::Good;
+    }
+    EXPECT_EQ(Read(*fusion).quality, LightSampleQuality::Good);
+}
+
+TEST(SensorFusionTest, ReplaceSourceKeepsOtherSensors)
+{
+    auto kept = MakeState(30);
+    auto old = MakeState(50);
+    auto fusion = MakeFusion({{"kept", kept}, {"replaced", old}});
+    EXPECT_EQ(Read(*fusion).level, 40);
+
+    auto replacement = MakeState(70);
+    EXPECT_TRUE(fusion->ReplaceSource(MakeSource("replaced", replacement)));
+    EXPECT_FALSE(fusion->ReplaceSource(MakeSource("missing", MakeState(0))));
+    EXPECT_THROW(fusion->ReplaceSource({nullptr, "replaced", 1.0}), std::invalid_argument);
+
+    // 差し替えたセンサーの以前の値だけを捨てる
+    auto status = fusion->GetStatus();
+    EXPECT_TRUE(status[0].lastSample.has_value());
+    EXPECT_FALSE(status[1].lastSample.has_value());
+
+    EXPECT_EQ(Read(*fusion).level, 50);
+    EXPECT_EQ(kept->reads, 2);
+    EXPECT_EQ(old->reads, 1);
+    EXPECT_EQ(replacement->reads, 1);
+}
+
+TEST(SensorFusionTest, ReplacingHungSourceCompletesPendingRead)
+{
+    auto hung = MakeState(0);
+    hung->hang = true;
+
+    SensorFusion::Options options;
+    options.readTimeout = 1h;
+    auto fusion = MakeFusion({{"good", MakeState(30)}, {"hung", hung}}, options);
+
+    // 応答しないセンサーを差し替えると、進行中の読み取りはそのセンサーを待たずに完了する
+    auto future = fusion->ReadAsync();
+    EXPECT_EQ(future.wait_for(50ms), std::future_status::timeout);
+    EXPECT_TRUE(fusion->ReplaceSource(MakeSource("hung", MakeState(70))));
+    ASSERT_EQ(future.wait_for(5s), std::future_status::ready);
+    auto sample = future.get();
+    EXPECT_EQ(sample.level, 30);
+    EXPECT_EQ(sample.quality, LightSampleQuality::Good);
+
+    // 差し替える前のセンサーが破棄時に返した結果は使わない
+    EXPECT_EQ(Read(*fusion).level, 50);
+}
+
+TEST(SensorFusionTest, HungSensorTimesOutAndIsNotWaitedForAgain)
+{
+    auto hung = MakeState(0);
+    hung->hang = true;
+
+    SensorFusion::Options options;
+    options.readTimeout = 100ms;
+    auto fusion = MakeFusion({{"good", MakeState(30)}, {"hung", hung}}, options);
+
+    auto start = Clock::now();
+    auto sample = Read(*fusion);
+    EXPECT_EQ(sample.level, 30);
+    EXPECT_GE(Clock::now() - start, 90ms);
+
+    // 応答のないセンサーには新しい読み取りを重ねず、待たない
+    start = Clock::now();
+    EXPECT_EQ(Read(*fusion).level, 30);
+    EXPECT_LT(Clock::now() - start, 90ms);
+    EXPECT_EQ(hung->reads, 1);
+}
+
+TEST(SensorFusionTest, SuspendsSensorAfterConsecutiveFailures)
+{
+    auto failing = MakeState(0);
+    failing->quality = LightSampleQuality::Unavailable;
+
+    SensorFusion::Options options;
+    options.maxConsecutiveFailures = 2;
+    options.suspendDuration = 1h;
+    auto fusion = MakeFusion({{"good", MakeState(30)}, {"failing", failing}}, options);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(Read(*fusion).level, 30);
+    }
+    EXPECT_EQ(failing->reads, 2);
+
+    auto status = fusion->GetStatus();
+    EXPECT_TRUE(status[1].suspended);
+    EXPECT_EQ(status[1].failures, 2u);
+}
+
+TEST(SensorFusionTest, DestructionCompletesPendingReads)
+{
+    auto hung = MakeState(0);
+    hung->hang = true;
+
+    SensorFusion::Options options;
+    options.readTimeout = 1h;
+    auto fusion = MakeFusion({{"hung", hung}}, options);
+
+    std::atomic<bool> called{false};
+    fusion->StartRead([&](const LightSample &sample) {
+        EXPECT_FALSE(sample.IsUsable());
+        called = true;
+    });
+    fusion.reset();
+    EXPECT_TRUE(called);
+}
+
+TEST(SensorFusionTest, ParseStrategy)
+{
+    EXPECT_EQ(SensorFusion::ParseStrategy("median"), FusionStrategy::Median);
+    EXPECT_EQ(SensorFusion::ParseStrategy("weighted_mean"), FusionStrategy::WeightedMean);
+    EXPECT_EQ(SensorFusion::ParseStrategy("max"), FusionStrategy::Max);
+    EXPECT_EQ(SensorFusion::ParseStrategy("nearest"), FusionStrategy::Nearest);
+    EXPECT_THROW(SensorFusion::ParseStrategy("mean"), std::invalid_argument);
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include "LatestValueMailbox.h"
+#include "StageMetrics.h"
+#include <atomic>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+TEST(LatestValueMailboxTest, EmptyUntilPublished)
+{
+    LatestValueMailbox<int> mailbox;
+    EXPECT_FALSE(mailbox.HasNew());
+    EXPECT_FALSE(mailbox.TakeLatest().has_value());
+
+    mailbox.Publish(42);
+    EXPECT_TRUE(mailbox.HasNew());
+    EXPECT_EQ(mailbox.TakeLatest(), 42);
+
+    // 同じ値は二度読み取られない
+    EXPECT_FALSE(mailbox.TakeLatest().has_value());
+}
+
+TEST(LatestValueMailboxTest, KeepsOnlyLatestValue)
+{
+    LatestValueMailbox<int> mailbox;
+    mailbox.Publish(1);
+    mailbox.Publish(2);
+    mailbox.Publish(3);
+
+    EXPECT_EQ(mailbox.TakeLatest(), 3);
+    EXPECT_EQ(mailbox.GetOverwrittenCount(), 2u);
+}
+
+TEST(LatestValueMailboxTest, ConcurrentReaderSeesIncreasingValues)
+{
+    struct Sample
+    {
+        int sequence = 0;
+        int check = 0;   // sequenceと対で書き込まれ、値の欠けを検出する
+    };
+
+    LatestValueMailbox<Sample> mailbox;
+    constexpr int kCount = 200000;
+    std::atomic<bool> done{false};
+
+    std::thread producer([&] {
+        for (int i = 1; i <= kCount; ++i)
+        {
+            mailbox.Publish(Sample{i, -i});
+        }
+        done = true;
+    });
+
+    int last = 0;
+    int received = 0;
+    while (true)
+    {
+        bool finished = done;
+        if (auto sample = mailbox.TakeLatest())
+        {
+            ASSERT_EQ(sample->check, -sample->sequence);
+            ASSERT_GT(sample->sequence, last);
+            last = sample->sequence;
+            ++received;
+        }
+        else if (finished)
+        {
+            break;
+        }
+    }
+    producer.join();
+
+    // 最後に書き込まれた値は必ず読み取られる
+    EXPECT_EQ(last, kCount);
+    EXPECT_EQ(static_cast<uint64_t>(received) + mailbox.GetOverwrittenCount(), static_cast<uint64_t>(kCount));
+}
+
+TEST(StageMetricsTest, TracksLatencyAndFailures)
+{
+    StageMetrics metrics;
+    metrics.Record(10ms, true);
+    metrics.Record(30ms, false);
+    metrics.Record(20ms, true);
+
+    auto snapshot = metrics.GetSnapshot();
+    EXPECT_EQ(snapshot.runs, 3u);
+    EXPECT_EQ(snapshot.failures, 1u);
+    EXPECT_EQ(snapshot.lastLatency, 20ms);
+    EXPECT_EQ(snapshot.maxLatency, 30ms);
+    EXPECT_EQ(snapshot.averageLatency, 20ms);
+
+    metrics.Reset();
+    EXPECT_EQ(metrics.GetSnapshot().runs, 0u);
+}
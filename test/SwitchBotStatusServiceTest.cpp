@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+#include "SwitchBotStatusService.h"
+#include "SwitchBotException.h"
+#include "HttpClient.h"
+#include "MockHttpServer.h"
+#include <atomic>
+#include <future>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // パスに含まれるデバイスIDを照度として返すローカルのSwitchBot API
+    MockHttpServer::Response DeviceStatus(const MockHttpServer::Request &request)
+    {
+        // /v1.1/devices/{id}/status
+        std::string path = request.path;
+        std::string prefix = "/v1.1/devices/";
+        std::string id = path.substr(prefix.size(), path.rfind("/status") - prefix.size());
+
+        MockHttpServer::Response response;
+        if (id == "missing")
+        {
+            response.status = 500;
+            return response;
+        }
+        response.body = nlohmann::json{
+            {"statusCode", 100},
+            {"body", {{"deviceId", id}, {"lightLevel", static_cast<int>(id.size())}}}}.dump();
+        return response;
+    }
+}
+
+class SwitchBotStatusServiceTest : public ::testing::Test
+{
+protected:
+    MockHttpServer server{DeviceStatus};
+
+    SwitchBotStatusService::Options MakeOptions(std::chrono::milliseconds window = 100ms, int dailyLimit = 100)
+    {
+        SwitchBotStatusService::Options options;
+        options.baseUrl = server.GetBaseUrl() + "/v1.1/devices/";
+        options.coalesceWindow = window;
+        options.dailyLimit = dailyLimit;
+        return options;
+    }
+};
+
+TEST_F(SwitchBotStatusServiceTest, CoalescesConcurrentPollsIntoOneRound)
+{
+    SwitchBotStatusService service("test-token", "test-secret", MakeOptions(200ms));
+
+    // 2台のデバイスを3つのセンサーから同時に要求する
+    std::vector<std::future<nlohmann::json>> results;
+    for (const std::string id : {"hub-a", "hub-bb", "hub-a"})
+    {
+        results.push_back(std::async(std::launch::async, [&service, id] { return service.FetchStatus(id); }));
+    }
+
+    EXPECT_EQ(results[0].get()["body"]["deviceId"], "hub-a");
+    EXPECT_EQ(results[1].get()["body"]["deviceId"], "hub-bb");
+    EXPECT_EQ(results[2].get()["body"]["deviceId"], "hub-a");
+
+    // 同じデバイスへの要求は1回のAPI呼び出しにまとめられる
+    EXPECT_EQ(server.GetRequestCount(), 2u);
+    auto stats = service.GetStats();
+    EXPECT_EQ(stats.rounds, 1u);
+    EXPECT_EQ(stats.requests, 3u);
+    EXPECT_EQ(stats.coalescedRequests, 1u);
+    EXPECT_EQ(stats.apiCalls, 2u);
+    EXPECT_EQ(service.GetBudgetStats().used, 2);
+}
+
+TEST_F(SwitchBotStatusServiceTest, RoundStartsEarlyWhenAllRegisteredDevicesRequested)
+{
+    SwitchBotStatusService service("test-token", "test-secret", MakeOptions(5s));
+    service.Register("hub-a");
+    service.Register("hub-b");
+
+    auto start = std::chrono::steady_clock::now();
+    auto first = std::async(std::launch::async, [&] { return service.FetchStatus("hub-a"); });
+    auto second = std::async(std::launch::async, [&] { return service.FetchStatus("hub-b"); });
+    first.get();
+    second.get();
+
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 2s);
+    EXPECT_EQ(service.GetStats().rounds, 1u);
+}
+
+TEST_F(SwitchBotStatusServiceTest, FailureIsDeliveredOnlyToThatDevice)
+{
+    SwitchBotStatusService service("test-token", "test-secret", MakeOptions());
+
+    auto good = std::async(std::launch::async, [&] { return service.FetchStatus("hub-a"); });
+    auto bad = std::async(std::launch::async, [&] { return service.FetchStatus("missing"); });
+
+    EXPECT_EQ(good.get()["body"]["deviceId"], "hub-a");
+    EXPECT_THROW(bad.get(), HttpException);
+}
+
+TEST_F(SwitchBotStatusServiceTest, ExhaustedBudgetFailsWithoutCallingApi)
+{
+    SwitchBotStatusService service("test-token", "test-secret", MakeOptions(10ms, 1));
+
+    service.FetchStatus("hub-a");
+    EXPECT_THROW(service.FetchStatus("hub-a"), RateLimitException);
+    EXPECT_EQ(server.GetRequestCount(), 1u);
+    EXPECT_EQ(service.GetBudgetStats().rejected, 1u);
+}
+
+TEST_F(SwitchBotStatusServiceTest, SharedInstancePerToken)
+{
+    auto first = SwitchBotStatusService::ForToken("token-1", "secret", MakeOptions());
+    auto second = SwitchBotStatusService::ForToken("token-1", "secret", MakeOptions());
+    auto other = SwitchBotStatusService::ForToken("token-2", "secret", MakeOptions());
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, other);
+}
+
+TEST(RateLimitBudgetTest, ResetsAtUtcDayBoundary)
+{
+    auto now = RateLimitBudget::Clock::time_point{} + std::chrono::hours(24 * 20000 + 23);
+    RateLimitBudget budget(2, [&now] { return now; });
+
+    EXPECT_TRUE(budget.TryConsume());
+    EXPECT_TRUE(budget.TryConsume());
+    EXPECT_FALSE(budget.TryConsume());
+    EXPECT_EQ(budget.GetRemaining(), 0);
+
+    now += std::chrono::hours(1);
+    EXPECT_EQ(budget.GetRemaining(), 2);
+    EXPECT_TRUE(budget.TryConsume());
+
+    auto stats = budget.GetStats();
+    EXPECT_EQ(stats.used, 1);
+    EXPECT_EQ(stats.rejected, 1u);
+}
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include "SyncLightSensorAdapter.h"
+#include <atomic>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // 読み取りに時間のかかる同期センサー
+    class SlowLightSensor : public ILightSensor
+    {
+    public:
+        SlowLightSensor(int level, std::chrono::milliseconds delay, std::atomic<int> &reads)
+            : m_level(level), m_delay(delay), m_reads(reads) {}
+
+        int GetLightLevel() override
+        {
+            ++m_reads;
+            std::this_thread::sleep_for(m_delay);
+            return m_level;
+        }
+
+    private:
+        int m_level;
+        std::chrono::milliseconds m_delay;
+        std::atomic<int> &m_reads;
+    };
+
+    class FailingLightSensor : public ILightSensor
+    {
+    public:
+        int GetLightLevel() override
+        {
+            throw std::runtime_error("network error");
+        }
+    };
+
+    // 最初から非同期インターフェースを実装しているセンサー
+    class ImmediateAsyncSensor : public IAsyncLightSensor
+    {
+    public:
+        void StartRead(SampleCallback callback) override
+        {
+            callback(LightSample{30, Clock::now(), LightSampleQuality::Good, "", {}});
+        }
+    };
+}
+
+TEST(SyncLightSensorAdapterTest, ReadDoesNotBlockCaller)
+{
+    std::atomic<int> reads{0};
+    SyncLightSensorAdapter adapter(std::make_unique<SlowLightSensor>(75, 100ms, reads));
+
+    auto start = Clock::now();
+    auto future = adapter.ReadAsync();
+    EXPECT_LT(Clock::now() - start, 20ms);
+
+    LightSample sample = future.get();
+    EXPECT_EQ(sample.quality, LightSampleQuality::Good);
+    EXPECT_EQ(sample.level, 75);
+    EXPECT_GE(sample.timestamp - start, 100ms);
+}
+
+TEST(SyncLightSensorAdapterTest, CallbackReceivesSample)
+{
+    std::atomic<int> reads{0};
+    SyncLightSensorAdapter adapter(std::make_unique<SlowLightSensor>(40, 0ms, reads));
+
+    std::promise<LightSample> received;
+    adapter.StartRead([&](const LightSample &sample) { received.set_value(sample); });
+
+    auto future = received.get_future();
+    ASSERT_EQ(future.wait_for(1s), std::future_status::ready);
+    EXPECT_EQ(future.get().level, 40);
+}
+
+TEST(SyncLightSensorAdapterTest, FailureIsReportedAsUnavailable)
+{
+    SyncLightSensorAdapter adapter(std::make_unique<FailingLightSensor>());
+
+    LightSample sample = adapter.ReadAsync().get();
+    EXPECT_FALSE(sample.IsUsable());
+    EXPECT_EQ(sample.error, "network error");
+    EXPECT_THROW(adapter.GetLightLevel(), std::runtime_error);
+}
+
+TEST(SyncLightSensorAdapterTest, RequestsDuringReadShareResult)
+{
+    std::atomic<int> reads{0};
+    SyncLightSensorAdapter adapter(std::make_unique<SlowLightSensor>(60, 100ms, reads));
+
+    auto first = adapter.ReadAsync();
+    // 最初の読み取りが始まるのを待ってから追加の要求を出す
+    while (reads == 0)
+    {
+        std::this_thread::yield();
+    }
+    auto second = adapter.ReadAsync();
+    auto third = adapter.ReadAsync();
+
+    EXPECT_EQ(first.get().level, 60);
+    EXPECT_EQ(second.get().level, 60);
+    EXPECT_EQ(third.get().level, 60);
+    EXPECT_EQ(reads, 1);
+}
+
+TEST(SyncLightSensorAdapterTest, SynchronousCallersStillWork)
+{
+    std::atomic<int> reads{0};
+    SyncLightSensorAdapter adapter(std::make_unique<SlowLightSensor>(55, 0ms, reads));
+    EXPECT_EQ(adapter.GetLightLevel(), 55);
+}
+
+TEST(SyncLightSensorAdapterTest, PendingRequestsCompleteOnDestruction)
+{
+    std::atomic<int> reads{0};
+    std::future<LightSample> first;
+    std::future<LightSample> second;
+    {
+        SyncLightSensorAdapter adapter(std::make_unique<SlowLightSensor>(10, 50ms, reads));
+        first = adapter.ReadAsync();
+        while (reads == 0)
+        {
+            std::this_thread::yield();
+        }
+        second = adapter.ReadAsync();
+    }
+    EXPECT_TRUE(first.get().IsUsable());
+    // 破棄時に読み取られなかった要求は壊れたpromiseにならず、結果を受け取る
+    ASSERT_EQ(second.wait_for(0s), std::future_status::ready);
+    second.get();
+}
+
+TEST(MakeAsyncLightSensorTest, WrapsOnlySynchronousSensors)
+{
+    auto native = std::make_unique<ImmediateAsyncSensor>();
+    auto *raw = native.get();
+    auto async = MakeAsyncLightSensor(std::move(native));
+    EXPECT_EQ(async.get(), raw);
+    EXPECT_EQ(async->GetLightLevel(), 30);
+
+    std::atomic<int> reads{0};
+    auto wrapped = MakeAsyncLightSensor(std::make_unique<SlowLightSensor>(20, 0ms, reads));
+    EXPECT_NE(dynamic_cast<SyncLightSensorAdapter *>(wrapped.get()), nullptr);
+    EXPECT_EQ(wrapped->GetLightLevel(), 20);
+
+    EXPECT_THROW(MakeAsyncLightSensor(nullptr), std::invalid_argument);
+}
@@ -0,0 +1,344 @@
+#include <gtest/gtest.h>
+#include "BrightnessManager.h"
+#include "EdidSamples.h"
+#include "MonitorController.h"
+#include "SimulatedDisplayBackend.h"
+#include "TestSupport.h"
+#include <common/StringUtils.h>
+#include <atomic>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    class FakeLightSensor : public ILightSensor
+    {
+    public:
+        explicit FakeLightSensor(std::shared_ptr<std::atomic<int>> level)
+            : m_level(std::move(level))
+        {
+        }
+
+        int GetLightLevel() override { return *m_level; }
+
+    private:
+        std::shared_ptr<std::atomic<int>> m_level;
+    };
+
+    SimulatedDisplayBackend::MonitorSpec Dell(std::chrono::milliseconds latency = 0ms)
+    {
+        SimulatedDisplayBackend::MonitorSpec spec{EdidSamples::DellP2419H(), "DP-1", true, {}};
+        spec.latency = latency;
+        return spec;
+    }
+
+    SimulatedDisplayBackend::MonitorSpec LgUltraFine(std::chrono::milliseconds latency = 0ms)
+    {
+        SimulatedDisplayBackend::MonitorSpec spec{EdidSamples::LgUltraFine(), "DP-2", false, {}};
+        // 生値の範囲が0-100ではないモニター
+        spec.maxBrightness = 200;
+        spec.latency = latency;
+        return spec;
+    }
+}
+
+TEST(SyncPipelineTest, ControllerBuildsTopologyFromSimulatedBackend)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    MonitorId dell = simulated->Connect(Dell());
+    auto spec = LgUltraFine();
+    spec.supportsDdc = false;
+    simulated->Connect(spec);
+
+    MonitorController controller(std::move(backend), settings.Path());
+    auto monitors = controller.GetMonitors();
+    ASSERT_EQ(monitors.size(), 2u);
+    EXPECT_EQ(monitors[0].id, dell);
+    EXPECT_TRUE(monitors[0].isPrimary);
+    EXPECT_EQ(monitors[0].deviceName, L"DP-1");
+
+    controller.GetDetailedMonitorInfo(monitors[0]);
+    EXPECT_EQ(monitors[0].modelName, L"DELL P2419H");
+    EXPECT_EQ(monitors[0].manufacturerName, L"DEL");
+    EXPECT_EQ(monitors[0].productCode, L"A0C4");
+    EXPECT_EQ(monitors[0].humanReadableName, L"DELL P2419H 24inch Primary");
+
+    // DDC/CIに対応していないモニターは一覧に含まれるが、輝度は設定できない
+    EXPECT_TRUE(controller.GetMonitorCapabilities(dell).supportsBrightness);
+    EXPECT_FALSE(controller.GetMonitorCapabilities(monitors[1].id).supportsBrightness);
+    EXPECT_FALSE(controller.SetBrightness(monitors[1].id, 50));
+}
+
+TEST(SyncPipelineTest, ControllerScalesBrightnessToRawRange)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    MonitorId dell = simulated->Connect(Dell());
+    MonitorId lg = simulated->Connect(LgUltraFine());
+
+    MonitorController controller(std::move(backend), settings.Path());
+    EXPECT_TRUE(controller.SetUnifiedBrightness(40));
+    EXPECT_EQ(simulated->GetBrightnessValue(dell), 40u);
+    EXPECT_EQ(simulated->GetBrightnessValue(lg), 80u);
+    EXPECT_EQ(controller.GetBrightness(lg), 40);
+}
+
+TEST(SyncPipelineTest, ConcurrentDispatchOverlapsSlowMonitors)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    MonitorId dell = simulated->Connect(Dell());
+    MonitorId lg = simulated->Connect(LgUltraFine());
+
+    MonitorController controller(std::move(backend), settings.Path());
+    // 一覧の作成時の輝度範囲の問い合わせは計測に含めない
+    controller.GetTopology();
+    simulated->SetLatency(dell, 150ms);
+    simulated->SetLatency(lg, 150ms);
+
+    auto start = std::chrono::steady_clock::now();
+    auto result = controller.DispatchBrightness({{dell, 30}, {lg, 70}});
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_TRUE(result.AllSucceeded());
+    EXPECT_LT(elapsed, 280ms);
+
+    controller.SetDispatchMode(MonitorController::DispatchMode::Sequential);
+    start = std::chrono::steady_clock::now();
+    result = controller.DispatchBrightness({{dell, 40}, {lg, 60}});
+    EXPECT_TRUE(result.AllSucceeded());
+    EXPECT_GE(std::chrono::steady_clock::now() - start, 300ms);
+    EXPECT_EQ(simulated->GetBrightnessValue(dell), 40u);
+    EXPECT_EQ(simulated->GetBrightnessValue(lg), 120u);
+}
+
+TEST(SyncPipelineTest, DestroyingControllerWaitsForTimedOutWrites)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    auto controller = std::make_unique<MonitorController>(std::move(backend), settings.Path());
+    controller->GetTopology();
+
+    // 一覧の作成後に接続したモニターは、書き込みのたびにハンドルを開いて輝度範囲を問い合わせる
+    MonitorId dell = simulated->Connect(Dell(200ms));
+    MonitorId lg = simulated->Connect(LgUltraFine(200ms));
+    controller->SetDispatchDeadline(20ms);
+    auto result = controller->DispatchBrightness({{dell, 30}, {lg, 70}});
+    ASSERT_EQ(result.entries.size(), 2u);
+    EXPECT_TRUE(result.entries[0].timedOut);
+    EXPECT_TRUE(result.entries[1].timedOut);
+
+    // 期限切れの後も実行中の書き込みは続いているため、コントローラーの破棄はその完了を待つ
+    controller.reset();
+}
+
+TEST(SyncPipelineTest, SyncAppliesSensorLevelToAllMonitors)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    MonitorId dell = simulated->Connect(Dell(20ms));
+    MonitorId lg = simulated->Connect(LgUltraFine(20ms));
+
+    auto level = std::make_shared<std::atomic<int>>(50);
+    BrightnessManager manager(std::make_unique<FakeLightSensor>(level),
+        std::make_unique<MonitorController>(std::move(backend), settings.Path()));
+    manager.SetBrightnessRange(20, 100);
+    manager.StartSync();
+
+    // 照度50は輝度範囲20-100の60%
+    EXPECT_TRUE(WaitUntil([&] {
+        return simulated->GetBrightnessValue(dell) == 60u && simulated->GetBrightnessValue(lg) == 120u;
+    }));
+
+    // 照度が変わると遷移しながら新しい輝度へ近づく
+    manager.SetTransition(200ms, EasingCurve::Linear);
+    *level = 100;
+    manager.RequestUpdate();
+    EXPECT_TRUE(WaitUntil([&] {
+        return simulated->GetBrightnessValue(dell) == 100u && simulated->GetBrightnessValue(lg) == 200u;
+    }));
+    EXPECT_GT(simulated->GetWriteCount(dell), 2u);
+    manager.StopSync();
+
+    auto stats = manager.GetPipelineStats();
+    EXPECT_GE(stats.sensor.runs, 2u);
+    EXPECT_GE(stats.apply.runs, 2u);
+}
+
+TEST(SyncPipelineTest, ProfilesMatchMonitorIdentityBeforeName)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    MonitorId dell = simulated->Connect(Dell());
+    MonitorId lg = simulated->Connect(LgUltraFine());
+
+    auto level = std::make_shared<std::atomic<int>>(100);
+    BrightnessManager manager(std::make_unique<FakeLightSensor>(level),
+        std::make_unique<MonitorController>(std::move(backend), settings.Path()));
+    manager.SetBrightnessRange(0, 100);
+
+    auto topology = manager.GetMonitorController().GetTopology();
+    const auto *dellMonitor = topology->Find(dell);
+    const auto *lgMonitor = topology->Find(lg);
+    ASSERT_TRUE(dellMonitor && lgMonitor);
+
+    // DELLは識別子の設定を名前の設定より優先し、識別子の設定のないLGは名前の設定を使う
+    BrightnessManager::MonitorProfileTable profiles;
+    profiles[dellMonitor->identity.ToKey()].range = MonitorBrightnessRange{10, 20};
+    profiles[StringUtils::WideToUtf8(dellMonitor->name)].range = MonitorBrightnessRange{50, 60};
+    profiles[StringUtils::WideToUtf8(lgMonitor->name)].range = MonitorBrightnessRange{30, 40};
+    manager.SetMonitorProfiles(std::move(profiles));
+    manager.StartSync();
+
+    EXPECT_TRUE(WaitUntil([&] {
+        return simulated->GetBrightnessValue(dell) == 20u && simulated->GetBrightnessValue(lg) == 80u;
+    })) << simulated->GetBrightnessValue(dell) << ", " << simulated->GetBrightnessValue(lg);
+    manager.StopSync();
+}
+
+TEST(SyncPipelineTest, SmallTransitionsReachTargetDespiteDeadband)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    MonitorId dell = simulated->Connect(Dell());
+
+    auto level = std::make_shared<std::atomic<int>>(40);
+    BrightnessManager manager(std::make_unique<FakeLightSensor>(level),
+        std::make_unique<MonitorController>(std::move(backend), settings.Path()));
+    manager.SetBrightnessRange(0, 100);
+    manager.SetWriteDeadband(1);
+    manager.StartSync();
+    ASSERT_TRUE(WaitUntil([&] { return simulated->GetBrightnessValue(dell) == 40u; }));
+
+    // 不感帯以内の途中フレームが省かれても、遷移の最後には目標値まで書き込む
+    manager.SetTransition(150ms, EasingCurve::EaseInOut);
+    int current = 40;
+    for (int step : {1, 2, 3, 5, 10, -1, -2, -3, -5, -10})
+    {
+        current += step;
+        *level = current;
+        manager.RequestUpdate();
+        EXPECT_TRUE(WaitUntil([&] { return simulated->GetBrightnessValue(dell) == static_cast<unsigned long>(current); }))
+            << "step " << step << " stopped at " << simulated->GetBrightnessValue(dell) << " instead of " << current;
+    }
+    manager.StopSync();
+}
+
+TEST(SyncPipelineTest, MonitorsWithoutDdcAreNotWritten)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    MonitorId dell = simulated->Connect(Dell());
+    auto spec = LgUltraFine();
+    spec.supportsDdc = false;
+    simulated->Connect(spec);
+
+    auto level = std::make_shared<std::atomic<int>>(40);
+    BrightnessManager manager(std::make_unique<FakeLightSensor>(level),
+        std::make_unique<MonitorController>(std::move(backend), settings.Path()));
+    manager.SetBrightnessRange(0, 100);
+    manager.SetTransition(0ms, EasingCurve::Linear);
+    manager.SetApplyInterval(100ms);
+    manager.StartSync();
+    ASSERT_TRUE(WaitUntil([&] { return simulated->GetBrightnessValue(dell) == 40u; }));
+
+    // 輝度を変更できないモニターへは書き込み要求を積まず、失敗と再送を繰り返さない
+    std::this_thread::sleep_for(300ms);
+    manager.StopSync();
+    auto stats = manager.GetWriteStats();
+    EXPECT_EQ(stats.writesFailed, 0u);
+    EXPECT_EQ(stats.writesIssued, 1u);
+}
+
+TEST(SyncPipelineTest, StopSyncWakesWaitingThreadsWithin10ms)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    MonitorId dell = simulated->Connect(Dell());
+
+    auto level = std::make_shared<std::atomic<int>>(40);
+    BrightnessManager manager(std::make_unique<FakeLightSensor>(level),
+        std::make_unique<MonitorController>(std::move(backend), settings.Path()));
+    manager.SetBrightnessRange(0, 100);
+    manager.SetTransition(0ms, EasingCurve::Linear);
+    manager.SetUpdateInterval(1h);
+    manager.SetApplyInterval(1h);
+    manager.StartSync();
+    ASSERT_TRUE(WaitUntil([&] { return simulated->GetBrightnessValue(dell) == 40u; }));
+
+    // 読み取り・適用・書き込みのスレッドがすべて次の通知を待っている状態で停止する
+    std::this_thread::sleep_for(50ms);
+    auto start = std::chrono::steady_clock::now();
+    manager.StopSync();
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 10ms);
+}
+
+TEST(SyncPipelineTest, RequestsDuringSlowWriteAreCoalesced)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    MonitorId dell = simulated->Connect(Dell());
+
+    auto level = std::make_shared<std::atomic<int>>(40);
+    BrightnessManager manager(std::make_unique<FakeLightSensor>(level),
+        std::make_unique<MonitorController>(std::move(backend), settings.Path()));
+    manager.SetBrightnessRange(0, 100);
+    manager.SetTransition(0ms, EasingCurve::Linear);
+    manager.StartSync();
+    ASSERT_TRUE(WaitUntil([&] { return simulated->GetBrightnessValue(dell) == 40u; }));
+
+    // 書き込みに300msかかる間に届いた要求は、最新の値だけにまとめて書き込む
+    simulated->SetLatency(dell, 300ms);
+    auto writesBefore = simulated->GetWriteCount(dell);
+    for (int value = 50; value <= 90; value += 5)
+    {
+        *level = value;
+        manager.RequestUpdate();
+        std::this_thread::sleep_for(40ms);
+    }
+    EXPECT_TRUE(WaitUntil([&] { return simulated->GetBrightnessValue(dell) == 90u; }));
+    manager.StopSync();
+
+    auto stats = manager.GetWriteStats();
+    EXPECT_GE(stats.requestsCoalesced, 1u);
+    EXPECT_LT(stats.writesIssued, stats.requests);
+    EXPECT_LT(simulated->GetWriteCount(dell) - writesBefore, 9u);
+    EXPECT_GE(manager.GetPipelineStats().write.runs, 2u);
+}
+
+TEST(SyncPipelineTest, SyncSetsBrightnessOnHotPluggedMonitor)
+{
+    TempDirectory settings("SyncPipelineTest");
+    auto backend = std::make_unique<SimulatedDisplayBackend>();
+    auto *simulated = backend.get();
+    MonitorId dell = simulated->Connect(Dell());
+
+    auto level = std::make_shared<std::atomic<int>>(25);
+    BrightnessManager manager(std::make_unique<FakeLightSensor>(level),
+        std::make_unique<MonitorController>(std::move(backend), settings.Path()));
+    manager.SetBrightnessRange(0, 100);
+    manager.StartSync();
+    EXPECT_TRUE(WaitUntil([&] { return simulated->GetBrightnessValue(dell) == 25u; }));
+
+    MonitorId lg = simulated->Connect(LgUltraFine());
+    auto change = manager.OnDisplayChange();
+    ASSERT_EQ(change.added.size(), 1u);
+    EXPECT_EQ(change.added[0], lg);
+    EXPECT_TRUE(WaitUntil([&] { return simulated->GetBrightnessValue(lg) == 50u; }));
+
+    simulated->Disconnect(dell);
+    change = manager.OnDisplayChange();
+    EXPECT_EQ(change.removed.size(), 1u);
+    manager.StopSync();
+}
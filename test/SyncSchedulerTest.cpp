@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "SyncScheduler.h"
+#include <atomic>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // 待機中のスレッドを起床させ、起床までの時間と理由を計測する
+    template <typename Action>
+    std::pair<SyncScheduler::WakeReason, Clock::duration> MeasureWakeup(SyncScheduler &scheduler, Action action)
+    {
+        std::atomic<bool> waiting{false};
+        SyncScheduler::WakeReason reason{};
+        Clock::time_point wokenAt;
+
+        std::thread waiter([&] {
+            waiting = true;
+            reason = scheduler.WaitForNextTick();
+            wokenAt = Clock::now();
+        });
+
+        while (!waiting)
+        {
+            std::this_thread::yield();
+        }
+        // 待機に入るまで少し待つ
+        std::this_thread::sleep_for(20ms);
+
+        auto requestedAt = Clock::now();
+        action();
+        waiter.join();
+        return {reason, wokenAt - requestedAt};
+    }
+}
+
+TEST(SyncSchedulerTest, StopWakesWaiterWithin10ms)
+{
+    SyncScheduler scheduler(5s);
+    auto [reason, latency] = MeasureWakeup(scheduler, [&] { scheduler.Stop(); });
+
+    EXPECT_EQ(reason, SyncScheduler::WakeReason::Stopped);
+    EXPECT_LT(latency, 10ms);
+}
+
+TEST(SyncSchedulerTest, NotifyWakesWaiterImmediately)
+{
+    SyncScheduler scheduler(5s);
+    auto [reason, latency] = MeasureWakeup(scheduler, [&] { scheduler.Notify(); });
+
+    EXPECT_EQ(reason, SyncScheduler::WakeReason::Notified);
+    EXPECT_LT(latency, 10ms);
+}
+
+TEST(SyncSchedulerTest, ShorterIntervalAppliesToCurrentWait)
+{
+    SyncScheduler scheduler(5s);
+    auto [reason, latency] = MeasureWakeup(scheduler, [&] { scheduler.SetInterval(1ms); });
+
+    EXPECT_EQ(reason, SyncScheduler::WakeReason::Timeout);
+    EXPECT_LT(latency, 10ms);
+}
+
+TEST(SyncSchedulerTest, TicksAfterInterval)
+{
+    SyncScheduler scheduler(30ms);
+    auto start = Clock::now();
+
+    EXPECT_EQ(scheduler.WaitForNextTick(), SyncScheduler::WakeReason::Timeout);
+    EXPECT_GE(Clock::now() - start, 30ms);
+}
+
+TEST(SyncSchedulerTest, FrameDeadlineWakesBeforeInterval)
+{
+    SyncScheduler scheduler(5s);
+    auto start = Clock::now();
+
+    EXPECT_EQ(scheduler.WaitForNextTick(start + 20ms), SyncScheduler::WakeReason::Frame);
+    auto elapsed = Clock::now() - start;
+    EXPECT_GE(elapsed, 20ms);
+    EXPECT_LT(elapsed, 1s);
+}
+
+TEST(SyncSchedulerTest, IntervalWinsOverLaterFrameDeadline)
+{
+    SyncScheduler scheduler(20ms);
+    EXPECT_EQ(scheduler.WaitForNextTick(Clock::now() + 5s), SyncScheduler::WakeReason::Timeout);
+}
+
+TEST(SyncSchedulerTest, StopIsStickyUntilReset)
+{
+    SyncScheduler scheduler(5s);
+    scheduler.Stop();
+    EXPECT_EQ(scheduler.WaitForNextTick(), SyncScheduler::WakeReason::Stopped);
+    EXPECT_EQ(scheduler.WaitForNextTick(), SyncScheduler::WakeReason::Stopped);
+
+    scheduler.Reset();
+    scheduler.Notify();
+    EXPECT_EQ(scheduler.WaitForNextTick(), SyncScheduler::WakeReason::Notified);
+}
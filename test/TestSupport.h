@@ -0,0 +1,56 @@
+#ifndef DISPLAYCONTROLLER_TEST_TEST_SUPPORT_H
+#define DISPLAYCONTROLLER_TEST_TEST_SUPPORT_H
+
+// テストで共通して使う補助クラス・関数
+
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+
+// 一時ディレクトリ（破棄時に中身ごと削除する）
+class TempDirectory
+{
+public:
+    // prefix: ディレクトリ名の先頭（テストごとに分けて、残ったディレクトリの出どころを分かるようにする）
+    explicit TempDirectory(const std::string &prefix)
+    {
+        std::random_device random;
+        m_path = std::filesystem::temp_directory_path() / (prefix + "_" + std::to_string(random()));
+        std::filesystem::create_directories(m_path);
+    }
+
+    ~TempDirectory()
+    {
+        std::error_code error;
+        std::filesystem::remove_all(m_path, error);
+    }
+
+    TempDirectory(const TempDirectory &) = delete;
+    TempDirectory &operator=(const TempDirectory &) = delete;
+
+    const std::filesystem::path &Path() const { return m_path; }
+
+private:
+    std::filesystem::path m_path;
+};
+
+// 条件が満たされるまで待つ（別スレッドの処理を待つため）
+template <typename Predicate>
+bool WaitUntil(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::seconds(5))
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline)
+    {
+        if (predicate())
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return predicate();
+}
+
+#endif // DISPLAYCONTROLLER_TEST_TEST_SUPPORT_H